@@ -50,11 +50,11 @@ void UModularAbilityExtensionComponent::InitializeAbilitySystem(UModularAbilityS
 	AModularExperienceCharacter* Pawn = GetPawnChecked<AModularExperienceCharacter>();
 	const AActor* ExistingAvatar = InASC->GetAvatarActor();
 
-	UE_LOG(LogModularGameplayAbilities, Verbose, TEXT("Setting up ASC [%s] on pawn [%s] owner [%s], existing [%s] "), *GetNameSafe(InASC), *GetNameSafe(Pawn), *GetNameSafe(InOwnerActor), *GetNameSafe(ExistingAvatar));
+	MGA_LOG(Verbose, TEXT("Setting up ASC [%s] on pawn [%s] owner [%s], existing [%s] "), *GetNameSafe(InASC), *GetNameSafe(Pawn), *GetNameSafe(InOwnerActor), *GetNameSafe(ExistingAvatar))
 
 	if ((ExistingAvatar != nullptr) && (ExistingAvatar != Pawn))
 	{
-		UE_LOG(LogModularGameplayAbilities, Log, TEXT("Existing avatar (authority=%d)"), ExistingAvatar->HasAuthority() ? 1 : 0);
+		MGA_LOG(Log, TEXT("Existing avatar (authority=%d)"), ExistingAvatar->HasAuthority() ? 1 : 0)
 
 		// There is already a pawn acting as the ASC's avatar, so we need to kick it out
 		// This can happen on clients if they're lagged: their new pawn is spawned + possessed before the dead one is removed
@@ -393,8 +393,9 @@ void UModularAbilityExtensionComponent::OnRegister()
 
 	if (!GetPawn<APawn>())
 	{
-		UE_LOG(LogModularGameplayAbilities, Error,
-			TEXT("[UModularAbilityExtensionComponent::OnRegister] This component has been added to a blueprint whose base class is not a Pawn. To use this component, it MUST be placed on a Pawn Blueprint."));
+		MGA_LOG(
+			Error,
+			TEXT("[UModularAbilityExtensionComponent::OnRegister] This component has been added to a blueprint whose base class is not a Pawn. To use this component, it MUST be placed on a Pawn Blueprint."))
 
 #if WITH_EDITOR
 		if (GIsEditor)
@@ -4,18 +4,40 @@
 
 #include "ModularGameplayAbilitiesLogChannels.h"
 #include "Animation/GameplayTagsAnimInstance.h"
+#include "Attributes/ModularAttributeSetBase.h"
 #include "DataAsset/ModularAbilityData.h"
 #include "DataAsset/ModularAssetManager.h"
 #include "GameplayAbilities/ModularGameplayAbility.h"
 #include "Engine/World.h"
+#include "TimerManager.h"
 #include "GameFramework/Pawn.h"
 #include "GameplayAbilities/ModularAbilityTagRelationshipMapping.h"
 #include "GameplayAbilities/ModularGlobalAbilitySystem.h"
+#include "Utilities/MGANetProfiler.h"
+#include "Utilities/MGAPredictionProfiler.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ModularAbilitySystemComponent)
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_Ability_Input_Blocked, "Gameplay.Ability.Input.Blocked");
 
+void FModularAttributeChangeFlushTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && IsValid(Target))
+	{
+		Target->FlushAttributeChanges();
+	}
+}
+
+FString FModularAttributeChangeFlushTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("%s[FlushAttributeChanges]"), *GetPathNameSafe(Target));
+}
+
+FName FModularAttributeChangeFlushTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("ModularAttributeChangeFlush"));
+}
+
 UModularAbilitySystemComponent::UModularAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -30,6 +52,18 @@ void UModularAbilitySystemComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (bCoalesceAttributeChanges)
+	{
+		RegisterAttributeChangeFlushTickFunction();
+	}
+
+	RegisterActivityDelegates();
+
+	if (bAutoDormancy && IsOwnerActorAuthoritative())
+	{
+		RegisterAutoDormancy();
+	}
+
 	/* @Change: Block init delegate registration & startup effects */
 	//RegisterDelegates();
 
@@ -45,9 +79,64 @@ void UModularAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 		GlobalAbilitySystem->UnregisterAbilityComponent(this);
 	}
 
+	UnregisterAttributeChangeFlushTickFunction();
+	UnregisterAutoDormancy();
+	UnregisterActivityDelegates();
+	ResetPendingAttributeChanges();
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AbilityFailureFlushTimerHandle);
+	}
+
+	PendingAbilityFailures.Reset();
+	LastSentAbilityFailureTimes.Reset();
+	LastPresentedAbilityFailureTimes.Reset();
+	ReplicatedTargetDataKeys.Reset();
+
+#if MGA_WITH_NET_PROFILER
+	FMGANetProfiler::Get().NotifyEndPlay(this);
+#endif
+
 	Super::EndPlay(EndPlayReason);
 }
 
+void UModularAbilitySystemComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+#if MGA_WITH_NET_PROFILER
+	if (FMGANetProfiler::IsEnabled())
+	{
+		FMGANetProfiler::Get().NotifyPreReplication(this, ReplicationMode);
+	}
+#endif
+}
+
+void UModularAbilitySystemComponent::PostNetReceive()
+{
+	Super::PostNetReceive();
+
+	/* Attribute sets granted or removed by the server reach clients through replication, not through UModularAbilitySet. */
+	const TArray<UAttributeSet*>& SpawnedAttributes = GetSpawnedAttributes();
+	bool bAttributeSetsChanged = SpawnedAttributes.Num() != ReplicatedAttributeSets.Num();
+	for (int32 Index = 0; Index < SpawnedAttributes.Num() && !bAttributeSetsChanged; ++Index)
+	{
+		bAttributeSetsChanged = ReplicatedAttributeSets[Index] != TObjectKey<UAttributeSet>(SpawnedAttributes[Index]);
+	}
+
+	if (bAttributeSetsChanged)
+	{
+		ReplicatedAttributeSets.Reset(SpawnedAttributes.Num());
+		for (UAttributeSet* AttributeSet : SpawnedAttributes)
+		{
+			ReplicatedAttributeSets.Add(AttributeSet);
+		}
+
+		ResetAttributeAccessors();
+	}
+}
+
 void UModularAbilitySystemComponent::BeginDestroy()
 {
 	UnregisterDelegates();
@@ -57,7 +146,7 @@ void UModularAbilitySystemComponent::BeginDestroy()
 
 void UModularAbilitySystemComponent::RegisterDelegates()
 {
-	UE_LOG(LogModularGameplayAbilities, Verbose, TEXT("Registering Delegates for %s"), *GetNameSafe(this));
+	MGA_LOG(Verbose, TEXT("Registering Delegates for %s"), *GetNameSafe(this))
 
 	UnregisterDelegates();
 
@@ -137,6 +226,9 @@ void UModularAbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor,
 
 	Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
 
+	/* Owners commonly grant their attribute sets around this point, outside of UModularAbilitySet. */
+	ResetAttributeAccessors();
+
 	if (bHasNewPawnAvatar)
 	{
 		// Notify all abilities that a new pawn avatar has been set
@@ -174,14 +266,194 @@ void UModularAbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor,
 	}
 }
 
+void UModularAbilitySystemComponent::NotifyAbilitySystemActivity(const EModularAbilitySystemActivity Activity)
+{
+	if (bAutoDormancy)
+	{
+		WakeFromAutoDormancy();
+	}
+
+	OnAbilitySystemActivity.Broadcast(Activity);
+}
+
+void UModularAbilitySystemComponent::RegisterActivityDelegates()
+{
+	TWeakObjectPtr<ThisClass> WeakThis(this);
+	ActivityEffectAddedHandle = OnActiveGameplayEffectAddedDelegateToSelf.AddLambda([WeakThis](UAbilitySystemComponent*, const FGameplayEffectSpec&, FActiveGameplayEffectHandle)
+	{
+		if (ThisClass* StrongThis = WeakThis.Get())
+		{
+			StrongThis->NotifyAbilitySystemActivity(EModularAbilitySystemActivity::EffectAdded);
+		}
+	});
+	ActivityEffectRemovedHandle = OnAnyGameplayEffectRemovedDelegate().AddLambda([WeakThis](const FActiveGameplayEffect&)
+	{
+		if (ThisClass* StrongThis = WeakThis.Get())
+		{
+			StrongThis->NotifyAbilitySystemActivity(EModularAbilitySystemActivity::EffectRemoved);
+		}
+	});
+
+	RegisterAttributeActivityDelegates();
+}
+
+void UModularAbilitySystemComponent::UnregisterActivityDelegates()
+{
+	OnActiveGameplayEffectAddedDelegateToSelf.Remove(ActivityEffectAddedHandle);
+	OnAnyGameplayEffectRemovedDelegate().Remove(ActivityEffectRemovedHandle);
+	ActivityEffectAddedHandle.Reset();
+	ActivityEffectRemovedHandle.Reset();
+
+	for (const TPair<FGameplayAttribute, FDelegateHandle>& Pair : ActivityAttributeHandles)
+	{
+		GetGameplayAttributeValueChangeDelegate(Pair.Key).Remove(Pair.Value);
+	}
+
+	ActivityAttributeHandles.Reset();
+}
+
+void UModularAbilitySystemComponent::RegisterAttributeActivityDelegates()
+{
+	TArray<FGameplayAttribute> Attributes;
+	GetAllAttributes(Attributes);
+
+	TWeakObjectPtr<ThisClass> WeakThis(this);
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		const UClass* AttributeSetClass = Attribute.GetAttributeSetClass();
+		if (!AttributeSetClass || AttributeSetClass->IsChildOf<UModularAttributeSetBase>() || ActivityAttributeHandles.Contains(Attribute))
+		{
+			continue;
+		}
+
+		ActivityAttributeHandles.Add(Attribute, GetGameplayAttributeValueChangeDelegate(Attribute).AddLambda([WeakThis](const FOnAttributeChangeData& Data)
+		{
+			ThisClass* StrongThis = WeakThis.Get();
+			if (StrongThis && Data.OldValue != Data.NewValue)
+			{
+				StrongThis->NotifyAbilitySystemActivity(EModularAbilitySystemActivity::AttributeChange);
+			}
+		}));
+	}
+}
+
+void UModularAbilitySystemComponent::RegisterAutoDormancy()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	LastReplicatedStateChangeTime = World->GetTimeSeconds();
+	World->GetTimerManager().SetTimer(AutoDormancyTimerHandle, this, &ThisClass::UpdateAutoDormancy, 1.f, true);
+}
+
+void UModularAbilitySystemComponent::UnregisterAutoDormancy()
+{
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AutoDormancyTimerHandle);
+	}
+
+	bIsAutoDormant = false;
+}
+
+void UModularAbilitySystemComponent::UpdateAutoDormancy()
+{
+	AActor* Owner = GetOwner();
+	const UWorld* World = GetWorld();
+	if (!Owner || !World || bIsAutoDormant)
+	{
+		return;
+	}
+
+	/* Leave owners that are dormant for other reasons (or never dormant) alone. */
+	if (Owner->NetDormancy != DORM_Awake)
+	{
+		return;
+	}
+
+	if (World->GetTimeSeconds() - LastReplicatedStateChangeTime < AutoDormancyDelay || !IsQuiescent())
+	{
+		return;
+	}
+
+	/* Attribute sets added since BeginPlay have to wake the owner up as well. */
+	RegisterAttributeActivityDelegates();
+
+	MGA_LOG(Verbose, TEXT("%s is quiescent, putting %s to net dormancy"), *GetNameSafe(this), *GetNameSafe(Owner))
+
+	bIsAutoDormant = true;
+	Owner->SetNetDormancy(DORM_DormantAll);
+	World->GetTimerManager().PauseTimer(AutoDormancyTimerHandle);
+}
+
+bool UModularAbilitySystemComponent::IsQuiescent() const
+{
+	if (!PendingAttributeChanges.IsEmpty() || !PendingPreAttributeChanges.IsEmpty() || !PendingAbilityFailures.IsEmpty())
+	{
+		return false;
+	}
+
+	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+	{
+		if (AbilitySpec.IsActive())
+		{
+			return false;
+		}
+	}
+
+	/* Effects with a duration expire and periodic ones execute, both change replicated state on their own. */
+	for (auto It = ActiveGameplayEffects.CreateConstIterator(); It; ++It)
+	{
+		if (It->GetDuration() > 0.f || It->GetPeriod() > 0.f)
+		{
+			return false;
+		}
+	}
+
+	if (CanEnterAutoDormancy.IsBound() && !CanEnterAutoDormancy.Execute(this))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void UModularAbilitySystemComponent::WakeFromAutoDormancy()
+{
+	const UWorld* World = GetWorld();
+	if (!World || !IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+
+	LastReplicatedStateChangeTime = World->GetTimeSeconds();
+
+	if (!bIsAutoDormant)
+	{
+		return;
+	}
+
+	bIsAutoDormant = false;
+	if (AActor* Owner = GetOwner())
+	{
+		MGA_LOG(Verbose, TEXT("%s changed, waking %s from net dormancy"), *GetNameSafe(this), *GetNameSafe(Owner))
+		Owner->SetNetDormancy(DORM_Awake);
+	}
+
+	World->GetTimerManager().UnPauseTimer(AutoDormancyTimerHandle);
+}
+
 void UModularAbilitySystemComponent::HandleOnAbilityActivate(UGameplayAbility* Ability)
 {
-	UE_LOG(LogModularGameplayAbilities, Log, TEXT("UModularAbilitySystemComponent::OnAbilityActivatedCallback %s"), *Ability->GetName());
+	MGA_LOG(Log, TEXT("UModularAbilitySystemComponent::OnAbilityActivatedCallback %s"), *Ability->GetName())
 
 	const AActor* Avatar = GetAvatarActor();
 	if (!Avatar)
 	{
-		UE_LOG(LogModularGameplayAbilities, Error, TEXT("UModularAbilitySystemComponent::OnAbilityActivated No OwnerActor for this ability: %s"), *Ability->GetName());
+		MGA_LOG(Error, TEXT("UModularAbilitySystemComponent::OnAbilityActivated No OwnerActor for this ability: %s"), *Ability->GetName())
 		return;
 	}
 	
@@ -224,12 +496,12 @@ void UModularAbilitySystemComponent::HandleOnAbilityCommit(UGameplayAbility* Act
 
 void UModularAbilitySystemComponent::HandleOnAbilityEnd(UGameplayAbility* Ability)
 {
-	UE_LOG(LogModularGameplayAbilities, Log, TEXT("UModularAbilitySystemComponent::OnAbilityEndedCallback %s"), *Ability->GetName());
+	MGA_LOG(Log, TEXT("UModularAbilitySystemComponent::OnAbilityEndedCallback %s"), *Ability->GetName())
 
 	const AActor* Avatar = GetAvatarActor();
 	if (!Avatar)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("UModularAbilitySystemComponent::OnAbilityEndedCallback No OwnerActor for this ability: %s"), *Ability->GetName());
+		MGA_LOG(Warning, TEXT("UModularAbilitySystemComponent::OnAbilityEndedCallback No OwnerActor for this ability: %s"), *Ability->GetName())
 		return;
 	}
 
@@ -239,12 +511,12 @@ void UModularAbilitySystemComponent::HandleOnAbilityEnd(UGameplayAbility* Abilit
 void UModularAbilitySystemComponent::HandleOnAbilityFail(const UGameplayAbility* Ability,
 	const FGameplayTagContainer& Tags)
 {
-	UE_LOG(LogModularGameplayAbilities, Log, TEXT("UModularAbilitySystemComponent::OnAbilityFailedCallback %s"), *Ability->GetName());
+	MGA_LOG(Log, TEXT("UModularAbilitySystemComponent::OnAbilityFailedCallback %s"), *Ability->GetName())
 
 	const AActor* Avatar = GetAvatarActor();
 	if (!Avatar)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("UModularAbilitySystemComponent::OnAbilityFailed No OwnerActor for this ability: %s Tags: %s"), *Ability->GetName(), *Tags.ToString());
+		MGA_LOG(Warning, TEXT("UModularAbilitySystemComponent::OnAbilityFailed No OwnerActor for this ability: %s Tags: %s"), *Ability->GetName(), *Tags.ToString())
 		return;
 	}
 
@@ -277,7 +549,29 @@ void UModularAbilitySystemComponent::HandleOnCooldownEnd(UGameplayAbility* Activ
 void UModularAbilitySystemComponent::HandlePreAttributeChange(UAttributeSet* AttributeSet,
 	const FGameplayAttribute& Attribute, float NewValue)
 {
-	OnPreAttributeChange.Broadcast(AttributeSet, Attribute, NewValue);
+	if (!IsCoalescingAttributeChanges())
+	{
+		OnPreAttributeChange.Broadcast(AttributeSet, Attribute, NewValue);
+		return;
+	}
+
+	/* Only keep the last proposed value for each attribute until next flush. */
+	const FMGAAttributeHandle AttributeHandle = GetAttributeHandle(Attribute, AttributeSet);
+	if (const int32* Index = PendingPreAttributeChangeIndices.Find(AttributeHandle))
+	{
+		FModularPreAttributeChangeBatchEntry& Entry = PendingPreAttributeChanges[*Index];
+		Entry.AttributeSet = AttributeSet;
+		Entry.NewValue = NewValue;
+		return;
+	}
+
+	PendingPreAttributeChangeIndices.Add(AttributeHandle, PendingPreAttributeChanges.Num());
+	FModularPreAttributeChangeBatchEntry& Entry = PendingPreAttributeChanges.AddDefaulted_GetRef();
+	Entry.AttributeSet = AttributeSet;
+	Entry.Attribute = Attribute;
+	Entry.NewValue = NewValue;
+
+	RequestAttributeChangeFlush();
 }
 
 void UModularAbilitySystemComponent::HandleOnAttributeChange(const FOnAttributeChangeData& Data)
@@ -285,18 +579,143 @@ void UModularAbilitySystemComponent::HandleOnAttributeChange(const FOnAttributeC
 	const float NewValue = Data.NewValue;
 	const float OldValue = Data.OldValue;
 
+	const bool bCoalesce = IsCoalescingAttributeChanges();
+
 	/* Prevent broadcast Attribute changes if New and Old values are the same, most likely because of clamping in post gameplay effect execute. */
-	if (OldValue == NewValue) {return;}
+	/* When coalescing, a no-op write still has to be recorded as it may revert a pending change. */
+	if (OldValue == NewValue && !bCoalesce) {return;}
 
 	const FGameplayEffectModCallbackData* ModData = Data.GEModData;
-	FGameplayTagContainer SourceTags = FGameplayTagContainer();
-	if (ModData)
+	const FGameplayTagContainer* SourceTags = ModData ? ModData->EffectSpec.CapturedSourceTags.GetAggregatedTags() : nullptr;
+
+	if (!bCoalesce)
 	{
-		SourceTags = *ModData->EffectSpec.CapturedSourceTags.GetAggregatedTags();
+		/* Broadcast attribute change to component. */
+		OnAttributeChange.Broadcast(Data.Attribute, NewValue - OldValue, SourceTags ? *SourceTags : FGameplayTagContainer());
+		return;
 	}
 
-	/* Broadcast attribute change to component. */
-	OnAttributeChange.Broadcast(Data.Attribute, NewValue - OldValue, SourceTags);
+	/* Record the first old value and the last new value for each attribute until next flush. */
+	const FMGAAttributeHandle AttributeHandle = GetAttributeHandle(Data.Attribute);
+	FModularAttributeChangeBatchEntry* Entry;
+	if (const int32* Index = PendingAttributeChangeIndices.Find(AttributeHandle))
+	{
+		Entry = &PendingAttributeChanges[*Index];
+	}
+	else
+	{
+		if (OldValue == NewValue) {return;}
+
+		PendingAttributeChangeIndices.Add(AttributeHandle, PendingAttributeChanges.Num());
+		Entry = &PendingAttributeChanges.AddDefaulted_GetRef();
+		Entry->Attribute = Data.Attribute;
+		Entry->OldValue = OldValue;
+	}
+
+	Entry->NewValue = NewValue;
+	if (SourceTags)
+	{
+		Entry->EventTags.AppendTags(*SourceTags);
+	}
+
+	RequestAttributeChangeFlush();
+}
+
+void UModularAbilitySystemComponent::FlushAttributeChanges()
+{
+	if (PendingAttributeChanges.IsEmpty() && PendingPreAttributeChanges.IsEmpty())
+	{
+		return;
+	}
+
+	/* Move pending changes out first, so that listeners changing attributes queue up for next flush. */
+	TArray<FModularPreAttributeChangeBatchEntry> PreAttributeChanges = MoveTemp(PendingPreAttributeChanges);
+	TArray<FModularAttributeChangeBatchEntry> AttributeChanges = MoveTemp(PendingAttributeChanges);
+	ResetPendingAttributeChanges();
+
+	for (const FModularPreAttributeChangeBatchEntry& Entry : PreAttributeChanges)
+	{
+		OnPreAttributeChange.Broadcast(Entry.AttributeSet.Get(), Entry.Attribute, Entry.NewValue);
+	}
+
+	/* Drop attributes that came back to their initial value during the frame. */
+	AttributeChanges.RemoveAll([](const FModularAttributeChangeBatchEntry& Entry)
+	{
+		return Entry.OldValue == Entry.NewValue;
+	});
+
+	if (AttributeChanges.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FModularAttributeChangeBatchEntry& Entry : AttributeChanges)
+	{
+		OnAttributeChange.Broadcast(Entry.Attribute, Entry.NewValue - Entry.OldValue, Entry.EventTags);
+	}
+
+	OnAttributeChangeBatch.Broadcast(AttributeChanges);
+}
+
+bool UModularAbilitySystemComponent::IsCoalescingAttributeChanges() const
+{
+	return bCoalesceAttributeChanges && AttributeChangeFlushTickFunction.IsTickFunctionRegistered();
+}
+
+void UModularAbilitySystemComponent::RegisterAttributeChangeFlushTickFunction()
+{
+	if (AttributeChangeFlushTickFunction.IsTickFunctionRegistered())
+	{
+		return;
+	}
+
+	const AActor* Owner = GetOwner();
+	ULevel* Level = Owner ? Owner->GetLevel() : nullptr;
+	if (!Level)
+	{
+		MGA_LOG(Warning, TEXT("Unable to register attribute change flush for %s, changes will not be coalesced"), *GetNameSafe(this))
+		return;
+	}
+
+	AttributeChangeFlushTickFunction.Target = this;
+	AttributeChangeFlushTickFunction.TickGroup = AttributeChangeFlushTickGroup;
+	AttributeChangeFlushTickFunction.bCanEverTick = true;
+	AttributeChangeFlushTickFunction.bStartWithTickEnabled = false;
+	AttributeChangeFlushTickFunction.bAllowTickOnDedicatedServer = true;
+	AttributeChangeFlushTickFunction.bTickEvenWhenPaused = false;
+	AttributeChangeFlushTickFunction.RegisterTickFunction(Level);
+}
+
+void UModularAbilitySystemComponent::UnregisterAttributeChangeFlushTickFunction()
+{
+	if (AttributeChangeFlushTickFunction.IsTickFunctionRegistered())
+	{
+		AttributeChangeFlushTickFunction.UnRegisterTickFunction();
+	}
+
+	AttributeChangeFlushTickFunction.Target = nullptr;
+}
+
+void UModularAbilitySystemComponent::RequestAttributeChangeFlush()
+{
+	/* The flush tick function is only enabled while there are pending changes. */
+	if (!AttributeChangeFlushTickFunction.IsTickFunctionEnabled())
+	{
+		AttributeChangeFlushTickFunction.SetTickFunctionEnable(true);
+	}
+}
+
+void UModularAbilitySystemComponent::ResetPendingAttributeChanges()
+{
+	PendingAttributeChanges.Reset();
+	PendingPreAttributeChanges.Reset();
+	PendingAttributeChangeIndices.Reset();
+	PendingPreAttributeChangeIndices.Reset();
+
+	if (AttributeChangeFlushTickFunction.IsTickFunctionRegistered() && AttributeChangeFlushTickFunction.IsTickFunctionEnabled())
+	{
+		AttributeChangeFlushTickFunction.SetTickFunctionEnable(false);
+	}
 }
 
 void UModularAbilitySystemComponent::HandleOnGameplayEffectAdd(UAbilitySystemComponent* Target,
@@ -370,7 +789,7 @@ void UModularAbilitySystemComponent::HandlePostGameplayEffectExecute(UAttributeS
 {
 	if (!AttributeSet)
 	{
-		UE_LOG(LogModularGameplayAbilities, Error, TEXT("ModularAttributeSet isn't valid"));
+		MGA_LOG(Error, TEXT("ModularAttributeSet isn't valid"))
 		return;
 	}
 
@@ -404,65 +823,123 @@ void UModularAbilitySystemComponent::HandleOnGameplayTagChange(const FGameplayTa
 
 float UModularAbilitySystemComponent::GetAttributeBaseValue(FGameplayAttribute Attribute) const
 {
+	const FMGAAttributeAccessor& Accessor = FindAttributeAccessor(Attribute);
+	if (Accessor.IsValid())
+	{
+		return Accessor.GetBaseValue();
+	}
+
+#if MGA_WITH_ATTRIBUTE_ACCESSOR_VALIDATION
 	if (!Attribute.IsValid())
 	{
-		UE_LOG(LogModularGameplayAbilities, Error, TEXT("Passed in Attribute is invalid (None). Will return 0.f."))
+		MGA_LOG(Error, TEXT("Passed in Attribute is invalid (None). Will return 0.f."))
 		return 0.f;
 	}
 
 	if (!HasAttributeSetForAttribute(Attribute))
 	{
 		const UClass* AttributeSet = Attribute.GetAttributeSetClass();
-		UE_LOG(
-			LogModularGameplayAbilities,
+		MGA_LOG(
 			Error,
 			TEXT("Trying to get value of attribute [%s.%s]. %s doesn't seem to be granted to %s. Returning 0.f"),
 			*GetNameSafe(AttributeSet),
 			*Attribute.GetName(),
 			*GetNameSafe(AttributeSet),
 			*GetNameSafe(this)
-		);
+		)
 
 		return 0.f;
 	}
+#endif
 
 	return GetNumericAttributeBase(Attribute);
 }
 
 float UModularAbilitySystemComponent::GetAttributeCurrentValue(FGameplayAttribute Attribute) const
 {
+	const FMGAAttributeAccessor& Accessor = FindAttributeAccessor(Attribute);
+	if (Accessor.IsValid())
+	{
+		return Accessor.GetCurrentValue();
+	}
+
+#if MGA_WITH_ATTRIBUTE_ACCESSOR_VALIDATION
 	if (!Attribute.IsValid())
 	{
-		UE_LOG(LogModularGameplayAbilities, Error, TEXT("Passed in Attribute is invalid (None). Will return 0.f."))
+		MGA_LOG(Error, TEXT("Passed in Attribute is invalid (None). Will return 0.f."))
 		return 0.f;
 	}
 
 	if (!HasAttributeSetForAttribute(Attribute))
 	{
 		const UClass* AttributeSet = Attribute.GetAttributeSetClass();
-		UE_LOG(
-			LogModularGameplayAbilities,
+		MGA_LOG(
 			Error,
 			TEXT("Trying to get value of attribute [%s.%s]. %s doesn't seem to be granted to %s. Returning 0.f"),
 			*GetNameSafe(AttributeSet),
 			*Attribute.GetName(),
 			*GetNameSafe(AttributeSet),
 			*GetNameSafe(this)
-		);
+		)
 
 		return 0.f;
 	}
+#endif
 
 	return GetNumericAttribute(Attribute);
 }
 
+FMGAAttributeAccessor UModularAbilitySystemComponent::ResolveAttributeAccessor(const FGameplayAttribute& Attribute) const
+{
+	FMGAAttributeAccessor Accessor = FMGAAttributeAccessor::Make(this, Attribute);
+
+	/* Invalid accessors keep their attribute as well, so that they can be resolved again once the set is granted. */
+	Accessor.Attribute = Attribute;
+	Accessor.AttributeSetsSerial = AttributeSetsSerial;
+	return Accessor;
+}
+
+const FMGAAttributeAccessor& UModularAbilitySystemComponent::FindAttributeAccessor(const FGameplayAttribute& Attribute) const
+{
+	if (FMGAAttributeAccessor* Accessor = AttributeAccessors.Find(Attribute))
+	{
+		RefreshAttributeAccessor(*Accessor);
+		return *Accessor;
+	}
+
+	/* Invalid accessors are kept as well, callers fall back to the generic path. */
+	return AttributeAccessors.Add(Attribute, ResolveAttributeAccessor(Attribute));
+}
+
+void UModularAbilitySystemComponent::ResetAttributeAccessors()
+{
+	/* Kept accessors are resolved again on their next refresh, resolving them all here would pay for unused ones. */
+	++AttributeSetsSerial;
+}
+
+FMGAAttributeHandle UModularAbilitySystemComponent::GetAttributeHandle(const FGameplayAttribute& Attribute, const UAttributeSet* AttributeSet) const
+{
+	if (!AttributeSet)
+	{
+		AttributeSet = GetAttributeSubobject(Attribute.GetAttributeSetClass());
+	}
+
+	/* Modular sets resolve the handles of their attributes once, others go through the registry. */
+	if (const UModularAttributeSetBase* ModularAttributeSet = Cast<UModularAttributeSetBase>(AttributeSet))
+	{
+		return ModularAttributeSet->GetAttributeHandle(Attribute);
+	}
+
+	return FMGAAttributeHandle::FromAttribute(Attribute);
+}
+
 void UModularAbilitySystemComponent::GrantAbility(TSubclassOf<UGameplayAbility> Ability, int32 Level)
 {
 	if (!GetOwner() || !Ability) {return;}
 
 	if (!IsOwnerActorAuthoritative())
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("GrantAbility Called on non authority"));
+		MGA_LOG(Warning, TEXT("GrantAbility Called on non authority"))
 		return;
 	}
 
@@ -506,7 +983,7 @@ bool UModularAbilitySystemComponent::IsUsingAbilityByClass(TSubclassOf<UGameplay
 {
 	if (!AbilityClass)
 	{
-		UE_LOG(LogModularGameplayAbilities, Error, TEXT("IsUsingAbilityByClass: Provided AbilityClass is null"))
+		MGA_LOG(Error, TEXT("IsUsingAbilityByClass: Provided AbilityClass is null"))
 		return false;
 	}
 
@@ -595,14 +1072,14 @@ void UModularAbilitySystemComponent::AdjustAttributeForMaxChange(UAttributeSet*
 	FGameplayAttributeData* AttributeData = AffectedAttributeProperty.GetGameplayAttributeData(AttributeSet);
 	if (!AttributeData)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("AdjustAttributeForMaxChange() AttributeData returned by AffectedAttributeProperty.GetGameplayAttributeData() seems to be invalid."))
+		MGA_LOG(Warning, TEXT("AdjustAttributeForMaxChange() AttributeData returned by AffectedAttributeProperty.GetGameplayAttributeData() seems to be invalid."))
 		return;
 	}
 
 	const FGameplayAttributeData* MaxAttributeData = MaxAttribute.GetGameplayAttributeData(AttributeSet);
-	if (!AttributeData)
+	if (!MaxAttributeData)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("AdjustAttributeForMaxChange() MaxAttributeData returned by MaxAttribute.GetGameplayAttributeData() seems to be invalid."))
+		MGA_LOG(Warning, TEXT("AdjustAttributeForMaxChange() MaxAttributeData returned by MaxAttribute.GetGameplayAttributeData() seems to be invalid."))
 		return;
 	}
 
@@ -617,8 +1094,8 @@ void UModularAbilitySystemComponent::AdjustAttributeForMaxChange(UAttributeSet*
 		// Calculate value for the affected attribute based on current ratio
 		const float NewValue = FMath::RoundToFloat(NewMaxValue * Ratio);
 
-		UE_LOG(LogModularGameplayAbilities, Verbose, TEXT("AdjustAttributeForMaxChange: CurrentValue: %f, CurrentMaxValue: %f, NewMaxValue: %f, NewValue: %f (Ratio: %f)"), CurrentValue, CurrentMaxValue, NewMaxValue, NewValue, Ratio)
-		UE_LOG(LogModularGameplayAbilities, Verbose, TEXT("AdjustAttributeForMaxChange: ApplyModToAttribute %s with %f"), *AffectedAttributeProperty.GetName(), NewValue)
+		MGA_LOG(Verbose, TEXT("AdjustAttributeForMaxChange: CurrentValue: %f, CurrentMaxValue: %f, NewMaxValue: %f, NewValue: %f (Ratio: %f)"), CurrentValue, CurrentMaxValue, NewMaxValue, NewValue, Ratio)
+		MGA_LOG(Verbose, TEXT("AdjustAttributeForMaxChange: ApplyModToAttribute %s with %f"), *AffectedAttributeProperty.GetName(), NewValue)
 		ApplyModToAttribute(AffectedAttributeProperty, EGameplayModOp::Override, NewValue);
 	}
 }
@@ -648,7 +1125,7 @@ void UModularAbilitySystemComponent::CancelAbilitiesByFunc(TShouldCancelAbilityF
 		UModularGameplayAbility* ModularAbilityCDO = CastChecked<UModularGameplayAbility>(AbilitySpec.Ability); 
 		if (!ModularAbilityCDO)
 		{
-			UE_LOG(LogModularGameplayAbilities, Error, TEXT("CancelAbilitiesByFunc: Non-ModularGameplayAbility %s was Granted to ASC. Skipping."), *AbilitySpec.Ability.GetName());
+			MGA_LOG(Error, TEXT("CancelAbilitiesByFunc: Non-ModularGameplayAbility %s was Granted to ASC. Skipping."), *AbilitySpec.Ability.GetName())
 			continue;
 		}
 
@@ -666,7 +1143,7 @@ void UModularAbilitySystemComponent::CancelAbilitiesByFunc(TShouldCancelAbilityF
 				}
 				else
 				{
-					UE_LOG(LogModularGameplayAbilities, Error, TEXT("CancelAbilitiesByFunc: Can't cancel ability [%s] because CanBeCanceled is false."), *ModularAbilityInstance->GetName());
+					MGA_LOG(Error, TEXT("CancelAbilitiesByFunc: Can't cancel ability [%s] because CanBeCanceled is false."), *ModularAbilityInstance->GetName())
 				}
 			}
 		}
@@ -854,6 +1331,52 @@ void UModularAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbili
 	{
 		AddAbilityToActivationGroup(ModularAbility->GetActivationGroup(), ModularAbility);
 	}
+
+	NotifyAbilitySystemActivity(EModularAbilitySystemActivity::AbilityActivated);
+
+#if MGA_WITH_PREDICTION_PROFILER
+	if (FMGAPredictionProfiler::IsEnabled() && Ability)
+	{
+		const FGameplayAbilityActivationInfo& ActivationInfo = Ability->GetCurrentActivationInfo();
+		if (ActivationInfo.ActivationMode == EGameplayAbilityActivationMode::Predicting)
+		{
+			FMGAPredictionProfiler::Get().NotifyPredictedActivation(this, Ability, ActivationInfo.GetActivationPredictionKey());
+		}
+	}
+#endif
+}
+
+FActiveGameplayEffectHandle UModularAbilitySystemComponent::ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey)
+{
+#if MGA_WITH_PREDICTION_PROFILER
+	if (FMGAPredictionProfiler::IsEnabled() && PredictionKey.IsLocalClientKey())
+	{
+		FMGAPredictionProfiler::Get().NotifyPredictedEffect(this, PredictionKey);
+	}
+#endif
+
+	return Super::ApplyGameplayEffectSpecToSelf(GameplayEffect, PredictionKey);
+}
+
+void UModularAbilitySystemComponent::OnTagUpdated(const FGameplayTag& Tag, bool TagExists)
+{
+	Super::OnTagUpdated(Tag, TagExists);
+
+	NotifyAbilitySystemActivity(EModularAbilitySystemActivity::TagChange);
+}
+
+void UModularAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	NotifyAbilitySystemActivity(EModularAbilitySystemActivity::AbilityGiven);
+}
+
+void UModularAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnRemoveAbility(AbilitySpec);
+
+	NotifyAbilitySystemActivity(EModularAbilitySystemActivity::AbilityRemoved);
 }
 
 void UModularAbilitySystemComponent::NotifyAbilityFailed(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason)
@@ -864,7 +1387,7 @@ void UModularAbilitySystemComponent::NotifyAbilityFailed(const FGameplayAbilityS
 	{
 		if (!Avatar->IsLocallyControlled() && Ability->IsSupportedForNetworking())
 		{
-			ClientNotifyAbilityFailed(Ability, FailureReason);
+			QueueAbilityFailure(Ability, FailureReason);
 			return;
 		}
 	}
@@ -922,9 +1445,112 @@ void UModularAbilitySystemComponent::ClientNotifyAbilityFailed_Implementation(co
 	HandleAbilityFailed(Ability, FailureReason);
 }
 
+void UModularAbilitySystemComponent::ClientNotifyAbilityFailures_Implementation(const TArray<FModularAbilityFailureBatchEntry>& Failures)
+{
+	for (const FModularAbilityFailureBatchEntry& Failure : Failures)
+	{
+		HandleAbilityFailed(Failure.Ability, Failure.FailureReason);
+	}
+}
+
+void UModularAbilitySystemComponent::QueueAbilityFailure(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason)
+{
+	if (IsAbilityFailureThrottled(LastSentAbilityFailureTimes, Ability, FailureReason))
+	{
+		return;
+	}
+
+	FModularAbilityFailureBatchEntry& Entry = PendingAbilityFailures.AddDefaulted_GetRef();
+	Entry.Ability = Ability;
+	Entry.FailureReason = FailureReason;
+
+	/* RPCs of a dormant owner aren't sent, wake it up before the batch goes out. */
+	NotifyAbilitySystemActivity(EModularAbilitySystemActivity::AbilityFailed);
+
+	/*
+	* Failures of a frame go out in a single RPC from a next tick timer, independently of the owner net update frequency
+	* and of whether it replicates this frame at all.
+	*/
+	if (PendingAbilityFailures.Num() == 1)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			AbilityFailureFlushTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &ThisClass::FlushAbilityFailures);
+		}
+		else
+		{
+			FlushAbilityFailures();
+		}
+	}
+}
+
+void UModularAbilitySystemComponent::FlushAbilityFailures()
+{
+	AbilityFailureFlushTimerHandle.Invalidate();
+
+	if (PendingAbilityFailures.IsEmpty())
+	{
+		return;
+	}
+
+#if MGA_WITH_NET_PROFILER
+	if (FMGANetProfiler::IsEnabled())
+	{
+		/* Array size, then ability reference and failure tags of each entry */
+		int64 NumBits = 32;
+		for (const FModularAbilityFailureBatchEntry& Failure : PendingAbilityFailures)
+		{
+			NumBits += 32 + Failure.FailureReason.Num() * 16;
+		}
+
+		FMGANetProfiler::Get().RecordRPC(GET_FUNCTION_NAME_CHECKED(ThisClass, ClientNotifyAbilityFailures), NumBits, true);
+	}
+#endif
+
+	ClientNotifyAbilityFailures(PendingAbilityFailures);
+	PendingAbilityFailures.Reset();
+}
+
+bool UModularAbilitySystemComponent::IsAbilityFailureThrottled(TMap<FModularAbilityFailureKey, double>& InOutLastTimes, const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason) const
+{
+	const UWorld* World = GetWorld();
+	if (AbilityFailureWindow <= 0.f || !World)
+	{
+		return false;
+	}
+
+	const double Now = World->GetTimeSeconds();
+
+	/* Keep the map small, entries older than the window are no longer relevant. */
+	if (InOutLastTimes.Num() > 32)
+	{
+		for (auto It = InOutLastTimes.CreateIterator(); It; ++It)
+		{
+			if (Now - It.Value() >= AbilityFailureWindow)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	const FModularAbilityFailureKey Key(Ability, FailureReason);
+	if (const double* LastTime = InOutLastTimes.Find(Key); LastTime && Now - *LastTime < AbilityFailureWindow)
+	{
+		return true;
+	}
+
+	InOutLastTimes.Add(Key, Now);
+	return false;
+}
+
 void UModularAbilitySystemComponent::HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason)
 {
-	UE_LOG(LogModularGameplayAbilities, Warning, TEXT("Ability %s failed to activate (tags: %s)"), *GetPathNameSafe(Ability), *FailureReason.ToString());
+	if (IsAbilityFailureThrottled(LastPresentedAbilityFailureTimes, Ability, FailureReason))
+	{
+		return;
+	}
+
+	MGA_LOG(Warning, TEXT("Ability %s failed to activate (tags: %s)"), *GetPathNameSafe(Ability), *FailureReason.ToString())
 
 	if (const UModularGameplayAbility* ModularAbility = Cast<const UModularGameplayAbility>(Ability))
 	{
@@ -986,7 +1612,7 @@ void UModularAbilitySystemComponent::AddAbilityToActivationGroup(EModularAbility
 		+ ActivationGroupCounts[StaticCast<uint8>(EModularAbilityActivationGroup::Exclusive_Blocking)];
 		!ensure(ExclusiveCount <= 1))
 	{
-		UE_LOG(LogModularGameplayAbilities, Error, TEXT("AddAbilityToActivationGroup: Multiple exclusive abilities are running."));
+		MGA_LOG(Error, TEXT("AddAbilityToActivationGroup: Multiple exclusive abilities are running."))
 	}
 }
 
@@ -1013,7 +1639,7 @@ void UModularAbilitySystemComponent::AddDynamicTagGameplayEffect(const FGameplay
 	const TSubclassOf<UGameplayEffect> DynamicTagGE = UModularAssetManager::GetSubclass(UModularAbilityData::Get().DynamicTagGameplayEffect);
 	if (!DynamicTagGE)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("AddDynamicTagGameplayEffect: Unable to find DynamicTagGameplayEffect [%s]."), *UModularAbilityData::Get().DynamicTagGameplayEffect.GetAssetName());
+		MGA_LOG(Warning, TEXT("AddDynamicTagGameplayEffect: Unable to find DynamicTagGameplayEffect [%s]."), *UModularAbilityData::Get().DynamicTagGameplayEffect.GetAssetName())
 		return;
 	}
 
@@ -1022,7 +1648,7 @@ void UModularAbilitySystemComponent::AddDynamicTagGameplayEffect(const FGameplay
 
 	if (!Spec)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("AddDynamicTagGameplayEffect: Unable to make outgoing spec for [%s]."), *GetNameSafe(DynamicTagGE));
+		MGA_LOG(Warning, TEXT("AddDynamicTagGameplayEffect: Unable to make outgoing spec for [%s]."), *GetNameSafe(DynamicTagGE))
 		return;
 	}
 
@@ -1036,7 +1662,7 @@ void UModularAbilitySystemComponent::RemoveDynamicTagGameplayEffect(const FGamep
 	const TSubclassOf<UGameplayEffect> DynamicTagGE = UModularAssetManager::GetSubclass(UModularAbilityData::Get().DynamicTagGameplayEffect);
 	if (!DynamicTagGE)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("RemoveDynamicTagGameplayEffect: Unable to find gameplay effect [%s]."), *UModularAbilityData::Get().DynamicTagGameplayEffect.GetAssetName());
+		MGA_LOG(Warning, TEXT("RemoveDynamicTagGameplayEffect: Unable to find gameplay effect [%s]."), *UModularAbilityData::Get().DynamicTagGameplayEffect.GetAssetName())
 		return;
 	}
 
@@ -1055,6 +1681,49 @@ void UModularAbilitySystemComponent::GetAbilityTargetData(const FGameplayAbility
 	}
 }
 
+void UModularAbilitySystemComponent::ServerSetReplicatedTargetData_Implementation(FGameplayAbilitySpecHandle AbilityHandle, FPredictionKey AbilityOriginalPredictionKey, const FGameplayAbilityTargetDataHandle& ReplicatedTargetDataHandle, FGameplayTag ApplicationTag, FPredictionKey CurrentPredictionKey)
+{
+	Super::ServerSetReplicatedTargetData_Implementation(AbilityHandle, AbilityOriginalPredictionKey, ReplicatedTargetDataHandle, ApplicationTag, CurrentPredictionKey);
+
+	const FGameplayAbilitySpecHandleAndPredictionKey Key(AbilityHandle, AbilityOriginalPredictionKey);
+	ReplicatedTargetDataKeys.RemoveAll([&Key](const FModularReplicatedTargetDataEntry& Entry) { return Entry.Key == Key; });
+
+	FModularReplicatedTargetDataEntry& Entry = ReplicatedTargetDataKeys.AddDefaulted_GetRef();
+	Entry.Key = Key;
+	Entry.ReceivedTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+
+	EvictReplicatedTargetData();
+}
+
+void UModularAbilitySystemComponent::EvictReplicatedTargetData()
+{
+	const double Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+	const int32 MaxEntries = FMath::Max(MaxReplicatedTargetData, 1);
+
+	/* Oldest first, entries past the count limit or the lifetime go unless their ability is still using them. */
+	int32 NumToEvict = ReplicatedTargetDataKeys.Num() - MaxEntries;
+	for (int32 Index = 0; Index < ReplicatedTargetDataKeys.Num();)
+	{
+		const FModularReplicatedTargetDataEntry& Entry = ReplicatedTargetDataKeys[Index];
+		const bool bEvict = NumToEvict > 0 || Now - Entry.ReceivedTime > ReplicatedTargetDataLifetime;
+		if (!bEvict)
+		{
+			break;
+		}
+
+		const FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandle(Entry.Key.AbilityHandle);
+		if (Spec && Spec->IsActive())
+		{
+			++Index;
+			continue;
+		}
+
+		AbilityTargetDataMap.Remove(Entry.Key);
+		ReplicatedTargetDataKeys.RemoveAt(Index, 1, EAllowShrinking::No);
+		--NumToEvict;
+	}
+}
+
 int32 UModularAbilitySystemComponent::GetActiveGameplayEffectLevel(FActiveGameplayEffectHandle ActiveHandle)
 {
 	const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect(ActiveHandle);
@@ -0,0 +1,67 @@
+// Copyright Halcyonyx Studios.
+
+#include "Attributes/MGAAttributeAccessor.h"
+
+#include "AbilitySystemComponent.h"
+#include "Attributes/MGAAttributeSlotTable.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+
+FMGAAttributeAccessor FMGAAttributeAccessor::Make(UAttributeSet* InAttributeSet, const FGameplayAttribute& InAttribute)
+{
+	FMGAAttributeAccessor Accessor;
+	if (!InAttributeSet || !InAttribute.IsValid())
+	{
+		return Accessor;
+	}
+
+	// Slot lookup also checks the attribute is a FGameplayAttributeData member of this set
+	const TSharedRef<const FMGAAttributeSlotTable> SlotTable = FMGAAttributeSlotTable::Get(InAttributeSet->GetClass());
+	const int32 SlotIndex = SlotTable->FindSlot(InAttribute);
+	if (SlotIndex == INDEX_NONE)
+	{
+		return Accessor;
+	}
+
+	Accessor.Attribute = InAttribute;
+	Accessor.AttributeSet = InAttributeSet;
+	Accessor.Offset = SlotTable->GetSlot(SlotIndex).Offset;
+	Accessor.WeakAttributeSet = InAttributeSet;
+	return Accessor;
+}
+
+FMGAAttributeAccessor FMGAAttributeAccessor::Make(const UAbilitySystemComponent* InAbilitySystemComponent, const FGameplayAttribute& InAttribute)
+{
+	if (!InAbilitySystemComponent || !InAttribute.IsValid())
+	{
+		return FMGAAttributeAccessor();
+	}
+
+	const UClass* AttributeSetClass = InAttribute.GetAttributeSetClass();
+	for (UAttributeSet* AttributeSet : InAbilitySystemComponent->GetSpawnedAttributes())
+	{
+		if (AttributeSet && AttributeSet->IsA(AttributeSetClass))
+		{
+			return Make(AttributeSet, InAttribute);
+		}
+	}
+
+	return FMGAAttributeAccessor();
+}
+
+void FMGAAttributeAccessor::SetBaseValue(const float NewValue) const
+{
+	if (!IsValid())
+	{
+		MGA_LOG(Warning, TEXT("FMGAAttributeAccessor::SetBaseValue - Unable to set value for %s because accessor is invalid"), *Attribute.GetName())
+		return;
+	}
+
+	UAbilitySystemComponent* ASC = AttributeSet->GetOwningAbilitySystemComponent();
+	if (!ASC)
+	{
+		MGA_LOG(Warning, TEXT("FMGAAttributeAccessor::SetBaseValue - Unable to set value for %s because ASC is invalid"), *Attribute.GetName())
+		return;
+	}
+
+	ASC->SetNumericAttributeBase(Attribute, NewValue);
+}
@@ -0,0 +1,341 @@
+// Copyright Halcyonyx Studios.
+
+#include "Attributes/MGAAttributeHandle.h"
+
+#include "Attributes/MGAAttributeSlotTable.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectIterator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MGAAttributeHandle)
+
+FMGAAttributeHandle FMGAAttributeHandle::FromAttribute(const FGameplayAttribute& InAttribute)
+{
+	return FromProperty(InAttribute.GetUProperty());
+}
+
+FMGAAttributeHandle FMGAAttributeHandle::FromProperty(const FProperty* InProperty)
+{
+	return FMGAAttributeRegistry::Get().FindOrAddHandle(InProperty);
+}
+
+FGameplayAttribute FMGAAttributeHandle::GetAttribute() const
+{
+	return FMGAAttributeRegistry::Get().GetAttribute(*this);
+}
+
+FString FMGAAttributeHandle::ToString() const
+{
+	if (!IsValid())
+	{
+		return TEXT("Invalid");
+	}
+
+	return FString::Printf(TEXT("%d:%d (%s)"), ClassIndex, SlotIndex, *GetAttribute().GetName());
+}
+
+FMGAAttributeRegistry::FReadScope::FReadScope(const FMGAAttributeRegistry& InRegistry)
+	: Registry(InRegistry)
+{
+	// Announce the read before loading the pointer, a writer seeing no reader after publishing knows nobody holds a retired snapshot
+	Registry.NumReaders.fetch_add(1);
+	Snapshot = Registry.CurrentSnapshot.load();
+}
+
+FMGAAttributeRegistry::FReadScope::~FReadScope()
+{
+	Registry.NumReaders.fetch_sub(1);
+}
+
+FMGAAttributeRegistry::FMGAAttributeRegistry()
+	: CurrentSnapshot(new FSnapshot())
+{
+}
+
+FMGAAttributeRegistry::~FMGAAttributeRegistry()
+{
+	delete CurrentSnapshot.load();
+
+	for (const FSnapshot* Snapshot : RetiredSnapshots)
+	{
+		delete Snapshot;
+	}
+}
+
+FMGAAttributeRegistry& FMGAAttributeRegistry::Get()
+{
+	static FMGAAttributeRegistry Registry;
+	return Registry;
+}
+
+void FMGAAttributeRegistry::RegisterNativeClasses()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		const UClass* Class = *It;
+		if (Class->IsNative() && Class->IsChildOf(UAttributeSet::StaticClass()) && !Class->HasAnyClassFlags(CLASS_NewerVersionExists))
+		{
+			FindOrRegisterClass_Locked(Class);
+		}
+	}
+
+	PublishSnapshot_Locked();
+
+	MGA_LOG(Verbose, TEXT("FMGAAttributeRegistry::RegisterNativeClasses - %d Attribute Set classes registered"), Classes.Num())
+}
+
+uint16 FMGAAttributeRegistry::FindOrRegisterClass(const UClass* InClass)
+{
+	if (!InClass)
+	{
+		return FMGAAttributeHandle::InvalidIndex;
+	}
+
+	{
+		const FReadScope Snapshot(*this);
+		if (const uint16* ClassIndex = Snapshot->ClassIndices.Find(InClass))
+		{
+			if (Snapshot->Classes[*ClassIndex].Class.Get() == InClass)
+			{
+				return *ClassIndex;
+			}
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	const uint16 ClassIndex = FindOrRegisterClass_Locked(InClass);
+	PublishSnapshot_Locked();
+	return ClassIndex;
+}
+
+FMGAAttributeHandle FMGAAttributeRegistry::FindOrAddHandle(const FProperty* InProperty)
+{
+	if (!InProperty)
+	{
+		return FMGAAttributeHandle();
+	}
+
+	{
+		const FReadScope Snapshot(*this);
+		if (const FMGAAttributeHandle* Handle = Snapshot->HandlesByProperty.Find(InProperty))
+		{
+			// The pointer is only a key, make sure it is not a new property allocated where a collected one was
+			if (Snapshot->Classes[Handle->GetClassIndex()].Class.Get() == InProperty->GetOwnerClass())
+			{
+				return *Handle;
+			}
+		}
+	}
+
+	if (!FGameplayAttribute::IsGameplayAttributeDataProperty(InProperty))
+	{
+		return FMGAAttributeHandle();
+	}
+
+	// First lookup of a property of a class not registered yet
+	const uint16 ClassIndex = FindOrRegisterClass(InProperty->GetOwnerClass());
+	if (ClassIndex == FMGAAttributeHandle::InvalidIndex)
+	{
+		return FMGAAttributeHandle();
+	}
+
+	const FReadScope Snapshot(*this);
+	const int32 SlotIndex = Snapshot->Classes.IsValidIndex(ClassIndex) ? Snapshot->Classes[ClassIndex].SlotTable->FindSlot(InProperty) : INDEX_NONE;
+	if (SlotIndex == INDEX_NONE)
+	{
+		return FMGAAttributeHandle();
+	}
+
+	return FMGAAttributeHandle(ClassIndex, static_cast<uint16>(SlotIndex));
+}
+
+FMGAAttributeHandle FMGAAttributeRegistry::FindHandleByPath(const FName InPropertyPath)
+{
+	if (InPropertyPath.IsNone())
+	{
+		return FMGAAttributeHandle();
+	}
+
+	{
+		const FReadScope Snapshot(*this);
+		if (const FMGAAttributeHandle* Handle = Snapshot->HandlesByPath.Find(InPropertyPath))
+		{
+			return *Handle;
+		}
+	}
+
+	// Only hit once per path (and again after a new class is registered for unresolved ones)
+	const FProperty* Property = FindFProperty<FProperty>(*InPropertyPath.ToString());
+	const FMGAAttributeHandle Handle = FindOrAddHandle(Property);
+
+	FScopeLock ScopeLock(&Lock);
+	HandlesByPath.Add(InPropertyPath, Handle);
+	PublishSnapshot_Locked();
+	return Handle;
+}
+
+FGameplayAttribute FMGAAttributeRegistry::GetAttribute(const FMGAAttributeHandle& InHandle) const
+{
+	if (!InHandle.IsValid())
+	{
+		return FGameplayAttribute();
+	}
+
+	const FReadScope Snapshot(*this);
+	if (!Snapshot->Classes.IsValidIndex(InHandle.GetClassIndex()))
+	{
+		return FGameplayAttribute();
+	}
+
+	const FClassEntry& Entry = Snapshot->Classes[InHandle.GetClassIndex()];
+	if (!Entry.Class.IsValid() || !Entry.SlotTable->IsValidSlot(InHandle.GetSlotIndex()))
+	{
+		return FGameplayAttribute();
+	}
+
+	return Entry.SlotTable->GetSlot(InHandle.GetSlotIndex()).Attribute;
+}
+
+const UClass* FMGAAttributeRegistry::GetClass(const uint16 InClassIndex) const
+{
+	const FReadScope Snapshot(*this);
+	return Snapshot->Classes.IsValidIndex(InClassIndex) ? Snapshot->Classes[InClassIndex].Class.Get() : nullptr;
+}
+
+int32 FMGAAttributeRegistry::NumClasses() const
+{
+	const FReadScope Snapshot(*this);
+	return Snapshot->Classes.Num();
+}
+
+void FMGAAttributeRegistry::HandleAttributeSetLayoutChanged(const UClass* InClass)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TBitArray<> RefreshedClasses(false, Classes.Num());
+	for (int32 ClassIndex = 0; ClassIndex < Classes.Num(); ++ClassIndex)
+	{
+		FClassEntry& Entry = Classes[ClassIndex];
+		const UClass* Class = Entry.Class.Get();
+		if (Class && (!InClass || Class->IsChildOf(InClass)))
+		{
+			Entry.SlotTable = FMGAAttributeSlotTable::Get(Class);
+			RefreshedClasses[ClassIndex] = true;
+		}
+	}
+
+	// Properties of a recompiled class are regenerated, paths must resolve to the new ones
+	for (auto It = HandlesByPath.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid() || RefreshedClasses[It->Value.GetClassIndex()])
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	PublishSnapshot_Locked();
+}
+
+uint16 FMGAAttributeRegistry::FindOrRegisterClass_Locked(const UClass* InClass)
+{
+	if (!InClass->IsChildOf(UAttributeSet::StaticClass()))
+	{
+		return FMGAAttributeHandle::InvalidIndex;
+	}
+
+	// Only the writer replaces the current snapshot, no need for a read scope under the lock
+	if (const uint16* ClassIndex = CurrentSnapshot.load()->ClassIndices.Find(InClass))
+	{
+		if (Classes[*ClassIndex].Class.Get() == InClass)
+		{
+			return *ClassIndex;
+		}
+	}
+
+	// A regenerated Blueprint class (or a new class at the address of a garbage collected one) keeps the index of the
+	// class sharing its path, so that handles created before recompilation still point to the same attributes
+	const FName ClassPath = FName(*InClass->GetPathName());
+	uint16 ClassIndex;
+	if (const uint16* ExistingIndex = ClassIndicesByPath.Find(ClassPath))
+	{
+		// Registered since the snapshot was published (eg. by RegisterNativeClasses())
+		ClassIndex = *ExistingIndex;
+		if (Classes[ClassIndex].Class.Get() == InClass)
+		{
+			return ClassIndex;
+		}
+	}
+	else
+	{
+		if (!ensureMsgf(Classes.Num() < FMGAAttributeHandle::InvalidIndex, TEXT("FMGAAttributeRegistry - Too many Attribute Set classes registered")))
+		{
+			return FMGAAttributeHandle::InvalidIndex;
+		}
+
+		ClassIndex = static_cast<uint16>(Classes.AddDefaulted());
+		ClassIndicesByPath.Add(ClassPath, ClassIndex);
+	}
+
+	FClassEntry& Entry = Classes[ClassIndex];
+	Entry.Class = InClass;
+	Entry.ClassPath = ClassPath;
+	Entry.SlotTable = FMGAAttributeSlotTable::Get(InClass);
+
+	// Paths that failed to resolve may now point to this class, and a regenerated class may have a different layout
+	for (auto It = HandlesByPath.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid() || It->Value.GetClassIndex() == ClassIndex)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return ClassIndex;
+}
+
+void FMGAAttributeRegistry::PublishSnapshot_Locked()
+{
+	FSnapshot* Snapshot = new FSnapshot();
+	Snapshot->Classes = Classes;
+	Snapshot->HandlesByPath = HandlesByPath;
+
+	for (int32 ClassIndex = 0; ClassIndex < Classes.Num(); ++ClassIndex)
+	{
+		const FClassEntry& Entry = Classes[ClassIndex];
+		const UClass* Class = Entry.Class.Get();
+		if (!Class)
+		{
+			continue;
+		}
+
+		Snapshot->ClassIndices.Add(Class, static_cast<uint16>(ClassIndex));
+
+		// Inherited slots are handed out with the index of the class declaring them
+		for (int32 SlotIndex = 0; SlotIndex < Entry.SlotTable->Num(); ++SlotIndex)
+		{
+			const FStructProperty* Property = Entry.SlotTable->GetSlot(SlotIndex).Property;
+			if (Property->GetOwnerClass() == Class)
+			{
+				Snapshot->HandlesByProperty.Add(Property, FMGAAttributeHandle(static_cast<uint16>(ClassIndex), static_cast<uint16>(SlotIndex)));
+			}
+		}
+	}
+
+	if (const FSnapshot* PreviousSnapshot = CurrentSnapshot.exchange(Snapshot))
+	{
+		RetiredSnapshots.Add(PreviousSnapshot);
+	}
+
+	// Readers arriving from now on load the new snapshot, so retired ones are unreachable once no reader is active
+	if (NumReaders.load() == 0)
+	{
+		for (const FSnapshot* RetiredSnapshot : RetiredSnapshots)
+		{
+			delete RetiredSnapshot;
+		}
+
+		RetiredSnapshots.Reset();
+	}
+}
@@ -2,6 +2,8 @@
 
 #include "Attributes/MGAAttributeSetBlueprint.h"
 
+#include "AttributeSet.h"
+#include "Attributes/ModularAttributeSetBase.h"
 #include "MGADelegates.h"
 #include "ModularGameplayAbilitiesLogChannels.h"
 #include "Misc/EngineVersionComparison.h"
@@ -9,6 +11,14 @@
 
 #if WITH_EDITOR
 #include "RigVMDeveloperTypeUtils.h"
+#if UE_VERSION_NEWER_THAN(5, 4, -1)
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
+
+const FName UMGAAttributeSetBlueprint::AttributesTagName = TEXT("MGAAttributes");
+const FName UMGAAttributeSetBlueprint::NumAttributesTagName = TEXT("MGANumAttributes");
+const FName UMGAAttributeSetBlueprint::PackedReplicationTagName = TEXT("MGAPackedReplication");
+const FName UMGAAttributeSetBlueprint::ReplicationValidationHashTagName = TEXT("MGAReplicationValidationHash");
 #endif
 
 UMGAAttributeSetBlueprint::~UMGAAttributeSetBlueprint()
@@ -31,6 +41,162 @@ void UMGAAttributeSetBlueprint::PostLoad()
 
 #if WITH_EDITOR
 
+#if UE_VERSION_NEWER_THAN(5, 4, -1)
+void UMGAAttributeSetBlueprint::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+
+	TArray<FAssetRegistryTag> Tags;
+	GetAttributeSetAssetRegistryTags(Tags);
+	for (FAssetRegistryTag& Tag : Tags)
+	{
+		Context.AddTag(MoveTemp(Tag));
+	}
+}
+#else
+void UMGAAttributeSetBlueprint::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+
+	GetAttributeSetAssetRegistryTags(OutTags);
+}
+#endif
+
+void UMGAAttributeSetBlueprint::GetAttributeSetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	TArray<FMGAAttributeSetBlueprintTagEntry> Attributes;
+	GetDeclaredAttributes(Attributes);
+	OutTags.Add(FAssetRegistryTag(AttributesTagName, MakeAttributesTag(Attributes), FAssetRegistryTag::TT_Hidden));
+	OutTags.Add(FAssetRegistryTag(NumAttributesTagName, LexToString(Attributes.Num()), FAssetRegistryTag::TT_Numerical));
+
+	const UModularAttributeSetBase* DefaultObject = GeneratedClass ? Cast<UModularAttributeSetBase>(GeneratedClass->GetDefaultObject(false)) : nullptr;
+	OutTags.Add(FAssetRegistryTag(PackedReplicationTagName, DefaultObject && DefaultObject->bUsePackedReplication ? TEXT("True") : TEXT("False"), FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(FAssetRegistryTag(ReplicationValidationHashTagName, LexToString(UModularAttributeSetBase::GetReplicationValidationHash(this)), FAssetRegistryTag::TT_Hidden));
+}
+
+void UMGAAttributeSetBlueprint::GetDeclaredAttributes(TArray<FMGAAttributeSetBlueprintTagEntry>& OutAttributes) const
+{
+	// Clamp definitions are default values, only known once compiled
+	const UObject* DefaultObject = GeneratedClass ? GeneratedClass->GetDefaultObject(false) : nullptr;
+
+	for (const FBPVariableDescription& Variable : NewVariables)
+	{
+		const UScriptStruct* Struct = Cast<UScriptStruct>(Variable.VarType.PinSubCategoryObject.Get());
+		if (!Struct || !Struct->IsChildOf(FGameplayAttributeData::StaticStruct()) || Variable.VarType.IsContainer())
+		{
+			continue;
+		}
+
+		FMGAAttributeSetBlueprintTagEntry& Entry = OutAttributes.AddDefaulted_GetRef();
+		Entry.Name = Variable.VarName;
+		Entry.Category = Variable.Category.ToString();
+		for (const FBPVariableMetaDataEntry& MetaData : Variable.MetaDataArray)
+		{
+			Entry.MetaDataKeys.Add(MetaData.DataKey);
+		}
+
+		Entry.Type = Struct->GetFName();
+		Entry.bReplicated = (Variable.PropertyFlags & CPF_Net) != 0;
+		Entry.ReplicationCondition = Entry.bReplicated ? static_cast<uint8>(Variable.ReplicationCondition.GetValue()) : 0;
+		Entry.RepNotifyFunc = Variable.RepNotifyFunc;
+
+		const FStructProperty* Property = DefaultObject ? FindFProperty<FStructProperty>(DefaultObject->GetClass(), Variable.VarName) : nullptr;
+		if (Property && Property->Struct && Property->Struct->IsChildOf(FMGAClampedAttributeData::StaticStruct()))
+		{
+			const FMGAClampedAttributeData* ClampedData = Property->ContainerPtrToValuePtr<FMGAClampedAttributeData>(DefaultObject);
+			Entry.bClamped = ClampedData->MinValue.ClampType != EMGAAttributeClampingType::None || ClampedData->MaxValue.ClampType != EMGAAttributeClampingType::None;
+		}
+	}
+}
+
+FString UMGAAttributeSetBlueprint::MakeAttributesTag(const TArray<FMGAAttributeSetBlueprintTagEntry>& InAttributes)
+{
+	// One attribute per line, tab separated fields. Neither can be part of variable names, categories or metadata keys.
+	// Fields: Name, Category, MetaDataKeys, Type, Flags, ReplicationCondition, RepNotifyFunc. New fields go at the end.
+	TStringBuilder<1024> Builder;
+	for (const FMGAAttributeSetBlueprintTagEntry& Entry : InAttributes)
+	{
+		if (Builder.Len() > 0)
+		{
+			Builder << TEXT('\n');
+		}
+
+		Builder << Entry.Name << TEXT('\t') << Entry.Category << TEXT('\t');
+		for (int32 Index = 0; Index < Entry.MetaDataKeys.Num(); ++Index)
+		{
+			Builder << (Index > 0 ? TEXT(",") : TEXT("")) << Entry.MetaDataKeys[Index];
+		}
+
+		Builder << TEXT('\t') << Entry.Type << TEXT('\t');
+		Builder << (Entry.bReplicated ? TEXT("Replicated") : TEXT(""));
+		Builder << (Entry.bReplicated && Entry.bClamped ? TEXT(",") : TEXT(""));
+		Builder << (Entry.bClamped ? TEXT("Clamped") : TEXT(""));
+		Builder << TEXT('\t') << static_cast<int32>(Entry.ReplicationCondition) << TEXT('\t');
+		if (!Entry.RepNotifyFunc.IsNone())
+		{
+			Builder << Entry.RepNotifyFunc;
+		}
+	}
+
+	return Builder.ToString();
+}
+
+void UMGAAttributeSetBlueprint::ParseAttributesTag(const FString& InTagValue, TArray<FMGAAttributeSetBlueprintTagEntry>& OutAttributes)
+{
+	TArray<FString> Lines;
+	InTagValue.ParseIntoArray(Lines, TEXT("\n"));
+
+	for (const FString& Line : Lines)
+	{
+		TArray<FString> Fields;
+		Line.ParseIntoArray(Fields, TEXT("\t"), false);
+		if (Fields.IsEmpty() || Fields[0].IsEmpty())
+		{
+			continue;
+		}
+
+		FMGAAttributeSetBlueprintTagEntry& Entry = OutAttributes.AddDefaulted_GetRef();
+		Entry.Name = *Fields[0];
+		Entry.Category = Fields.IsValidIndex(1) ? Fields[1] : FString();
+
+		if (Fields.IsValidIndex(2))
+		{
+			TArray<FString> MetaDataKeys;
+			Fields[2].ParseIntoArray(MetaDataKeys, TEXT(","));
+			for (const FString& MetaDataKey : MetaDataKeys)
+			{
+				Entry.MetaDataKeys.Add(*MetaDataKey);
+			}
+		}
+
+		// Tags written before these fields existed leave them to their defaults
+		if (Fields.IsValidIndex(3) && !Fields[3].IsEmpty())
+		{
+			Entry.Type = *Fields[3];
+		}
+
+		if (Fields.IsValidIndex(4))
+		{
+			TArray<FString> Flags;
+			Fields[4].ParseIntoArray(Flags, TEXT(","));
+			Entry.bReplicated = Flags.Contains(TEXT("Replicated"));
+			Entry.bClamped = Flags.Contains(TEXT("Clamped"));
+		}
+
+		if (Fields.IsValidIndex(5))
+		{
+			int32 ReplicationCondition = 0;
+			LexFromString(ReplicationCondition, *Fields[5]);
+			Entry.ReplicationCondition = static_cast<uint8>(ReplicationCondition);
+		}
+
+		if (Fields.IsValidIndex(6) && !Fields[6].IsEmpty())
+		{
+			Entry.RepNotifyFunc = *Fields[6];
+		}
+	}
+}
+
 void UMGAAttributeSetBlueprint::RegisterDelegates()
 {
 	if (IsTemplate())
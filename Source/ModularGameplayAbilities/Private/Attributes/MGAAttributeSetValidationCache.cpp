@@ -0,0 +1,172 @@
+// Copyright Halcyonyx Studios.
+
+#include "Attributes/MGAAttributeSetValidationCache.h"
+
+#if WITH_EDITOR
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MGA::AttributeSetValidationCache
+{
+	/** Bump whenever the layout of the cache file changes */
+	static constexpr int32 CacheVersion = 3;
+
+	/**
+	 * Bump whenever UModularAttributeSetBase::IsDataValidReplication() rules change, so that results computed by a previous
+	 * version of the plugin are discarded (Blueprints are unchanged, keys alone wouldn't tell).
+	 */
+	static constexpr int32 RulesVersion = 1;
+}
+
+FMGAAttributeSetValidationCache& FMGAAttributeSetValidationCache::Get()
+{
+	static FMGAAttributeSetValidationCache Instance;
+	return Instance;
+}
+
+FMGAAttributeSetValidationCache::FMGAAttributeSetValidationCache()
+{
+	Load();
+}
+
+bool FMGAAttributeSetValidationCache::Find(const FName& InPackageName, const FBlake3Hash& InKey, FMGAAttributeSetValidationEntry& OutEntry) const
+{
+	if (InKey.IsZero())
+	{
+		return false;
+	}
+
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+
+	const FMGAAttributeSetValidationEntry* Entry = Entries.Find(InPackageName);
+	if (!Entry || Entry->Key != InKey)
+	{
+		return false;
+	}
+
+	OutEntry = *Entry;
+	return true;
+}
+
+void FMGAAttributeSetValidationCache::Add(const FName& InPackageName, FMGAAttributeSetValidationEntry&& InEntry)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	Entries.Add(InPackageName, MoveTemp(InEntry));
+	bDirty = true;
+}
+
+void FMGAAttributeSetValidationCache::Reset()
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	bDirty |= !Entries.IsEmpty();
+	Entries.Reset();
+}
+
+FBlake3Hash FMGAAttributeSetValidationCache::MakeKey(const TConstArrayView<FBlake3Hash> InBlueprintHashes)
+{
+	FBlake3 Hasher;
+
+	const int32 RulesVersion = MGA::AttributeSetValidationCache::RulesVersion;
+	Hasher.Update(&RulesVersion, sizeof(RulesVersion));
+
+	for (const FBlake3Hash& BlueprintHash : InBlueprintHashes)
+	{
+		// Zero is reserved for "not cacheable"
+		if (BlueprintHash.IsZero())
+		{
+			return FBlake3Hash();
+		}
+
+		Hasher.Update(BlueprintHash.GetBytes(), sizeof(FBlake3Hash::ByteArray));
+	}
+
+	return Hasher.Finalize();
+}
+
+FString FMGAAttributeSetValidationCache::GetCacheFilePath()
+{
+	return FPaths::ProjectIntermediateDir() / TEXT("ModularGameplayAbilities") / TEXT("AttributeSetValidationCache.bin");
+}
+
+void FMGAAttributeSetValidationCache::Load()
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetCacheFilePath(), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	int32 Version = 0;
+	int32 RulesVersion = 0;
+	Reader << Version;
+	Reader << RulesVersion;
+	if (Version != MGA::AttributeSetValidationCache::CacheVersion || RulesVersion != MGA::AttributeSetValidationCache::RulesVersion)
+	{
+		return;
+	}
+
+	int32 NumEntries = 0;
+	Reader << NumEntries;
+	for (int32 Index = 0; Index < NumEntries && !Reader.IsError(); ++Index)
+	{
+		FName PackageName;
+		FMGAAttributeSetValidationEntry Entry;
+		uint8 Result = 0;
+		Reader << PackageName;
+		Reader << Entry.Key;
+		Reader << Result;
+		Reader << Entry.Errors;
+
+		if (!Reader.IsError())
+		{
+			Entry.Result = static_cast<EDataValidationResult>(Result);
+			Entries.Add(PackageName, MoveTemp(Entry));
+		}
+	}
+
+	MGA_NS_LOG(Verbose, TEXT("Loaded %d cached Attribute Set validation results"), Entries.Num())
+}
+
+void FMGAAttributeSetValidationCache::Save()
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	if (!bDirty)
+	{
+		return;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	int32 Version = MGA::AttributeSetValidationCache::CacheVersion;
+	int32 RulesVersion = MGA::AttributeSetValidationCache::RulesVersion;
+	Writer << Version;
+	Writer << RulesVersion;
+
+	int32 NumEntries = Entries.Num();
+	Writer << NumEntries;
+	for (TPair<FName, FMGAAttributeSetValidationEntry>& Pair : Entries)
+	{
+		FName PackageName = Pair.Key;
+		uint8 Result = static_cast<uint8>(Pair.Value.Result);
+		Writer << PackageName;
+		Writer << Pair.Value.Key;
+		Writer << Result;
+		Writer << Pair.Value.Errors;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *GetCacheFilePath()))
+	{
+		MGA_NS_LOG(Warning, TEXT("Failed to write %s"), *GetCacheFilePath())
+		return;
+	}
+
+	bDirty = false;
+}
+#endif
@@ -0,0 +1,167 @@
+// Copyright Halcyonyx Studios.
+
+#include "Attributes/MGAAttributeSlotTable.h"
+
+#include "MGADelegates.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UnrealType.h"
+
+namespace MGA::SlotTable
+{
+	static FCriticalSection CacheCriticalSection;
+	static TMap<const UClass*, TSharedRef<FMGAAttributeSlotTable>> Cache;
+}
+
+FMGAAttributeDataKey FMGAAttributeDataKey::FromProperty(const FProperty* InProperty)
+{
+	if (!InProperty || !FGameplayAttribute::IsGameplayAttributeDataProperty(InProperty))
+	{
+		return FMGAAttributeDataKey();
+	}
+
+	return FMGAAttributeDataKey(InProperty->GetOwnerClass(), InProperty->GetOffset_ForInternal());
+}
+
+FMGAAttributeDataKey FMGAAttributeDataKey::FromAttributeData(const UAttributeSet* InOwnerSet, const FGameplayAttributeData& InAttributeData)
+{
+	if (!InOwnerSet)
+	{
+		return FMGAAttributeDataKey();
+	}
+
+	const TSharedRef<const FMGAAttributeSlotTable> SlotTable = FMGAAttributeSlotTable::Get(InOwnerSet->GetClass());
+	const int32 SlotIndex = SlotTable->FindSlot(InOwnerSet, InAttributeData);
+	return SlotTable->IsValidSlot(SlotIndex) ? SlotTable->GetSlot(SlotIndex).Key : FMGAAttributeDataKey();
+}
+
+TSharedRef<const FMGAAttributeSlotTable> FMGAAttributeSlotTable::Get(const UClass* InClass)
+{
+	check(InClass);
+
+	FScopeLock Lock(&MGA::SlotTable::CacheCriticalSection);
+
+	if (const TSharedRef<FMGAAttributeSlotTable>* CachedSlotTable = MGA::SlotTable::Cache.Find(InClass))
+	{
+		if ((*CachedSlotTable)->Class.Get() == InClass)
+		{
+			return *CachedSlotTable;
+		}
+
+		// Built for a class that was garbage collected, and InClass now lives at the same address
+		(*CachedSlotTable)->bStale = true;
+	}
+
+	// Never rebuilt in place, users may still be reading the previous table
+	const TSharedRef<FMGAAttributeSlotTable> SlotTable = MakeShared<FMGAAttributeSlotTable>();
+	SlotTable->Build(InClass);
+	MGA::SlotTable::Cache.Add(InClass, SlotTable);
+	return SlotTable;
+}
+
+void FMGAAttributeSlotTable::Invalidate(const UClass* InClass)
+{
+	{
+		FScopeLock Lock(&MGA::SlotTable::CacheCriticalSection);
+
+		for (auto It = MGA::SlotTable::Cache.CreateIterator(); It; ++It)
+		{
+			const UClass* Class = It->Value->Class.Get();
+			if (!InClass || !Class || Class->IsChildOf(InClass))
+			{
+				It->Value->bStale = true;
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	MGA_LOG(Verbose, TEXT("FMGAAttributeSlotTable::Invalidate - %s"), InClass ? *InClass->GetName() : TEXT("All classes"))
+	FMGADelegates::OnAttributeSetLayoutChanged.Broadcast(InClass);
+}
+
+#if WITH_EDITOR
+void FMGAAttributeSlotTable::InvalidateReinstancedClasses(const TMap<UObject*, UObject*>& InReplacedObjects)
+{
+	// Reinstancing a recompiled Blueprint class replaces its default object, and those of its child classes
+	TSet<const UClass*> ReinstancedClasses;
+	for (const TPair<UObject*, UObject*>& Pair : InReplacedObjects)
+	{
+		if (const UAttributeSet* AttributeSet = Cast<UAttributeSet>(Pair.Value))
+		{
+			ReinstancedClasses.Add(AttributeSet->GetClass());
+		}
+	}
+
+	for (const UClass* Class : ReinstancedClasses)
+	{
+		Invalidate(Class);
+	}
+}
+#endif
+
+int32 FMGAAttributeSlotTable::FindSlot(const FProperty* InProperty) const
+{
+	if (!InProperty)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 SlotIndex = FindSlotByOffset(InProperty->GetOffset_ForInternal());
+	if (SlotIndex == INDEX_NONE || Slots[SlotIndex].Property != InProperty)
+	{
+		return INDEX_NONE;
+	}
+
+	return SlotIndex;
+}
+
+void FMGAAttributeSlotTable::Build(const UClass* InClass)
+{
+	Class = InClass;
+	Slots.Reset();
+	ReplicatedSlots.Reset();
+	SlotByOffset.Reset();
+	SlotsByName.Reset();
+
+	for (TFieldIterator<FProperty> It(InClass, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (!FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+		{
+			continue;
+		}
+
+		FMGAAttributeSlot& Slot = Slots.AddDefaulted_GetRef();
+		Slot.Property = CastFieldChecked<const FStructProperty>(Property);
+		Slot.Attribute = FGameplayAttribute(const_cast<FProperty*>(Property));
+		Slot.Offset = Property->GetOffset_ForInternal();
+		Slot.Key = FMGAAttributeDataKey(Property->GetOwnerClass(), Slot.Offset);
+		Slot.bReplicated = Property->HasAnyPropertyFlags(CPF_Net);
+	}
+
+	// Slot order follows memory layout, which is stable for a given class layout regardless of iteration order
+	Slots.Sort([](const FMGAAttributeSlot& A, const FMGAAttributeSlot& B)
+	{
+		return A.Offset < B.Offset;
+	});
+
+	checkf(Slots.Num() < MAX_int16, TEXT("FMGAAttributeSlotTable - Too many attributes in %s (%d)"), *GetNameSafe(InClass), Slots.Num());
+
+	const int32 MaxOffset = Slots.Num() > 0 ? Slots.Last().Offset : 0;
+	SlotByOffset.Init(INDEX_NONE, MaxOffset / OffsetGranularity + 1);
+
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		const FMGAAttributeSlot& Slot = Slots[SlotIndex];
+		ensureMsgf(Slot.Offset % OffsetGranularity == 0, TEXT("Unexpected alignment for attribute %s"), *Slot.Attribute.GetName());
+		SlotByOffset[Slot.Offset / OffsetGranularity] = static_cast<int16>(SlotIndex);
+		SlotsByName.Add(Slot.Property->GetFName(), SlotIndex);
+
+		if (Slot.bReplicated)
+		{
+			ReplicatedSlots.Add(SlotIndex);
+		}
+	}
+
+	MGA_LOG(Verbose, TEXT("FMGAAttributeSlotTable::Build - %s: %d slots (%d replicated)"), *GetNameSafe(InClass), Slots.Num(), ReplicatedSlots.Num())
+}
@@ -0,0 +1,263 @@
+// Copyright Halcyonyx Studios.
+
+#include "Attributes/MGAClampDependencyGraph.h"
+
+#include "Attributes/MGAAttributeSlotTable.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "Misc/ScopeLock.h"
+
+const TArray<int32> FMGAClampDependencyGraph::EmptyDependents;
+
+namespace MGA::ClampDependencyGraph
+{
+	static FCriticalSection CacheCriticalSection;
+	static TMap<const UClass*, TSharedRef<FMGAClampDependencyGraph>> Cache;
+
+	static void ResolveBound(const FMGAAttributeSlotTable& InSlotTable, const FMGAAttributeClampDefinition& InDefinition, const FMGAAttributeSlot& InClampedSlot, FMGAClampBound& OutBound)
+	{
+		OutBound.ClampType = InDefinition.ClampType;
+		OutBound.Value = InDefinition.Value;
+		OutBound.bAdjustProportionally = InDefinition.bAdjustProportionally;
+
+		if (InDefinition.ClampType != EMGAAttributeClampingType::AttributeBased)
+		{
+			return;
+		}
+
+		// Bounding attribute must be part of the same set (same check as FMGAAttributeClampDefinition::GetValueForClamping)
+		const int32 BoundSlot = InSlotTable.FindSlot(InDefinition.Attribute);
+		if (BoundSlot == INDEX_NONE)
+		{
+			if (InDefinition.Attribute.IsValid())
+			{
+				MGA_LOG(
+					Warning,
+					TEXT("FMGAClampDependencyGraph - Clamping of %s based on %s is disabled because it's not a member of %s"),
+					*InClampedSlot.Attribute.GetName(),
+					*InDefinition.Attribute.GetName(),
+					*GetNameSafe(InSlotTable.GetClass())
+				)
+			}
+
+			OutBound.ClampType = EMGAAttributeClampingType::None;
+			return;
+		}
+
+		OutBound.BoundSlot = BoundSlot;
+		OutBound.BoundOffset = InSlotTable.GetSlot(BoundSlot).Offset;
+	}
+}
+
+bool FMGAClampNode::Clamp(const UAttributeSet* InOwnerSet, float& InOutValue, const bool bInBaseValue) const
+{
+	float MinValue;
+	const bool bIsMinValid = Min.GetValue(InOwnerSet, MinValue, bInBaseValue);
+
+	float MaxValue;
+	const bool bIsMaxValid = Max.GetValue(InOwnerSet, MaxValue, bInBaseValue);
+
+	if (bIsMinValid && bIsMaxValid)
+	{
+		InOutValue = FMath::Clamp(InOutValue, MinValue, MaxValue);
+	}
+	else if (bIsMinValid)
+	{
+		InOutValue = FMath::Max(InOutValue, MinValue);
+	}
+	else if (bIsMaxValid)
+	{
+		InOutValue = FMath::Min(InOutValue, MaxValue);
+	}
+
+	return bIsMinValid || bIsMaxValid;
+}
+
+TSharedRef<const FMGAClampDependencyGraph> FMGAClampDependencyGraph::Get(const UClass* InClass)
+{
+	check(InClass);
+
+	FScopeLock Lock(&MGA::ClampDependencyGraph::CacheCriticalSection);
+
+	// See FMGAAttributeSlotTable::Get()
+	if (const TSharedRef<FMGAClampDependencyGraph>* CachedGraph = MGA::ClampDependencyGraph::Cache.Find(InClass))
+	{
+		if ((*CachedGraph)->Class.Get() == InClass)
+		{
+			return *CachedGraph;
+		}
+
+		(*CachedGraph)->bStale = true;
+	}
+
+	const TSharedRef<FMGAClampDependencyGraph> Graph = MakeShared<FMGAClampDependencyGraph>();
+	Graph->Build(InClass);
+	MGA::ClampDependencyGraph::Cache.Add(InClass, Graph);
+	return Graph;
+}
+
+void FMGAClampDependencyGraph::Invalidate(const UClass* InClass)
+{
+	FScopeLock Lock(&MGA::ClampDependencyGraph::CacheCriticalSection);
+
+	for (auto It = MGA::ClampDependencyGraph::Cache.CreateIterator(); It; ++It)
+	{
+		const UClass* Class = It->Value->Class.Get();
+		if (!InClass || !Class || Class->IsChildOf(InClass))
+		{
+			It->Value->bStale = true;
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FMGAClampDependencyGraph::Build(const UClass* InClass)
+{
+	Class = InClass;
+	Nodes.Reset();
+	NodeBySlot.Reset();
+	DependentsBySlot.Reset();
+	bHasDependencies = false;
+
+	const TSharedRef<const FMGAAttributeSlotTable> SlotTableRef = FMGAAttributeSlotTable::Get(InClass);
+	const FMGAAttributeSlotTable& SlotTable = *SlotTableRef;
+	const UAttributeSet* DefaultObject = CastChecked<UAttributeSet>(InClass->GetDefaultObject());
+
+	// Gather clamped attributes with their bounds resolved to slots
+	TArray<FMGAClampNode> UnorderedNodes;
+	for (int32 SlotIndex = 0; SlotIndex < SlotTable.Num(); ++SlotIndex)
+	{
+		const FMGAAttributeSlot& Slot = SlotTable.GetSlot(SlotIndex);
+		if (!Slot.Property->Struct || !Slot.Property->Struct->IsChildOf(FMGAClampedAttributeData::StaticStruct()))
+		{
+			continue;
+		}
+
+		const FMGAClampedAttributeData* ClampedData = static_cast<const FMGAClampedAttributeData*>(Slot.GetData(DefaultObject));
+
+		FMGAClampNode& Node = UnorderedNodes.AddDefaulted_GetRef();
+		Node.Slot = SlotIndex;
+		MGA::ClampDependencyGraph::ResolveBound(SlotTable, ClampedData->MinValue, Slot, Node.Min);
+		MGA::ClampDependencyGraph::ResolveBound(SlotTable, ClampedData->MaxValue, Slot, Node.Max);
+	}
+
+	NodeBySlot.Init(INDEX_NONE, SlotTable.Num());
+	for (int32 Index = 0; Index < UnorderedNodes.Num(); ++Index)
+	{
+		NodeBySlot[UnorderedNodes[Index].Slot] = Index;
+	}
+
+	// Topological sort (Kahn), edges go from a bounding attribute to the attribute it clamps
+	TArray<int32> InDegrees;
+	InDegrees.Init(0, UnorderedNodes.Num());
+	TArray<TArray<int32>> Edges;
+	Edges.SetNum(UnorderedNodes.Num());
+
+	for (int32 Index = 0; Index < UnorderedNodes.Num(); ++Index)
+	{
+		const FMGAClampNode& Node = UnorderedNodes[Index];
+		for (const FMGAClampBound* Bound : { &Node.Min, &Node.Max })
+		{
+			if (!Bound->IsAttributeBased())
+			{
+				continue;
+			}
+
+			bHasDependencies = true;
+
+			const int32 BoundNode = NodeBySlot[Bound->BoundSlot];
+			if (BoundNode != INDEX_NONE && !Edges[BoundNode].Contains(Index))
+			{
+				Edges[BoundNode].Add(Index);
+				InDegrees[Index]++;
+			}
+		}
+	}
+
+	TArray<int32> Order;
+	Order.Reserve(UnorderedNodes.Num());
+	for (int32 Index = 0; Index < UnorderedNodes.Num(); ++Index)
+	{
+		if (InDegrees[Index] == 0)
+		{
+			Order.Add(Index);
+		}
+	}
+
+	for (int32 OrderIndex = 0; OrderIndex < Order.Num(); ++OrderIndex)
+	{
+		for (const int32 Dependent : Edges[Order[OrderIndex]])
+		{
+			if (--InDegrees[Dependent] == 0)
+			{
+				Order.Add(Dependent);
+			}
+		}
+	}
+
+	if (Order.Num() != UnorderedNodes.Num())
+	{
+		MGA_LOG(Warning, TEXT("FMGAClampDependencyGraph - Cyclic clamp bounds detected in %s, re-clamping order for those attributes is undefined"), *GetNameSafe(InClass))
+		for (int32 Index = 0; Index < UnorderedNodes.Num(); ++Index)
+		{
+			if (InDegrees[Index] > 0)
+			{
+				Order.Add(Index);
+			}
+		}
+	}
+
+	Nodes.Reserve(Order.Num());
+	for (const int32 Index : Order)
+	{
+		NodeBySlot[UnorderedNodes[Index].Slot] = Nodes.Num();
+		Nodes.Add(UnorderedNodes[Index]);
+	}
+
+	if (!bHasDependencies)
+	{
+		return;
+	}
+
+	// Direct dependents, as node indices
+	TArray<TArray<int32>> DirectDependents;
+	DirectDependents.SetNum(SlotTable.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const FMGAClampNode& Node = Nodes[NodeIndex];
+		for (const FMGAClampBound* Bound : { &Node.Min, &Node.Max })
+		{
+			if (Bound->IsAttributeBased())
+			{
+				DirectDependents[Bound->BoundSlot].AddUnique(NodeIndex);
+			}
+		}
+	}
+
+	// Transitive dependents, node indices sorted ascending is the topological order
+	DependentsBySlot.SetNum(SlotTable.Num());
+	for (int32 SlotIndex = 0; SlotIndex < SlotTable.Num(); ++SlotIndex)
+	{
+		if (DirectDependents[SlotIndex].IsEmpty())
+		{
+			continue;
+		}
+
+		TArray<int32>& Dependents = DependentsBySlot[SlotIndex];
+		TArray<int32> Pending = DirectDependents[SlotIndex];
+		while (!Pending.IsEmpty())
+		{
+			const int32 NodeIndex = Pending.Pop();
+			if (Nodes[NodeIndex].Slot == SlotIndex || Dependents.Contains(NodeIndex))
+			{
+				continue;
+			}
+
+			Dependents.Add(NodeIndex);
+			Pending.Append(DirectDependents[Nodes[NodeIndex].Slot]);
+		}
+
+		Dependents.Sort();
+	}
+
+	MGA_LOG(Verbose, TEXT("FMGAClampDependencyGraph::Build - %s: %d clamped attributes"), *GetNameSafe(InClass), Nodes.Num())
+}
@@ -0,0 +1,343 @@
+// Copyright Halcyonyx Studios.
+
+#include "Attributes/MGAPackedAttributes.h"
+
+#include "AbilitySystemComponent.h"
+#include "Attributes/MGAAttributeSlotTable.h"
+#include "Attributes/ModularAttributeSetBase.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "Utilities/MGANetProfiler.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MGAPackedAttributes)
+
+namespace MGA::PackedAttributes
+{
+	static FCriticalSection CacheCriticalSection;
+	static TMap<const UClass*, TSharedRef<FMGAPackedAttributeLayout>> Cache;
+
+	/** Quantized values last sent to a given connection */
+	class FDeltaState : public INetDeltaBaseState
+	{
+	public:
+		TArray<uint32> Values;
+
+		virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+		{
+			const FDeltaState* Other = static_cast<const FDeltaState*>(OtherState);
+			return Other && Values == Other->Values;
+		}
+	};
+
+	static uint32 FloatToBits(const float InValue)
+	{
+		uint32 Bits;
+		FMemory::Memcpy(&Bits, &InValue, sizeof(float));
+		return Bits;
+	}
+
+	static float BitsToFloat(const uint32 InBits)
+	{
+		float Value;
+		FMemory::Memcpy(&Value, &InBits, sizeof(float));
+		return Value;
+	}
+}
+
+uint32 FMGAPackedAttributeEncoding::Quantize(const float InValue) const
+{
+	if (NumBits == 0)
+	{
+		return MGA::PackedAttributes::FloatToBits(InValue);
+	}
+
+	const float Clamped = FMath::Clamp(InValue, MinValue, MaxValue);
+	return static_cast<uint32>(FMath::RoundToInt((Clamped - MinValue) / Precision));
+}
+
+float FMGAPackedAttributeEncoding::Dequantize(const uint32 InQuantizedValue) const
+{
+	if (NumBits == 0)
+	{
+		return MGA::PackedAttributes::BitsToFloat(InQuantizedValue);
+	}
+
+	return FMath::Min(MinValue + static_cast<float>(InQuantizedValue) * Precision, MaxValue);
+}
+
+TSharedRef<const FMGAPackedAttributeLayout> FMGAPackedAttributeLayout::Get(const UClass* InClass)
+{
+	check(InClass);
+
+	FScopeLock Lock(&MGA::PackedAttributes::CacheCriticalSection);
+
+	// See FMGAAttributeSlotTable::Get()
+	if (const TSharedRef<FMGAPackedAttributeLayout>* CachedLayout = MGA::PackedAttributes::Cache.Find(InClass))
+	{
+		if ((*CachedLayout)->Class.Get() == InClass)
+		{
+			return *CachedLayout;
+		}
+	}
+
+	const TSharedRef<FMGAPackedAttributeLayout> Layout = MakeShared<FMGAPackedAttributeLayout>();
+	Layout->Build(InClass);
+	MGA::PackedAttributes::Cache.Add(InClass, Layout);
+	return Layout;
+}
+
+void FMGAPackedAttributeLayout::Invalidate(const UClass* InClass)
+{
+	FScopeLock Lock(&MGA::PackedAttributes::CacheCriticalSection);
+
+	for (auto It = MGA::PackedAttributes::Cache.CreateIterator(); It; ++It)
+	{
+		const UClass* Class = It->Value->Class.Get();
+		if (!InClass || !Class || Class->IsChildOf(InClass))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FMGAPackedAttributeLayout::Build(const UClass* InClass)
+{
+	Class = InClass;
+	Encodings.Reset();
+
+	const TSharedRef<const FMGAAttributeSlotTable> SlotTableRef = FMGAAttributeSlotTable::Get(InClass);
+	const FMGAAttributeSlotTable& SlotTable = *SlotTableRef;
+	const UModularAttributeSetBase* DefaultObject = Cast<UModularAttributeSetBase>(InClass->GetDefaultObject());
+	if (!DefaultObject)
+	{
+		return;
+	}
+
+	for (const int32 SlotIndex : SlotTable.GetReplicatedSlots())
+	{
+		const FMGAAttributeSlot& Slot = SlotTable.GetSlot(SlotIndex);
+
+		FMGAPackedAttributeEncoding& Encoding = Encodings.AddDefaulted_GetRef();
+		Encoding.Attribute = Slot.Attribute;
+		Encoding.Offset = Slot.Offset;
+
+		const FMGAAttributeQuantizationRule* Rule = DefaultObject->QuantizationRules.FindByPredicate([&Slot](const FMGAAttributeQuantizationRule& InRule)
+		{
+			return InRule.Attribute == Slot.Attribute;
+		});
+
+		if (!Rule || Rule->Precision <= 0.f)
+		{
+			continue;
+		}
+
+		if (Rule->MaxValue <= Rule->MinValue)
+		{
+			MGA_LOG(Warning, TEXT("FMGAPackedAttributeLayout - Invalid quantization range for %s in %s, replicating full float"), *Slot.Attribute.GetName(), *GetNameSafe(InClass))
+			continue;
+		}
+
+		const double NumSteps = FMath::CeilToDouble((Rule->MaxValue - Rule->MinValue) / Rule->Precision);
+		const uint32 NumBits = FMath::CeilLogTwo64(static_cast<uint64>(NumSteps) + 1);
+		if (NumBits == 0 || NumBits >= 32)
+		{
+			// Nothing to gain over a full float (or a constant value which is better served by the float path too)
+			continue;
+		}
+
+		Encoding.MinValue = Rule->MinValue;
+		Encoding.MaxValue = Rule->MaxValue;
+		Encoding.Precision = Rule->Precision;
+		Encoding.NumBits = NumBits;
+	}
+
+	MGA_LOG(Verbose, TEXT("FMGAPackedAttributeLayout::Build - %s: %d packed attributes"), *GetNameSafe(InClass), Encodings.Num())
+}
+
+void FMGAPackedAttributes::GatherQuantizedValues(const FMGAPackedAttributeLayout& InLayout, TArray<uint32>& OutValues) const
+{
+	const TArray<FMGAPackedAttributeEncoding>& Encodings = InLayout.GetEncodings();
+	OutValues.SetNumUninitialized(Encodings.Num() * 2);
+
+	const uint8* OwnerMemory = reinterpret_cast<const uint8*>(Owner);
+	for (int32 Index = 0; Index < Encodings.Num(); ++Index)
+	{
+		const FMGAPackedAttributeEncoding& Encoding = Encodings[Index];
+		const FGameplayAttributeData* Data = reinterpret_cast<const FGameplayAttributeData*>(OwnerMemory + Encoding.Offset);
+		OutValues[Index * 2] = Encoding.Quantize(Data->GetCurrentValue());
+		OutValues[Index * 2 + 1] = Encoding.Quantize(Data->GetBaseValue());
+	}
+}
+
+bool FMGAPackedAttributes::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	// No object references in there
+	if (DeltaParms.bUpdateUnmappedObjects || DeltaParms.GatherGuidReferences || DeltaParms.MoveGuidToUnmapped)
+	{
+		return false;
+	}
+
+	if (!Owner)
+	{
+		return false;
+	}
+
+	// Held for the whole serialization, a layout invalidated meanwhile stays alive
+	const TSharedRef<const FMGAPackedAttributeLayout> Layout = FMGAPackedAttributeLayout::Get(Owner->GetClass());
+	const TArray<FMGAPackedAttributeEncoding>& Encodings = Layout->GetEncodings();
+	uint32 NumEncodings = Encodings.Num();
+
+	if (DeltaParms.Writer)
+	{
+		FBitWriter& Writer = *DeltaParms.Writer;
+
+		TSharedPtr<MGA::PackedAttributes::FDeltaState> NewState = MakeShared<MGA::PackedAttributes::FDeltaState>();
+		GatherQuantizedValues(*Layout, NewState->Values);
+
+		const MGA::PackedAttributes::FDeltaState* OldState = static_cast<const MGA::PackedAttributes::FDeltaState*>(DeltaParms.OldState);
+		const bool bFullState = !OldState || OldState->Values.Num() != NewState->Values.Num();
+
+		TBitArray<> ChangedMask(false, NumEncodings);
+		bool bAnyChange = bFullState;
+		for (uint32 Index = 0; Index < NumEncodings && !bFullState; ++Index)
+		{
+			if (OldState->Values[Index * 2] != NewState->Values[Index * 2] || OldState->Values[Index * 2 + 1] != NewState->Values[Index * 2 + 1])
+			{
+				ChangedMask[Index] = true;
+				bAnyChange = true;
+			}
+		}
+
+		if (!bAnyChange)
+		{
+			return false;
+		}
+
+		*DeltaParms.NewState = NewState;
+
+#if MGA_WITH_NET_PROFILER
+		const bool bProfile = FMGANetProfiler::IsEnabled();
+		const int64 HeaderStartBits = Writer.GetNumBits();
+#endif
+
+		// Layout size is sent as a sanity check, both sides are expected to agree on it
+		Writer.SerializeIntPacked(NumEncodings);
+
+		for (uint32 Index = 0; Index < NumEncodings; ++Index)
+		{
+			uint8 bChanged = bFullState || ChangedMask[Index] ? 1 : 0;
+			Writer.SerializeBits(&bChanged, 1);
+		}
+
+#if MGA_WITH_NET_PROFILER
+		if (bProfile)
+		{
+			FMGANetProfiler::Get().RecordAttributeSet(Owner, Writer.GetNumBits() - HeaderStartBits, false);
+		}
+#endif
+
+		for (uint32 Index = 0; Index < NumEncodings; ++Index)
+		{
+			if (!bFullState && !ChangedMask[Index])
+			{
+				continue;
+			}
+
+			const FMGAPackedAttributeEncoding& Encoding = Encodings[Index];
+			const uint32 NumBits = Encoding.NumBits > 0 ? Encoding.NumBits : 32;
+
+			uint32 CurrentValue = NewState->Values[Index * 2];
+			uint32 BaseValue = NewState->Values[Index * 2 + 1];
+			uint8 bBaseEqualsCurrent = CurrentValue == BaseValue ? 1 : 0;
+
+			Writer.SerializeBits(&CurrentValue, NumBits);
+			Writer.SerializeBits(&bBaseEqualsCurrent, 1);
+			if (!bBaseEqualsCurrent)
+			{
+				Writer.SerializeBits(&BaseValue, NumBits);
+			}
+
+#if MGA_WITH_NET_PROFILER
+			if (bProfile)
+			{
+				FMGANetProfiler::Get().RecordAttribute(Owner, Encoding.Attribute, NumBits + 1 + (bBaseEqualsCurrent ? 0 : NumBits), false);
+			}
+#endif
+		}
+
+		return true;
+	}
+
+	if (DeltaParms.Reader)
+	{
+		FBitReader& Reader = *DeltaParms.Reader;
+
+		uint32 NumSentEncodings = 0;
+		Reader.SerializeIntPacked(NumSentEncodings);
+		if (NumSentEncodings != NumEncodings)
+		{
+			MGA_LOG(Error, TEXT("FMGAPackedAttributes::NetDeltaSerialize - Layout mismatch for %s (received %d attributes, expected %d)"), *GetNameSafe(Owner), NumSentEncodings, NumEncodings)
+			Reader.SetError();
+			return false;
+		}
+
+		TBitArray<> ChangedMask(false, NumEncodings);
+		for (uint32 Index = 0; Index < NumEncodings; ++Index)
+		{
+			uint8 bChanged = 0;
+			Reader.SerializeBits(&bChanged, 1);
+			ChangedMask[Index] = bChanged != 0;
+		}
+
+		UAbilitySystemComponent* ASC = Owner->GetOwningAbilitySystemComponent();
+		uint8* OwnerMemory = reinterpret_cast<uint8*>(Owner);
+
+		for (uint32 Index = 0; Index < NumEncodings; ++Index)
+		{
+			if (!ChangedMask[Index])
+			{
+				continue;
+			}
+
+			const FMGAPackedAttributeEncoding& Encoding = Encodings[Index];
+			const uint32 NumBits = Encoding.NumBits > 0 ? Encoding.NumBits : 32;
+
+			uint32 CurrentValue = 0;
+			uint32 BaseValue = 0;
+			uint8 bBaseEqualsCurrent = 0;
+
+			Reader.SerializeBits(&CurrentValue, NumBits);
+			Reader.SerializeBits(&bBaseEqualsCurrent, 1);
+			if (bBaseEqualsCurrent)
+			{
+				BaseValue = CurrentValue;
+			}
+			else
+			{
+				Reader.SerializeBits(&BaseValue, NumBits);
+			}
+
+			if (Reader.IsError())
+			{
+				return false;
+			}
+
+			FGameplayAttributeData* Data = reinterpret_cast<FGameplayAttributeData*>(OwnerMemory + Encoding.Offset);
+			const FGameplayAttributeData OldData = *Data;
+			Data->SetBaseValue(Encoding.Dequantize(BaseValue));
+			Data->SetCurrentValue(Encoding.Dequantize(CurrentValue));
+
+			// Same as GAMEPLAYATTRIBUTE_REPNOTIFY(), keeps predicted modifiers on top of the replicated base value
+			if (ASC)
+			{
+				ASC->SetBaseAttributeValueFromReplication(Encoding.Attribute, *Data, OldData);
+			}
+		}
+
+		return true;
+	}
+
+	return true;
+}
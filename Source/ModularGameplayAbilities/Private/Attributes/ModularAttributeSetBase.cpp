@@ -20,9 +20,14 @@
 #include "UObject/UnrealType.h"
 #include "Utilities/ModularAttributesHelpers.h"
 #include "Utilities/MGAUtilities.h"
+#include "Attributes/MGAAttributeSlotTable.h"
+#include "Attributes/MGAClampDependencyGraph.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Net/UnrealNetwork.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
+#include "Attributes/MGAAttributeSetValidationCache.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_FunctionEntry.h"
 #include "K2Node_VariableGet.h"
@@ -98,6 +103,19 @@ FString FMGAAttributeSetExecutionData::ToString(const FString& InSeparator) cons
 	return FString::Join(Results, *InSeparator);
 }
 
+ELifetimeCondition FMGAAttributeReplicationRule::GetCondition() const
+{
+	switch (Audience)
+	{
+	case EMGAAttributeReplicationAudience::OwnerOnly:
+		return COND_OwnerOnly;
+	case EMGAAttributeReplicationAudience::SimulatedOnly:
+		return COND_SimulatedOnly;
+	default:
+		return COND_None;
+	}
+}
+
 float FMGAAttributeClampDefinition::GetValueForClamping(const UAttributeSet* InOwnerSet) const
 {
 	check(InOwnerSet);
@@ -167,6 +185,7 @@ bool FMGAAttributeClampDefinition::GetValueForClamping(const UAttributeSet* InOw
 UModularAttributeSetBase::UModularAttributeSetBase(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	PackedAttributes.Owner = this;
 }
 
 void UModularAttributeSetBase::Serialize(FArchive& Ar)
@@ -191,6 +210,13 @@ void UModularAttributeSetBase::PostEditChangeChainProperty(FPropertyChangedChain
 
 	const FName PropertyChangedName = PropertyChangedEvent.MemberProperty->GetFName();
 	const UStruct* OwnerStruct = PropertyChangedEvent.MemberProperty->GetOwnerStruct();
+
+	// Packed replication layout is built from the default object quantization rules
+	if (PropertyChangedName == GET_MEMBER_NAME_CHECKED(UModularAttributeSetBase, QuantizationRules) && HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FMGAPackedAttributeLayout::Invalidate(GetClass());
+		return;
+	}
 	
 	// protected visibility on BaseValue prevents us from using GET_MEMBER_NAME_CHECKED(FGameplayAttributeData, BaseValue);
 	if (OwnerStruct != FGameplayAttributeData::StaticStruct() || PropertyChangedName != MGA::Constants::BaseValuePropertyName)
@@ -290,7 +316,26 @@ void UModularAttributeSetBase::PreAttributeChange(const FGameplayAttribute& Attr
 void UModularAttributeSetBase::PostAttributeChange(const FGameplayAttribute& Attribute, const float OldValue, const float NewValue)
 {
 	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+	MarkAttributeDirty(Attribute);
 	K2_PostAttributeChange(Attribute, OldValue, NewValue);
+
+	if (!bIsReclampingDependents && OldValue != NewValue)
+	{
+		// Only a base value change scales dependents proportionally. A current value change from a temporary modifier
+		// (eg. a MaxHealth buff) only re-clamps them, otherwise their base value would keep the scaling once it expires.
+		const FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeData(this);
+		const float NewBaseValue = AttributeData ? AttributeData->GetBaseValue() : NewValue;
+		const float OldBaseValue = PendingBaseValueChange.Attribute == Attribute ? PendingBaseValueChange.OldBaseValue : NewBaseValue;
+		ReclampDependentAttributes(Attribute, OldBaseValue, NewBaseValue);
+	}
+
+	if (OldValue != NewValue)
+	{
+		if (UModularAbilitySystemComponent* ASC = Cast<UModularAbilitySystemComponent>(GetOwningAbilitySystemComponent()))
+		{
+			ASC->NotifyAbilitySystemActivity(EModularAbilitySystemActivity::AttributeChange);
+		}
+	}
 }
 
 void UModularAttributeSetBase::PreAttributeBaseChange(const FGameplayAttribute& Attribute, float& OutValue) const
@@ -300,11 +345,24 @@ void UModularAttributeSetBase::PreAttributeBaseChange(const FGameplayAttribute&
 	// Pass in an additional float param to the BP event, reference value are handled differently in BP and far less intuitive than in native
 	const float Value = OutValue;
 	K2_PreAttributeBaseChange(Attribute, Value, OutValue);
+
+	// The current value is updated (and PostAttributeChange called) before PostAttributeBaseChange, with the new base value
+	// already written: keep the old one around so that PostAttributeChange knows the base value changed
+	const FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeData(const_cast<UModularAttributeSetBase*>(this));
+	PendingBaseValueChange.Attribute = Attribute;
+	PendingBaseValueChange.OldBaseValue = AttributeData ? AttributeData->GetBaseValue() : OutValue;
 }
 
 void UModularAttributeSetBase::PostAttributeBaseChange(const FGameplayAttribute& Attribute, const float OldValue, const float NewValue) const
 {
 	Super::PostAttributeBaseChange(Attribute, OldValue, NewValue);
+	MarkAttributeDirty(Attribute);
+
+	if (PendingBaseValueChange.Attribute == Attribute)
+	{
+		PendingBaseValueChange = FPendingBaseValueChange();
+	}
+
 	K2_PostAttributeBaseChange(Attribute, OldValue, NewValue);
 }
 
@@ -385,6 +443,15 @@ float UModularAttributeSetBase::K2_GetAttributeValue(FGameplayAttribute Attribut
 
 float UModularAttributeSetBase::GetAttributeValue(const FGameplayAttribute& Attribute, bool& bSuccessfullyFoundAttribute) const
 {
+	// Fast path for attributes of this set, read directly from the resolved slot
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	const int32 SlotIndex = SlotTable.FindSlot(Attribute);
+	if (SlotIndex != INDEX_NONE)
+	{
+		bSuccessfullyFoundAttribute = true;
+		return SlotTable.GetSlot(SlotIndex).GetData(this)->GetCurrentValue();
+	}
+
 	const UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
 	if (!ASC)
 	{
@@ -393,6 +460,17 @@ float UModularAttributeSetBase::GetAttributeValue(const FGameplayAttribute& Attr
 		return 0.f;
 	}
 
+	// Attributes of other sets, through the cached accessors of the owning ASC
+	if (const UModularAbilitySystemComponent* ModularASC = Cast<UModularAbilitySystemComponent>(ASC))
+	{
+		const FMGAAttributeAccessor& Accessor = ModularASC->FindAttributeAccessor(Attribute);
+		if (Accessor.IsValid())
+		{
+			bSuccessfullyFoundAttribute = true;
+			return Accessor.GetCurrentValue();
+		}
+	}
+
 	return UAbilitySystemBlueprintLibrary::GetFloatAttributeFromAbilitySystemComponent(ASC, Attribute, bSuccessfullyFoundAttribute);
 }
 
@@ -403,6 +481,15 @@ float UModularAttributeSetBase::K2_GetAttributeBaseValue(FGameplayAttribute Attr
 
 float UModularAttributeSetBase::GetAttributeBaseValue(const FGameplayAttribute& Attribute, bool& bSuccessfullyFoundAttribute) const
 {
+	// Fast path for attributes of this set, read directly from the resolved slot
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	const int32 SlotIndex = SlotTable.FindSlot(Attribute);
+	if (SlotIndex != INDEX_NONE)
+	{
+		bSuccessfullyFoundAttribute = true;
+		return SlotTable.GetSlot(SlotIndex).GetData(this)->GetBaseValue();
+	}
+
 	const UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
 	if (!ASC)
 	{
@@ -411,6 +498,16 @@ float UModularAttributeSetBase::GetAttributeBaseValue(const FGameplayAttribute&
 		return 0.f;
 	}
 
+	if (const UModularAbilitySystemComponent* ModularASC = Cast<UModularAbilitySystemComponent>(ASC))
+	{
+		const FMGAAttributeAccessor& Accessor = ModularASC->FindAttributeAccessor(Attribute);
+		if (Accessor.IsValid())
+		{
+			bSuccessfullyFoundAttribute = true;
+			return Accessor.GetBaseValue();
+		}
+	}
+
 	return UAbilitySystemBlueprintLibrary::GetFloatAttributeBaseFromAbilitySystemComponent(ASC, Attribute, bSuccessfullyFoundAttribute);
 }
 
@@ -468,11 +565,33 @@ FGameplayAbilityActorInfo UModularAttributeSetBase::K2_GetActorInfo() const
 	return *ActorInfo;
 }
 
+const FMGAAttributeSlotTable& UModularAttributeSetBase::GetAttributeSlotTable() const
+{
+	if (!CachedSlotTable.IsValid() || CachedSlotTable->IsStale())
+	{
+		CachedSlotTable = FMGAAttributeSlotTable::Get(GetClass());
+
+		CachedAttributeHandles.Reset(CachedSlotTable->Num());
+		for (const FMGAAttributeSlot& Slot : CachedSlotTable->GetSlots())
+		{
+			CachedAttributeHandles.Add(FMGAAttributeHandle::FromProperty(Slot.Property));
+		}
+	}
+
+	return *CachedSlotTable;
+}
+
+FMGAAttributeHandle UModularAttributeSetBase::GetAttributeHandle(const FGameplayAttribute& InAttribute) const
+{
+	const int32 SlotIndex = GetAttributeSlotTable().FindSlot(InAttribute);
+	return CachedAttributeHandles.IsValidIndex(SlotIndex) ? CachedAttributeHandles[SlotIndex] : FMGAAttributeHandle::FromAttribute(InAttribute);
+}
+
 void UModularAttributeSetBase::HandleRepNotifyForGameplayAttribute(const FName InPropertyName)
 {
-	FProperty* ThisProperty = FindFProperty<FProperty>(GetClass(), InPropertyName);
+	const int32 SlotIndex = GetAttributeSlotTable().FindSlotByName(InPropertyName);
 	
-	if (!ThisProperty)
+	if (SlotIndex == INDEX_NONE)
 	{
 		MGA_LOG(
 			Warning,
@@ -482,42 +601,18 @@ void UModularAttributeSetBase::HandleRepNotifyForGameplayAttribute(const FName I
 		)
 		return;
 	}
-	
-	const FGameplayAttribute Attribute = FGameplayAttribute(ThisProperty);
-	const FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeData(this);
-	{
-		const FString ErrorMessage = FString::Printf(TEXT("Was unable to determine current attribute data for property: %s"), *InPropertyName.ToString());
-		if (!ensureMsgf(AttributeData, TEXT("%s"), *ErrorMessage))
-		{
-			MGA_LOG(Error, TEXT("UModularAttributeSetBase::HandleRepNotifyForGameplayAttribute - %s"), *ErrorMessage)
-			return;
-		}
-	}
-
-	// Try to find old attribute data from pre-computed rep map in PreNetReceive, that should contain the value right before receiving the net update
-	const FString Key = FString::Printf(TEXT("%s.%s"), *GetNameSafe(ThisProperty->GetOwnerClass()), *InPropertyName.ToString());
 
-	const FGameplayAttributeData* OldAttributeDataPtr = AttributeDataRepMap.Contains(Key) ? AttributeDataRepMap.FindChecked(Key).Get() : nullptr;
-	{
-		const FString ErrorMessage = FString::Printf(TEXT("Was unable to determine old attribute data for property: %s"), *InPropertyName.ToString());
-		if (!ensureMsgf(OldAttributeDataPtr, TEXT("%s"), *ErrorMessage))
-		{
-			MGA_LOG(Error, TEXT("UModularAttributeSetBase::HandleRepNotifyForGameplayAttribute - %s"), *ErrorMessage)
-		}
-	}
-
-	const FGameplayAttributeData OldAttributeData = OldAttributeDataPtr != nullptr ? *OldAttributeDataPtr : FGameplayAttributeData();
-	GetOwningAbilitySystemComponent()->SetBaseAttributeValueFromReplication(Attribute, *AttributeData, OldAttributeData);
+	HandleRepNotifyForSlot(SlotIndex);
 }
 
 void UModularAttributeSetBase::HandleRepNotifyForAttributeData(const FGameplayAttributeData& InAttribute)
 {
-	FString AttributeName;
-	if (!GetAttributeDataPropertyName(InAttribute, AttributeName))
+	const int32 SlotIndex = GetAttributeSlotTable().FindSlot(this, InAttribute);
+	if (SlotIndex == INDEX_NONE)
 	{
 		const FString ErrorMessage = FString::Printf(
 			TEXT(
-				"Unable to determine AttributeName - AttributeSet: %s - "
+				"Unable to determine Attribute slot - AttributeSet: %s - "
 				"This shouldn't happen and will prevent proper predictive attribute replication handling."
 			),
 			*GetName()
@@ -528,7 +623,7 @@ void UModularAttributeSetBase::HandleRepNotifyForAttributeData(const FGameplayAt
 		return;
 	}
 
-	HandleRepNotifyForGameplayAttribute(FName(*AttributeName));
+	HandleRepNotifyForSlot(SlotIndex);
 }
 
 void UModularAttributeSetBase::HandleRepNotifyForClampedAttributeData(const FMGAClampedAttributeData& InAttribute)
@@ -536,10 +631,28 @@ void UModularAttributeSetBase::HandleRepNotifyForClampedAttributeData(const FMGA
 	HandleRepNotifyForAttributeData(InAttribute);
 }
 
+void UModularAttributeSetBase::MarkAttributeDirty(const FGameplayAttribute& InAttribute) const
+{
+#if WITH_PUSH_MODEL
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	const int32 SlotIndex = SlotTable.FindSlot(InAttribute);
+	if (SlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FMGAAttributeSlot& Slot = SlotTable.GetSlot(SlotIndex);
+	if (Slot.bReplicated)
+	{
+		MARK_PROPERTY_DIRTY(this, Slot.Property);
+	}
+#endif
+}
+
 void UModularAttributeSetBase::BeginDestroy()
 {
 	AttributesMetaData.Empty();
-	AttributeDataRepMap.Empty();
+	AttributeDataRepSlots.Empty();
 	Super::BeginDestroy();
 }
 
@@ -551,6 +664,79 @@ void UModularAttributeSetBase::GetLifetimeReplicatedProps(TArray<FLifetimeProper
 	if (BPClass != nullptr)
 	{
 		BPClass->GetLifetimeBlueprintReplicationList(OutLifetimeProps);
+
+#if WITH_PUSH_MODEL
+		if (bPushModelBlueprintAttributes)
+		{
+			// Blueprint replication list has no way of declaring push based properties, flag attribute data ones here
+			const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+			for (const int32 SlotIndex : SlotTable.GetReplicatedSlots())
+			{
+				const FStructProperty* Property = SlotTable.GetSlot(SlotIndex).Property;
+				if (!Cast<UBlueprintGeneratedClass>(Property->GetOwnerClass()))
+				{
+					continue;
+				}
+
+				FLifetimeProperty* LifetimeProperty = OutLifetimeProps.FindByPredicate([Property](const FLifetimeProperty& InLifetimeProperty)
+				{
+					return InLifetimeProperty.RepIndex == Property->RepIndex;
+				});
+
+				if (LifetimeProperty)
+				{
+					LifetimeProperty->bIsPushBased = true;
+				}
+			}
+		}
+#endif
+	}
+
+	FDoRepLifetimeParams PackedParams;
+	PackedParams.Condition = bUsePackedReplication ? COND_None : COND_Never;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UModularAttributeSetBase, PackedAttributes, PackedParams);
+
+	ApplyAttributeReplicationRules(OutLifetimeProps);
+}
+
+void UModularAttributeSetBase::ApplyAttributeReplicationRules(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	if (!bUsePackedReplication && ReplicationRules.IsEmpty())
+	{
+		return;
+	}
+
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	for (const int32 SlotIndex : SlotTable.GetReplicatedSlots())
+	{
+		const FMGAAttributeSlot& Slot = SlotTable.GetSlot(SlotIndex);
+		const FStructProperty* Property = Slot.Property;
+		FLifetimeProperty* LifetimeProperty = OutLifetimeProps.FindByPredicate([Property](const FLifetimeProperty& InLifetimeProperty)
+		{
+			return InLifetimeProperty.RepIndex == Property->RepIndex;
+		});
+
+		if (!LifetimeProperty)
+		{
+			continue;
+		}
+
+		// Attribute values go through PackedAttributes instead
+		if (bUsePackedReplication)
+		{
+			LifetimeProperty->Condition = COND_Never;
+			continue;
+		}
+
+		const FMGAAttributeReplicationRule* Rule = ReplicationRules.FindByPredicate([&Slot](const FMGAAttributeReplicationRule& InRule)
+		{
+			return InRule.Attribute == Slot.Attribute;
+		});
+
+		if (Rule)
+		{
+			LifetimeProperty->Condition = Rule->GetCondition();
+		}
 	}
 }
 
@@ -565,35 +751,23 @@ void UModularAttributeSetBase::PreNetReceive()
 	//
 	// All of this is necessary because of BP rep notifies not accepting a param (to represent the old state) as we can do in cpp
 
-	TArray<FProperty*> ReplicatedProps;
-	GetAllBlueprintReplicatedProps(ReplicatedProps);
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	const TArray<int32>& ReplicatedSlots = SlotTable.GetReplicatedSlots();
 
-	AttributeDataRepMap.Reset();
-	AttributeDataRepMap.Reserve(ReplicatedProps.Num());
-
-	MGA_LOG(VeryVerbose, TEXT("UModularAttributeSetBase::PreNetReceive ... ReplicatedProps: %d"), ReplicatedProps.Num())
-	for (FProperty* Prop : ReplicatedProps)
+	// Slots are stable for this class, so size once and only overwrite replicated entries on each bunch
+	if (AttributeDataRepSlots.Num() != SlotTable.Num())
 	{
-		if (!Prop || !Prop->GetOwnerClass())
-		{
-			continue;
-		}
+		AttributeDataRepSlots.SetNum(SlotTable.Num());
+	}
 
-		const FGameplayAttribute Attribute = FGameplayAttribute(Prop);
-		const FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeData(this);
-		if (!ensureMsgf(AttributeData, TEXT("Could not get attribute data from property: %s"), *GetNameSafe(Prop)))
-		{
-			continue;
-		}
+	MGA_LOG(VeryVerbose, TEXT("UModularAttributeSetBase::PreNetReceive ... ReplicatedSlots: %d"), ReplicatedSlots.Num())
+	for (const int32 SlotIndex : ReplicatedSlots)
+	{
+		const FMGAAttributeSlot& Slot = SlotTable.GetSlot(SlotIndex);
+		const FGameplayAttributeData* AttributeData = Slot.GetData(this);
 		
-		MGA_LOG(VeryVerbose, TEXT("\t Prop: %s (Owner: %s) - Value: %f"), *GetNameSafe(Prop), *GetNameSafe(Prop->GetOwnerClass()), AttributeData->GetCurrentValue())
-		if (const UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent())
-		{
-			MGA_LOG(VeryVerbose, TEXT("\t\t Prop: %s (Owner: %s) - ASC Value: %f"), *GetNameSafe(Prop), *GetNameSafe(Prop->GetOwnerClass()), ASC->GetNumericAttribute(Attribute))
-		}
-
-		FString Key = FString::Printf(TEXT("%s.%s"), *Prop->GetOwnerClass()->GetName(), *Prop->GetName());
-		AttributeDataRepMap.Add(Key, MakeShared<FGameplayAttributeData>(*AttributeData));
+		MGA_LOG(VeryVerbose, TEXT("\t Prop: %s (Owner: %s) - Value: %f"), *Slot.Property->GetName(), *GetNameSafe(Slot.Key.OwnerClass), AttributeData->GetCurrentValue())
+		AttributeDataRepSlots[SlotIndex] = *AttributeData;
 	}
 }
 
@@ -614,20 +788,162 @@ EDataValidationResult UModularAttributeSetBase::IsDataValid(FDataValidationConte
 	}
 
 	{
-		
 		TArray<FText> ValidationErrors;
-		Result = CombineDataValidationResults(Result, IsDataValidRepNotifies(ValidationErrors));
-		
+		Result = CombineDataValidationResults(Result, IsDataValidReplication(ValidationErrors));
+
 		// Add to context manually until IsDataValidBlueprintEditor is re-written to work off FDataValidationContext in 5.6 (IsDataValid() with array of errors deprecated in 5.3)
 		for (const FText& ValidationError : ValidationErrors)
 		{
 			Context.AddError(ValidationError);
 		}
 	}
-	
+
+	return Result;
+}
+
+EDataValidationResult UModularAttributeSetBase::IsDataValidReplication(TArray<FText>& ValidationErrors) const
+{
+	const UPackage* Package = GetClass()->GetPackage();
+	if (!UBlueprint::GetBlueprintFromClass(GetClass()) || !Package)
+	{
+		// Native Attribute Sets have no graphs to walk, nothing worth caching
+		return CombineDataValidationResults(IsDataValidRepNotifies(ValidationErrors), IsDataValidReplicationRules(ValidationErrors));
+	}
+
+	FMGAAttributeSetValidationCache& Cache = FMGAAttributeSetValidationCache::Get();
+	const FBlake3Hash Key = GetReplicationValidationKey();
+
+	FMGAAttributeSetValidationEntry Entry;
+	if (Cache.Find(Package->GetFName(), Key, Entry))
+	{
+		MGA_LOG(VeryVerbose, TEXT("UModularAttributeSetBase::IsDataValidReplication - Using cached result for %s"), *Package->GetName())
+		for (const FString& Error : Entry.Errors)
+		{
+			ValidationErrors.Add(FText::FromString(Error));
+		}
+
+		return Entry.Result;
+	}
+
+	TArray<FText> Errors;
+	const EDataValidationResult Result = CombineDataValidationResults(IsDataValidRepNotifies(Errors), IsDataValidReplicationRules(Errors));
+
+	if (!Key.IsZero())
+	{
+		Entry.Key = Key;
+		Entry.Result = Result;
+		Entry.Errors.Reserve(Errors.Num());
+		for (const FText& Error : Errors)
+		{
+			Entry.Errors.Add(Error.ToString());
+		}
+
+		Cache.Add(Package->GetFName(), MoveTemp(Entry));
+	}
+
+	ValidationErrors.Append(MoveTemp(Errors));
 	return Result;
 }
 
+FBlake3Hash UModularAttributeSetBase::GetReplicationValidationKey() const
+{
+	// Replicated variables, rep notify graphs and replication rules all live in the Blueprint and its parent Blueprints,
+	// up to the first native class
+	TArray<FBlake3Hash, TInlineAllocator<4>> BlueprintHashes;
+	for (const UClass* Class = GetClass(); Class && !Class->HasAnyClassFlags(CLASS_Native); Class = Class->GetSuperClass())
+	{
+		const UBlueprint* Blueprint = UBlueprint::GetBlueprintFromClass(Class);
+		if (!Blueprint)
+		{
+			return FBlake3Hash();
+		}
+
+		BlueprintHashes.Add(GetReplicationValidationHash(Blueprint));
+	}
+
+	return FMGAAttributeSetValidationCache::MakeKey(BlueprintHashes);
+}
+
+FBlake3Hash UModularAttributeSetBase::GetReplicationValidationHash(const UBlueprint* InBlueprint)
+{
+	if (!InBlueprint)
+	{
+		return FBlake3Hash();
+	}
+
+	// Strings are hashed as UTF-8 with their length, so that hashes match across platforms and fields can't run together
+	FBlake3 Hasher;
+	auto UpdateString = [&Hasher](const FString& InString)
+	{
+		const FTCHARToUTF8 Utf8String(*InString);
+		const int32 Length = Utf8String.Length();
+		Hasher.Update(&Length, sizeof(Length));
+		Hasher.Update(Utf8String.Get(), Length);
+	};
+
+	for (const FBPVariableDescription& Variable : InBlueprint->NewVariables)
+	{
+		FString VariableText;
+		FBPVariableDescription::StaticStruct()->ExportText(VariableText, &Variable, nullptr, nullptr, PPF_None, nullptr);
+		UpdateString(VariableText);
+	}
+
+	TArray<UEdGraph*> Graphs;
+	InBlueprint->GetAllGraphs(Graphs);
+	for (const UEdGraph* Graph : Graphs)
+	{
+		if (!Graph || !Graph->GetName().StartsWith(TEXT("OnRep_")))
+		{
+			continue;
+		}
+
+		UpdateString(Graph->GetName());
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			UpdateString(Node->GetClass()->GetPathName());
+			UpdateString(Node->GetName());
+			if (const UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
+			{
+				UpdateString(CallFunction->GetFunctionName().ToString());
+			}
+			else if (const UK2Node_VariableGet* VariableGet = Cast<UK2Node_VariableGet>(Node))
+			{
+				UpdateString(VariableGet->VariableReference.GetMemberName().ToString());
+			}
+
+			for (const UEdGraphPin* Pin : Node->Pins)
+			{
+				UpdateString(Pin->PinName.ToString());
+
+				const uint8 Direction = static_cast<uint8>(Pin->Direction);
+				Hasher.Update(&Direction, sizeof(Direction));
+
+				for (const UEdGraphPin* LinkedTo : Pin->LinkedTo)
+				{
+					UpdateString(LinkedTo ? GetNameSafe(LinkedTo->GetOwningNodeUnchecked()) + TEXT(".") + LinkedTo->PinName.ToString() : FString());
+				}
+			}
+		}
+	}
+
+	// Replication rules are default values, only known once compiled
+	const ThisClass* DefaultObject = InBlueprint->GeneratedClass ? Cast<ThisClass>(InBlueprint->GeneratedClass->GetDefaultObject(false)) : nullptr;
+	if (DefaultObject)
+	{
+		FString RulesText;
+		const FProperty* RulesProperty = FindFieldChecked<FProperty>(StaticClass(), GET_MEMBER_NAME_CHECKED(ThisClass, ReplicationRules));
+		RulesProperty->ExportText_InContainer(0, RulesText, DefaultObject, nullptr, nullptr, PPF_None);
+		UpdateString(RulesText);
+	}
+
+	return Hasher.Finalize();
+}
+
 EDataValidationResult UModularAttributeSetBase::IsDataValidBlueprintEditor(TArray<FText>& ValidationErrors) const
 {
 	EDataValidationResult Result = EDataValidationResult::NotValidated;
@@ -683,6 +999,79 @@ EDataValidationResult UModularAttributeSetBase::IsDataValidBlueprintEditor(TArra
 	return Result;
 }
 
+EDataValidationResult UModularAttributeSetBase::IsDataValidReplicationRules(TArray<FText>& ValidationErrors) const
+{
+	EDataValidationResult Result = EDataValidationResult::NotValidated;
+	if (ReplicationRules.IsEmpty())
+	{
+		return Result;
+	}
+
+	Result = EDataValidationResult::Valid;
+
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	TSet<FGameplayAttribute> SeenAttributes;
+	for (const FMGAAttributeReplicationRule& Rule : ReplicationRules)
+	{
+		const int32 SlotIndex = SlotTable.FindSlot(Rule.Attribute);
+		if (SlotIndex == INDEX_NONE || !SlotTable.GetSlot(SlotIndex).bReplicated)
+		{
+			Result = EDataValidationResult::Invalid;
+			ValidationErrors.Add(FText::Format(
+				LOCTEXT("Invalid_ReplicationRuleAttribute", "Replication rule attribute {0} is not a replicated attribute of this Attribute Set."),
+				FText::FromString(Rule.Attribute.GetName())
+			));
+			continue;
+		}
+
+		bool bAlreadySeen = false;
+		SeenAttributes.Add(Rule.Attribute, &bAlreadySeen);
+		if (bAlreadySeen)
+		{
+			Result = EDataValidationResult::Invalid;
+			ValidationErrors.Add(FText::Format(
+				LOCTEXT("Invalid_ReplicationRuleDuplicate", "Attribute {0} has more than one replication rule, only the first one is used."),
+				FText::FromString(Rule.Attribute.GetName())
+			));
+		}
+	}
+
+	if (bUsePackedReplication)
+	{
+		return Result;
+	}
+
+	// Native subclasses registering attributes after Super::GetLifetimeReplicatedProps() have to apply the rules again
+	TArray<FLifetimeProperty> LifetimeProps;
+	GetLifetimeReplicatedProps(LifetimeProps);
+
+	for (const FGameplayAttribute& Attribute : SeenAttributes)
+	{
+		const FMGAAttributeReplicationRule* Rule = ReplicationRules.FindByPredicate([&Attribute](const FMGAAttributeReplicationRule& InRule)
+		{
+			return InRule.Attribute == Attribute;
+		});
+
+		const FStructProperty* Property = SlotTable.GetSlot(SlotTable.FindSlot(Attribute)).Property;
+		const FLifetimeProperty* LifetimeProperty = LifetimeProps.FindByPredicate([Property](const FLifetimeProperty& InLifetimeProperty)
+		{
+			return InLifetimeProperty.RepIndex == Property->RepIndex;
+		});
+
+		if (LifetimeProperty && LifetimeProperty->Condition != Rule->GetCondition())
+		{
+			Result = EDataValidationResult::Invalid;
+			ValidationErrors.Add(FText::Format(
+				LOCTEXT("Invalid_ReplicationRuleNotApplied", "Replication rule of attribute {0} is not applied, {1}::GetLifetimeReplicatedProps() must call ApplyAttributeReplicationRules() after registering its attributes."),
+				FText::FromString(Attribute.GetName()),
+				FText::FromString(Property->GetOwnerClass() ? Property->GetOwnerClass()->GetPrefixCPP() + Property->GetOwnerClass()->GetName() : FString())
+			));
+		}
+	}
+
+	return Result;
+}
+
 EDataValidationResult UModularAttributeSetBase::IsDataValidRepNotifies(TArray<FText>& ValidationErrors) const
 {
 	EDataValidationResult Result = EDataValidationResult::NotValidated;
@@ -904,7 +1293,20 @@ UEdGraphPin* UModularAttributeSetBase::FindGraphNodePin(const UEdGraphNode* InNo
 
 TMap<FString, TSharedPtr<FAttributeMetaData>> UModularAttributeSetBase::GetAttributesMetaData() const
 {
-	return AttributesMetaData;
+	TMap<FString, TSharedPtr<FAttributeMetaData>> Result;
+	Result.Reserve(AttributesMetaData.Num());
+	for (const TPair<FMGAAttributeHandle, TSharedPtr<FAttributeMetaData>>& Pair : AttributesMetaData)
+	{
+		Result.Add(Pair.Key.GetAttribute().GetName(), Pair.Value);
+	}
+	
+	return Result;
+}
+
+TSharedPtr<FAttributeMetaData> UModularAttributeSetBase::FindAttributeMetaData(const FMGAAttributeHandle& InAttributeHandle) const
+{
+	const TSharedPtr<FAttributeMetaData>* MetaData = AttributesMetaData.Find(InAttributeHandle);
+	return MetaData ? *MetaData : nullptr;
 }
 
 void UModularAttributeSetBase::InitClampedAttributeDataProperties()
@@ -927,6 +1329,7 @@ void UModularAttributeSetBase::InitClampedAttributeDataProperties()
 		NewValue = GetClampedValueForClampedProperty(Attribute, NewValue);
 		DataPtr->SetBaseValue(NewValue);
 		DataPtr->SetCurrentValue(NewValue);
+		MarkAttributeDirty(Attribute);
 	}
 }
 
@@ -967,7 +1370,7 @@ void UModularAttributeSetBase::InitDataTableProperties(const UDataTable* DataTab
 				check(DataPtr);
 				
 				TSharedRef<FAttributeMetaData> AttributeMetaData = MakeShared<FAttributeMetaData>(*MetaData);
-				AttributesMetaData.Add(Property->GetName(), AttributeMetaData);
+				AttributesMetaData.Add(FMGAAttributeHandle::FromProperty(Property), AttributeMetaData);
 
 				// Since this initialization won't run into any of the code path for the attribute set (like PreAttributeChange)
 				//
@@ -981,6 +1384,7 @@ void UModularAttributeSetBase::InitDataTableProperties(const UDataTable* DataTab
 				
 				DataPtr->SetBaseValue(BaseValue);
 				DataPtr->SetCurrentValue(BaseValue);
+				MarkAttributeDirty(FGameplayAttribute(Property));
 			}
 		}
 	}
@@ -1003,50 +1407,128 @@ float UModularAttributeSetBase::GetClampedValueForClampedProperty(const FGamepla
 {
 	float NewValue = InValue;
 
-	if (IsGameplayAttributeDataClampedProperty(Attribute.GetUProperty()))
+	const int32 SlotIndex = GetAttributeSlotTable().FindSlot(Attribute);
+	if (const FMGAClampNode* ClampNode = GetClampDependencyGraph().FindNode(SlotIndex))
 	{
-		if (const FMGAClampedAttributeData* Clamped = static_cast<FMGAClampedAttributeData*>(Attribute.GetGameplayAttributeData(this)))
+		// Bounds are resolved once per class, see FMGAClampDependencyGraph
+		if (!ClampNode->Clamp(this, NewValue))
 		{
-			float MinValue;
-			const bool bIsMinValid = Clamped->MinValue.GetValueForClamping(this, MinValue);
-			
-			float MaxValue;
-			const bool bIsMaxValid = Clamped->MaxValue.GetValueForClamping(this, MaxValue);
+			const FMGAClampedAttributeData* Clamped = static_cast<FMGAClampedAttributeData*>(Attribute.GetGameplayAttributeData(this));
+			MGA_LOG(
+				Warning,
+				TEXT("UModularAttributeSetBase::GetClampedValueForClampedProperty - "
+				"Clamping for Clamped Attribute %s was disabled because Min and Max values are incorrrect"
+				"(Min: %s, Max: %s)"),
+				*Attribute.GetName(),
+				*Clamped->MinValue.ToString(),
+				*Clamped->MaxValue.ToString()
+			)
+		}
+	}
+	
+	return NewValue;
+}
 
-			// If both min / max are valid, usual clamp
-			if (bIsMinValid && bIsMaxValid)
-			{
-				// MGA_LOG(VeryVerbose, TEXT("UModularAttributeSetBase::GetClampedValueForClampedProperty - Clamp %f between %f and %f"), NewValue, MinValue, MaxValue);
-				NewValue = FMath::Clamp(NewValue, MinValue, MaxValue);
-			}
-			// If only min is valid, then clamp using the lower bound only
-			else if (bIsMinValid)
+const FMGAClampDependencyGraph& UModularAttributeSetBase::GetClampDependencyGraph() const
+{
+	if (!CachedClampDependencyGraph.IsValid() || CachedClampDependencyGraph->IsStale())
+	{
+		CachedClampDependencyGraph = FMGAClampDependencyGraph::Get(GetClass());
+	}
+
+	return *CachedClampDependencyGraph;
+}
+
+void UModularAttributeSetBase::ReclampDependentAttributes(const FGameplayAttribute& InAttribute, const float OldBaseValue, const float NewBaseValue)
+{
+	const FMGAClampDependencyGraph& Graph = GetClampDependencyGraph();
+	if (!Graph.HasDependencies())
+	{
+		return;
+	}
+
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	const int32 SlotIndex = SlotTable.FindSlot(InAttribute);
+	const TArray<int32>& Dependents = Graph.GetDependents(SlotIndex);
+	if (Dependents.IsEmpty())
+	{
+		return;
+	}
+
+	// Clients get the adjusted values through replication, and only adjust their own predicted changes (replicated values
+	// are already adjusted)
+	const UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (!ASC || (!ASC->IsOwnerActorAuthoritative() && !ASC->CanPredict()))
+	{
+		return;
+	}
+
+	TGuardValue<bool> ReclampingGuard(bIsReclampingDependents, true);
+
+	// Old / new base values of the attributes changed so far, so that transitive dependents can be adjusted proportionally
+	struct FChangedValue
+	{
+		int32 Slot;
+		float OldValue;
+		float NewValue;
+	};
+	TArray<FChangedValue, TInlineAllocator<8>> ChangedValues;
+	if (OldBaseValue != NewBaseValue)
+	{
+		ChangedValues.Add({ SlotIndex, OldBaseValue, NewBaseValue });
+	}
+
+	for (const int32 NodeIndex : Dependents)
+	{
+		const FMGAClampNode& Node = Graph.GetNode(NodeIndex);
+		const FMGAAttributeSlot& Slot = SlotTable.GetSlot(Node.Slot);
+
+		const FGameplayAttributeData* Data = Slot.GetData(this);
+		const float CurrentValue = Data->GetCurrentValue();
+		const float BaseValue = Data->GetBaseValue();
+		float DependentBaseValue = BaseValue;
+
+		for (const FMGAClampBound* Bound : { &Node.Max, &Node.Min })
+		{
+			if (!Bound->bAdjustProportionally || !Bound->IsAttributeBased())
 			{
-				// MGA_LOG(VeryVerbose, TEXT("UModularAttributeSetBase::GetClampedValueForClampedProperty - Clamp %f using only min %f (max invalid)"), NewValue, MinValue);
-				NewValue = FMath::Max(NewValue, MinValue);
+				continue;
 			}
-			// If only max is valid, then clamp using the higher bound only
-			else if (bIsMaxValid)
+
+			const FChangedValue* BoundChange = ChangedValues.FindByPredicate([Bound](const FChangedValue& Changed)
 			{
-				// MGA_LOG(VeryVerbose, TEXT("UModularAttributeSetBase::GetClampedValueForClampedProperty - Clamp %f using only max %f (min invalid)"), NewValue, MaxValue);
-				NewValue = FMath::Min(NewValue, MaxValue);
-			}
-			else
+				return Changed.Slot == Bound->BoundSlot;
+			});
+
+			if (BoundChange && BoundChange->OldValue > 0.f)
 			{
-				MGA_LOG(
-					Warning,
-					TEXT("UModularAttributeSetBase::GetClampedValueForClampedProperty - "
-					"Clamping for Clamped Attribute %s was disabled because Min and Max values are incorrrect"
-					"(Min: %s, Max: %s)"),
-					*Attribute.GetName(),
-					*Clamped->MinValue.ToString(),
-					*Clamped->MaxValue.ToString()
-				)
+				// Same computation as UModularAbilitySystemComponent::AdjustAttributeForMaxChange
+				DependentBaseValue = FMath::RoundToFloat(DependentBaseValue * (BoundChange->NewValue / BoundChange->OldValue));
+				break;
 			}
 		}
+
+		Node.Clamp(this, DependentBaseValue, true);
+
+		// Modifiers on the bounds may leave the current value out of bounds with an unchanged base value, writing the base
+		// value re-evaluates the current one, which goes through PreAttributeChange clamping
+		float ClampedCurrentValue = CurrentValue;
+		Node.Clamp(this, ClampedCurrentValue);
+
+		if (DependentBaseValue == BaseValue && ClampedCurrentValue == CurrentValue)
+		{
+			continue;
+		}
+
+		SetAttributeValue(Slot.Attribute, DependentBaseValue);
+
+		const float NewCurrentValue = Data->GetCurrentValue();
+		MGA_LOG(Verbose, TEXT("UModularAttributeSetBase::ReclampDependentAttributes - %s: %f -> %f (base %f -> %f, %s changed)"), *Slot.Attribute.GetName(), CurrentValue, NewCurrentValue, BaseValue, DependentBaseValue, *InAttribute.GetName())
+		if (DependentBaseValue != BaseValue)
+		{
+			ChangedValues.Add({ Node.Slot, BaseValue, DependentBaseValue });
+		}
 	}
-	
-	return NewValue;
 }
 
 bool UModularAttributeSetBase::IsValidAttributeMetadata(const FAttributeMetaData& InAttributeMetadata)
@@ -1066,23 +1548,21 @@ bool UModularAttributeSetBase::IsValidAttributeMetadata(const TSharedPtr<FAttrib
 
 bool UModularAttributeSetBase::HasClampedMetaData(const FGameplayAttribute& Attribute)
 {
-	const FString AttributeName = Attribute.GetName();
-	if (AttributesMetaData.Contains(AttributeName))
+	if (AttributesMetaData.IsEmpty())
 	{
-		return IsValidAttributeMetadata(AttributesMetaData.FindChecked(AttributeName));
+		return false;
 	}
 	
-	return false;
+	return IsValidAttributeMetadata(FindAttributeMetaData(GetAttributeHandle(Attribute)));
 }
 
 float UModularAttributeSetBase::GetClampedValueForMetaData(const FGameplayAttribute& Attribute, const float InValue)
 {
 	float NewValue = InValue;
-	const FString AttributeName = Attribute.GetName();
 	
-	if (AttributesMetaData.Contains(AttributeName))
+	if (!AttributesMetaData.IsEmpty())
 	{
-		const TSharedPtr<FAttributeMetaData> MetaData = AttributesMetaData.FindChecked(AttributeName);
+		const TSharedPtr<FAttributeMetaData> MetaData = FindAttributeMetaData(GetAttributeHandle(Attribute));
 		if (MetaData.IsValid())
 		{
 			if (IsValidAttributeMetadata(MetaData))
@@ -1098,7 +1578,7 @@ float UModularAttributeSetBase::GetClampedValueForMetaData(const FGameplayAttrib
 					TEXT("UModularAttributeSetBase::GetClampedValueForMetaData - "
 					"Clamping from MetaData table for Attribute %s was disabled because Min and Max values are incorrrect "
 					"(Min must be lower than Max - Min: %f, Max: %f)"),
-					*AttributeName,
+					*Attribute.GetName(),
 					MetaData->MinValue,
 					MetaData->MaxValue
 				)
@@ -1154,45 +1634,57 @@ bool UModularAttributeSetBase::GetAttributeDataPropertyName(const FGameplayAttri
 		return false;
 	}
 
-	// Note: One possible improvement to this would be to cache the result in an internal map TMap<FGameplayAttribute, FString>
-	// and avoid further iterations over BP properties if we already know its name.
-	//
-	// But the problem lies with the original input parameter that is passed down from Blueprint, the FGameplayAttributeData
-	// property. We can get the FGameplayAttribute (where we can read its name) from an FProperty or get the corresponding
-	// FGameplayAttributeData from a FGameplayAttribute, but we can't get a FGameplayAttribute out of a
-	// FGameplayAttributeData.
-	//
-	// Even with a cache, we wouldn't be able to query the map from a FGameplayAttributeData as the struct doesn't implement
-	// GetTypeHash() and equality operators (whereas FGameplayAttribute do).
+	// FGameplayAttributeData has no identity on its own, but its offset within this set maps to a stable slot
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	const int32 SlotIndex = SlotTable.FindSlot(this, InAttributeData);
+	if (SlotIndex == INDEX_NONE)
+	{
+		return false;
+	}
 
-	uint32 PropertiesLeft = BPClass->NumReplicatedProperties;
-	for (TFieldIterator<FProperty> It(BPClass, EFieldIteratorFlags::ExcludeSuper); It && PropertiesLeft > 0; ++It)
+	const FMGAAttributeSlot& Slot = SlotTable.GetSlot(SlotIndex);
+	if (!Slot.bReplicated)
 	{
-		const FProperty* Prop = *It;
-		if (Prop != nullptr && Prop->GetPropertyFlags() & CPF_Net)
-		{
-			PropertiesLeft--;
+		return false;
+	}
 
-			// Ignore any props that are not valid GameplayAttributeData or one of its child struct
-			if (!FGameplayAttribute::IsGameplayAttributeDataProperty(Prop))
-			{
-				continue;
-			}
+	OutPropertyName = Slot.Property->GetAuthoredName();
+	MGA_LOG(Verbose, TEXT("\t\t Found matching property for AuthoredName: %s"), *OutPropertyName)
+	return true;
+}
 
-			if (const FGameplayAttributeData* DataPtr = Prop->ContainerPtrToValuePtr<FGameplayAttributeData>(this))
-			{
-				if (DataPtr == &InAttributeData)
-				{
-					FString AuthoredName = Prop->GetAuthoredName();
-					MGA_LOG(Verbose, TEXT("\t\t Found matching property for AuthoredName: %s"), *AuthoredName)
-					OutPropertyName = MoveTemp(AuthoredName);
-					return true;
-				}
-			}
-		}
+void UModularAttributeSetBase::HandleRepNotifyForSlot(const int32 InSlotIndex)
+{
+	const FMGAAttributeSlotTable& SlotTable = GetAttributeSlotTable();
+	if (!SlotTable.IsValidSlot(InSlotIndex))
+	{
+		MGA_LOG(
+			Warning,
+			TEXT("UModularAttributeSetBase::HandleRepNotifyForSlot - Invalid slot %d for %s"),
+			InSlotIndex,
+			*GetNameSafe(GetClass())
+		)
+		return;
 	}
-	
-	return false;
+
+	const FMGAAttributeSlot& Slot = SlotTable.GetSlot(InSlotIndex);
+	const FGameplayAttributeData* AttributeData = Slot.GetData(this);
+
+	// Old attribute data was stored in PreNetReceive, that should contain the value right before receiving the net update
+	const FGameplayAttributeData* OldAttributeDataPtr = AttributeDataRepSlots.IsValidIndex(InSlotIndex) ? &AttributeDataRepSlots[InSlotIndex] : nullptr;
+	if (!ensureMsgf(OldAttributeDataPtr, TEXT("Was unable to determine old attribute data for property: %s"), *Slot.Attribute.GetName()))
+	{
+		MGA_LOG(Error, TEXT("UModularAttributeSetBase::HandleRepNotifyForSlot - Was unable to determine old attribute data for property: %s"), *Slot.Attribute.GetName())
+	}
+
+	UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (!ASC)
+	{
+		return;
+	}
+
+	const FGameplayAttributeData OldAttributeData = OldAttributeDataPtr != nullptr ? *OldAttributeDataPtr : FGameplayAttributeData();
+	ASC->SetBaseAttributeValueFromReplication(Slot.Attribute, *AttributeData, OldAttributeData);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -57,6 +57,11 @@ void FModularAbilitySet_GrantedHandles::TakeFromAbilitySystem(UModularAbilitySys
 		ModularASC->RemoveSpawnedAttribute(Set);
 	}
 
+	if (!GrantedAttributeSets.IsEmpty())
+	{
+		ModularASC->ResetAttributeAccessors();
+	}
+
 	AbilitySpecHandles.Reset();
 	GameplayEffectHandles.Reset();
 	GrantedAttributeSets.Reset();
@@ -84,7 +89,7 @@ void UModularAbilitySet::GiveToAbilitySystem(UModularAbilitySystemComponent* Mod
 
 		if (!IsValid(AbilityToGrant.Ability))
 		{
-			UE_LOG(LogModularGameplayAbilities, Error, TEXT("GrantedGameplayAbilities[%d] on ability set [%s] is not valid."), AbilityIndex, *GetNameSafe(this));
+			MGA_LOG(Error, TEXT("GrantedGameplayAbilities[%d] on ability set [%s] is not valid."), AbilityIndex, *GetNameSafe(this))
 			continue;
 		}
 
@@ -109,7 +114,7 @@ void UModularAbilitySet::GiveToAbilitySystem(UModularAbilitySystemComponent* Mod
 
 		if (!IsValid(EffectToGrant.GameplayEffect))
 		{
-			UE_LOG(LogModularGameplayAbilities, Error, TEXT("GrantedGameplayEffects[%d] on ability set [%s] is not valid"), EffectIndex, *GetNameSafe(this));
+			MGA_LOG(Error, TEXT("GrantedGameplayEffects[%d] on ability set [%s] is not valid"), EffectIndex, *GetNameSafe(this))
 			continue;
 		}
 
@@ -129,7 +134,7 @@ void UModularAbilitySet::GiveToAbilitySystem(UModularAbilitySystemComponent* Mod
 
 		if (!IsValid(SetToGrant.AttributeSet))
 		{
-			UE_LOG(LogModularGameplayAbilities, Error, TEXT("GrantedAttributes[%d] on ability set [%s] is not valid"), SetIndex, *GetNameSafe(this));
+			MGA_LOG(Error, TEXT("GrantedAttributes[%d] on ability set [%s] is not valid"), SetIndex, *GetNameSafe(this))
 			continue;
 		}
 
@@ -143,6 +148,7 @@ void UModularAbilitySet::GiveToAbilitySystem(UModularAbilitySystemComponent* Mod
 		}
 		
 		ModularASC->AddAttributeSetSubobject(NewSet);
+		ModularASC->ResetAttributeAccessors();
 
 		if (OutGrantedHandles)
 		{
@@ -159,7 +159,7 @@ void UModularGameplayAbility::SetCanBeCanceled(bool bCanBeCanceled)
 	// The ability can not block canceling if it's replaceable.
 	if (!bCanBeCanceled && (ActivationGroup == EModularAbilityActivationGroup::Exclusive_Replaceable))
 	{
-		UE_LOG(LogModularGameplayAbilities, Error, TEXT("SetCanBeCanceled: Ability [%s] can not block canceling because its activation group is replaceable."), *GetName());
+		MGA_LOG(Error, TEXT("SetCanBeCanceled: Ability [%s] can not block canceling because its activation group is replaceable."), *GetName())
 		return;
 	}
 
@@ -0,0 +1,102 @@
+// Copyright Halcyonyx Studios.
+
+#include "GameplayAbilities/ModularGameplayAbilityTargetData.h"
+
+#include "Engine/NetSerialization.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModularGameplayAbilityTargetData)
+
+namespace MGA::TargetData
+{
+	enum ECompactHitFlags : uint8
+	{
+		BlockingHit = 1 << 0,
+		HasImpactPoint = 1 << 1,
+		HasImpactNormal = 1 << 2,
+
+		NumBits = 3
+	};
+}
+
+FGameplayAbilityTargetDataHandle FModularGameplayAbilityTargetData_CompactHit::MakeHandle(const TArray<FHitResult>& InHitResults)
+{
+	FGameplayAbilityTargetDataHandle Handle;
+	for (const FHitResult& HitResult : InHitResults)
+	{
+		Handle.Add(new FModularGameplayAbilityTargetData_CompactHit(HitResult));
+	}
+
+	return Handle;
+}
+
+TArray<TWeakObjectPtr<AActor>> FModularGameplayAbilityTargetData_CompactHit::GetActors() const
+{
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	if (AActor* HitActor = HitResult.HitObjectHandle.FetchActor())
+	{
+		Actors.Add(HitActor);
+	}
+
+	return Actors;
+}
+
+bool FModularGameplayAbilityTargetData_CompactHit::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace MGA::TargetData;
+
+	FVector_NetQuantize10 Location = HitResult.Location;
+	FVector_NetQuantize10 ImpactPoint = HitResult.ImpactPoint;
+	FVector_NetQuantize10 TraceStart = HitResult.TraceStart;
+	FVector_NetQuantizeNormal Normal = HitResult.Normal;
+	FVector_NetQuantizeNormal ImpactNormal = HitResult.ImpactNormal;
+
+	uint8 Flags = 0;
+	if (Ar.IsSaving())
+	{
+		Flags |= HitResult.bBlockingHit ? BlockingHit : 0;
+		Flags |= !HitResult.ImpactPoint.Equals(HitResult.Location, 0.1) ? HasImpactPoint : 0;
+		Flags |= !HitResult.ImpactNormal.Equals(HitResult.Normal, UE_KINDA_SMALL_NUMBER) ? HasImpactNormal : 0;
+	}
+
+	Ar.SerializeBits(&Flags, NumBits);
+
+	Ar << HitResult.HitObjectHandle;
+
+	bOutSuccess = true;
+	bool bSuccess = true;
+
+	Location.NetSerialize(Ar, Map, bSuccess);
+	bOutSuccess &= bSuccess;
+
+	TraceStart.NetSerialize(Ar, Map, bSuccess);
+	bOutSuccess &= bSuccess;
+
+	Normal.NetSerialize(Ar, Map, bSuccess);
+	bOutSuccess &= bSuccess;
+
+	if (Flags & HasImpactPoint)
+	{
+		ImpactPoint.NetSerialize(Ar, Map, bSuccess);
+		bOutSuccess &= bSuccess;
+	}
+
+	if (Flags & HasImpactNormal)
+	{
+		ImpactNormal.NetSerialize(Ar, Map, bSuccess);
+		bOutSuccess &= bSuccess;
+	}
+
+	if (Ar.IsLoading())
+	{
+		HitResult.bBlockingHit = (Flags & BlockingHit) != 0;
+		HitResult.Location = Location;
+		HitResult.TraceStart = TraceStart;
+		HitResult.TraceEnd = Location;
+		HitResult.Normal = Normal;
+		HitResult.ImpactPoint = (Flags & HasImpactPoint) ? FVector(ImpactPoint) : HitResult.Location;
+		HitResult.ImpactNormal = (Flags & HasImpactNormal) ? FVector(ImpactNormal) : HitResult.Normal;
+		HitResult.Distance = FVector::Dist(HitResult.TraceStart, HitResult.Location);
+	}
+
+	return true;
+}
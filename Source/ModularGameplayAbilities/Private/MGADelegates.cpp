@@ -8,4 +8,5 @@ FMGADelegates::FMGAOnVariableRenamed FMGADelegates::OnVariableRenamed;
 FMGADelegates::FMGAOnVariableTypeChanged FMGADelegates::OnVariableTypeChanged;
 FMGADelegates::FMGAOnPreCompile FMGADelegates::OnPreCompile;
 FMGADelegates::FMGAOnPostCompile FMGADelegates::OnPostCompile;
+FMGADelegates::FMGAOnAttributeSetLayoutChanged FMGADelegates::OnAttributeSetLayoutChanged;
 FMGADelegates::FMGAOnRequestDetailsRefresh FMGADelegates::OnRequestDetailsRefresh;
@@ -6,6 +6,7 @@
 #include "DataAsset/ModularAbilityPawnData.h"
 #include "GameplayAbilities/ModularAbilitySet.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ModularAbilityPlayerState)
 
@@ -39,6 +40,99 @@ void AModularAbilityPlayerState::PostInitializeComponents()
 	// @Game-Change delete CallOrRegister_OnExperienceLoaded section, logic moved to ACorePlayerState::RegisterToExperienceLoadedToSetPawnData()
 }
 
+void AModularAbilityPlayerState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bAdaptiveNetUpdateFrequency && HasAuthority())
+	{
+		RegisterAdaptiveNetUpdate();
+	}
+}
+
+void AModularAbilityPlayerState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterAdaptiveNetUpdate();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AModularAbilityPlayerState::RegisterAdaptiveNetUpdate()
+{
+	check(ModularAbilitySystemComponent);
+
+	// Effect add and remove are reported through OnAbilitySystemActivity as well
+	ModularAbilitySystemComponent->OnAbilitySystemActivity.AddUObject(this, &ThisClass::HandleAbilitySystemActivity);
+
+	// Start as active, decaying down from there
+	HandleAbilitySystemActivity(EModularAbilitySystemActivity::AttributeChange);
+}
+
+void AModularAbilityPlayerState::UnregisterAdaptiveNetUpdate()
+{
+	if (ModularAbilitySystemComponent)
+	{
+		ModularAbilitySystemComponent->OnAbilitySystemActivity.RemoveAll(this);
+	}
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(AdaptiveNetUpdateTimerHandle);
+	}
+}
+
+void AModularAbilityPlayerState::HandleAbilitySystemActivity(const EModularAbilitySystemActivity Activity)
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	LastAbilitySystemActivityTime = World->GetTimeSeconds();
+
+	if (GetNetUpdateFrequency() != MaxAdaptiveNetUpdateFrequency)
+	{
+		SetNetUpdateFrequency(MaxAdaptiveNetUpdateFrequency);
+		NetPriority = MaxAdaptiveNetPriority;
+	}
+
+	if (EnumHasAnyFlags(static_cast<EModularAbilitySystemActivity>(ForceNetUpdateActivities), Activity))
+	{
+		ForceNetUpdate();
+	}
+
+	if (!World->GetTimerManager().IsTimerActive(AdaptiveNetUpdateTimerHandle))
+	{
+		// Decay doesn't need to be smooth, a few steps per second is enough
+		World->GetTimerManager().SetTimer(AdaptiveNetUpdateTimerHandle, this, &ThisClass::UpdateAdaptiveNetUpdateFrequency, 0.25f, true);
+	}
+}
+
+void AModularAbilityPlayerState::UpdateAdaptiveNetUpdateFrequency()
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	const double IdleTime = World->GetTimeSeconds() - LastAbilitySystemActivityTime - AdaptiveIdleDelay;
+	if (IdleTime <= 0.0)
+	{
+		return;
+	}
+
+	const float Alpha = AdaptiveDecayDuration > 0.f ? FMath::Clamp(static_cast<float>(IdleTime / AdaptiveDecayDuration), 0.f, 1.f) : 1.f;
+	SetNetUpdateFrequency(FMath::Lerp(MaxAdaptiveNetUpdateFrequency, MinAdaptiveNetUpdateFrequency, Alpha));
+	NetPriority = FMath::Lerp(MaxAdaptiveNetPriority, MinAdaptiveNetPriority, Alpha);
+
+	if (Alpha >= 1.f)
+	{
+		World->GetTimerManager().ClearTimer(AdaptiveNetUpdateTimerHandle);
+	}
+}
+
 void AModularAbilityPlayerState::SetPawnData(const UModularPawnData* InPawnData)
 {
 	Super::SetPawnData(InPawnData);
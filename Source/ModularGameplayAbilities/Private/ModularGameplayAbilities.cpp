@@ -2,17 +2,59 @@
 
 #include "ModularGameplayAbilities.h"
 
+#include "Attributes/MGAAttributeHandle.h"
+#include "Attributes/MGAAttributeSlotTable.h"
+#include "Attributes/MGAClampDependencyGraph.h"
+#include "Attributes/MGAPackedAttributes.h"
+#include "MGADelegates.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+#include "Attributes/MGAAttributeSetValidationCache.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "FModularGameplayAbilitiesModule"
 
 void FModularGameplayAbilitiesModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Assign attribute handles to native Attribute Sets upfront, Blueprint ones are registered lazily
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([]()
+	{
+		FMGAAttributeRegistry::Get().RegisterNativeClasses();
+	});
+
+	FMGADelegates::OnAttributeSetLayoutChanged.AddRaw(&FMGAAttributeRegistry::Get(), &FMGAAttributeRegistry::HandleAttributeSetLayoutChanged);
+	ClampDependencyGraphInvalidationHandle = FMGADelegates::OnAttributeSetLayoutChanged.AddStatic(&FMGAClampDependencyGraph::Invalidate);
+	PackedAttributeLayoutInvalidationHandle = FMGADelegates::OnAttributeSetLayoutChanged.AddStatic(&FMGAPackedAttributeLayout::Invalidate);
+
+	// Recompiled Blueprint classes keep their UClass, drop per-class caches built from the previous property layout
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		FMGAAttributeSlotTable::Invalidate();
+	});
+
+#if WITH_EDITOR
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddStatic(&FMGAAttributeSlotTable::InvalidateReinstancedClasses);
+#endif
 }
 
 void FModularGameplayAbilitiesModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FMGADelegates::OnAttributeSetLayoutChanged.RemoveAll(&FMGAAttributeRegistry::Get());
+	FMGADelegates::OnAttributeSetLayoutChanged.Remove(ClampDependencyGraphInvalidationHandle);
+	FMGADelegates::OnAttributeSetLayoutChanged.Remove(PackedAttributeLayoutInvalidationHandle);
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+	FMGAAttributeSetValidationCache::Get().Save();
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
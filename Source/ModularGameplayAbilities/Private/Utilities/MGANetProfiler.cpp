@@ -0,0 +1,466 @@
+// Copyright Halcyonyx Studios.
+
+#include "Utilities/MGANetProfiler.h"
+
+#if MGA_WITH_NET_PROFILER
+
+#include "AbilitySystemComponent.h"
+#include "Attributes/MGAAttributeSlotTable.h"
+#include "Attributes/ModularAttributeSetBase.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "Net/UnrealNetwork.h"
+
+namespace MGA::NetProfiler
+{
+	static bool bEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("MGA.NetProfiler.Enabled"),
+		bEnabled,
+		TEXT("Whether bytes replicated by Modular Ability System Components are accounted per attribute, attribute set, effect class and RPC."),
+		ECVF_Default
+	);
+
+	/** Estimated size of a changed attribute: current and base float values, plus the property handle */
+	static constexpr int64 AttributeBits = 2 * 32 + 8;
+
+	/** Estimated size of a changed active effect, besides modifiers and dynamic tags: handle, definition, level, duration, period, start times, prediction key */
+	static constexpr int64 EffectBaseBits = 32 * 8;
+
+	/** Estimated size of a removed active effect (fast array delete) */
+	static constexpr int64 EffectRemovedBits = 32;
+
+	/** Estimated size of a replicated gameplay tag (net index) */
+	static constexpr int64 TagBits = 16;
+
+	/** Estimated size of an object reference (net GUID) */
+	static constexpr int64 ObjectBits = 32;
+
+	static FAutoConsoleCommandWithOutputDevice DumpCommand(
+		TEXT("MGA.NetProfiler.Dump"),
+		TEXT("Logs bytes replicated by Modular Ability System Components per attribute, attribute set, effect class and RPC."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			FMGANetProfiler::Get().Dump(Ar);
+		})
+	);
+
+	static FAutoConsoleCommand ExportCommand(
+		TEXT("MGA.NetProfiler.ExportCSV"),
+		TEXT("Writes bytes replicated by Modular Ability System Components to a CSV file. Usage: MGA.NetProfiler.ExportCSV [FilePath]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+		{
+			const FString FilePath = InArgs.Num() > 0
+				? InArgs[0]
+				: FPaths::ProfilingDir() / TEXT("MGA") / FString::Printf(TEXT("NetProfile-%s.csv"), *FDateTime::Now().ToString());
+
+			if (FMGANetProfiler::Get().ExportCSV(FilePath))
+			{
+				MGA_LOG(Display, TEXT("MGA.NetProfiler.ExportCSV - Wrote %s"), *FilePath)
+			}
+			else
+			{
+				MGA_LOG(Error, TEXT("MGA.NetProfiler.ExportCSV - Failed to write %s"), *FilePath)
+			}
+		})
+	);
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("MGA.NetProfiler.Reset"),
+		TEXT("Clears bytes replicated by Modular Ability System Components."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FMGANetProfiler::Get().Reset();
+		})
+	);
+
+	static FName GetAttributeEntryName(const UAttributeSet* InAttributeSet, const FGameplayAttribute& InAttribute)
+	{
+		return FName(*FString::Printf(TEXT("%s.%s"), *InAttributeSet->GetClass()->GetName(), *InAttribute.GetName()));
+	}
+
+	/** Returns how many connections a change of a property replicated with InCondition is sent to, past its initial replication */
+	static int32 GetNumConnectionsForCondition(const ELifetimeCondition InCondition, const int32 InNumConnections, const int32 InNumOwnerConnections)
+	{
+		switch (InCondition)
+		{
+		case COND_Never:
+		case COND_InitialOnly:
+			return 0;
+		case COND_OwnerOnly:
+		case COND_AutonomousOnly:
+		case COND_InitialOrOwner:
+		case COND_ReplayOrOwner:
+			return InNumOwnerConnections;
+		case COND_SkipOwner:
+		case COND_SimulatedOnly:
+		case COND_SimulatedOnlyNoReplay:
+		case COND_SimulatedOrPhysics:
+		case COND_SimulatedOrPhysicsNoReplay:
+			return InNumConnections - InNumOwnerConnections;
+		default:
+			return InNumConnections;
+		}
+	}
+}
+
+FMGANetProfiler& FMGANetProfiler::Get()
+{
+	static FMGANetProfiler Instance;
+	return Instance;
+}
+
+bool FMGANetProfiler::IsEnabled()
+{
+	return MGA::NetProfiler::bEnabled;
+}
+
+const TCHAR* FMGANetProfiler::LexToString(const EMGANetProfilerCategory InCategory)
+{
+	switch (InCategory)
+	{
+	case EMGANetProfilerCategory::Attribute:
+		return TEXT("Attribute");
+	case EMGANetProfilerCategory::AttributeSet:
+		return TEXT("AttributeSet");
+	case EMGANetProfilerCategory::Effect:
+		return TEXT("Effect");
+	case EMGANetProfilerCategory::RPC:
+		return TEXT("RPC");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+void FMGANetProfiler::Record(const EMGANetProfilerCategory InCategory, const FName InName, const int64 InNumBits, const bool bInEstimated, const int32 InNumSends)
+{
+	check(IsInGameThread());
+
+	if (InNumSends <= 0)
+	{
+		return;
+	}
+
+	FEntryStats& EntryStats = (bInEstimated ? EstimatedStats : MeasuredStats)[static_cast<uint8>(InCategory)].FindOrAdd(InName);
+	EntryStats.NumBits += InNumBits * InNumSends;
+	EntryStats.NumUpdates += InNumSends;
+}
+
+void FMGANetProfiler::RecordAttribute(const UAttributeSet* InAttributeSet, const FGameplayAttribute& InAttribute, const int64 InNumBits, const bool bInEstimated, const int32 InNumSends)
+{
+	if (!InAttributeSet)
+	{
+		return;
+	}
+
+	Record(EMGANetProfilerCategory::Attribute, MGA::NetProfiler::GetAttributeEntryName(InAttributeSet, InAttribute), InNumBits, bInEstimated, InNumSends);
+	Record(EMGANetProfilerCategory::AttributeSet, InAttributeSet->GetClass()->GetFName(), InNumBits, bInEstimated, InNumSends);
+}
+
+void FMGANetProfiler::RecordAttributeSet(const UAttributeSet* InAttributeSet, const int64 InNumBits, const bool bInEstimated)
+{
+	if (InAttributeSet)
+	{
+		Record(EMGANetProfilerCategory::AttributeSet, InAttributeSet->GetClass()->GetFName(), InNumBits, bInEstimated, 1);
+	}
+}
+
+void FMGANetProfiler::RecordRPC(const FName InFunctionName, const int64 InNumBits, const bool bInEstimated, const int32 InNumSends)
+{
+	Record(EMGANetProfilerCategory::RPC, InFunctionName, InNumBits, bInEstimated, InNumSends);
+}
+
+FMGANetProfiler::FConnectionFanOut FMGANetProfiler::GetConnectionFanOut(const UAbilitySystemComponent* InAbilitySystemComponent)
+{
+	FConnectionFanOut FanOut;
+
+	AActor* Owner = InAbilitySystemComponent->GetOwner();
+	const UNetDriver* NetDriver = Owner ? Owner->GetNetDriver() : nullptr;
+	if (!NetDriver)
+	{
+		return FanOut;
+	}
+
+	const UNetConnection* OwnerConnection = Owner->GetNetConnection();
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		// Only connections the owner actor has a channel open on receive its properties
+		if (!Connection || !Connection->FindActorChannelRef(Owner))
+		{
+			continue;
+		}
+
+		FanOut.NumConnections++;
+		if (Connection == OwnerConnection)
+		{
+			FanOut.NumOwnerConnections++;
+		}
+	}
+
+	return FanOut;
+}
+
+void FMGANetProfiler::NotifyPreReplication(const UAbilitySystemComponent* InAbilitySystemComponent, const EGameplayEffectReplicationMode InEffectReplicationMode)
+{
+	if (!InAbilitySystemComponent)
+	{
+		return;
+	}
+
+	const FConnectionFanOut FanOut = GetConnectionFanOut(InAbilitySystemComponent);
+	if (FanOut.NumConnections == 0)
+	{
+		return;
+	}
+
+	for (const UAttributeSet* AttributeSet : InAbilitySystemComponent->GetSpawnedAttributes())
+	{
+		AccountAttributeSet(AttributeSet, FanOut);
+	}
+
+	// Mixed mode only replicates active effects to the owner, simulated proxies get minimal cues and tags
+	switch (InEffectReplicationMode)
+	{
+	case EGameplayEffectReplicationMode::Full:
+		AccountEffects(InAbilitySystemComponent, FanOut.NumConnections);
+		break;
+	case EGameplayEffectReplicationMode::Mixed:
+		AccountEffects(InAbilitySystemComponent, FanOut.NumOwnerConnections);
+		break;
+	default:
+		break;
+	}
+}
+
+const TArray<int32>& FMGANetProfiler::GetReplicatedSlotFanOut(const UAttributeSet* InAttributeSet, const FConnectionFanOut& InFanOut)
+{
+	UClass* Class = InAttributeSet->GetClass();
+	const TSharedRef<const FMGAAttributeSlotTable> SlotTable = FMGAAttributeSlotTable::Get(Class);
+	const TArray<int32>& ReplicatedSlots = SlotTable->GetReplicatedSlots();
+
+	// Conditions include replication rules of modular sets, applied in GetLifetimeReplicatedProps()
+	TArray<uint8>& Conditions = ReplicatedSlotConditions.FindOrAdd(Class);
+	if (Conditions.Num() != ReplicatedSlots.Num())
+	{
+		Conditions.Init(COND_None, ReplicatedSlots.Num());
+
+		TArray<FLifetimeProperty> LifetimeProps;
+		Class->GetDefaultObject()->GetLifetimeReplicatedProps(LifetimeProps);
+		for (const FLifetimeProperty& LifetimeProp : LifetimeProps)
+		{
+			const FProperty* Property = Class->ClassReps.IsValidIndex(LifetimeProp.RepIndex) ? Class->ClassReps[LifetimeProp.RepIndex].Property : nullptr;
+			const int32 Index = ReplicatedSlots.IndexOfByPredicate([SlotTable, Property](const int32 SlotIndex)
+			{
+				return SlotTable->GetSlot(SlotIndex).Property == Property;
+			});
+
+			if (Index != INDEX_NONE)
+			{
+				Conditions[Index] = static_cast<uint8>(LifetimeProp.Condition);
+			}
+		}
+	}
+
+	ReplicatedSlotFanOut.SetNumUninitialized(Conditions.Num());
+	for (int32 Index = 0; Index < Conditions.Num(); ++Index)
+	{
+		ReplicatedSlotFanOut[Index] = MGA::NetProfiler::GetNumConnectionsForCondition(static_cast<ELifetimeCondition>(Conditions[Index]), InFanOut.NumConnections, InFanOut.NumOwnerConnections);
+	}
+
+	return ReplicatedSlotFanOut;
+}
+
+void FMGANetProfiler::AccountAttributeSet(const UAttributeSet* InAttributeSet, const FConnectionFanOut& InFanOut)
+{
+	if (!InAttributeSet)
+	{
+		return;
+	}
+
+	// Packed attributes account for the exact bits they write, see FMGAPackedAttributes::NetDeltaSerialize()
+	const UModularAttributeSetBase* ModularAttributeSet = Cast<UModularAttributeSetBase>(InAttributeSet);
+	if (ModularAttributeSet && ModularAttributeSet->bUsePackedReplication)
+	{
+		return;
+	}
+
+	const TSharedRef<const FMGAAttributeSlotTable> SlotTable = FMGAAttributeSlotTable::Get(InAttributeSet->GetClass());
+	const TArray<int32>& ReplicatedSlots = SlotTable->GetReplicatedSlots();
+
+	const TArray<int32>& SlotFanOut = GetReplicatedSlotFanOut(InAttributeSet, InFanOut);
+
+	TArray<float>& Snapshot = AttributeSnapshots.FindOrAdd(InAttributeSet);
+	const bool bInitialState = Snapshot.Num() != ReplicatedSlots.Num() * 2;
+	if (bInitialState)
+	{
+		Snapshot.SetNumZeroed(ReplicatedSlots.Num() * 2);
+	}
+
+	for (int32 Index = 0; Index < ReplicatedSlots.Num(); ++Index)
+	{
+		const FMGAAttributeSlot& Slot = SlotTable->GetSlot(ReplicatedSlots[Index]);
+		const FGameplayAttributeData* Data = Slot.GetData(InAttributeSet);
+
+		const float CurrentValue = Data->GetCurrentValue();
+		const float BaseValue = Data->GetBaseValue();
+		if (!bInitialState && Snapshot[Index * 2] == CurrentValue && Snapshot[Index * 2 + 1] == BaseValue)
+		{
+			continue;
+		}
+
+		Snapshot[Index * 2] = CurrentValue;
+		Snapshot[Index * 2 + 1] = BaseValue;
+
+		RecordAttribute(InAttributeSet, Slot.Attribute, MGA::NetProfiler::AttributeBits, true, SlotFanOut[Index]);
+	}
+}
+
+void FMGANetProfiler::AccountEffects(const UAbilitySystemComponent* InAbilitySystemComponent, const int32 InNumConnections)
+{
+	using namespace MGA::NetProfiler;
+
+	TMap<int32, int32>& Snapshot = EffectSnapshots.FindOrAdd(InAbilitySystemComponent);
+
+	TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<16>> ReplicatedIds;
+	for (auto It = InAbilitySystemComponent->GetActiveGameplayEffects().CreateConstIterator(); It; ++It)
+	{
+		const FActiveGameplayEffect& ActiveEffect = *It;
+		ReplicatedIds.Add(ActiveEffect.ReplicationID);
+
+		const int32* LastReplicationKey = Snapshot.Find(ActiveEffect.ReplicationID);
+		if (LastReplicationKey && *LastReplicationKey == ActiveEffect.ReplicationKey)
+		{
+			continue;
+		}
+
+		Snapshot.Add(ActiveEffect.ReplicationID, ActiveEffect.ReplicationKey);
+
+		const FGameplayEffectSpec& Spec = ActiveEffect.Spec;
+		const int64 NumBits = EffectBaseBits + Spec.Modifiers.Num() * 32 + Spec.DynamicGrantedTags.Num() * TagBits;
+		Record(EMGANetProfilerCategory::Effect, Spec.Def ? Spec.Def->GetClass()->GetFName() : NAME_None, NumBits, true, InNumConnections);
+	}
+
+	for (auto It = Snapshot.CreateIterator(); It; ++It)
+	{
+		if (!ReplicatedIds.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+			Record(EMGANetProfilerCategory::Effect, TEXT("(Removed)"), EffectRemovedBits, true, InNumConnections);
+		}
+	}
+}
+
+void FMGANetProfiler::NotifyEndPlay(const UAbilitySystemComponent* InAbilitySystemComponent)
+{
+	if (!InAbilitySystemComponent)
+	{
+		return;
+	}
+
+	EffectSnapshots.Remove(InAbilitySystemComponent);
+	for (const UAttributeSet* AttributeSet : InAbilitySystemComponent->GetSpawnedAttributes())
+	{
+		AttributeSnapshots.Remove(AttributeSet);
+	}
+}
+
+void FMGANetProfiler::Reset()
+{
+	for (TMap<FName, FEntryStats>& CategoryStats : MeasuredStats)
+	{
+		CategoryStats.Reset();
+	}
+
+	for (TMap<FName, FEntryStats>& CategoryStats : EstimatedStats)
+	{
+		CategoryStats.Reset();
+	}
+
+	AttributeSnapshots.Reset();
+	EffectSnapshots.Reset();
+}
+
+TArray<TPair<FName, FMGANetProfiler::FEntryStats>> FMGANetProfiler::GetSortedStats(const EMGANetProfilerCategory InCategory, const bool bInEstimated) const
+{
+	TArray<TPair<FName, FEntryStats>> SortedStats = GetStats(InCategory, bInEstimated).Array();
+	SortedStats.Sort([](const TPair<FName, FEntryStats>& A, const TPair<FName, FEntryStats>& B)
+	{
+		return A.Value.NumBits > B.Value.NumBits;
+	});
+
+	return SortedStats;
+}
+
+void FMGANetProfiler::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Net profiler%s, measured and estimated sizes are reported separately"), IsEnabled() ? TEXT("") : TEXT(" (disabled, see MGA.NetProfiler.Enabled)"));
+
+	for (const bool bEstimated : { false, true })
+	{
+		for (uint8 Category = 0; Category < static_cast<uint8>(EMGANetProfilerCategory::Num); ++Category)
+		{
+			const EMGANetProfilerCategory CategoryEnum = static_cast<EMGANetProfilerCategory>(Category);
+			const TArray<TPair<FName, FEntryStats>> SortedStats = GetSortedStats(CategoryEnum, bEstimated);
+			if (SortedStats.IsEmpty())
+			{
+				continue;
+			}
+
+			int64 TotalBits = 0;
+			for (const TPair<FName, FEntryStats>& Pair : SortedStats)
+			{
+				TotalBits += Pair.Value.NumBits;
+			}
+
+			Ar.Logf(TEXT("%s (%s): %d entries, %lld bytes"), LexToString(CategoryEnum), bEstimated ? TEXT("estimated") : TEXT("measured"), SortedStats.Num(), (TotalBits + 7) / 8);
+			Ar.Logf(TEXT("  %-64s %10s %12s %10s"), TEXT("Name"), TEXT("Sends"), TEXT("Bytes"), TEXT("Bytes/send"));
+
+			for (const TPair<FName, FEntryStats>& Pair : SortedStats)
+			{
+				const FEntryStats& EntryStats = Pair.Value;
+				Ar.Logf(
+					TEXT("  %-64s %10d %12lld %10.1f"),
+					*Pair.Key.ToString(),
+					EntryStats.NumUpdates,
+					EntryStats.GetNumBytes(),
+					EntryStats.NumUpdates > 0 ? EntryStats.NumBits / 8.0 / EntryStats.NumUpdates : 0.0
+				);
+			}
+		}
+	}
+}
+
+bool FMGANetProfiler::ExportCSV(const FString& InFilePath) const
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Category,Name,Sends,Bytes,BytesPerSend,Estimated"));
+
+	for (const bool bEstimated : { false, true })
+	{
+		for (uint8 Category = 0; Category < static_cast<uint8>(EMGANetProfilerCategory::Num); ++Category)
+		{
+			const EMGANetProfilerCategory CategoryEnum = static_cast<EMGANetProfilerCategory>(Category);
+			for (const TPair<FName, FEntryStats>& Pair : GetSortedStats(CategoryEnum, bEstimated))
+			{
+				const FEntryStats& EntryStats = Pair.Value;
+				Lines.Add(FString::Printf(
+					TEXT("%s,%s,%d,%lld,%.2f,%d"),
+					LexToString(CategoryEnum),
+					*Pair.Key.ToString(),
+					EntryStats.NumUpdates,
+					EntryStats.GetNumBytes(),
+					EntryStats.NumUpdates > 0 ? EntryStats.NumBits / 8.0 / EntryStats.NumUpdates : 0.0,
+					bEstimated ? 1 : 0
+				));
+			}
+		}
+	}
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *InFilePath);
+}
+
+#endif
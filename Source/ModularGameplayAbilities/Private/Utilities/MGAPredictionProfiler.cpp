@@ -0,0 +1,290 @@
+// Copyright Halcyonyx Studios.
+
+#include "Utilities/MGAPredictionProfiler.h"
+
+#if MGA_WITH_PREDICTION_PROFILER
+
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+
+namespace MGA::PredictionProfiler
+{
+	static bool bEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("MGA.PredictionProfiler.Enabled"),
+		bEnabled,
+		TEXT("Whether locally predicted ability activations are tracked until confirmed or rejected by the server."),
+		ECVF_Default
+	);
+
+	static float RejectGraceSeconds = 1.f;
+	static FAutoConsoleVariableRef CVarRejectGraceSeconds(
+		TEXT("MGA.PredictionProfiler.RejectGraceSeconds"),
+		RejectGraceSeconds,
+		TEXT("Seconds a caught up prediction key may still be rejected by the server before its activation is counted as confirmed."),
+		ECVF_Default
+	);
+
+	/** Activations still pending after this many seconds are assumed lost (eg. disconnected) and dropped */
+	static constexpr double PendingTimeout = 30.0;
+
+	/** Interval of ResolveCaughtUpActivations() while activations are pending */
+	static constexpr float ResolveInterval = 0.25f;
+
+	static FAutoConsoleCommandWithOutputDevice DumpCommand(
+		TEXT("MGA.PredictionProfiler.Dump"),
+		TEXT("Logs prediction stats (reject rate, confirmation latency, rolled back effects) of predicted ability activations."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			FMGAPredictionProfiler::Get().Dump(Ar);
+		})
+	);
+
+	static FAutoConsoleCommand ExportCommand(
+		TEXT("MGA.PredictionProfiler.ExportCSV"),
+		TEXT("Writes prediction stats of predicted ability activations to a CSV file. Usage: MGA.PredictionProfiler.ExportCSV [FilePath]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+		{
+			const FString FilePath = InArgs.Num() > 0
+				? InArgs[0]
+				: FPaths::ProfilingDir() / TEXT("MGA") / FString::Printf(TEXT("PredictionProfile-%s.csv"), *FDateTime::Now().ToString());
+
+			if (FMGAPredictionProfiler::Get().ExportCSV(FilePath))
+			{
+				MGA_LOG(Display, TEXT("MGA.PredictionProfiler.ExportCSV - Wrote %s"), *FilePath)
+			}
+			else
+			{
+				MGA_LOG(Error, TEXT("MGA.PredictionProfiler.ExportCSV - Failed to write %s"), *FilePath)
+			}
+		})
+	);
+
+	static FAutoConsoleCommand ResetCommand(
+		TEXT("MGA.PredictionProfiler.Reset"),
+		TEXT("Clears prediction stats of predicted ability activations."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FMGAPredictionProfiler::Get().Reset();
+		})
+	);
+}
+
+void FMGAPredictionProfiler::FAbilityStats::AddLatencySample(const float InLatencyMs)
+{
+	if (LatencySamples.Num() < MaxLatencySamples)
+	{
+		LatencySamples.Add(InLatencyMs);
+		return;
+	}
+
+	LatencySamples[NextLatencySample] = InLatencyMs;
+	NextLatencySample = (NextLatencySample + 1) % MaxLatencySamples;
+}
+
+float FMGAPredictionProfiler::FAbilityStats::GetLatencyPercentile(const float InPercentile) const
+{
+	if (LatencySamples.IsEmpty())
+	{
+		return 0.f;
+	}
+
+	TArray<float> SortedSamples = LatencySamples;
+	SortedSamples.Sort();
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(InPercentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+	return SortedSamples[Index];
+}
+
+FMGAPredictionProfiler& FMGAPredictionProfiler::Get()
+{
+	static FMGAPredictionProfiler Instance;
+	return Instance;
+}
+
+bool FMGAPredictionProfiler::IsEnabled()
+{
+	return MGA::PredictionProfiler::bEnabled;
+}
+
+void FMGAPredictionProfiler::NotifyPredictedActivation(const UAbilitySystemComponent* InAbilitySystemComponent, const UGameplayAbility* InAbility, const FPredictionKey& InPredictionKey)
+{
+	check(IsInGameThread());
+
+	if (!InAbility || !InPredictionKey.IsValidKey())
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (auto It = PendingActivations.CreateIterator(); It; ++It)
+	{
+		if (Now - It.Value().StartTime > MGA::PredictionProfiler::PendingTimeout)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const FName AbilityName = InAbility->GetClass()->GetFName();
+	Stats.FindOrAdd(AbilityName).NumActivations++;
+
+	const FKeyId KeyId(InAbilitySystemComponent, InPredictionKey.Current);
+	FPendingActivation& Pending = PendingActivations.Add(KeyId);
+	Pending.AbilityName = AbilityName;
+	Pending.StartTime = Now;
+
+	// Delegates are fired once and removed by the prediction system. Rejected keys catch up too, a rejection resolves the
+	// activation whenever it comes while catching up only resolves it after the grace period, see ResolveCaughtUpActivations()
+	FPredictionKey PredictionKey = InPredictionKey;
+	PredictionKey.NewRejectedDelegate().BindLambda([KeyId]()
+	{
+		Get().HandleKeyRejected(KeyId);
+	});
+	PredictionKey.NewCaughtUpDelegate().BindLambda([KeyId]()
+	{
+		Get().HandleKeyCaughtUp(KeyId);
+	});
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMGAPredictionProfiler::Tick), MGA::PredictionProfiler::ResolveInterval);
+	}
+}
+
+void FMGAPredictionProfiler::NotifyPredictedEffect(const UAbilitySystemComponent* InAbilitySystemComponent, const FPredictionKey& InPredictionKey)
+{
+	// Effects predicted in a later prediction window of the ability use a dependent key, based on the activation one
+	FPendingActivation* Pending = PendingActivations.Find(FKeyId(InAbilitySystemComponent, InPredictionKey.Current));
+	if (!Pending && InPredictionKey.Base != 0)
+	{
+		Pending = PendingActivations.Find(FKeyId(InAbilitySystemComponent, InPredictionKey.Base));
+	}
+
+	if (Pending)
+	{
+		Pending->NumPredictedEffects++;
+	}
+}
+
+void FMGAPredictionProfiler::HandleKeyCaughtUp(const FKeyId InKeyId)
+{
+	FPendingActivation* Pending = PendingActivations.Find(InKeyId);
+	if (Pending && Pending->CaughtUpTime == 0.0)
+	{
+		Pending->CaughtUpTime = FPlatformTime::Seconds();
+	}
+}
+
+void FMGAPredictionProfiler::ResolveCaughtUpActivations()
+{
+	check(IsInGameThread());
+
+	const double Now = FPlatformTime::Seconds();
+	for (auto It = PendingActivations.CreateIterator(); It; ++It)
+	{
+		const FPendingActivation& Pending = It.Value();
+		if (Pending.CaughtUpTime == 0.0 || Now - Pending.CaughtUpTime < MGA::PredictionProfiler::RejectGraceSeconds)
+		{
+			continue;
+		}
+
+		FAbilityStats& AbilityStats = Stats.FindOrAdd(Pending.AbilityName);
+		AbilityStats.NumConfirmed++;
+		AbilityStats.AddLatencySample(static_cast<float>((Pending.CaughtUpTime - Pending.StartTime) * 1000.0));
+		It.RemoveCurrent();
+	}
+}
+
+bool FMGAPredictionProfiler::Tick(float InDeltaTime)
+{
+	ResolveCaughtUpActivations();
+
+	// Added again by the next tracked activation
+	if (PendingActivations.IsEmpty())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FMGAPredictionProfiler::HandleKeyRejected(const FKeyId InKeyId)
+{
+	FPendingActivation Pending;
+	if (!PendingActivations.RemoveAndCopyValue(InKeyId, Pending))
+	{
+		return;
+	}
+
+	FAbilityStats& AbilityStats = Stats.FindOrAdd(Pending.AbilityName);
+	AbilityStats.NumRejected++;
+	AbilityStats.NumRolledBackEffects += Pending.NumPredictedEffects;
+}
+
+void FMGAPredictionProfiler::Reset()
+{
+	PendingActivations.Reset();
+	Stats.Reset();
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+void FMGAPredictionProfiler::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Prediction profiler: %d abilities, %d pending activations%s"), Stats.Num(), PendingActivations.Num(), IsEnabled() ? TEXT("") : TEXT(" (disabled, see MGA.PredictionProfiler.Enabled)"));
+	Ar.Logf(TEXT("%-48s %8s %8s %8s %8s %8s %8s %8s %10s"), TEXT("Ability"), TEXT("Activ."), TEXT("Confirm"), TEXT("Reject"), TEXT("Reject%"), TEXT("p50 ms"), TEXT("p90 ms"), TEXT("p99 ms"), TEXT("Rollbacks"));
+
+	for (const TPair<FName, FAbilityStats>& Pair : Stats)
+	{
+		const FAbilityStats& AbilityStats = Pair.Value;
+		Ar.Logf(
+			TEXT("%-48s %8d %8d %8d %7.1f%% %8.1f %8.1f %8.1f %10d"),
+			*Pair.Key.ToString(),
+			AbilityStats.NumActivations,
+			AbilityStats.NumConfirmed,
+			AbilityStats.NumRejected,
+			AbilityStats.GetRejectRate() * 100.f,
+			AbilityStats.GetLatencyPercentile(0.5f),
+			AbilityStats.GetLatencyPercentile(0.9f),
+			AbilityStats.GetLatencyPercentile(0.99f),
+			AbilityStats.NumRolledBackEffects
+		);
+	}
+}
+
+bool FMGAPredictionProfiler::ExportCSV(const FString& InFilePath) const
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Stats.Num() + 1);
+	Lines.Add(TEXT("Ability,Activations,Confirmed,Rejected,RejectRate,LatencyP50Ms,LatencyP90Ms,LatencyP99Ms,RolledBackEffects"));
+
+	for (const TPair<FName, FAbilityStats>& Pair : Stats)
+	{
+		const FAbilityStats& AbilityStats = Pair.Value;
+		Lines.Add(FString::Printf(
+			TEXT("%s,%d,%d,%d,%.4f,%.2f,%.2f,%.2f,%d"),
+			*Pair.Key.ToString(),
+			AbilityStats.NumActivations,
+			AbilityStats.NumConfirmed,
+			AbilityStats.NumRejected,
+			AbilityStats.GetRejectRate(),
+			AbilityStats.GetLatencyPercentile(0.5f),
+			AbilityStats.GetLatencyPercentile(0.9f),
+			AbilityStats.GetLatencyPercentile(0.99f),
+			AbilityStats.NumRolledBackEffects
+		));
+	}
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *InFilePath);
+}
+
+#endif
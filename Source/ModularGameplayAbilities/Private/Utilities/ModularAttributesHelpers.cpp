@@ -25,6 +25,31 @@ bool UModularAttributesHelpers::NotEqual_GameplayAttributeGameplayAttribute(cons
 	return A.GetName() != B;
 }
 
+bool UModularAttributesHelpers::NotEqual_GameplayAttributeAttributePath(const FGameplayAttribute& A, const FName B)
+{
+	return FMGAAttributeHandle::FromAttribute(A) != FMGAAttributeRegistry::Get().FindHandleByPath(B);
+}
+
+FMGAAttributeHandle UModularAttributesHelpers::Conv_GameplayAttributeToAttributeHandle(const FGameplayAttribute& InAttribute)
+{
+	return FMGAAttributeHandle::FromAttribute(InAttribute);
+}
+
+FGameplayAttribute UModularAttributesHelpers::Conv_AttributeHandleToGameplayAttribute(const FMGAAttributeHandle& InHandle)
+{
+	return InHandle.GetAttribute();
+}
+
+bool UModularAttributesHelpers::EqualEqual_AttributeHandle(const FMGAAttributeHandle& A, const FMGAAttributeHandle& B)
+{
+	return A == B;
+}
+
+bool UModularAttributesHelpers::NotEqual_AttributeHandle(const FMGAAttributeHandle& A, const FMGAAttributeHandle& B)
+{
+	return A != B;
+}
+
 FText UModularAttributesHelpers::GetAttributeDisplayNameText(const FGameplayAttribute& InAttribute)
 {
 	return FText::FromString(InAttribute.GetName());
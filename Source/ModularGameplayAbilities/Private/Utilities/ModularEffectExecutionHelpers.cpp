@@ -52,7 +52,7 @@ bool UModularEffectExecutionHelpers::AttemptCalculateCapturedAttributeMagnitude(
 
 	if (!FoundCapture)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("Unable to retrieve a valid Capture Definition from passed in RelevantAttributesToCapture and Attribute: %s"), *InAttribute.GetName())
+		MGA_LOG(Warning, TEXT("Unable to retrieve a valid Capture Definition from passed in RelevantAttributesToCapture and Attribute: %s"), *InAttribute.GetName())
 		return false;
 	}
 
@@ -75,7 +75,7 @@ bool UModularEffectExecutionHelpers::AttemptCalculateCapturedAttributeMagnitudeW
 
 	if (!FoundCapture)
 	{
-		UE_LOG(LogModularGameplayAbilities, Warning, TEXT("Unable to retrieve a valid Capture Definition from passed in RelevantAttributesToCapture and Attribute: %s"), *InAttribute.GetName())
+		MGA_LOG(Warning, TEXT("Unable to retrieve a valid Capture Definition from passed in RelevantAttributesToCapture and Attribute: %s"), *InAttribute.GetName())
 		return false;
 	}
 
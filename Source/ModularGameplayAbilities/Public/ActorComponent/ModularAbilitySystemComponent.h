@@ -4,8 +4,12 @@
 
 #include "GameplayAbilities/ModularGameplayAbility.h"
 #include "AbilitySystemComponent.h"
+#include "Attributes/MGAAttributeAccessor.h"
+#include "Attributes/MGAAttributeHandle.h"
+#include "Engine/EngineBaseTypes.h"
 #include "GameplayEffectExtension.h"
 #include "NativeGameplayTags.h"
+#include "UObject/ObjectKey.h"
 
 #include "ModularAbilitySystemComponent.generated.h"
 
@@ -37,8 +41,136 @@ struct FModularGameplayEffectExecuteData
 	float DeltaValue = 0.f;
 };
 
+/* Coalesced change of a single Attribute, from the first write to the last one within a frame */
+USTRUCT(BlueprintType)
+struct FModularAttributeChangeBatchEntry
+{
+	GENERATED_BODY()
+
+	/* The Attribute that was changed */
+	UPROPERTY(BlueprintReadOnly, Category = AttributeChange)
+	FGameplayAttribute Attribute;
+
+	/* Value before the first change of the frame */
+	UPROPERTY(BlueprintReadOnly, Category = AttributeChange)
+	float OldValue = 0.f;
+
+	/* Value after the last change of the frame */
+	UPROPERTY(BlueprintReadOnly, Category = AttributeChange)
+	float NewValue = 0.f;
+
+	/* Source tags of all the changes that were coalesced */
+	UPROPERTY(BlueprintReadOnly, Category = AttributeChange)
+	FGameplayTagContainer EventTags;
+};
+
+/* Coalesced PreAttributeChange, keeping the last proposed value within a frame */
+struct FModularPreAttributeChangeBatchEntry
+{
+	TWeakObjectPtr<UAttributeSet> AttributeSet;
+	FGameplayAttribute Attribute;
+	float NewValue = 0.f;
+};
+
+/* Entry of UModularAbilitySystemComponent::ReplicatedTargetDataKeys, a key of the engine replicated target data map */
+struct FModularReplicatedTargetDataEntry
+{
+	FGameplayAbilitySpecHandleAndPredictionKey Key;
+	double ReceivedTime = 0.0;
+};
+
+/* Ability activation failure sent to the owning client, see UModularAbilitySystemComponent::ClientNotifyAbilityFailures */
+USTRUCT()
+struct FModularAbilityFailureBatchEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<const UGameplayAbility> Ability = nullptr;
+
+	UPROPERTY()
+	FGameplayTagContainer FailureReason;
+};
+
+/* Identity of an ability failure for deduplication: the ability and all of its failure tags, regardless of their order */
+struct FModularAbilityFailureKey
+{
+	TObjectKey<UGameplayAbility> Ability;
+	FGameplayTagContainer FailureReason;
+
+	FModularAbilityFailureKey(const UGameplayAbility* InAbility, const FGameplayTagContainer& InFailureReason)
+		: Ability(InAbility)
+		, FailureReason(InFailureReason)
+	{
+	}
+
+	bool operator==(const FModularAbilityFailureKey& Other) const
+	{
+		return Ability == Other.Ability && FailureReason.Num() == Other.FailureReason.Num() && FailureReason.HasAllExact(Other.FailureReason);
+	}
+
+	friend uint32 GetTypeHash(const FModularAbilityFailureKey& InKey)
+	{
+		/* Order independent, containers with the same tags added in another order are the same failure. */
+		uint32 TagsHash = 0;
+		for (const FGameplayTag& Tag : InKey.FailureReason)
+		{
+			TagsHash += GetTypeHash(Tag);
+		}
+
+		return HashCombineFast(GetTypeHash(InKey.Ability), TagsHash);
+	}
+};
+
+class UModularAbilitySystemComponent;
+
+/* Tick function flushing coalesced attribute changes of an Ability System Component, only enabled while changes are pending */
+USTRUCT()
+struct FModularAttributeChangeFlushTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UModularAbilitySystemComponent* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FModularAttributeChangeFlushTickFunction> : public TStructOpsTypeTraitsBase2<FModularAttributeChangeFlushTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/*
+* Kinds of state change reported by UModularAbilitySystemComponent::OnAbilitySystemActivity.
+*
+* A single activity is reported at a time, values are flags so that sets of activities can be stored as a mask (see
+* AModularAbilityPlayerState::ForceNetUpdateActivities).
+*/
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EModularAbilitySystemActivity : uint8
+{
+	None = 0 UMETA(Hidden),
+	AttributeChange = 1 << 0,
+	EffectAdded = 1 << 1,
+	EffectRemoved = 1 << 2,
+	TagChange = 1 << 3,
+	AbilityActivated = 1 << 4,
+	AbilityGiven = 1 << 5,
+	AbilityRemoved = 1 << 6,
+	AbilityFailed = 1 << 7,
+};
+ENUM_CLASS_FLAGS(EModularAbilitySystemActivity)
+
 /* State Delegates */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FModularOnInitAbilityActorInfo);
+DECLARE_MULTICAST_DELEGATE_OneParam(FModularOnAbilitySystemActivity, EModularAbilitySystemActivity);
+DECLARE_DELEGATE_RetVal_OneParam(bool, FModularCanEnterAutoDormancy, const UModularAbilitySystemComponent*);
 
 /* Ability Delegates */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FModularOnAbilityActivate, const UGameplayAbility*, Ability);
@@ -52,6 +184,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FModularOnCooldownEnd, UGameplayAbi
 /* Attribute Delegates */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FModularOnPreAttributeChange, UAttributeSet*, AttributeSet, FGameplayAttribute, Attribute, float, NewValue);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FModularOnAttributeChange, FGameplayAttribute, Attribute, float, DeltaValue, const struct FGameplayTagContainer, EventTags);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FModularOnAttributeChangeBatch, const TArray<FModularAttributeChangeBatchEntry>&, Changes);
 
 /* Effect Delegates */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FModularOnPreGameplayEffectExecute, FGameplayAttribute, Attribute, AActor*, SourceActor, AActor*, TargetActor, const FGameplayTagContainer&, SourceTags, const FModularGameplayEffectExecuteData, Payload);
@@ -89,6 +222,8 @@ public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void BeginDestroy() override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+	virtual void PostNetReceive() override;
 	//~End of UActorComponent interface
 
 	/* Handle Delegates */
@@ -117,7 +252,12 @@ public:
 	/* Removes all active instances of the gameplay effect that was used to add the specified dynamic granted tag. */
 	void RemoveDynamicTagGameplayEffect(const FGameplayTag& Tag);
 
-	/* Gets the ability target data associated with the given ability handle and activation info. */
+	/*
+	* Gets the ability target data associated with the given ability handle and activation info.
+	*
+	* On the server, replicated target data is bounded by MaxReplicatedTargetData and ReplicatedTargetDataLifetime, see
+	* ServerSetReplicatedTargetData_Implementation().
+	*/
 	void GetAbilityTargetData(const FGameplayAbilitySpecHandle AbilityHandle, FGameplayAbilityActivationInfo ActivationInfo, FGameplayAbilityTargetDataHandle& OutTargetDataHandle);
 
 	/* Sets the current tag relationship mapping, if null it will clear it out. */
@@ -148,6 +288,21 @@ public:
 	FModularOnInitAbilityActorInfo OnInitAbilityActorInfo;
 	virtual void InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor) override;
 
+	/* Native only, called whenever state that may need replicating changes (attribute values, tags, effects, abilities given, removed, activated or failed). */
+	FModularOnAbilitySystemActivity OnAbilitySystemActivity;
+
+	/*
+	* Native only, bound by owners with replicated state of their own (movement, other components) to veto auto dormancy,
+	* see bAutoDormancy. Owners vetoing it have to call WakeFromAutoDormancy() themselves when their own state changes.
+	*/
+	FModularCanEnterAutoDormancy CanEnterAutoDormancy;
+
+	/* Records a replicated state change, waking the owner up if it was put to dormancy by this component. */
+	void WakeFromAutoDormancy();
+
+	/* Broadcasts OnAbilitySystemActivity, also called by Modular Attribute Sets on attribute changes. */
+	void NotifyAbilitySystemActivity(EModularAbilitySystemActivity Activity);
+
 	
 	/* Ability Delegates */
 	
@@ -227,6 +382,23 @@ public:
 	/* Generic Attribute change callback. */
 	virtual void HandleOnAttributeChange(const FOnAttributeChangeData& Data);
 
+	/*
+	* Called once per frame with every Attribute changed during that frame, when bCoalesceAttributeChanges is enabled.
+	*
+	* OnAttributeChange and OnPreAttributeChange are still broadcast during the flush, once per Attribute.
+	*
+	* @param Changes The coalesced changes, with the value before the first change and after the last one
+	*/
+	UPROPERTY(BlueprintAssignable, Category="ModularAbilitySystem|Attribute")
+	FModularOnAttributeChangeBatch OnAttributeChangeBatch;
+
+	/* Broadcasts all pending coalesced attribute changes right away. */
+	UFUNCTION(BlueprintCallable, Category = "ModularAbilitySystem|Attribute")
+	void FlushAttributeChanges();
+
+	/* Returns whether attribute change notifications are currently coalesced (enabled and flush tick function registered). */
+	bool IsCoalescingAttributeChanges() const;
+
 	
 	/* Effect Delegates */
 	
@@ -287,6 +459,43 @@ public:
 	/* Returns current (final) value of an attribute. */
 	UFUNCTION(BlueprintCallable, Category = "ModularAbilitySystem|Attribute")
 	virtual float GetAttributeCurrentValue(FGameplayAttribute Attribute) const;
+
+	/*
+	* Resolves a direct accessor for the given attribute, for callers to keep and pass to RefreshAttributeAccessor() before
+	* each use. The accessor is invalid if the attribute set is not granted or if the attribute is not a FGameplayAttributeData.
+	*/
+	FMGAAttributeAccessor ResolveAttributeAccessor(const FGameplayAttribute& Attribute) const;
+
+	/*
+	* Resolves InOutAccessor again if attribute sets were granted or removed since it was resolved (see
+	* ResetAttributeAccessors()) or its attribute set was destroyed, then returns whether it is valid.
+	* A serial compare and a weak pointer check otherwise.
+	*/
+	FORCEINLINE bool RefreshAttributeAccessor(FMGAAttributeAccessor& InOutAccessor) const
+	{
+		if (InOutAccessor.AttributeSetsSerial == AttributeSetsSerial && !InOutAccessor.IsStale())
+		{
+			return InOutAccessor.AttributeSet != nullptr;
+		}
+
+		InOutAccessor = ResolveAttributeAccessor(InOutAccessor.Attribute);
+		return InOutAccessor.IsValid();
+	}
+
+	/*
+	* Returns the accessor kept by this component for the given attribute, brought up to date with RefreshAttributeAccessor().
+	* For callers that can't keep their own, costs a map lookup on top.
+	*/
+	const FMGAAttributeAccessor& FindAttributeAccessor(const FGameplayAttribute& Attribute) const;
+
+	/*
+	* Invalidates every resolved attribute accessor, to call whenever attribute sets are granted or removed (done by
+	* UModularAbilitySet, and on clients when replicated attribute sets change).
+	*/
+	void ResetAttributeAccessors();
+
+	/* Returns the handle of an attribute, resolved by its spawned attribute set when it's a modular one (no registry lookup). */
+	FMGAAttributeHandle GetAttributeHandle(const FGameplayAttribute& Attribute, const UAttributeSet* AttributeSet = nullptr) const;
 	
 	/*
 	* Grants the Actor with the given ability, making it available for activation
@@ -358,6 +567,9 @@ public:
 	*/
 	UFUNCTION(BlueprintCallable, Category = "ModularAbilitySystem|Attribute")
 	virtual void AdjustAttributeForMaxChange(UPARAM(ref) UAttributeSet* AttributeSet, const FGameplayAttribute AffectedAttributeProperty, const FGameplayAttribute MaxAttribute, float NewMaxValue);
+
+	/* Public like the base class one, records effects predicted by ability activations for the prediction profiler. */
+	virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey = FPredictionKey()) override;
 	
 protected:
 
@@ -369,6 +581,10 @@ protected:
 	virtual void NotifyAbilityActivated(
 		const FGameplayAbilitySpecHandle Handle,
 		UGameplayAbility* Ability) override;
+	virtual void OnTagUpdated(const FGameplayTag& Tag, bool TagExists) override;
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void ServerSetReplicatedTargetData_Implementation(FGameplayAbilitySpecHandle AbilityHandle, FPredictionKey AbilityOriginalPredictionKey, const FGameplayAbilityTargetDataHandle& ReplicatedTargetDataHandle, FGameplayTag ApplicationTag, FPredictionKey CurrentPredictionKey) override;
 	virtual void NotifyAbilityFailed(
 		const FGameplayAbilitySpecHandle Handle,
 		UGameplayAbility* Ability,
@@ -389,17 +605,86 @@ protected:
 		UGameplayAbility* RequestingAbility,
 		bool bCanBeCanceled) override;
 
-	/* Notify client that an ability failed to activate. */
-	UFUNCTION(Client, Unreliable)
+	/*
+	* Notify client that an ability failed to activate.
+	*
+	* Deprecated: failures are no longer sent one by one, but batched through ClientNotifyAbilityFailures(). Kept for
+	* subclasses still calling it, it presents the failure the same way.
+	*/
+	UFUNCTION(Client, Unreliable, meta = (DeprecatedFunction, DeprecationMessage = "Use QueueAbilityFailure() instead, failures are batched through ClientNotifyAbilityFailures()."))
 	void ClientNotifyAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
 
+	/* Notify client of the ability failures aggregated during the last frame, see QueueAbilityFailure(). */
+	UFUNCTION(Client, Reliable)
+	void ClientNotifyAbilityFailures(const TArray<FModularAbilityFailureBatchEntry>& Failures);
+
+	/* Queues a failure to be sent to the owning client at the end of the frame, dropped if already sent within AbilityFailureWindow. */
+	void QueueAbilityFailure(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
+
+	/* Sends failures queued with QueueAbilityFailure(), called from a next tick timer once the first failure of a frame is queued. */
+	void FlushAbilityFailures();
+
+	/* Presents the failure through the ability, throttled to one presentation per ability and failure tags within AbilityFailureWindow. */
 	void HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
 
+	/* Returns whether the (Ability, FailureReason) pair was already seen within AbilityFailureWindow, recording it otherwise. All failure tags are compared. */
+	bool IsAbilityFailureThrottled(TMap<FModularAbilityFailureKey, double>& InOutLastTimes, const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason) const;
+
 public:
 	/* List of GameplayEffects to apply when the Ability System Component is initialized (typically on begin play). */
 	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Effect")
 	TArray<TSubclassOf<UGameplayEffect>> GrantedEffects;
 
+	/*
+	* If set, OnAttributeChange and OnPreAttributeChange are no longer broadcast for every write. Changes are recorded
+	* per Attribute (value before the first write, value after the last one) and broadcast once per frame, along with
+	* OnAttributeChangeBatch.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Attribute")
+	bool bCoalesceAttributeChanges = false;
+
+	/* Tick group in which coalesced attribute changes are flushed. */
+	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Attribute", meta = (EditCondition = "bCoalesceAttributeChanges"))
+	TEnumAsByte<ETickingGroup> AttributeChangeFlushTickGroup = TG_PostUpdateWork;
+
+	/*
+	* Maximum number of replicated target data entries kept in AbilityTargetDataMap on the server. Oldest entries of abilities
+	* no longer active are evicted first, entries of active abilities are never evicted.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Ability", meta = (ClampMin = "1"))
+	int32 MaxReplicatedTargetData = 8;
+
+	/*
+	* Seconds after which replicated target data of an ability no longer active is evicted from AbilityTargetDataMap (eg. sent
+	* for an activation the server rejected, so never cleared by EndAbility()).
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Ability", meta = (ClampMin = "0"))
+	float ReplicatedTargetDataLifetime = 5.f;
+
+	/*
+	* Identical ability failures (same ability and failure tags) within this many seconds are only sent to the owning
+	* client and presented once. Zero disables deduplication.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Ability", meta = (ClampMin = "0"))
+	float AbilityFailureWindow = 0.5f;
+
+	/*
+	* If set, the owning actor is put to net dormancy (DORM_DormantAll) once this component is quiescent: no active
+	* abilities, no active effects with a duration or period, no pending attribute changes or ability failures and no
+	* activity for AutoDormancyDelay seconds. It is woken up on the next activity (see OnAbilitySystemActivity).
+	*
+	* Dormancy freezes replication of the whole owner, not only of this component. Only enable it on owners without
+	* replicated state of their own, or have the owner veto it with CanEnterAutoDormancy.
+	*
+	* Server only, intended for AI owned components. Owners set to DORM_Never are left alone.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Replication")
+	bool bAutoDormancy = false;
+
+	/* Seconds without activity before a quiescent component puts its owner to dormancy. */
+	UPROPERTY(EditDefaultsOnly, Category = "ModularAbilitySystem|Replication", meta = (EditCondition = "bAutoDormancy", ClampMin = "0"))
+	float AutoDormancyDelay = 5.f;
+
 protected:
 	/* If set, this table is used to look up tag relationships for activate and cancel. */
 	UPROPERTY()
@@ -423,6 +708,84 @@ protected:
 	
 	/* Called when Ability System Component is initialized. */
 	void GrantStartupEffects();
+
+	/* Tick function used to flush coalesced attribute changes. */
+	FModularAttributeChangeFlushTickFunction AttributeChangeFlushTickFunction;
+
+	/* Pending coalesced attribute changes, in order of first change. */
+	TArray<FModularAttributeChangeBatchEntry> PendingAttributeChanges;
+
+	/* Pending coalesced pre attribute changes, in order of first change. */
+	TArray<FModularPreAttributeChangeBatchEntry> PendingPreAttributeChanges;
+
+	/* Index in PendingAttributeChanges by Attribute. */
+	TMap<FMGAAttributeHandle, int32> PendingAttributeChangeIndices;
+
+	/* Index in PendingPreAttributeChanges by Attribute. */
+	TMap<FMGAAttributeHandle, int32> PendingPreAttributeChangeIndices;
+
+	/* Keys of replicated target data received by the server, oldest first, to bound AbilityTargetDataMap. */
+	TArray<FModularReplicatedTargetDataEntry> ReplicatedTargetDataKeys;
+
+	/* Evicts replicated target data of inactive abilities, older than ReplicatedTargetDataLifetime or beyond MaxReplicatedTargetData. */
+	void EvictReplicatedTargetData();
+
+	/* Timer checking for quiescence while awake, see bAutoDormancy. */
+	FTimerHandle AutoDormancyTimerHandle;
+
+	/* Effect delegates feeding OnAbilitySystemActivity, not bound to this object so that UnregisterDelegates() keeps them. */
+	FDelegateHandle ActivityEffectAddedHandle;
+	FDelegateHandle ActivityEffectRemovedHandle;
+
+	/* Value change delegates feeding OnAbilitySystemActivity for attributes of sets that aren't Modular Attribute Sets (those notify on their own). */
+	TMap<FGameplayAttribute, FDelegateHandle> ActivityAttributeHandles;
+
+	/* Last time replicated state of this component changed, in world seconds. */
+	double LastReplicatedStateChangeTime = 0.0;
+
+	/* Whether the owner was put to dormancy by this component. */
+	bool bIsAutoDormant = false;
+
+	void RegisterActivityDelegates();
+	void UnregisterActivityDelegates();
+
+	/* Binds ActivityAttributeHandles for attribute sets added since last call. */
+	void RegisterAttributeActivityDelegates();
+
+	void RegisterAutoDormancy();
+	void UnregisterAutoDormancy();
+
+	/* Puts the owner to dormancy if quiescent long enough, stops checking once dormant. */
+	void UpdateAutoDormancy();
+
+	/* Returns whether no ability, effect or attribute change is running or pending, and the owner doesn't veto dormancy. */
+	bool IsQuiescent() const;
+
+	/* Ability failures waiting for the end of the frame, see QueueAbilityFailure(). */
+	TArray<FModularAbilityFailureBatchEntry> PendingAbilityFailures;
+
+	/* Next tick timer sending PendingAbilityFailures, set while failures are pending. */
+	FTimerHandle AbilityFailureFlushTimerHandle;
+
+	/* Last time each (ability, failure tags) pair was sent to the owning client (server only). */
+	TMap<FModularAbilityFailureKey, double> LastSentAbilityFailureTimes;
+
+	/* Last time each (ability, failure tags) pair was presented locally. */
+	TMap<FModularAbilityFailureKey, double> LastPresentedAbilityFailureTimes;
+
+	/* Accessors kept for FindAttributeAccessor() callers. */
+	mutable TMap<FGameplayAttribute, FMGAAttributeAccessor> AttributeAccessors;
+
+	/* Bumped by ResetAttributeAccessors(), accessors resolved with an older serial are resolved again. */
+	uint32 AttributeSetsSerial = 1;
+
+	/* Spawned attribute sets accessors were last resolved against on clients, see PostNetReceive(). */
+	TArray<TObjectKey<UAttributeSet>> ReplicatedAttributeSets;
+
+	void RegisterAttributeChangeFlushTickFunction();
+	void UnregisterAttributeChangeFlushTickFunction();
+	void RequestAttributeChangeFlush();
+	void ResetPendingAttributeChanges();
 	
 private:
 	/* Array of active GE handle bound to delegates that will be fired when the count for the key tag changes to or away from zero */
@@ -0,0 +1,95 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+
+class UAbilitySystemComponent;
+
+/** Whether attribute accessors validate their Attribute Set on each access (development builds only) */
+#ifndef MGA_WITH_ATTRIBUTE_ACCESSOR_VALIDATION
+#define MGA_WITH_ATTRIBUTE_ACCESSOR_VALIDATION !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+#endif
+
+/**
+ * Direct accessor to a FGameplayAttributeData living in an Attribute Set instance.
+ *
+ * The owning set and the offset of the attribute data are resolved once, reading values afterward is a single pointer
+ * offset. Only FGameplayAttributeData based attributes are supported (Make() returns an invalid accessor otherwise).
+ *
+ * The accessor doesn't keep the Attribute Set alive, it holds a weak pointer to it so that an accessor to a destroyed set
+ * is reported as stale instead of reading freed memory.
+ *
+ * Accessors resolved by UModularAbilitySystemComponent::ResolveAttributeAccessor() are meant to be kept by callers, and
+ * brought up to date with UModularAbilitySystemComponent::RefreshAttributeAccessor() before use: it only re-resolves them
+ * once attribute sets were granted or removed since.
+ *
+ * Writes still go through UAbilitySystemComponent::SetNumericAttributeBase(), so that aggregators and attribute
+ * change callbacks stay in sync.
+ */
+struct MODULARGAMEPLAYABILITIES_API FMGAAttributeAccessor
+{
+	FMGAAttributeAccessor() = default;
+
+	/** Resolves an accessor for InAttribute in the given Attribute Set instance */
+	static FMGAAttributeAccessor Make(UAttributeSet* InAttributeSet, const FGameplayAttribute& InAttribute);
+
+	/** Resolves an accessor for InAttribute in the Attribute Set instance granted to the given Ability System Component */
+	static FMGAAttributeAccessor Make(const UAbilitySystemComponent* InAbilitySystemComponent, const FGameplayAttribute& InAttribute);
+
+	FORCEINLINE bool IsValid() const
+	{
+		return AttributeSet != nullptr && WeakAttributeSet.IsValid();
+	}
+
+	/** Returns whether the accessor was resolved to an Attribute Set that has since been destroyed */
+	FORCEINLINE bool IsStale() const
+	{
+		return AttributeSet != nullptr && !WeakAttributeSet.IsValid();
+	}
+
+	/** Returns the current (final) value of the attribute. Accessor must be valid. */
+	FORCEINLINE float GetCurrentValue() const
+	{
+		return GetData()->GetCurrentValue();
+	}
+
+	/** Returns the base value of the attribute. Accessor must be valid. */
+	FORCEINLINE float GetBaseValue() const
+	{
+		return GetData()->GetBaseValue();
+	}
+
+	/** Sets the base value of the attribute through the owning Ability System Component */
+	void SetBaseValue(float NewValue) const;
+
+	const FGameplayAttribute& GetAttribute() const
+	{
+		return Attribute;
+	}
+
+	UAttributeSet* GetAttributeSet() const
+	{
+		return AttributeSet;
+	}
+
+private:
+	friend class UModularAbilitySystemComponent;
+
+	FORCEINLINE const FGameplayAttributeData* GetData() const
+	{
+#if MGA_WITH_ATTRIBUTE_ACCESSOR_VALIDATION
+		checkf(IsValid(), TEXT("FMGAAttributeAccessor - Accessing %s from an invalid accessor"), *Attribute.GetName());
+#endif
+		return reinterpret_cast<const FGameplayAttributeData*>(reinterpret_cast<const uint8*>(AttributeSet) + Offset);
+	}
+
+	FGameplayAttribute Attribute;
+	UAttributeSet* AttributeSet = nullptr;
+	int32 Offset = INDEX_NONE;
+	TWeakObjectPtr<UAttributeSet> WeakAttributeSet;
+
+	/** Attribute sets serial of the Ability System Component when resolved, see UModularAbilitySystemComponent::RefreshAttributeAccessor() */
+	uint32 AttributeSetsSerial = 0;
+};
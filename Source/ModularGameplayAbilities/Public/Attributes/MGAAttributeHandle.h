@@ -0,0 +1,204 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include <atomic>
+#include "MGAAttributeHandle.generated.h"
+
+class FMGAAttributeSlotTable;
+
+/**
+ * Compact identity of a Gameplay Attribute: the index of its declaring Attribute Set class in FMGAAttributeRegistry,
+ * plus its slot index in that class FMGAAttributeSlotTable.
+ *
+ * Equality and hashing are integer operations, which makes it a cheap replacement for attribute name comparisons and
+ * string keyed maps in hot paths. Handles are runtime only and are not stable across sessions, don't serialize them.
+ */
+USTRUCT(BlueprintType)
+struct MODULARGAMEPLAYABILITIES_API FMGAAttributeHandle
+{
+	GENERATED_BODY()
+
+	FMGAAttributeHandle() = default;
+
+	FMGAAttributeHandle(const uint16 InClassIndex, const uint16 InSlotIndex)
+		: ClassIndex(InClassIndex)
+		, SlotIndex(InSlotIndex)
+	{
+	}
+
+	/** Returns the handle for the given Gameplay Attribute, registering its Attribute Set class if needed */
+	static FMGAAttributeHandle FromAttribute(const FGameplayAttribute& InAttribute);
+
+	/** Returns the handle for the given attribute data property, registering its Attribute Set class if needed */
+	static FMGAAttributeHandle FromProperty(const FProperty* InProperty);
+
+	/** Returns the Gameplay Attribute this handle was created from, or an invalid attribute if the handle is stale */
+	FGameplayAttribute GetAttribute() const;
+
+	bool IsValid() const
+	{
+		return ClassIndex != InvalidIndex && SlotIndex != InvalidIndex;
+	}
+
+	uint16 GetClassIndex() const
+	{
+		return ClassIndex;
+	}
+
+	uint16 GetSlotIndex() const
+	{
+		return SlotIndex;
+	}
+
+	/** Returns both indices packed in a single integer */
+	uint32 GetPackedValue() const
+	{
+		return (static_cast<uint32>(ClassIndex) << 16) | SlotIndex;
+	}
+
+	bool operator==(const FMGAAttributeHandle& Other) const
+	{
+		return GetPackedValue() == Other.GetPackedValue();
+	}
+
+	bool operator!=(const FMGAAttributeHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FMGAAttributeHandle& InHandle)
+	{
+		return InHandle.GetPackedValue();
+	}
+
+	FString ToString() const;
+
+	static constexpr uint16 InvalidIndex = MAX_uint16;
+
+private:
+	UPROPERTY(Transient)
+	uint16 ClassIndex = InvalidIndex;
+
+	UPROPERTY(Transient)
+	uint16 SlotIndex = InvalidIndex;
+};
+
+/**
+ * Global registry assigning a compact index to every Attribute Set class.
+ *
+ * Native classes are registered once the engine is initialized, Blueprint classes are registered lazily the first time
+ * one of their attributes is turned into a handle. A regenerated Blueprint class keeps the index of the class it replaces,
+ * and slot tables are refreshed when a class layout changes (slot indices of handles made before may then differ, resolve
+ * them again from their attribute).
+ *
+ * Lookups don't lock: registrations publish an immutable snapshot of the registry (classes, handles by property and by
+ * path), which readers access through an atomic pointer. Only registering a class, resolving a path for the first time
+ * or refreshing slot tables takes the lock and rebuilds the snapshot. Hot paths should still prefer handles resolved once
+ * and stored (see UModularAttributeSetBase::GetAttributeHandle()), a lookup is a map find.
+ */
+class MODULARGAMEPLAYABILITIES_API FMGAAttributeRegistry
+{
+public:
+	FMGAAttributeRegistry();
+	~FMGAAttributeRegistry();
+
+	static FMGAAttributeRegistry& Get();
+
+	/** Registers all native Attribute Set classes currently loaded */
+	void RegisterNativeClasses();
+
+	/** Returns the class index for the given Attribute Set class, registering it if needed. Returns InvalidIndex for non Attribute Set classes. */
+	uint16 FindOrRegisterClass(const UClass* InClass);
+
+	/** Returns the handle for the given attribute data property */
+	FMGAAttributeHandle FindOrAddHandle(const FProperty* InProperty);
+
+	/**
+	 * Returns the handle for an attribute identified by its property path name (eg. "/Script/Module.ClassName:AttributeName").
+	 *
+	 * Resolved paths are cached, so that subsequent lookups only hash the FName.
+	 */
+	FMGAAttributeHandle FindHandleByPath(FName InPropertyPath);
+
+	/** Returns the Gameplay Attribute for the given handle, or an invalid attribute if the handle is stale */
+	FGameplayAttribute GetAttribute(const FMGAAttributeHandle& InHandle) const;
+
+	/** Returns the Attribute Set class for the given class index, or nullptr if it is stale */
+	const UClass* GetClass(uint16 InClassIndex) const;
+
+	/** Returns the number of registered Attribute Set classes */
+	int32 NumClasses() const;
+
+	/** Refreshes the slot tables of InClass and its registered child classes (all classes if null), bound to FMGADelegates::OnAttributeSetLayoutChanged */
+	void HandleAttributeSetLayoutChanged(const UClass* InClass);
+
+private:
+	struct FClassEntry
+	{
+		TWeakObjectPtr<const UClass> Class;
+		FName ClassPath;
+		TSharedPtr<const FMGAAttributeSlotTable> SlotTable;
+	};
+
+	/** Immutable state read by lookups, rebuilt whenever the registry changes */
+	struct FSnapshot
+	{
+		TArray<FClassEntry> Classes;
+
+		/** Class index by class, the pointer is only used as a key */
+		TMap<const UClass*, uint16> ClassIndices;
+
+		/** Handles of the attribute data properties declared by registered classes */
+		TMap<const FProperty*, FMGAAttributeHandle> HandlesByProperty;
+
+		/** Resolved handles by property path name (also caches unresolved paths as invalid handles) */
+		TMap<FName, FMGAAttributeHandle> HandlesByPath;
+	};
+
+	/** Keeps the current snapshot alive for the scope, retired snapshots are only freed when no reader is active */
+	class FReadScope
+	{
+	public:
+		explicit FReadScope(const FMGAAttributeRegistry& InRegistry);
+		~FReadScope();
+
+		const FSnapshot& operator*() const
+		{
+			return *Snapshot;
+		}
+
+		const FSnapshot* operator->() const
+		{
+			return Snapshot;
+		}
+
+	private:
+		const FMGAAttributeRegistry& Registry;
+		const FSnapshot* Snapshot;
+	};
+
+	uint16 FindOrRegisterClass_Locked(const UClass* InClass);
+
+	/** Publishes a snapshot of the current state for readers, and frees retired snapshots if no reader may still use them */
+	void PublishSnapshot_Locked();
+
+	/** Guards the mutable state below, readers never take it */
+	FCriticalSection Lock;
+
+	TArray<FClassEntry> Classes;
+
+	/** Class index by class path name, used to reuse indices when a Blueprint class is regenerated */
+	TMap<FName, uint16> ClassIndicesByPath;
+
+	/** Resolved handles by property path name (also caches unresolved paths as invalid handles) */
+	TMap<FName, FMGAAttributeHandle> HandlesByPath;
+
+	/** Snapshots replaced by a newer one, waiting for readers to be done with them */
+	TArray<const FSnapshot*> RetiredSnapshots;
+
+	std::atomic<const FSnapshot*> CurrentSnapshot{nullptr};
+	mutable std::atomic<int32> NumReaders{0};
+};
@@ -4,8 +4,39 @@
 
 #include "CoreMinimal.h"
 #include "Engine/Blueprint.h"
+#include "Misc/EngineVersionComparison.h"
 #include "MGAAttributeSetBlueprint.generated.h"
 
+#if WITH_EDITOR
+/** Attribute declared by an Attribute Set Blueprint, as written to its asset registry tags */
+struct MODULARGAMEPLAYABILITIES_API FMGAAttributeSetBlueprintTagEntry
+{
+	/** Variable name of the attribute */
+	FName Name;
+
+	/** Category of the variable, as displayed in "My Blueprint" panel */
+	FString Category;
+
+	/** Keys of the variable metadata (eg. HideInDetailsView) */
+	TArray<FName> MetaDataKeys;
+
+	/** Name of the attribute data struct (eg. GameplayAttributeData, MGAClampedAttributeData) */
+	FName Type;
+
+	/** Whether the attribute is a FMGAClampedAttributeData with a min or max clamp definition */
+	bool bClamped = false;
+
+	/** Whether the variable is replicated */
+	bool bReplicated = false;
+
+	/** Replication condition of the variable (ELifetimeCondition), if replicated */
+	uint8 ReplicationCondition = 0;
+
+	/** Rep notify function of the variable, if any */
+	FName RepNotifyFunc;
+};
+#endif
+
 /**
  * A Modular Attribute Set is essentially a specialized Blueprint whose graphs control a GAS Attribute Set.
  * 
@@ -37,7 +68,37 @@ public:
 	
 	//~ Begin UObject interface
 	virtual void PostLoad() override;
+#if WITH_EDITOR
+#if UE_VERSION_NEWER_THAN(5, 4, -1)
+	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+#else
+	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+#endif
+#endif
 	//~ End of UObject interface
+
+#if WITH_EDITOR
+	/** Asset registry tag listing the attributes declared by this Blueprint, see ParseAttributesTag() */
+	static const FName AttributesTagName;
+
+	/** Asset registry tag with the number of attributes declared by this Blueprint (visible in Content Browser tooltips) */
+	static const FName NumAttributesTagName;
+
+	/** Asset registry tag set to "True" if the generated Attribute Set uses packed replication, see UModularAttributeSetBase::bUsePackedReplication */
+	static const FName PackedReplicationTagName;
+
+	/** Asset registry tag with UModularAttributeSetBase::GetReplicationValidationHash() of this Blueprint, see FMGAAttributeSetValidationCache */
+	static const FName ReplicationValidationHashTagName;
+
+	/** Returns the attributes declared by this Blueprint (not inherited ones), as written to AttributesTagName */
+	void GetDeclaredAttributes(TArray<FMGAAttributeSetBlueprintTagEntry>& OutAttributes) const;
+
+	/** Returns the value of AttributesTagName for the given attributes */
+	static FString MakeAttributesTag(const TArray<FMGAAttributeSetBlueprintTagEntry>& InAttributes);
+
+	/** Reads back attributes from a AttributesTagName value, without loading the Blueprint */
+	static void ParseAttributesTag(const FString& InTagValue, TArray<FMGAAttributeSetBlueprintTagEntry>& OutAttributes);
+#endif
 	
 #if WITH_EDITOR
 	void RegisterDelegates();
@@ -53,6 +114,11 @@ public:
 
 private:
 	
+#if WITH_EDITOR
+	/** Adds the tags declared above, shared by both GetAssetRegistryTags() signatures */
+	void GetAttributeSetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const;
+#endif
+
 #if WITH_EDITORONLY_DATA
 	TArray<FBPVariableDescription> LastNewVariables;
 	
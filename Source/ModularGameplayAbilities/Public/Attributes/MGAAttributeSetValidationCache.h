@@ -0,0 +1,69 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+#include "Hash/Blake3.h"
+#include "Misc/DataValidation.h"
+
+/** Result of UModularAttributeSetBase::IsDataValidReplication() for an Attribute Set Blueprint */
+struct FMGAAttributeSetValidationEntry
+{
+	/** Key of the Blueprint contents the result was computed from, see FMGAAttributeSetValidationCache::MakeKey() */
+	FBlake3Hash Key;
+
+	EDataValidationResult Result = EDataValidationResult::NotValidated;
+
+	TArray<FString> Errors;
+};
+
+/**
+ * Cache of Attribute Set Blueprint replication validation results, keyed by package name.
+ *
+ * Walking every rep notify graph is the expensive part of validating an Attribute Set Blueprint, results are reused as long
+ * as the content validation reads from the Blueprint and its parent Blueprints is unchanged (see
+ * UModularAttributeSetBase::GetReplicationValidationHash()), saved or not. Each Blueprint hash is also written to the asset
+ * registry, so that the MGAValidateAttributeSets commandlet computes keys without loading the Blueprints.
+ *
+ * Thread safe, so that keys can be looked up from worker threads. Persisted in the project Intermediate folder, and
+ * discarded whenever the validation rules version changes.
+ */
+class MODULARGAMEPLAYABILITIES_API FMGAAttributeSetValidationCache
+{
+public:
+	static FMGAAttributeSetValidationCache& Get();
+
+	/** Finds the cached result of InPackageName if it was computed with the same key, never for a zero key */
+	bool Find(const FName& InPackageName, const FBlake3Hash& InKey, FMGAAttributeSetValidationEntry& OutEntry) const;
+
+	void Add(const FName& InPackageName, FMGAAttributeSetValidationEntry&& InEntry);
+
+	/** Removes all cached results */
+	void Reset();
+
+	/** Writes the cache to disk if it changed since it was loaded */
+	void Save();
+
+	/**
+	 * Returns the key of a result depending on InBlueprintHashes (a Blueprint, then its parent Blueprints, see
+	 * UModularAttributeSetBase::GetReplicationValidationHash()) and the validation rules version. Zero if any hash is.
+	 */
+	static FBlake3Hash MakeKey(TConstArrayView<FBlake3Hash> InBlueprintHashes);
+
+private:
+	FMGAAttributeSetValidationCache();
+
+	static FString GetCacheFilePath();
+
+	void Load();
+
+	mutable FRWLock Lock;
+
+	TMap<FName, FMGAAttributeSetValidationEntry> Entries;
+
+	/** Whether entries were added or removed since the cache was loaded or saved */
+	bool bDirty = false;
+};
+#endif
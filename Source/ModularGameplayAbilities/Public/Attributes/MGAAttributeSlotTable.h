@@ -0,0 +1,219 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <atomic>
+
+class UAttributeSet;
+
+/**
+ * Hashable identity of a FGameplayAttributeData member variable.
+ *
+ * FGameplayAttributeData doesn't implement GetTypeHash() or equality operators, but the address of the data relative to
+ * its owning Attribute Set is stable for a given class layout. The key pairs the class declaring the property with
+ * that offset, which makes it usable as a map key (eg. from Blueprint rep notifies, where only the data is passed in).
+ */
+struct MODULARGAMEPLAYABILITIES_API FMGAAttributeDataKey
+{
+	/** Class the attribute data property is declared in */
+	const UClass* OwnerClass = nullptr;
+
+	/** Offset of the attribute data within the owning Attribute Set, in bytes */
+	int32 Offset = INDEX_NONE;
+
+	FMGAAttributeDataKey() = default;
+
+	FMGAAttributeDataKey(const UClass* InOwnerClass, const int32 InOffset)
+		: OwnerClass(InOwnerClass)
+		, Offset(InOffset)
+	{
+	}
+
+	/** Builds the key for a FGameplayAttributeData property */
+	static FMGAAttributeDataKey FromProperty(const FProperty* InProperty);
+
+	/** Builds the key for attribute data living in InOwnerSet memory. Returns an invalid key if the data is not part of the set. */
+	static FMGAAttributeDataKey FromAttributeData(const UAttributeSet* InOwnerSet, const FGameplayAttributeData& InAttributeData);
+
+	bool IsValid() const
+	{
+		return OwnerClass != nullptr && Offset != INDEX_NONE;
+	}
+
+	bool operator==(const FMGAAttributeDataKey& Other) const
+	{
+		return OwnerClass == Other.OwnerClass && Offset == Other.Offset;
+	}
+
+	bool operator!=(const FMGAAttributeDataKey& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FMGAAttributeDataKey& InKey)
+	{
+		return HashCombineFast(PointerHash(InKey.OwnerClass), ::GetTypeHash(InKey.Offset));
+	}
+};
+
+/** Resolved information about a single FGameplayAttributeData member of an Attribute Set class */
+struct MODULARGAMEPLAYABILITIES_API FMGAAttributeSlot
+{
+	/** The attribute data property (FGameplayAttributeData or one of its child struct) */
+	const FStructProperty* Property = nullptr;
+
+	/** Gameplay Attribute built from Property */
+	FGameplayAttribute Attribute;
+
+	/** Hashable identity of this slot */
+	FMGAAttributeDataKey Key;
+
+	/** Offset of the attribute data within the owning Attribute Set, in bytes */
+	int32 Offset = INDEX_NONE;
+
+	/** Whether the property is marked for replication */
+	bool bReplicated = false;
+
+	/** Returns the attribute data for this slot within InOwnerSet memory */
+	FORCEINLINE FGameplayAttributeData* GetData(UAttributeSet* InOwnerSet) const
+	{
+		return reinterpret_cast<FGameplayAttributeData*>(reinterpret_cast<uint8*>(InOwnerSet) + Offset);
+	}
+
+	/** Returns the attribute data for this slot within InOwnerSet memory */
+	FORCEINLINE const FGameplayAttributeData* GetData(const UAttributeSet* InOwnerSet) const
+	{
+		return reinterpret_cast<const FGameplayAttributeData*>(reinterpret_cast<const uint8*>(InOwnerSet) + Offset);
+	}
+};
+
+/**
+ * Per-class table of the FGameplayAttributeData member variables of an Attribute Set class.
+ *
+ * Built once per class layout (including inherited properties), it assigns each attribute data a stable slot index
+ * (slots are ordered by property offset) and resolves offset to slot with a single array access.
+ *
+ * Tables are immutable once built, and shared with whoever uses them. A Blueprint recompile regenerates the properties of
+ * the same UClass in place, so cached tables are invalidated when a class layout may have changed (Blueprint reinstancing,
+ * hot reload): the next Get() builds a new table, and tables already handed out are flagged stale instead of being freed.
+ * Code keeping a table around (eg. UModularAttributeSetBase::GetAttributeSlotTable()) must check IsStale() before using it.
+ */
+class MODULARGAMEPLAYABILITIES_API FMGAAttributeSlotTable
+{
+public:
+	/** Returns the slot table for the given Attribute Set class, building it on first use */
+	static TSharedRef<const FMGAAttributeSlotTable> Get(const UClass* InClass);
+
+	/**
+	 * Drops the cached tables of InClass and its child classes (of all classes if null), and flags them stale.
+	 *
+	 * Broadcasts FMGADelegates::OnAttributeSetLayoutChanged so that caches built from slot tables are invalidated as well.
+	 */
+	static void Invalidate(const UClass* InClass = nullptr);
+
+#if WITH_EDITOR
+	/** Invalidates the tables of all Attribute Set classes with reinstanced objects, bound to FCoreUObjectDelegates::OnObjectsReinstanced */
+	static void InvalidateReinstancedClasses(const TMap<UObject*, UObject*>& InReplacedObjects);
+#endif
+
+	/** Returns whether the layout of the class may have changed since this table was built, Get() a new one if so */
+	bool IsStale() const
+	{
+		return bStale.load(std::memory_order_relaxed);
+	}
+
+	/** Returns the class this table was built for */
+	const UClass* GetClass() const
+	{
+		return Class.Get();
+	}
+
+	/** Returns the number of attribute data slots for the class */
+	int32 Num() const
+	{
+		return Slots.Num();
+	}
+
+	/** Returns whether InSlotIndex is a valid slot for this class */
+	bool IsValidSlot(const int32 InSlotIndex) const
+	{
+		return Slots.IsValidIndex(InSlotIndex);
+	}
+
+	const FMGAAttributeSlot& GetSlot(const int32 InSlotIndex) const
+	{
+		return Slots[InSlotIndex];
+	}
+
+	const TArray<FMGAAttributeSlot>& GetSlots() const
+	{
+		return Slots;
+	}
+
+	/** Returns the slot indices of all replicated attribute data properties */
+	const TArray<int32>& GetReplicatedSlots() const
+	{
+		return ReplicatedSlots;
+	}
+
+	/** Returns the slot index for attribute data at the given offset within the owning set, or INDEX_NONE */
+	FORCEINLINE int32 FindSlotByOffset(const int32 InOffset) const
+	{
+		if (InOffset < 0 || InOffset % OffsetGranularity != 0)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 Index = InOffset / OffsetGranularity;
+		return SlotByOffset.IsValidIndex(Index) ? SlotByOffset[Index] : INDEX_NONE;
+	}
+
+	/** Returns the slot index for attribute data living in InOwnerSet memory, or INDEX_NONE */
+	FORCEINLINE int32 FindSlot(const UAttributeSet* InOwnerSet, const FGameplayAttributeData& InAttributeData) const
+	{
+		const UPTRINT Base = reinterpret_cast<UPTRINT>(InOwnerSet);
+		const UPTRINT Address = reinterpret_cast<UPTRINT>(&InAttributeData);
+		if (Address < Base)
+		{
+			return INDEX_NONE;
+		}
+
+		return FindSlotByOffset(static_cast<int32>(Address - Base));
+	}
+
+	/** Returns the slot index for the given attribute data property, or INDEX_NONE if it is not part of this class */
+	int32 FindSlot(const FProperty* InProperty) const;
+
+	/** Returns the slot index for the given Gameplay Attribute, or INDEX_NONE if it is not part of this class */
+	int32 FindSlot(const FGameplayAttribute& InAttribute) const
+	{
+		return FindSlot(InAttribute.GetUProperty());
+	}
+
+	/** Returns the slot index for the attribute data property with the given name, or INDEX_NONE if there is none in this class */
+	int32 FindSlotByName(const FName InPropertyName) const
+	{
+		const int32* SlotIndex = SlotsByName.Find(InPropertyName);
+		return SlotIndex ? *SlotIndex : INDEX_NONE;
+	}
+
+private:
+	/** Attribute data always starts on a pointer aligned address (FGameplayAttributeData has a vtable) */
+	static constexpr int32 OffsetGranularity = alignof(FGameplayAttributeData);
+
+	void Build(const UClass* InClass);
+
+	TWeakObjectPtr<const UClass> Class;
+	std::atomic<bool> bStale{false};
+	TArray<FMGAAttributeSlot> Slots;
+	TArray<int32> ReplicatedSlots;
+
+	/** Slot index by (offset / OffsetGranularity), INDEX_NONE for offsets that are not the start of an attribute data */
+	TArray<int16> SlotByOffset;
+
+	/** Slot index by property name, for callers only knowing the name (eg. Blueprint rep notifies) */
+	TMap<FName, int32> SlotsByName;
+};
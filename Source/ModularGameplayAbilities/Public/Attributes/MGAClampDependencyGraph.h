@@ -0,0 +1,137 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Attributes/ModularAttributeSetBase.h"
+#include <atomic>
+
+class FMGAAttributeSlotTable;
+
+/** Resolved bound (Min or Max) of a FMGAClampedAttributeData */
+struct MODULARGAMEPLAYABILITIES_API FMGAClampBound
+{
+	EMGAAttributeClampingType ClampType = EMGAAttributeClampingType::None;
+
+	/** Static value, for Float bounds */
+	float Value = 0.f;
+
+	/** Slot of the bounding attribute, for AttributeBased bounds */
+	int32 BoundSlot = INDEX_NONE;
+
+	/** Offset of the bounding attribute data within the owning set, for AttributeBased bounds */
+	int32 BoundOffset = INDEX_NONE;
+
+	/** Whether the clamped attribute is scaled along with the bounding attribute (see FMGAAttributeClampDefinition::bAdjustProportionally) */
+	bool bAdjustProportionally = false;
+
+	bool IsAttributeBased() const
+	{
+		return ClampType == EMGAAttributeClampingType::AttributeBased && BoundOffset != INDEX_NONE;
+	}
+
+	/** Returns the value to clamp with (the base value of attribute based bounds if bInBaseValue), returns false if the bound is disabled or invalid */
+	FORCEINLINE bool GetValue(const UAttributeSet* InOwnerSet, float& OutValue, const bool bInBaseValue = false) const
+	{
+		if (ClampType == EMGAAttributeClampingType::Float)
+		{
+			OutValue = Value;
+			return true;
+		}
+
+		if (IsAttributeBased())
+		{
+			const FGameplayAttributeData* BoundData = reinterpret_cast<const FGameplayAttributeData*>(reinterpret_cast<const uint8*>(InOwnerSet) + BoundOffset);
+			OutValue = bInBaseValue ? BoundData->GetBaseValue() : BoundData->GetCurrentValue();
+			return true;
+		}
+
+		OutValue = 0.f;
+		return false;
+	}
+};
+
+/** Clamping information for a single FMGAClampedAttributeData of an Attribute Set class */
+struct MODULARGAMEPLAYABILITIES_API FMGAClampNode
+{
+	/** Slot of the clamped attribute (see FMGAAttributeSlotTable) */
+	int32 Slot = INDEX_NONE;
+
+	FMGAClampBound Min;
+	FMGAClampBound Max;
+
+	/**
+	 * Clamps InValue within the bounds of this node. Returns false if both bounds are disabled or invalid.
+	 *
+	 * Current values are clamped by the current values of bounding attributes, base values by their base values.
+	 */
+	bool Clamp(const UAttributeSet* InOwnerSet, float& InOutValue, bool bInBaseValue = false) const;
+};
+
+/**
+ * Per-class graph of the clamp bounds of FMGAClampedAttributeData members (eg. Health clamped by MaxHealth).
+ *
+ * Built once per class from the class default object (clamp definitions are EditDefaultsOnly), with bounding attributes
+ * resolved to offsets. For every attribute, it stores the list of attributes depending on it directly or transitively,
+ * in topological order, so that a change to a bounding attribute re-clamps exactly its dependents, each one after its
+ * own bounds.
+ *
+ * Graphs are shared and immutable like FMGAAttributeSlotTable, and invalidated along with it when a class layout changes.
+ */
+class MODULARGAMEPLAYABILITIES_API FMGAClampDependencyGraph
+{
+public:
+	/** Returns the graph for the given Attribute Set class, building it on first use */
+	static TSharedRef<const FMGAClampDependencyGraph> Get(const UClass* InClass);
+
+	/** Drops the cached graphs of InClass and its child classes (of all classes if null), bound to FMGADelegates::OnAttributeSetLayoutChanged */
+	static void Invalidate(const UClass* InClass);
+
+	/** Returns whether the layout of the class may have changed since this graph was built, Get() a new one if so */
+	bool IsStale() const
+	{
+		return bStale.load(std::memory_order_relaxed);
+	}
+
+	/** Returns the clamp node for the given slot, or nullptr if the attribute is not a FMGAClampedAttributeData */
+	const FMGAClampNode* FindNode(const int32 InSlotIndex) const
+	{
+		return NodeBySlot.IsValidIndex(InSlotIndex) && NodeBySlot[InSlotIndex] != INDEX_NONE ? &Nodes[NodeBySlot[InSlotIndex]] : nullptr;
+	}
+
+	/** Returns the node indices of attributes depending on the given slot, in topological order */
+	const TArray<int32>& GetDependents(const int32 InSlotIndex) const
+	{
+		return DependentsBySlot.IsValidIndex(InSlotIndex) ? DependentsBySlot[InSlotIndex] : EmptyDependents;
+	}
+
+	const FMGAClampNode& GetNode(const int32 InNodeIndex) const
+	{
+		return Nodes[InNodeIndex];
+	}
+
+	/** Returns whether any attribute of the class is bound by another one */
+	bool HasDependencies() const
+	{
+		return bHasDependencies;
+	}
+
+private:
+	void Build(const UClass* InClass);
+
+	TWeakObjectPtr<const UClass> Class;
+	std::atomic<bool> bStale{false};
+
+	/** Clamp nodes, in topological order (bounds first) */
+	TArray<FMGAClampNode> Nodes;
+
+	/** Node index by slot, INDEX_NONE for attributes that are not clamped */
+	TArray<int32> NodeBySlot;
+
+	/** Direct and transitive dependents by slot, as node indices in topological order */
+	TArray<TArray<int32>> DependentsBySlot;
+
+	bool bHasDependencies = false;
+
+	static const TArray<int32> EmptyDependents;
+};
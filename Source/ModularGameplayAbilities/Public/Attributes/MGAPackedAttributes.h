@@ -0,0 +1,111 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "Engine/NetSerialization.h"
+#include "MGAPackedAttributes.generated.h"
+
+class UModularAttributeSetBase;
+
+/** Quantization used to replicate a single attribute when an Attribute Set uses packed replication */
+USTRUCT(BlueprintType)
+struct MODULARGAMEPLAYABILITIES_API FMGAAttributeQuantizationRule
+{
+	GENERATED_BODY()
+
+	/** Attribute to quantize (must be a member of the Attribute Set) */
+	UPROPERTY(EditDefaultsOnly, Category = "Quantization", meta = (ShowOnlyOwnedAttributes))
+	FGameplayAttribute Attribute;
+
+	/** Smallest difference that is preserved over the wire (eg. 0.1). Zero or less replicates the full float. */
+	UPROPERTY(EditDefaultsOnly, Category = "Quantization", meta = (ClampMin = "0"))
+	float Precision = 0.1f;
+
+	/** Lowest replicated value, values below are clamped */
+	UPROPERTY(EditDefaultsOnly, Category = "Quantization")
+	float MinValue = 0.f;
+
+	/** Highest replicated value, values above are clamped */
+	UPROPERTY(EditDefaultsOnly, Category = "Quantization")
+	float MaxValue = 10000.f;
+};
+
+/** Resolved encoding of a single replicated attribute within a packed Attribute Set */
+struct MODULARGAMEPLAYABILITIES_API FMGAPackedAttributeEncoding
+{
+	FGameplayAttribute Attribute;
+
+	/** Offset of the attribute data within the owning set */
+	int32 Offset = INDEX_NONE;
+
+	float MinValue = 0.f;
+	float MaxValue = 0.f;
+	float Precision = 0.f;
+
+	/** Number of bits of a quantized value, 0 for full floats */
+	uint32 NumBits = 0;
+
+	uint32 Quantize(float InValue) const;
+	float Dequantize(uint32 InQuantizedValue) const;
+};
+
+/**
+ * Per-class list of the replicated attributes packed by FMGAPackedAttributes, along with their quantization.
+ *
+ * Built once per class from the class default object quantization rules, so that server and clients agree on the layout.
+ * Layouts are shared and immutable like FMGAAttributeSlotTable, and invalidated along with it when a class layout changes
+ * (or when the default object quantization rules are edited).
+ */
+class MODULARGAMEPLAYABILITIES_API FMGAPackedAttributeLayout
+{
+public:
+	static TSharedRef<const FMGAPackedAttributeLayout> Get(const UClass* InClass);
+
+	/** Drops the cached layouts of InClass and its child classes (of all classes if null), bound to FMGADelegates::OnAttributeSetLayoutChanged */
+	static void Invalidate(const UClass* InClass);
+
+	const TArray<FMGAPackedAttributeEncoding>& GetEncodings() const
+	{
+		return Encodings;
+	}
+
+private:
+	void Build(const UClass* InClass);
+
+	TWeakObjectPtr<const UClass> Class;
+	TArray<FMGAPackedAttributeEncoding> Encodings;
+};
+
+/**
+ * Replicates all replicated attributes of a UModularAttributeSetBase as a single property (see bUsePackedReplication).
+ *
+ * Attribute values are quantized according to the set quantization rules, and only attributes that changed since the
+ * last state acknowledged by a connection are sent, flagged in a changed-attribute bitmask. When base and current values
+ * are the same, which is the common case, only one of them is sent.
+ */
+USTRUCT()
+struct MODULARGAMEPLAYABILITIES_API FMGAPackedAttributes
+{
+	GENERATED_BODY()
+
+	/** Attribute Set owning this struct, set on construction of the set */
+	UModularAttributeSetBase* Owner = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+private:
+	/** Writes quantized values of the owner into OutValues (current then base, for each encoding) */
+	void GatherQuantizedValues(const FMGAPackedAttributeLayout& InLayout, TArray<uint32>& OutValues) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FMGAPackedAttributes> : public TStructOpsTypeTraitsBase2<FMGAPackedAttributes>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+		WithCopy = false,
+	};
+};
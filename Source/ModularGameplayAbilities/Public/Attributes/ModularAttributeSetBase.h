@@ -10,10 +10,14 @@
 #include "Net/Core/PushModel/PushModelMacros.h"
 #include "Abilities/GameplayAbilityTypes.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Attributes/MGAAttributeHandle.h"
+#include "Attributes/MGAPackedAttributes.h"
 
 #if WITH_EDITOR
 #include "EdGraph/EdGraphNode.h"
+#include "Hash/Blake3.h"
 
+class UBlueprint;
 class UK2Node;
 class UEdGraphPin;
 #endif
@@ -21,6 +25,8 @@ class UEdGraphPin;
 #include "ModularAttributeSetBase.generated.h"
 
 struct FGameplayTagContainer;
+class FMGAAttributeSlotTable;
+class FMGAClampDependencyGraph;
 
 /** Structure holding various information to deal with AttributeSet PostGameplayEffectExecute, extracting info from FGameplayEffectModCallbackData */
 USTRUCT(BlueprintType)
@@ -138,6 +144,16 @@ struct MODULARGAMEPLAYABILITIES_API FMGAAttributeClampDefinition
 	UPROPERTY(EditDefaultsOnly, Category = "Clamp", meta=(EditConditionHides, EditCondition="ClampType == EMGAAttributeClampingType::AttributeBased", ShowOnlyOwnedAttributes))
 	FGameplayAttribute Attribute;
 
+	/**
+	 * Whether the clamped attribute should keep the same ratio to the bounding attribute when the bounding attribute base value
+	 * changes (for example, Health going from 50 to 100 when MaxHealth goes from 100 to 200).
+	 *
+	 * Otherwise, or when the bounding attribute only changes from a temporary modifier, the clamped attribute is only re-clamped
+	 * within its new bounds.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Clamp", meta=(EditConditionHides, EditCondition="ClampType == EMGAAttributeClampingType::AttributeBased"))
+	bool bAdjustProportionally = false;
+
 	/** default constructor */
 	FMGAAttributeClampDefinition() = default;
 	virtual ~FMGAAttributeClampDefinition() = default;
@@ -145,7 +161,7 @@ struct MODULARGAMEPLAYABILITIES_API FMGAAttributeClampDefinition
 	/** Returns string representation of all member variables of this struct */
 	FString ToString() const
 	{
-		return FString::Printf(TEXT("ClampType: %s, Value: %f, Attribute: %s"), *UEnum::GetValueAsString(ClampType), Value, *Attribute.GetName());
+		return FString::Printf(TEXT("ClampType: %s, Value: %f, Attribute: %s, AdjustProportionally: %s"), *UEnum::GetValueAsString(ClampType), Value, *Attribute.GetName(), bAdjustProportionally ? TEXT("true") : TEXT("false"));
 	}
 
 	/** Returns the actual float value to use for the clamping, based on the ClampType used (eg. the backing attribute value or the static float) */
@@ -183,6 +199,37 @@ struct MODULARGAMEPLAYABILITIES_API FMGAClampedAttributeData : public FMGAAttrib
 	}
 };
 
+/** Which connections a replicated attribute is sent to */
+UENUM()
+enum class EMGAAttributeReplicationAudience : uint8
+{
+	/** Every relevant connection (default) */
+	All,
+
+	/** Only the connection owning the Attribute Set actor (eg. stamina, ammo reserves) */
+	OwnerOnly,
+
+	/** Only connections simulating the Attribute Set actor, eg. not the owner */
+	SimulatedOnly,
+};
+
+/** Replication audience of a single attribute, see UModularAttributeSetBase::ReplicationRules */
+USTRUCT(BlueprintType)
+struct MODULARGAMEPLAYABILITIES_API FMGAAttributeReplicationRule
+{
+	GENERATED_BODY()
+
+	/** Replicated attribute this rule applies to (C++ or Blueprint declared) */
+	UPROPERTY(EditDefaultsOnly, Category = "Replication", meta = (ShowOnlyOwnedAttributes))
+	FGameplayAttribute Attribute;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Replication")
+	EMGAAttributeReplicationAudience Audience = EMGAAttributeReplicationAudience::OwnerOnly;
+
+	/** Returns the lifetime replication condition matching Audience */
+	ELifetimeCondition GetCondition() const;
+};
+
 // Uses macros from AttributeSet.h
 #define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
 GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
@@ -418,6 +465,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ModularGameplayAbilities|Attribute", DisplayName="GetActorInfo")
 	FGameplayAbilityActorInfo K2_GetActorInfo() const;
 
+	/** Returns the per-class table of attribute data slots for this set (cached on the instance until the class layout changes) */
+	const FMGAAttributeSlotTable& GetAttributeSlotTable() const;
+
+	/** Returns the handle of an attribute, without going through FMGAAttributeRegistry for attributes of this set (handles are resolved along with the slot table) */
+	FMGAAttributeHandle GetAttributeHandle(const FGameplayAttribute& InAttribute) const;
+
 	/** Internal implementation of Blueprint rep notifies GAMEPLAYATTRIBUTE_REPNOTIFY equivalent */
 	void HandleRepNotifyForGameplayAttribute(FName InPropertyName);
 	
@@ -445,6 +498,64 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ModularGameplayAbilities|Attribute")
 	void HandleRepNotifyForClampedAttributeData(const FMGAClampedAttributeData& InAttribute);
 
+	/**
+	 * Marks the given attribute dirty for push model replication.
+	 *
+	 * Writes going through the Ability System Component (gameplay effects, SetAttributeValue, clamping) and data table
+	 * initialization already mark attributes dirty. This is only needed when writing attribute data directly, for instance
+	 * with the InitXXX() setters of ATTRIBUTE_ACCESSORS, or by setting a Blueprint attribute variable.
+	 *
+	 * Natively declared attributes opt in to push model with FDoRepLifetimeParams::bIsPushBased, Blueprint declared ones
+	 * with bPushModelBlueprintAttributes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ModularGameplayAbilities|Attribute")
+	void MarkAttributeDirty(const FGameplayAttribute& InAttribute) const;
+
+	/**
+	 * Whether replicated attributes declared in Blueprint use push model replication, meaning they are only compared for
+	 * replication once written to (see MarkAttributeDirty()), instead of on every replication pass.
+	 *
+	 * Opt in: once enabled, every write that doesn't go through the Ability System Component has to mark the attribute
+	 * dirty, with MarkAttributeDirty() in Blueprint or MARK_PROPERTY_DIRTY natively. This includes setting the Blueprint
+	 * attribute variable directly. Writes that aren't marked dirty are never replicated.
+	 *
+	 * Has no effect unless push model is enabled (net.IsPushModelEnabled).
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Replication")
+	bool bPushModelBlueprintAttributes = false;
+
+	/**
+	 * Whether replicated attributes of this set are sent as a single quantized, delta-compressed property
+	 * (see FMGAPackedAttributes) instead of one property per attribute.
+	 *
+	 * Only attributes that changed since the last state acknowledged by a connection are sent, quantized according to
+	 * QuantizationRules. Attribute rep notifies are not called in this mode, received values are forwarded to the Ability
+	 * System Component directly (same as GAMEPLAYATTRIBUTE_REPNOTIFY()).
+	 *
+	 * Native subclasses declaring replicated attributes must call ApplyAttributeReplicationRules() at the end of their
+	 * GetLifetimeReplicatedProps().
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Replication")
+	bool bUsePackedReplication = false;
+
+	/** Per-attribute quantization used with bUsePackedReplication. Attributes without a rule replicate their full float value. */
+	UPROPERTY(EditDefaultsOnly, Category = "Replication", meta = (EditCondition = "bUsePackedReplication"))
+	TArray<FMGAAttributeQuantizationRule> QuantizationRules;
+
+	/**
+	 * Per-attribute replication audience, for attributes only relevant to some connections (eg. owner only stamina).
+	 *
+	 * Applies to both C++ and Blueprint declared attributes, overriding the condition they were declared with.
+	 * Attributes without a rule keep their declared condition. Not used with bUsePackedReplication, since all
+	 * attributes are then sent as a single property.
+	 *
+	 * Native subclasses register their attributes after Super::GetLifetimeReplicatedProps(), they must call
+	 * ApplyAttributeReplicationRules() at the end of their own GetLifetimeReplicatedProps() for rules to apply to them.
+	 * Data validation reports rules that are not applied.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Replication", meta = (EditCondition = "!bUsePackedReplication"))
+	TArray<FMGAAttributeReplicationRule> ReplicationRules;
+
 	//~ Begin UObject interface
 	virtual void BeginDestroy() override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -474,20 +585,72 @@ public:
 	 * parameter (name of the rep notified and the InAttribute property should match)
 	 */
 	EDataValidationResult IsDataValidRepNotifies(TArray<FText>& ValidationErrors) const;
+
+	/** Called from IsDataValid(), checks ReplicationRules only reference replicated attributes of this set, once each */
+	EDataValidationResult IsDataValidReplicationRules(TArray<FText>& ValidationErrors) const;
+
+	/**
+	 * Called from IsDataValid(), runs IsDataValidRepNotifies() and IsDataValidReplicationRules().
+	 *
+	 * Results are cached per Blueprint (see FMGAAttributeSetValidationCache) and reused while GetReplicationValidationKey()
+	 * is unchanged, so that only Attribute Sets whose Blueprint (or a parent Blueprint) changed are walked again, saved or not.
+	 * Reads UObjects, game thread only.
+	 */
+	EDataValidationResult IsDataValidReplication(TArray<FText>& ValidationErrors) const;
+
+	/** Returns the cache key of IsDataValidReplication(), from the GetReplicationValidationHash() of this Blueprint class and its parents */
+	FBlake3Hash GetReplicationValidationKey() const;
+
+	/**
+	 * Returns a hash of what IsDataValidReplication() reads from InBlueprint alone: its serialized NewVariables, the nodes,
+	 * pins and links of its OnRep_ graphs, and the ReplicationRules of its generated class default object.
+	 *
+	 * Written to the asset registry on save (see UMGAAttributeSetBlueprint::ReplicationValidationHashTagName) so that keys
+	 * of saved Blueprints can be computed without loading them.
+	 */
+	static FBlake3Hash GetReplicationValidationHash(const UBlueprint* InBlueprint);
+
 	static bool IsNodeWiredToEntry(const UK2Node* InNode);
 
 	static UEdGraphPin* FindGraphNodePin(const UEdGraphNode* InNode, const EEdGraphPinDirection InDirection);
 #endif
 
-	/** Getter to return current state of AttributesMetaData map */
+	/** Getter to return current state of AttributesMetaData map, keyed by attribute name */
 	TMap<FString, TSharedPtr<FAttributeMetaData>> GetAttributesMetaData() const;
 
+	/** Returns the MetaData read from the initialization data table for the given attribute, if any */
+	TSharedPtr<FAttributeMetaData> FindAttributeMetaData(const FMGAAttributeHandle& InAttributeHandle) const;
+
 protected:
-	/** Stores cached values of FGameplayAttributeData during a PostNetReceive() for use later on within rep notifies */
-	TMap<FString, TSharedPtr<FGameplayAttributeData>> AttributeDataRepMap;
+	/**
+	 * Stores cached values of FGameplayAttributeData during a PreNetReceive() for use later on within rep notifies.
+	 *
+	 * Indexed by attribute slot (see FMGAAttributeSlotTable), only replicated slots are filled.
+	 */
+	TArray<FGameplayAttributeData> AttributeDataRepSlots;
+
+	/** Cached slot table for this class, see GetAttributeSlotTable() */
+	mutable TSharedPtr<const FMGAAttributeSlotTable> CachedSlotTable;
+
+	/** Handle of each attribute data slot, resolved along with CachedSlotTable */
+	mutable TArray<FMGAAttributeHandle> CachedAttributeHandles;
+
+	/** Replicates all attributes at once when bUsePackedReplication is enabled, never replicated otherwise */
+	UPROPERTY(Replicated)
+	FMGAPackedAttributes PackedAttributes;
+
+	/**
+	 * Adjusts replication conditions of the attributes of this set according to its replication settings (ReplicationRules,
+	 * or disables per-attribute replication when bUsePackedReplication is enabled).
+	 *
+	 * Already called for Blueprint declared attributes. Native subclasses must call it at the end of their own
+	 * GetLifetimeReplicatedProps(), after registering their attributes, as these are not registered yet when it runs from
+	 * this class. Calling it more than once is fine.
+	 */
+	void ApplyAttributeReplicationRules(TArray<FLifetimeProperty>& OutLifetimeProps) const;
 
 	/** Stores cached values of FAttributeMetaData that was read from an initialization data table during InitFromMetaDataTable() */
-	TMap<FString, TSharedPtr<FAttributeMetaData>> AttributesMetaData;
+	TMap<FMGAAttributeHandle, TSharedPtr<FAttributeMetaData>> AttributesMetaData;
 
 	/** List of valid rep notify handler for GameplayAttributes (HandleRepNotify...). Key is the CPP type, Value is the function name. */
 	static TMap<FString, FString> RepNotifierHandlerNames;
@@ -507,6 +670,36 @@ protected:
 
 	/** Returns the new value for an attribute after clamping via FMGAClampedAttributeData defaults Min / Max values */
 	float GetClampedValueForClampedProperty(const FGameplayAttribute& Attribute, float InValue);
+
+	/** Returns the clamp dependency graph for this class */
+	const FMGAClampDependencyGraph& GetClampDependencyGraph() const;
+
+	/**
+	 * Re-clamps (and proportionally adjusts if configured) every attribute bounded directly or transitively by InAttribute,
+	 * in dependency order. Called from PostAttributeChange on authority, and on clients within a prediction window.
+	 *
+	 * Proportional adjustment only follows base value changes (OldBaseValue != NewBaseValue): a bound changed by a temporary
+	 * modifier only re-clamps its dependents.
+	 *
+	 * Base values are clamped by the base values of their bounds, current values are then clamped by PreAttributeChange
+	 * when the base value write re-evaluates them, so that active modifiers don't push base values out of bounds.
+	 */
+	void ReclampDependentAttributes(const FGameplayAttribute& InAttribute, float OldBaseValue, float NewBaseValue);
+
+	/** Cached clamp dependency graph for this class, see GetClampDependencyGraph() */
+	mutable TSharedPtr<const FMGAClampDependencyGraph> CachedClampDependencyGraph;
+
+	/** Set while dependent attributes are being re-clamped, to prevent nested propagation from our own writes */
+	bool bIsReclampingDependents = false;
+
+	/** Base value of the attribute being changed, between PreAttributeBaseChange and PostAttributeBaseChange */
+	struct FPendingBaseValueChange
+	{
+		FGameplayAttribute Attribute;
+		float OldBaseValue = 0.f;
+	};
+
+	mutable FPendingBaseValueChange PendingBaseValueChange;
 	
 	/** Returns whether given Attribute metadata has valid clamping values */
 	static bool IsValidAttributeMetadata(const FAttributeMetaData& InAttributeMetadata);
@@ -533,4 +726,7 @@ protected:
 	
 	/** Returns the property name of a given FGameplayAttributeData (or one of its child struct) */
 	bool GetAttributeDataPropertyName(const FGameplayAttributeData& InAttributeData, FString& OutPropertyName);
+
+	/** Implementation of rep notifies for a given attribute slot, passing down the old value stored in PreNetReceive() to the ASC */
+	void HandleRepNotifyForSlot(int32 InSlotIndex);
 };
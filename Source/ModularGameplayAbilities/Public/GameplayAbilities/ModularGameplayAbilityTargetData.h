@@ -0,0 +1,95 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Engine/HitResult.h"
+#include "ModularGameplayAbilityTargetData.generated.h"
+
+/**
+ * Hit result target data replicating only what abilities typically consume, quantized.
+ *
+ * Drop-in replacement for FGameplayAbilityTargetData_SingleTargetHit when sending many hits per activation (eg. shotgun
+ * pellets): sends the hit actor, location (0.1cm precision), normals, trace start and whether it was a blocking hit.
+ * Impact point and normal are only sent when they differ from location and normal. Component, bone, face index and
+ * physical material are not replicated.
+ */
+USTRUCT(BlueprintType)
+struct MODULARGAMEPLAYABILITIES_API FModularGameplayAbilityTargetData_CompactHit : public FGameplayAbilityTargetData
+{
+	GENERATED_BODY()
+
+	FModularGameplayAbilityTargetData_CompactHit() = default;
+
+	explicit FModularGameplayAbilityTargetData_CompactHit(const FHitResult& InHitResult)
+		: HitResult(InHitResult)
+	{
+	}
+
+	/** Returns a target data handle with one compact entry per hit */
+	static FGameplayAbilityTargetDataHandle MakeHandle(const TArray<FHitResult>& InHitResults);
+
+	// -------------------------------------
+
+	virtual TArray<TWeakObjectPtr<AActor>> GetActors() const override;
+
+	virtual bool HasHitResult() const override
+	{
+		return true;
+	}
+
+	virtual const FHitResult* GetHitResult() const override
+	{
+		return &HitResult;
+	}
+
+	virtual void ReplaceHitWith(AActor* NewHitActor, const FHitResult* NewHitResult) override
+	{
+		if (NewHitResult)
+		{
+			HitResult = *NewHitResult;
+		}
+	}
+
+	virtual bool HasOrigin() const override
+	{
+		return true;
+	}
+
+	virtual FTransform GetOrigin() const override
+	{
+		return FTransform(HitResult.TraceStart);
+	}
+
+	virtual bool HasEndPoint() const override
+	{
+		return true;
+	}
+
+	virtual FVector GetEndPoint() const override
+	{
+		return HitResult.Location;
+	}
+
+	// -------------------------------------
+
+	UPROPERTY(BlueprintReadOnly, Category = Targeting)
+	FHitResult HitResult;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	virtual UScriptStruct* GetScriptStruct() const override
+	{
+		return StaticStruct();
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FModularGameplayAbilityTargetData_CompactHit> : public TStructOpsTypeTraitsBase2<FModularGameplayAbilityTargetData_CompactHit>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
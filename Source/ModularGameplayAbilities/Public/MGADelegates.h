@@ -15,6 +15,9 @@ struct MODULARGAMEPLAYABILITIES_API FMGADelegates
 	DECLARE_MULTICAST_DELEGATE_OneParam(FMGAOnPostCompile, const FName&);
 	DECLARE_MULTICAST_DELEGATE_OneParam(FMGAOnPreCompile, const FName&);
 
+	/** Layout of an Attribute Set class (and its child classes) may have changed, all classes if null. See FMGAAttributeSlotTable::Invalidate() */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FMGAOnAttributeSetLayoutChanged, const UClass*);
+
 	DECLARE_MULTICAST_DELEGATE(FMGAOnRequestDetailsRefresh)
 
 	static FMGAOnVariableAddedOrRemoved OnVariableAdded;
@@ -24,6 +27,8 @@ struct MODULARGAMEPLAYABILITIES_API FMGADelegates
 	
 	static FMGAOnPreCompile OnPreCompile;
 	static FMGAOnPostCompile OnPostCompile;
+
+	static FMGAOnAttributeSetLayoutChanged OnAttributeSetLayoutChanged;
 	
 	static FMGAOnRequestDetailsRefresh OnRequestDetailsRefresh;
 };
@@ -19,6 +19,8 @@ public:
 	//~AActor interface
 	virtual void PreInitializeComponents() override;
 	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~End of AActor interface
 	
 	static const FName NAME_ModularAbilityReady;
@@ -29,7 +31,49 @@ public:
 	
 	void SetPawnData(const UModularPawnData* InPawnData) override;
 
+protected:
+	// Whether net update frequency and priority follow the activity of the ability system component (server only).
+	// When enabled, the player state replicates at MaxNetUpdateFrequency while its ability system component changes,
+	// and decays down to MinNetUpdateFrequency once idle for AdaptiveIdleDelay seconds.
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication")
+	bool bAdaptiveNetUpdateFrequency = false;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication", meta = (EditCondition = "bAdaptiveNetUpdateFrequency", ClampMin = "0.1"))
+	float MinAdaptiveNetUpdateFrequency = 2.f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication", meta = (EditCondition = "bAdaptiveNetUpdateFrequency", ClampMin = "0.1"))
+	float MaxAdaptiveNetUpdateFrequency = 100.f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication", meta = (EditCondition = "bAdaptiveNetUpdateFrequency", ClampMin = "0"))
+	float MinAdaptiveNetPriority = 1.f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication", meta = (EditCondition = "bAdaptiveNetUpdateFrequency", ClampMin = "0"))
+	float MaxAdaptiveNetPriority = 3.f;
+
+	// Seconds without activity before the update frequency starts decaying.
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication", meta = (EditCondition = "bAdaptiveNetUpdateFrequency", ClampMin = "0"))
+	float AdaptiveIdleDelay = 1.f;
+
+	// Seconds taken to decay from max to min update frequency once idle.
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication", meta = (EditCondition = "bAdaptiveNetUpdateFrequency", ClampMin = "0"))
+	float AdaptiveDecayDuration = 4.f;
+
+	// Activities replicated right away with ForceNetUpdate(), instead of waiting for the next update.
+	UPROPERTY(Config, EditDefaultsOnly, Category = "ModularAbility|Replication", meta = (EditCondition = "bAdaptiveNetUpdateFrequency", Bitmask, BitmaskEnum = "/Script/ModularGameplayAbilities.EModularAbilitySystemActivity"))
+	int32 ForceNetUpdateActivities = static_cast<int32>(EModularAbilitySystemActivity::EffectAdded | EModularAbilitySystemActivity::EffectRemoved | EModularAbilitySystemActivity::AbilityActivated);
+
+	void RegisterAdaptiveNetUpdate();
+	void UnregisterAdaptiveNetUpdate();
+
+	void HandleAbilitySystemActivity(EModularAbilitySystemActivity Activity);
+
+	// Periodically lowers update frequency and priority while idle, stopped once both reached their minimum.
+	void UpdateAdaptiveNetUpdateFrequency();
+
 private:
+	FTimerHandle AdaptiveNetUpdateTimerHandle;
+	double LastAbilitySystemActivityTime = 0.0;
+
 	// The ability system component sub-object used by player characters.
 	UPROPERTY(VisibleAnywhere, Category = "ModularAbility|PlayerState")
 	TObjectPtr<UModularAbilitySystemComponent> ModularAbilitySystemComponent;
@@ -21,4 +21,14 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle ClampDependencyGraphInvalidationHandle;
+	FDelegateHandle PackedAttributeLayoutInvalidationHandle;
+
+#if WITH_EDITOR
+	FDelegateHandle ObjectsReinstancedHandle;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UAbilitySystemComponent;
+class UAttributeSet;
+struct FGameplayAttribute;
+enum class EGameplayEffectReplicationMode : uint8;
+
+/** Whether bandwidth accounting is compiled in (enabled at runtime with MGA.NetProfiler.Enabled) */
+#ifndef MGA_WITH_NET_PROFILER
+#define MGA_WITH_NET_PROFILER !UE_BUILD_SHIPPING
+#endif
+
+#if MGA_WITH_NET_PROFILER
+
+/** What replicated data a net profiler entry accounts for */
+enum class EMGANetProfilerCategory : uint8
+{
+	/** A single attribute, named "SetClass.Attribute" */
+	Attribute,
+	/** All attributes of an attribute set class */
+	AttributeSet,
+	/** Active gameplay effect replication, per effect class */
+	Effect,
+	/** Plugin RPCs, per function */
+	RPC,
+
+	Num
+};
+
+/**
+ * Server side accounting of bytes replicated by the plugin, attributed to attributes, attribute set classes, gameplay
+ * effect classes and plugin RPCs (the engine network profiler only sees generic property and RPC names).
+ *
+ * Fed by UModularAbilitySystemComponent and FMGAPackedAttributes. Stats are kept in two separate buckets, never summed:
+ *
+ * - Measured: bits actually serialized, per connection (packed attributes, see FMGAPackedAttributes::NetDeltaSerialize())
+ * - Estimated: payload of changed properties and RPC parameters, multiplied by the connections they replicate to given
+ *   their replication condition (owner only, skip owner, ...) and the effect replication mode, excluding engine headers.
+ *   Attribute properties and active effects are serialized by the engine, so their actual size can't be measured here.
+ *
+ * Stats are shared by all Ability System Components of the process and can be inspected with the following console
+ * commands:
+ *
+ * - MGA.NetProfiler.Enabled 1: starts accounting
+ * - MGA.NetProfiler.Dump: logs stats, largest entries first
+ * - MGA.NetProfiler.ExportCSV [FilePath]: writes stats to a CSV file (defaults to the profiling directory)
+ * - MGA.NetProfiler.Reset: clears stats
+ */
+class MODULARGAMEPLAYABILITIES_API FMGANetProfiler
+{
+public:
+	/** Aggregated stats of a single entry */
+	struct FEntryStats
+	{
+		int64 NumBits = 0;
+
+		/** Number of sends, one per connection */
+		int32 NumUpdates = 0;
+
+		int64 GetNumBytes() const
+		{
+			return (NumBits + 7) / 8;
+		}
+	};
+
+	static FMGANetProfiler& Get();
+
+	/** Whether replication is accounted for (MGA.NetProfiler.Enabled) */
+	static bool IsEnabled();
+
+	static const TCHAR* LexToString(EMGANetProfilerCategory InCategory);
+
+	/** Records InNumBits sent InNumSends times (once per connection) for InAttribute of InAttributeSet, both to the attribute and its set class */
+	void RecordAttribute(const UAttributeSet* InAttributeSet, const FGameplayAttribute& InAttribute, int64 InNumBits, bool bInEstimated, int32 InNumSends = 1);
+
+	/** Records InNumBits sent by InAttributeSet not attributable to a single attribute (eg. headers) */
+	void RecordAttributeSet(const UAttributeSet* InAttributeSet, int64 InNumBits, bool bInEstimated);
+
+	/** Records InNumBits sent InNumSends times by the given plugin RPC */
+	void RecordRPC(FName InFunctionName, int64 InNumBits, bool bInEstimated, int32 InNumSends = 1);
+
+	/**
+	 * Called before InAbilitySystemComponent replicates. Estimates what changed since its last net update, for each
+	 * connection it replicates to: attributes of its attribute sets not using packed replication and, unless
+	 * InEffectReplicationMode is Minimal, its active gameplay effects. Nothing is recorded without any connection.
+	 */
+	void NotifyPreReplication(const UAbilitySystemComponent* InAbilitySystemComponent, EGameplayEffectReplicationMode InEffectReplicationMode);
+
+	/** Forgets replicated state tracked for InAbilitySystemComponent and its attribute sets */
+	void NotifyEndPlay(const UAbilitySystemComponent* InAbilitySystemComponent);
+
+	/** Clears stats and tracked replicated state */
+	void Reset();
+
+	/** Writes stats to the given output device, largest entries first */
+	void Dump(FOutputDevice& Ar) const;
+
+	/** Writes stats to a CSV file, returns whether it succeeded */
+	bool ExportCSV(const FString& InFilePath) const;
+
+	/** Returns measured (or estimated) stats of the given category */
+	const TMap<FName, FEntryStats>& GetStats(const EMGANetProfilerCategory InCategory, const bool bInEstimated = false) const
+	{
+		return (bInEstimated ? EstimatedStats : MeasuredStats)[static_cast<uint8>(InCategory)];
+	}
+
+private:
+	/** Connections an Ability System Component replicates to, for this net update */
+	struct FConnectionFanOut
+	{
+		int32 NumConnections = 0;
+
+		/** Connections owning the component (at most one, besides split screen children) */
+		int32 NumOwnerConnections = 0;
+	};
+
+	void Record(EMGANetProfilerCategory InCategory, FName InName, int64 InNumBits, bool bInEstimated, int32 InNumSends);
+
+	static FConnectionFanOut GetConnectionFanOut(const UAbilitySystemComponent* InAbilitySystemComponent);
+
+	void AccountAttributeSet(const UAttributeSet* InAttributeSet, const FConnectionFanOut& InFanOut);
+	void AccountEffects(const UAbilitySystemComponent* InAbilitySystemComponent, int32 InNumConnections);
+
+	/** Returns the number of InFanOut connections each replicated slot of InAttributeSet class is sent to, in slot table order */
+	const TArray<int32>& GetReplicatedSlotFanOut(const UAttributeSet* InAttributeSet, const FConnectionFanOut& InFanOut);
+
+	/** Returns entries of the given category sorted by size, largest first */
+	TArray<TPair<FName, FEntryStats>> GetSortedStats(EMGANetProfilerCategory InCategory, bool bInEstimated) const;
+
+	TMap<FName, FEntryStats> MeasuredStats[static_cast<uint8>(EMGANetProfilerCategory::Num)];
+	TMap<FName, FEntryStats> EstimatedStats[static_cast<uint8>(EMGANetProfilerCategory::Num)];
+
+	/** Replication condition of each replicated slot, in slot table order, per attribute set class */
+	TMap<TObjectKey<UClass>, TArray<uint8>> ReplicatedSlotConditions;
+
+	/** Scratch result of GetReplicatedSlotFanOut() */
+	TArray<int32> ReplicatedSlotFanOut;
+
+	/** Current and base values of replicated attributes as of the last net update, per attribute set */
+	TMap<TObjectKey<UAttributeSet>, TArray<float>> AttributeSnapshots;
+
+	/** Replication key of active effects as of the last net update, per effect replication ID, per component */
+	TMap<TObjectKey<UAbilitySystemComponent>, TMap<int32, int32>> EffectSnapshots;
+};
+
+#endif
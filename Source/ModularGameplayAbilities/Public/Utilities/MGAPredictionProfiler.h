@@ -0,0 +1,126 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "GameplayPrediction.h"
+#include "UObject/ObjectKey.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+
+/** Whether prediction profiling is compiled in (enabled at runtime with MGA.PredictionProfiler.Enabled) */
+#ifndef MGA_WITH_PREDICTION_PROFILER
+#define MGA_WITH_PREDICTION_PROFILER !UE_BUILD_SHIPPING
+#endif
+
+#if MGA_WITH_PREDICTION_PROFILER
+
+/**
+ * Tracks locally predicted ability activations from prediction key creation to server confirmation or rejection,
+ * aggregating stats per ability class (reject rate, confirmation latency percentiles, rolled back effects).
+ *
+ * Fed by UModularAbilitySystemComponent on predicting clients. Stats are shared by all Ability System Components of the
+ * process and can be inspected with the following console commands:
+ *
+ * - MGA.PredictionProfiler.Enabled 1: starts tracking new activations
+ * - MGA.PredictionProfiler.Dump: logs stats of all abilities
+ * - MGA.PredictionProfiler.ExportCSV [FilePath]: writes stats to a CSV file (defaults to the profiling directory)
+ * - MGA.PredictionProfiler.Reset: clears stats and tracked keys
+ *
+ * The server replicates prediction keys of rejected activations as well, so catching up alone doesn't mean confirmed: the
+ * rejection RPC may arrive after the key caught up (eg. resent after a packet loss). Caught up activations are only
+ * counted as confirmed once MGA.PredictionProfiler.RejectGraceSeconds passed without a rejection, latency is measured up
+ * to the catch up.
+ *
+ * Headless runs can use the engine network emulation (eg. -ExecCmds="NetEmulation.PktLag 100") on a client to get
+ * meaningful latency numbers.
+ */
+class MODULARGAMEPLAYABILITIES_API FMGAPredictionProfiler
+{
+public:
+	/** Aggregated stats of a single ability class */
+	struct FAbilityStats
+	{
+		/** Maximum number of latency samples kept, oldest ones are overwritten */
+		static constexpr int32 MaxLatencySamples = 256;
+
+		int32 NumActivations = 0;
+		int32 NumConfirmed = 0;
+		int32 NumRejected = 0;
+
+		/** Number of predicted gameplay effects removed because their activation was rejected */
+		int32 NumRolledBackEffects = 0;
+
+		/** Confirmation latencies in milliseconds, a ring buffer of MaxLatencySamples */
+		TArray<float> LatencySamples;
+		int32 NextLatencySample = 0;
+
+		void AddLatencySample(float InLatencyMs);
+
+		/** Returns the given percentile (0 - 1) of latency samples in milliseconds, 0 without samples */
+		float GetLatencyPercentile(float InPercentile) const;
+
+		float GetRejectRate() const
+		{
+			const int32 NumResolved = NumConfirmed + NumRejected;
+			return NumResolved > 0 ? static_cast<float>(NumRejected) / NumResolved : 0.f;
+		}
+	};
+
+	static FMGAPredictionProfiler& Get();
+
+	/** Whether new activations are tracked (MGA.PredictionProfiler.Enabled) */
+	static bool IsEnabled();
+
+	/** Starts tracking a locally predicted activation of InAbility until its prediction key is confirmed or rejected */
+	void NotifyPredictedActivation(const UAbilitySystemComponent* InAbilitySystemComponent, const UGameplayAbility* InAbility, const FPredictionKey& InPredictionKey);
+
+	/** Records a gameplay effect predicted with InPredictionKey, to be counted as rolled back if the activation is rejected */
+	void NotifyPredictedEffect(const UAbilitySystemComponent* InAbilitySystemComponent, const FPredictionKey& InPredictionKey);
+
+	/** Clears stats and tracked prediction keys */
+	void Reset();
+
+	/** Counts caught up activations past the rejection grace period as confirmed, done periodically while keys are pending */
+	void ResolveCaughtUpActivations();
+
+	/** Writes stats of all abilities to the given output device */
+	void Dump(FOutputDevice& Ar) const;
+
+	/** Writes stats of all abilities to a CSV file, returns whether it succeeded */
+	bool ExportCSV(const FString& InFilePath) const;
+
+	const TMap<FName, FAbilityStats>& GetStats() const
+	{
+		return Stats;
+	}
+
+private:
+	using FKeyId = TPair<TObjectKey<UAbilitySystemComponent>, FPredictionKey::KeyType>;
+
+	/** Activation waiting on server confirmation */
+	struct FPendingActivation
+	{
+		FName AbilityName;
+		double StartTime = 0.0;
+		int32 NumPredictedEffects = 0;
+
+		/** Time the server caught up to the key, 0 while it didn't. A confirmation candidate until the grace period ends. */
+		double CaughtUpTime = 0.0;
+	};
+
+	void HandleKeyCaughtUp(FKeyId InKeyId);
+	void HandleKeyRejected(FKeyId InKeyId);
+
+	bool Tick(float InDeltaTime);
+
+	TMap<FKeyId, FPendingActivation> PendingActivations;
+	TMap<FName, FAbilityStats> Stats;
+
+	/** Ticks ResolveCaughtUpActivations() while activations are pending */
+	FTSTicker::FDelegateHandle TickerHandle;
+};
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayEffectTypes.h"
+#include "Attributes/MGAAttributeHandle.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "ModularAttributesHelpers.generated.h"
 
@@ -41,10 +42,38 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ModularGameplayAbilities|Attribute")
 	static FString GetDebugStringFromAttribute(const FGameplayAttribute& Attribute);
 
-	/** Simple equality operator for gameplay attributes and string (for K2 Switch Node) */
+	/**
+	 * Simple equality operator for gameplay attributes and string (for K2 Switch Node)
+	 *
+	 * Kept for Blueprints compiled before the switch node used NotEqual_GameplayAttributeAttributePath.
+	 */
 	UFUNCTION(BlueprintPure, Category = "ModularGameplayAbilities|Attribute | PinOptions", meta = (BlueprintInternalUseOnly = "true"))
 	static bool NotEqual_GameplayAttributeGameplayAttribute(FGameplayAttribute A, FString B);
 
+	/**
+	 * Inequality operator for gameplay attributes and attribute property path (for K2 Switch Node)
+	 *
+	 * Both sides are resolved to a FMGAAttributeHandle, so that the comparison is an integer one.
+	 */
+	UFUNCTION(BlueprintPure, Category = "ModularGameplayAbilities|Attribute | PinOptions", meta = (BlueprintInternalUseOnly = "true"))
+	static bool NotEqual_GameplayAttributeAttributePath(const FGameplayAttribute& A, FName B);
+
+	/** Returns the compact handle for the given Attribute */
+	UFUNCTION(BlueprintPure, Category = "ModularGameplayAbilities|Attribute", meta = (DisplayName = "To Attribute Handle", BlueprintAutocast))
+	static FMGAAttributeHandle Conv_GameplayAttributeToAttributeHandle(const FGameplayAttribute& InAttribute);
+
+	/** Returns the Attribute the given handle was created from */
+	UFUNCTION(BlueprintPure, Category = "ModularGameplayAbilities|Attribute", meta = (DisplayName = "To Gameplay Attribute", BlueprintAutocast))
+	static FGameplayAttribute Conv_AttributeHandleToGameplayAttribute(const FMGAAttributeHandle& InHandle);
+
+	/** Returns true if both handles refer to the same Attribute */
+	UFUNCTION(BlueprintPure, Category = "ModularGameplayAbilities|Attribute", meta = (DisplayName = "Equal (Attribute Handle)", CompactNodeTitle = "==", Keywords = "== equal"))
+	static bool EqualEqual_AttributeHandle(const FMGAAttributeHandle& A, const FMGAAttributeHandle& B);
+
+	/** Returns true if the handles refer to different Attributes */
+	UFUNCTION(BlueprintPure, Category = "ModularGameplayAbilities|Attribute", meta = (DisplayName = "Not Equal (Attribute Handle)", CompactNodeTitle = "!=", Keywords = "!= not equal"))
+	static bool NotEqual_AttributeHandle(const FMGAAttributeHandle& A, const FMGAAttributeHandle& B);
+
 	/** Returns the Attribute name as an FText */
 	UFUNCTION(BlueprintPure, Category = "ModularGameplayAbilities|Attribute")
 	static FText GetAttributeDisplayNameText(const FGameplayAttribute& InAttribute);
@@ -13,7 +13,7 @@
 UMGAK2Node_SwitchGameplayAttribute::UMGAK2Node_SwitchGameplayAttribute(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	FunctionName = TEXT("NotEqual_GameplayAttributeGameplayAttribute");
+	FunctionName = GET_FUNCTION_NAME_CHECKED(UModularAttributesHelpers, NotEqual_GameplayAttributeAttributePath);
 	FunctionClass = UModularAttributesHelpers::StaticClass();
 	OrphanedPinSaveMode = ESaveOrphanPinMode::SaveNone;
 }
@@ -44,8 +44,17 @@ void UMGAK2Node_SwitchGameplayAttribute::CreateFunctionPin()
 void UMGAK2Node_SwitchGameplayAttribute::PostLoad()
 {
 	Super::PostLoad();
-	if (UEdGraphPin* FunctionPin = FindPin(FunctionName))
+
+	// Nodes saved before the switch compared attribute handles have a function pin named after the previous function,
+	// find it before renaming so that it is kept instead of being orphaned
+	UEdGraphPin* FunctionPin = FindPin(FunctionName);
+
+	FunctionName = GET_FUNCTION_NAME_CHECKED(UModularAttributesHelpers, NotEqual_GameplayAttributeAttributePath);
+	FunctionClass = UModularAttributesHelpers::StaticClass();
+
+	if (FunctionPin)
 	{
+		FunctionPin->PinName = FunctionName;
 		FunctionPin->DefaultObject = FunctionClass->GetDefaultObject();
 	}
 }
@@ -114,12 +123,24 @@ FEdGraphPinType UMGAK2Node_SwitchGameplayAttribute::GetPinType() const
 
 FEdGraphPinType UMGAK2Node_SwitchGameplayAttribute::GetInnerCaseType() const
 {
-	// This type should match the second argument of UMGABlueprintLibrary::NotEqual_GameplayAttributeGameplayAttribute !
+	// This type should match the second argument of UModularAttributesHelpers::NotEqual_GameplayAttributeAttributePath !
 	FEdGraphPinType PinType;
-	PinType.PinCategory = UEdGraphSchema_K2::PC_String;
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Name;
 	return PinType;
 }
 
+FString UMGAK2Node_SwitchGameplayAttribute::GetExportTextForPin(const UEdGraphPin* Pin) const
+{
+	// Case values are baked as the attribute property path, resolved once at runtime to an attribute handle
+	const int32 Index = PinNames.IndexOfByKey(Pin->PinName);
+	if (PinAttributes.IsValidIndex(Index) && PinAttributes[Index].IsValid())
+	{
+		return PinAttributes[Index].GetUProperty()->GetPathName();
+	}
+
+	return Super::GetExportTextForPin(Pin);
+}
+
 FName UMGAK2Node_SwitchGameplayAttribute::GetPinNameGivenIndex(const int32 Index) const
 {
 	check(Index);
@@ -42,6 +42,7 @@ class UMGAK2Node_SwitchGameplayAttribute : public UK2Node_Switch
 	virtual FName GetUniquePinName() override;
 	virtual FEdGraphPinType GetPinType() const override;
 	virtual FEdGraphPinType GetInnerCaseType() const override;
+	virtual FString GetExportTextForPin(const UEdGraphPin* Pin) const override;
 	// End of UK2Node_Switch Interface
 
 	virtual FName GetPinNameGivenIndex(int32 Index) const override;
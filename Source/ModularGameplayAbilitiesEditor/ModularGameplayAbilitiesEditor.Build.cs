@@ -55,6 +55,7 @@ public class ModularGameplayAbilitiesEditor : ModuleRules
 				"RigVMDeveloper",
 				"Slate",
 				"SlateCore",
+				"ToolMenus",
 				"ToolWidgets",
 				"UnrealEd",
 			}
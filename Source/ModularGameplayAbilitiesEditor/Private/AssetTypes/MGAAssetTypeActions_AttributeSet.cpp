@@ -6,6 +6,8 @@
 #include "AssetTypes/MGABlueprintFactory.h"
 #include "Editor/MGABlueprintEditor.h"
 #include "Misc/MessageDialog.h"
+#include "ToolMenuSection.h"
+#include "Utilities/MGADataTableUtils.h"
 
 #define LOCTEXT_NAMESPACE "MGAAssetTypeActions_AttributeSet"
 
@@ -46,6 +48,37 @@ const TArray<FText>& FMGAAssetTypeActions_AttributeSet::GetSubMenus() const
 	return SubMenus;
 }
 
+void FMGAAssetTypeActions_AttributeSet::GetActions(const TArray<UObject*>& InObjects, FToolMenuSection& Section)
+{
+	FAssetTypeActions_Blueprint::GetActions(InObjects, Section);
+
+	const TArray<TWeakObjectPtr<UBlueprint>> Blueprints = GetTypedWeakObjectPtrs<UBlueprint>(InObjects);
+
+	Section.AddMenuEntry(
+		"MGA_GenerateDataTables",
+		LOCTEXT("GenerateDataTables", "Generate Attribute DataTables"),
+		LOCTEXT("GenerateDataTablesTooltip", "Creates or updates the FAttributeMetaData DataTable of each selected Attribute Set, next to it (MGAGenerateAttributeDataTables commandlet does the same headless)."),
+		FSlateIcon(),
+		FUIAction(FExecuteAction::CreateStatic(&FMGAAssetTypeActions_AttributeSet::ExecuteGenerateDataTables, Blueprints))
+	);
+}
+
+void FMGAAssetTypeActions_AttributeSet::ExecuteGenerateDataTables(TArray<TWeakObjectPtr<UBlueprint>> InBlueprints)
+{
+	TArray<UBlueprint*> Blueprints;
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : InBlueprints)
+	{
+		if (Blueprint.IsValid())
+		{
+			Blueprints.Add(Blueprint.Get());
+		}
+	}
+
+	// Left dirty for the user to review and save
+	TArray<UDataTable*> DataTables;
+	UE::MGA::DataTableUtils::GenerateDataTables(Blueprints, FString(), false, DataTables);
+}
+
 UFactory* FMGAAssetTypeActions_AttributeSet::GetFactoryForBlueprintType(UBlueprint* InBlueprint) const
 {
 	check(InBlueprint && InBlueprint->IsA(UMGAAttributeSetBlueprint::StaticClass()));
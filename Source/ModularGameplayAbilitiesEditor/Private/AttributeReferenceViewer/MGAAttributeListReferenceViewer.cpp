@@ -2,15 +2,11 @@
 
 #include "AttributeReferenceViewer/MGAAttributeListReferenceViewer.h"
 
-#include "AbilitySystemComponent.h"
+#include "AttributeSet.h"
 #include "Editor.h"
 #include "MGAEditorLog.h"
-#include "MGAEditorSettings.h"
-#include "IMGAEditorModule.h"
-#include "Attributes/MGAAttributeSetBlueprint.h"
 #include "Misc/EngineVersionComparison.h"
-#include "UObject/UObjectIterator.h"
-#include "Utilities/MGAUtilities.h"
+#include "Subsystems/MGAAttributeCatalogSubsystem.h"
 #include "Widgets/Input/SComboBox.h"
 #include "Widgets/Input/SSearchBox.h"
 #include "AssetRegistry/AssetIdentifier.h"
@@ -90,26 +86,7 @@ private:
 
 void SMGAAttributeListReferenceViewer::Construct(const FArguments& InArgs)
 {
-	struct FLocal
-	{
-		static void AttributeToStringArray(const FProperty& Property, OUT TArray<FString>& StringArray)
-		{
-			// MGA Changed ...
-			const UClass* Class = Property.GetOwnerClass();
-			if (Class->IsChildOf(UAttributeSet::StaticClass()) ||
-				(Class->IsChildOf(UAbilitySystemComponent::StaticClass()) && !Class->ClassGeneratedBy))
-			{
-				StringArray.Add(FString::Printf(TEXT("%s.%s"), *Class->GetName(), *Property.GetName()));
-			}
-		}
-	};
-	
-	// Setup text filtering
-	AttributeTextFilter = MakeShared<FAttributeTextFilter>(FAttributeTextFilter::FItemToStringArray::CreateStatic(&FLocal::AttributeToStringArray));
-	
-	// Preload to ensure BP Attributes are loaded in memory so that they can be listed here
-	IMGAEditorModule::Get().PreloadAssetsByClass(UMGAAttributeSetBlueprint::StaticClass());
-	
+	// BP Attributes are listed from the attribute catalog, without having to load them in memory
 	UpdatePropertyOptions();
 	
 	TWeakPtr<SMGAAttributeListReferenceViewer> WeakSelf = StaticCastWeakPtr<SMGAAttributeListReferenceViewer>(AsWeak());
@@ -171,8 +148,7 @@ void SMGAAttributeListReferenceViewer::Construct(const FArguments& InArgs)
 
 void SMGAAttributeListReferenceViewer::OnFilterTextChanged(const FText& InFilterText)
 {
-	AttributeTextFilter->SetRawFilterText(InFilterText);
-	SearchAttributeBox->SetError(AttributeTextFilter->GetFilterErrorText());
+	SearchText = InFilterText.ToString();
 
 	UpdatePropertyOptions();
 
@@ -188,87 +164,15 @@ void SMGAAttributeListReferenceViewer::UpdatePropertyOptions()
 {
 	PropertyOptions.Empty();
 
-	const UMGAEditorSettings& Settings = UMGAEditorSettings::Get();
+	FMGAAttributeCatalogQuery Query;
+	Query.SearchText = SearchText;
 
-	// Gather all UAttribute classes
-	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
-	{
-		const UClass* Class = *ClassIt;
+	TArray<TSharedPtr<const FMGAAttributeCatalogEntry>> Entries;
+	UMGAAttributeCatalogSubsystem::Get().Query(Query, Entries);
 
-		if (FMGAUtilities::IsValidAttributeClass(Class))
-		{
-			// Allow entire classes to be filtered globally
-			if (Class->HasMetaData(TEXT("HideInDetailsView")))
-			{
-				continue;
-			}
-
-			for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
-			{
-				FProperty* Property = *PropertyIt;
-
-				// if we have a search string and this doesn't match, don't show it
-				if (AttributeTextFilter.IsValid() && !AttributeTextFilter->PassesFilter(*Property))
-				{
-					MGA_EDITOR_NS_LOG(Warning, TEXT("%s filtered"), *Property->GetName());
-					continue;
-				}
-
-				// Allow properties to be filtered globally (never show up)
-				if (Property->HasMetaData(TEXT("HideInDetailsView")))
-				{
-					continue;
-				}
-
-				// Only allow field of expected types
-				FString CPPType = Property->GetCPPType();
-				if (!FMGAUtilities::IsValidCPPType(CPPType))
-				{
-					continue;
-				}
-
-				const FString AttributeName = FString::Printf(TEXT("%s.%s"), *FMGAUtilities::GetAttributeClassName(Class), *Property->GetName());
-
-				// Allow properties to be filtered globally via Developer Settings (never show up)
-				if (UMGAEditorSettings::IsAttributeFiltered(Settings.FilterAttributesList, AttributeName))
-				{
-					continue;
-				}
-
-				PropertyOptions.Add(MakeShared<FMGAAttributeListReferenceViewerNode>(Property, AttributeName));
-			}
-		}
-
-		// UAbilitySystemComponent can add 'system' attributes
-		if (Class->IsChildOf(UAbilitySystemComponent::StaticClass()) && !Class->ClassGeneratedBy)
-		{
-			for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
-			{
-				FProperty* Property = *PropertyIt;
-
-				// SystemAttributes have to be explicitly tagged
-				if (Property->HasMetaData(TEXT("SystemGameplayAttribute")) == false)
-				{
-					continue;
-				}
-
-				// if we have a search string and this doesn't match, don't show it
-				if (AttributeTextFilter.IsValid() && !AttributeTextFilter->PassesFilter(*Property))
-				{
-					continue;
-				}
-
-				const FString AttributeName = FString::Printf(TEXT("%s.%s"), *Class->GetName(), *Property->GetName());
-				
-				// Allow properties to be filtered globally via Developer Settings (never show up)
-				if (UMGAEditorSettings::IsAttributeFiltered(Settings.FilterAttributesList, AttributeName))
-				{
-					continue;
-				}
-
-				PropertyOptions.Add(MakeShared<FMGAAttributeListReferenceViewerNode>(Property, AttributeName));
-			}
-		}
+	for (const TSharedPtr<const FMGAAttributeCatalogEntry>& Entry : Entries)
+	{
+		PropertyOptions.Add(MakeShared<FMGAAttributeListReferenceViewerNode>(Entry, Entry->AttributeName));
 	}
 }
 
@@ -284,10 +188,11 @@ TSharedRef<ITableRow> SMGAAttributeListReferenceViewer::OnGenerateRowForAttribut
 
 void SMGAAttributeListReferenceViewer::OnAttributeSelectionChanged(TSharedPtr<FMGAAttributeListReferenceViewerNode> InItem, ESelectInfo::Type SelectInfo) const
 {
-	if (InItem.IsValid() && InItem->Attribute.IsValid())
+	if (InItem.IsValid() && InItem->Entry.IsValid())
 	{
+		// Owner class name (with _C suffix for Blueprints) is part of the class path, no need to load the Attribute Set
 		TArray<FAssetIdentifier> AssetIdentifiers;
-		const FName Name = FName(*FString::Printf(TEXT("%s.%s"), *InItem->Attribute->GetOwnerVariant().GetName(), *InItem->Attribute->GetName()));
+		const FName Name = FName(*FString::Printf(TEXT("%s.%s"), *InItem->Entry->OwnerClassPath.GetAssetName().ToString(), *InItem->Entry->PropertyName.ToString()));
 		AssetIdentifiers.Add(FAssetIdentifier(FGameplayAttribute::StaticStruct(), Name));
 		FEditorDelegates::OnOpenReferenceViewer.Broadcast(AssetIdentifiers, FReferenceViewerParams());	
 	}
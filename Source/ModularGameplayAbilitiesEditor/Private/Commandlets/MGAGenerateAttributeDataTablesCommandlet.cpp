@@ -0,0 +1,54 @@
+// Copyright Halcyonyx Studios.
+
+#include "Commandlets/MGAGenerateAttributeDataTablesCommandlet.h"
+
+#include "MGAEditorLog.h"
+#include "AssetRegistry/AssetData.h"
+#include "Attributes/MGAAttributeSetBlueprint.h"
+#include "Engine/DataTable.h"
+#include "Utilities/MGACommandletUtils.h"
+#include "Utilities/MGADataTableUtils.h"
+
+UMGAGenerateAttributeDataTablesCommandlet::UMGAGenerateAttributeDataTablesCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMGAGenerateAttributeDataTablesCommandlet::Main(const FString& Params)
+{
+	FString OutputPath;
+	FParse::Value(*Params, TEXT("OutputPath="), OutputPath);
+	const bool bSave = !FParse::Param(*Params, TEXT("NoSave"));
+
+	TArray<FAssetData> Assets;
+	UE::MGA::CommandletUtils::GetAssetsFromParams(Params, UMGAAttributeSetBlueprint::StaticClass(), Assets);
+
+	MGA_EDITOR_LOG(Display, TEXT("UMGAGenerateAttributeDataTablesCommandlet - Generating DataTables for %d Attribute Set Blueprints"), Assets.Num())
+
+	TArray<UBlueprint*> Blueprints;
+	Blueprints.Reserve(Assets.Num());
+	for (const FAssetData& Asset : Assets)
+	{
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset()))
+		{
+			Blueprints.Add(Blueprint);
+		}
+		else
+		{
+			MGA_EDITOR_LOG(Warning, TEXT("UMGAGenerateAttributeDataTablesCommandlet - Failed to load %s"), *Asset.PackageName.ToString())
+		}
+	}
+
+	TArray<UDataTable*> DataTables;
+	UE::MGA::DataTableUtils::GenerateDataTables(Blueprints, OutputPath, bSave, DataTables);
+
+	for (const UDataTable* DataTable : DataTables)
+	{
+		MGA_EDITOR_LOG(Display, TEXT("\t%s (%d rows)"), *DataTable->GetPathName(), DataTable->GetRowMap().Num())
+	}
+
+	return DataTables.Num() == Blueprints.Num() && Blueprints.Num() == Assets.Num() ? 0 : 1;
+}
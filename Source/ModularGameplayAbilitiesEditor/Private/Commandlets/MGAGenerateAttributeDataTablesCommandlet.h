@@ -0,0 +1,34 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MGAGenerateAttributeDataTablesCommandlet.generated.h"
+
+/**
+ * Generates (or updates) the FAttributeMetaData DataTables of many Attribute Set Blueprints at once, the same way the
+ * "Create DataTable" window does for a single one.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=MGAGenerateAttributeDataTables [-Blueprints=/Game/A+/Game/B] [-Paths=/Game/Attributes+/Game/Other] [-OutputPath=/Game/Data] [-NoSave]
+ *
+ * - Blueprints: package names of the Attribute Set Blueprints to generate DataTables for
+ * - Paths: content folders (recursive) to look for Attribute Set Blueprints in
+ * - OutputPath: content folder of the generated DataTables, next to each Blueprint if omitted
+ * - NoSave: only generate the DataTables in memory (eg. to check for errors)
+ *
+ * Blueprints and Paths add up (Blueprints listed or under one of the paths are used), all Attribute Set Blueprints of the
+ * project are used when neither is given.
+ */
+UCLASS()
+class UMGAGenerateAttributeDataTablesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMGAGenerateAttributeDataTablesCommandlet();
+
+	//~ Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet interface
+};
@@ -0,0 +1,232 @@
+// Copyright Halcyonyx Studios.
+
+#include "Commandlets/MGAValidateAttributeSetsCommandlet.h"
+
+#include "MGAEditorLog.h"
+#include "Algo/Count.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Attributes/MGAAttributeSetBlueprint.h"
+#include "Attributes/MGAAttributeSetValidationCache.h"
+#include "Attributes/ModularAttributeSetBase.h"
+#include "Engine/Blueprint.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utilities/MGACommandletUtils.h"
+
+UMGAValidateAttributeSetsCommandlet::UMGAValidateAttributeSetsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMGAValidateAttributeSetsCommandlet::Main(const FString& Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FString JUnitFilePath = FPaths::ProjectSavedDir() / TEXT("ModularGameplayAbilities") / TEXT("AttributeSetValidation.xml");
+	FParse::Value(*Params, TEXT("JUnit="), JUnitFilePath);
+	const bool bUseCache = !FParse::Param(*Params, TEXT("NoCache"));
+
+	FMGAAttributeSetValidationCache& Cache = FMGAAttributeSetValidationCache::Get();
+	if (!bUseCache)
+	{
+		Cache.Reset();
+	}
+
+	TArray<FAssetData> Assets;
+	UE::MGA::CommandletUtils::GetAssetsFromParams(Params, UMGAAttributeSetBlueprint::StaticClass(), Assets);
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FTestCase> TestCases;
+	TestCases.SetNum(Assets.Num());
+
+	// Reuse cached results of unchanged Blueprints. Only asset registry data is read, no UObject.
+	for (int32 Index = 0; Index < Assets.Num(); ++Index)
+	{
+		FTestCase& TestCase = TestCases[Index];
+		TestCase.AssetData = Assets[Index];
+
+		FMGAAttributeSetValidationEntry Entry;
+		if (bUseCache && FindUpToDateResult(AssetRegistry, TestCase.AssetData, Entry))
+		{
+			TestCase.Result = Entry.Result;
+			TestCase.Errors = MoveTemp(Entry.Errors);
+			TestCase.bCached = true;
+		}
+	}
+
+	// Request loads for the others so that they load concurrently
+	TArray<int32> TestCasesToLoad;
+	for (int32 Index = 0; Index < TestCases.Num(); ++Index)
+	{
+		if (!TestCases[Index].bCached)
+		{
+			TestCasesToLoad.Add(Index);
+			LoadPackageAsync(TestCases[Index].AssetData.PackageName.ToString());
+		}
+	}
+
+	MGA_EDITOR_LOG(Display, TEXT("UMGAValidateAttributeSetsCommandlet - Validating %d Attribute Set Blueprints (%d up to date, %d to load)"), TestCases.Num(), TestCases.Num() - TestCasesToLoad.Num(), TestCasesToLoad.Num())
+
+	FlushAsyncLoading();
+
+	// Validation walks the loaded Blueprints and their graphs, on the game thread
+	for (const int32 TestCaseIndex : TestCasesToLoad)
+	{
+		const double TestStartTime = FPlatformTime::Seconds();
+
+		FTestCase& TestCase = TestCases[TestCaseIndex];
+
+		const UBlueprint* Blueprint = Cast<UBlueprint>(TestCase.AssetData.GetAsset());
+		const UModularAttributeSetBase* DefaultObject = Blueprint && Blueprint->GeneratedClass ? Cast<UModularAttributeSetBase>(Blueprint->GeneratedClass->GetDefaultObject()) : nullptr;
+		if (!DefaultObject)
+		{
+			TestCase.Result = EDataValidationResult::Invalid;
+			TestCase.Errors.Add(FString::Printf(TEXT("Failed to load %s"), *TestCase.AssetData.PackageName.ToString()));
+			TestCase.bLoadFailed = true;
+			continue;
+		}
+
+		TArray<FText> ValidationErrors;
+		TestCase.Result = DefaultObject->IsDataValidReplication(ValidationErrors);
+		for (const FText& ValidationError : ValidationErrors)
+		{
+			TestCase.Errors.Add(ValidationError.ToString());
+		}
+
+		TestCase.Seconds = FPlatformTime::Seconds() - TestStartTime;
+	}
+
+	Cache.Save();
+
+	for (const FTestCase& TestCase : TestCases)
+	{
+		if (TestCase.Result == EDataValidationResult::Invalid)
+		{
+			MGA_EDITOR_LOG(Error, TEXT("%s is invalid%s"), *TestCase.AssetData.PackageName.ToString(), TestCase.bCached ? TEXT(" (cached)") : TEXT(""))
+			for (const FString& Error : TestCase.Errors)
+			{
+				MGA_EDITOR_LOG(Error, TEXT("\t%s"), *Error)
+			}
+		}
+	}
+
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	const int32 NumFailures = Algo::CountIf(TestCases, [](const FTestCase& TestCase) { return TestCase.Result == EDataValidationResult::Invalid; });
+
+	MGA_EDITOR_LOG(Display, TEXT("UMGAValidateAttributeSetsCommandlet - %d / %d Attribute Set Blueprints invalid, took %.2f seconds"), NumFailures, TestCases.Num(), TotalSeconds)
+
+	if (!WriteJUnitReport(JUnitFilePath, TestCases, TotalSeconds))
+	{
+		MGA_EDITOR_LOG(Error, TEXT("UMGAValidateAttributeSetsCommandlet - Failed to write %s"), *JUnitFilePath)
+		return 1;
+	}
+
+	return NumFailures == 0 ? 0 : 1;
+}
+
+bool UMGAValidateAttributeSetsCommandlet::FindUpToDateResult(const IAssetRegistry& InAssetRegistry, const FAssetData& InAssetData, FMGAAttributeSetValidationEntry& OutEntry)
+{
+	// Walk up the parent Blueprints until a native class, same hashes as UModularAttributeSetBase::GetReplicationValidationKey()
+	TArray<FName, TInlineAllocator<4>> PackageNames;
+	TArray<FBlake3Hash, TInlineAllocator<4>> BlueprintHashes;
+
+	FAssetData AssetData = InAssetData;
+	while (true)
+	{
+		FString BlueprintHash;
+		if (!AssetData.GetTagValue(UMGAAttributeSetBlueprint::ReplicationValidationHashTagName, BlueprintHash))
+		{
+			return false;
+		}
+
+		PackageNames.Add(AssetData.PackageName);
+		LexFromString(BlueprintHashes.AddDefaulted_GetRef(), *BlueprintHash);
+
+		FString ParentClassPath;
+		if (!AssetData.GetTagValue(FBlueprintTags::ParentClassPath, ParentClassPath))
+		{
+			break;
+		}
+
+		const FName ParentPackageName = *FPackageName::ObjectPathToPackageName(FPackageName::ExportTextPathToObjectPath(ParentClassPath));
+		if (FPackageName::IsScriptPackage(ParentPackageName.ToString()))
+		{
+			break;
+		}
+
+		if (PackageNames.Contains(ParentPackageName))
+		{
+			return false;
+		}
+
+		TArray<FAssetData> ParentAssets;
+		InAssetRegistry.GetAssetsByPackageName(ParentPackageName, ParentAssets);
+		const FAssetData* ParentAsset = ParentAssets.FindByPredicate([](const FAssetData& Asset) { return Asset.TagsAndValues.Contains(FBlueprintTags::ParentClassPath); });
+		if (!ParentAsset)
+		{
+			return false;
+		}
+
+		AssetData = *ParentAsset;
+	}
+
+	return FMGAAttributeSetValidationCache::Get().Find(InAssetData.PackageName, FMGAAttributeSetValidationCache::MakeKey(BlueprintHashes), OutEntry);
+}
+
+bool UMGAValidateAttributeSetsCommandlet::WriteJUnitReport(const FString& InFilePath, const TArray<FTestCase>& InTestCases, const double InTotalSeconds)
+{
+	const int32 NumFailures = Algo::CountIf(InTestCases, [](const FTestCase& TestCase) { return TestCase.Result == EDataValidationResult::Invalid && !TestCase.bLoadFailed; });
+	const int32 NumErrors = Algo::CountIf(InTestCases, [](const FTestCase& TestCase) { return TestCase.bLoadFailed; });
+
+	TStringBuilder<4096> Report;
+	Report << TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	Report.Appendf(TEXT("<testsuites tests=\"%d\" failures=\"%d\" errors=\"%d\" time=\"%.3f\">\n"), InTestCases.Num(), NumFailures, NumErrors, InTotalSeconds);
+	Report.Appendf(TEXT("\t<testsuite name=\"MGA.AttributeSetValidation\" tests=\"%d\" failures=\"%d\" errors=\"%d\" time=\"%.3f\">\n"), InTestCases.Num(), NumFailures, NumErrors, InTotalSeconds);
+
+	for (const FTestCase& TestCase : InTestCases)
+	{
+		const FString PackagePath = FPackageName::GetLongPackagePath(TestCase.AssetData.PackageName.ToString());
+		Report.Appendf(
+			TEXT("\t\t<testcase classname=\"%s\" name=\"%s\" time=\"%.3f\">\n"),
+			*EscapeXml(PackagePath),
+			*EscapeXml(TestCase.AssetData.AssetName.ToString()),
+			TestCase.Seconds
+		);
+
+		if (TestCase.Result == EDataValidationResult::Invalid)
+		{
+			const FString Message = TestCase.Errors.IsEmpty() ? FString() : TestCase.Errors[0];
+			const TCHAR* Tag = TestCase.bLoadFailed ? TEXT("error") : TEXT("failure");
+			Report.Appendf(TEXT("\t\t\t<%s message=\"%s\">%s</%s>\n"), Tag, *EscapeXml(Message), *EscapeXml(FString::Join(TestCase.Errors, TEXT("\n"))), Tag);
+		}
+
+		if (TestCase.bCached)
+		{
+			Report << TEXT("\t\t\t<system-out>Cached result, Blueprint unchanged since last validation</system-out>\n");
+		}
+
+		Report << TEXT("\t\t</testcase>\n");
+	}
+
+	Report << TEXT("\t</testsuite>\n");
+	Report << TEXT("</testsuites>\n");
+
+	return FFileHelper::SaveStringToFile(Report.ToView(), *InFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString UMGAValidateAttributeSetsCommandlet::EscapeXml(const FString& InString)
+{
+	FString Escaped = InString.Replace(TEXT("&"), TEXT("&amp;"));
+	Escaped.ReplaceInline(TEXT("<"), TEXT("&lt;"));
+	Escaped.ReplaceInline(TEXT(">"), TEXT("&gt;"));
+	Escaped.ReplaceInline(TEXT("\""), TEXT("&quot;"));
+	Escaped.ReplaceInline(TEXT("'"), TEXT("&apos;"));
+	return Escaped;
+}
@@ -0,0 +1,72 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Commandlets/Commandlet.h"
+#include "Misc/DataValidation.h"
+#include "MGAValidateAttributeSetsCommandlet.generated.h"
+
+class IAssetRegistry;
+struct FMGAAttributeSetValidationEntry;
+
+/**
+ * Validates the replicated variables, rep notify graphs and replication rules of many Attribute Set Blueprints at once
+ * (see UModularAttributeSetBase::IsDataValidReplication()), and writes a JUnit report for CI.
+ *
+ * Blueprints whose content (and parent Attribute Set Blueprints content) didn't change since the last validation reuse the
+ * cached result without being loaded, keys are computed from the validation hashes saved to the asset registry (see
+ * UMGAAttributeSetBlueprint::ReplicationValidationHashTagName). The others are loaded concurrently, then validated one by
+ * one on the game thread: validation reads the loaded Blueprints and their graphs.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=MGAValidateAttributeSets [-Blueprints=/Game/A+/Game/B] [-Paths=/Game/Attributes+/Game/Other] [-JUnit=Report.xml] [-NoCache]
+ *
+ * - Blueprints: package names of the Attribute Set Blueprints to validate
+ * - Paths: content folders (recursive) to look for Attribute Set Blueprints in
+ * - JUnit: path of the JUnit report, Saved/ModularGameplayAbilities/AttributeSetValidation.xml if omitted
+ * - NoCache: discard cached results and validate every Blueprint
+ *
+ * Blueprints and Paths add up (Blueprints listed or under one of the paths are validated), all Attribute Set Blueprints of
+ * the project are validated when neither is given. Returns non zero
+ * if any Blueprint failed to load or is invalid.
+ */
+UCLASS()
+class UMGAValidateAttributeSetsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMGAValidateAttributeSetsCommandlet();
+
+	//~ Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet interface
+
+private:
+	/** Validation outcome of a single Attribute Set Blueprint */
+	struct FTestCase
+	{
+		FAssetData AssetData;
+		EDataValidationResult Result = EDataValidationResult::NotValidated;
+		TArray<FString> Errors;
+		double Seconds = 0.0;
+
+		/** Whether the result comes from the validation cache, without loading the Blueprint */
+		bool bCached = false;
+
+		/** Whether the Blueprint failed to load */
+		bool bLoadFailed = false;
+	};
+
+	/**
+	 * Finds the cached result of InAssetData, if it was computed from the saved content of InAssetData and its parent
+	 * Blueprints (parent graphs are walked when validating a child Blueprint). Only reads asset registry data, false for
+	 * Blueprints saved without a validation hash.
+	 */
+	static bool FindUpToDateResult(const IAssetRegistry& InAssetRegistry, const FAssetData& InAssetData, FMGAAttributeSetValidationEntry& OutEntry);
+
+	static bool WriteJUnitReport(const FString& InFilePath, const TArray<FTestCase>& InTestCases, double InTotalSeconds);
+
+	static FString EscapeXml(const FString& InString);
+};
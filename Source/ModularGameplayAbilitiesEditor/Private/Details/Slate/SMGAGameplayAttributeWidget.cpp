@@ -2,17 +2,11 @@
 
 #include "Details/Slate/SMGAGameplayAttributeWidget.h"
 
-#include "AbilitySystemComponent.h"
-#include "AttributeSet.h"
 #include "Editor.h"
 #include "MGAEditorLog.h"
-#include "MGAEditorSettings.h"
-#include "IMGAEditorModule.h"
 #include "SlateOptMacros.h"
-#include "Attributes/MGAAttributeSetBlueprint.h"
-#include "Misc/TextFilter.h"
+#include "Subsystems/MGAAttributeCatalogSubsystem.h"
 #include "UObject/PropertyAccessUtil.h"
-#include "UObject/UObjectIterator.h"
 #include "UObject/UnrealType.h"
 #include "Utilities/MGAUtilities.h"
 #include "Widgets/Input/SComboBox.h"
@@ -31,16 +25,17 @@ BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
 struct FMGAGameplayAttributeViewerNode
 {
-	FMGAGameplayAttributeViewerNode(FProperty* InAttribute, const FString InAttributeName)
+	FMGAGameplayAttributeViewerNode(const TSharedPtr<const FMGAAttributeCatalogEntry>& InEntry, const FString InAttributeName)
 	{
-		Attribute = InAttribute;
+		Entry = InEntry;
 		AttributeName = MakeShareable(new FString(InAttributeName));
 	}
 
 	/** The displayed name for this node. */
 	TSharedPtr<FString> AttributeName;
 
-	TWeakFieldPtr<FProperty> Attribute;
+	/** Catalog entry of the attribute, its Blueprint is only loaded once picked. Null for the "None" node. */
+	TSharedPtr<const FMGAAttributeCatalogEntry> Entry;
 };
 
 /** The item used for visualizing the attribute in the list. */
@@ -138,8 +133,6 @@ public:
 	virtual ~SMGAGameplayAttributeListWidget() override;
 
 private:
-	typedef TTextFilter<const FProperty&> FAttributeTextFilter;
-
 	/** Called by Slate when the filter box changes text. */
 	void OnFilterTextChanged(const FText& InFilterText);
 
@@ -164,8 +157,8 @@ private:
 	/** Array of items that can be selected in the dropdown menu */
 	TArray<TSharedPtr<FMGAGameplayAttributeViewerNode>> PropertyOptions;
 
-	/** Filters needed for filtering the assets */
-	TSharedPtr<FAttributeTextFilter> AttributeTextFilter;
+	/** Current search text, see UMGAAttributeCatalogSubsystem::Query() */
+	FString SearchText;
 
 	/** Filter for meta data */
 	FString FilterMetaData;
@@ -187,38 +180,12 @@ SMGAGameplayAttributeListWidget::~SMGAGameplayAttributeListWidget()
 
 void SMGAGameplayAttributeListWidget::Construct(const FArguments& InArgs)
 {
-	struct FLocal
-	{
-		static void AttributeToStringArray(const FProperty& Property, OUT TArray<FString>& StringArray)
-		{
-			// UClass* Class = Property.GetOwnerClass();
-			// if ((Class->IsChildOf(UAttributeSet::StaticClass()) && !Class->ClassGeneratedBy) ||
-			// 	(Class->IsChildOf(UAbilitySystemComponent::StaticClass()) && !Class->ClassGeneratedBy))
-			// {
-			// 	StringArray.Add(FString::Printf(TEXT("%s.%s"), *Class->GetName(), *Property.GetName()));
-			// }
-
-			// MGA Changed ...
-			const UClass* Class = Property.GetOwnerClass();
-			if (Class->IsChildOf(UAttributeSet::StaticClass()) ||
-				(Class->IsChildOf(UAbilitySystemComponent::StaticClass()) && !Class->ClassGeneratedBy))
-			{
-				StringArray.Add(FString::Printf(TEXT("%s.%s"), *Class->GetName(), *Property.GetName()));
-			}
-		}
-	};
-
 	FilterMetaData = InArgs._FilterMetaData;
 	OnAttributePicked = InArgs._OnAttributePickedDelegate;
 	FilterClass = InArgs._FilterClass;
 	bShowOnlyOwnedAttributes = InArgs._ShowOnlyOwnedAttributes;
 
-	// Setup text filtering
-	AttributeTextFilter = MakeShared<FAttributeTextFilter>(FAttributeTextFilter::FItemToStringArray::CreateStatic(&FLocal::AttributeToStringArray));
-
-	// Preload to ensure BP Attributes are loaded in memory so that they can be listed here
-	IMGAEditorModule::Get().PreloadAssetsByClass(UMGAAttributeSetBlueprint::StaticClass());
-
+	// BP Attributes are listed from the attribute catalog, without having to load them in memory
 	UpdatePropertyOptions();
 	
 	TSharedPtr<SWidget> ClassViewerContent;
@@ -293,107 +260,25 @@ TSharedPtr<FMGAGameplayAttributeViewerNode> SMGAGameplayAttributeListWidget::Upd
 
 	PropertyOptions.Add(InitiallySelected);
 
-	const UMGAEditorSettings& Settings = UMGAEditorSettings::Get();
-
-	// Use IncludeSuper for iteration here only if bShowOnlyOwnedAttributed is used. To handle the use case of
+	// Include super classes here only if bShowOnlyOwnedAttributed is used. To handle the use case of
 	// FMGAClampedAttributeData defined in a native class (for instance after wizard generation), whose value
 	// are tweaked in the details panel of a child Blueprint
-	
-	// EFieldIteratorFlags::SuperClassFlags IteratorFlag = EFieldIteratorFlags::ExcludeSuper;
-	const EFieldIteratorFlags::SuperClassFlags IteratorFlag = bShowOnlyOwnedAttributes ? EFieldIteratorFlags::IncludeSuper : EFieldIteratorFlags::ExcludeSuper;
-
-	// Gather all UAttribute classes
-	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	//
+	// If we have been given a FilterClass, only show attributes of this AttributeSet class
+	// (Way it's done right now, is containing details customization checks for ShowOnlyOwnedAttributed metadata on the
+	// FGameplayAttribute property, and only passes down outer base class if metadata is present)
+	FMGAAttributeCatalogQuery Query;
+	Query.SearchText = SearchText;
+	Query.FilterClass = FilterClass.Get();
+	Query.bIncludeSuperClasses = bShowOnlyOwnedAttributes;
+	Query.FilterMetaData = FilterMetaData;
+
+	TArray<TSharedPtr<const FMGAAttributeCatalogEntry>> Entries;
+	UMGAAttributeCatalogSubsystem::Get().Query(Query, Entries);
+
+	for (const TSharedPtr<const FMGAAttributeCatalogEntry>& Entry : Entries)
 	{
-		const UClass* Class = *ClassIt;
-
-		// If we have been given a FilterClass, only show attributes of this AttributeSet class
-		// (Way it's done right now, is containing details customization checks for ShowOnlyOwnedAttributed metadata on the
-		// FGameplayAttribute property, and only passes down outer base class if metadata is present)
-		if (FilterClass.IsValid() && !Class->IsChildOf(FilterClass.Get()))
-		{
-			continue;
-		}
-		
-		if (FMGAUtilities::IsValidAttributeClass(Class))
-		{
-			// Allow entire classes to be filtered globally
-			if (Class->HasMetaData(TEXT("HideInDetailsView")))
-			{
-				continue;
-			}
-
-			for (TFieldIterator<FProperty> PropertyIt(Class, IteratorFlag); PropertyIt; ++PropertyIt)
-			{
-				FProperty* Property = *PropertyIt;
-
-				// if we have a search string and this doesn't match, don't show it
-				if (AttributeTextFilter.IsValid() && !AttributeTextFilter->PassesFilter(*Property))
-				{
-					continue;
-				}
-
-				// don't show attributes that are filtered by meta data
-				if (!FilterMetaData.IsEmpty() && Property->HasMetaData(*FilterMetaData))
-				{
-					continue;
-				}
-
-				// Allow properties to be filtered globally (never show up)
-				if (Property->HasMetaData(TEXT("HideInDetailsView")))
-				{
-					continue;
-				}
-
-				// Only allow field of expected types
-				FString CPPType = Property->GetCPPType();
-				if (!FMGAUtilities::IsValidCPPType(CPPType))
-				{
-					continue;
-				}
-
-				const FString AttributeName = FString::Printf(TEXT("%s.%s"), *FMGAUtilities::GetAttributeClassName(Class), *Property->GetName());
-
-				// Allow properties to be filtered globally via Developer Settings (never show up)
-				if (UMGAEditorSettings::IsAttributeFiltered(Settings.FilterAttributesList, AttributeName))
-				{
-					continue;
-				}
-
-				PropertyOptions.Add(MakeShared<FMGAGameplayAttributeViewerNode>(Property, AttributeName));
-			}
-		}
-
-		// UAbilitySystemComponent can add 'system' attributes
-		if (Class->IsChildOf(UAbilitySystemComponent::StaticClass()) && !Class->ClassGeneratedBy)
-		{
-			for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
-			{
-				FProperty* Property = *PropertyIt;
-
-				// SystemAttributes have to be explicitly tagged
-				if (Property->HasMetaData(TEXT("SystemGameplayAttribute")) == false)
-				{
-					continue;
-				}
-
-				// if we have a search string and this doesn't match, don't show it
-				if (AttributeTextFilter.IsValid() && !AttributeTextFilter->PassesFilter(*Property))
-				{
-					continue;
-				}
-
-				const FString AttributeName = FString::Printf(TEXT("%s.%s"), *Class->GetName(), *Property->GetName());
-				
-				// Allow properties to be filtered globally via Developer Settings (never show up)
-				if (UMGAEditorSettings::IsAttributeFiltered(Settings.FilterAttributesList, AttributeName))
-				{
-					continue;
-				}
-
-				PropertyOptions.Add(MakeShared<FMGAGameplayAttributeViewerNode>(Property, AttributeName));
-			}
-		}
+		PropertyOptions.Add(MakeShared<FMGAGameplayAttributeViewerNode>(Entry, Entry->AttributeName));
 	}
 
 	return InitiallySelected;
@@ -401,16 +286,22 @@ TSharedPtr<FMGAGameplayAttributeViewerNode> SMGAGameplayAttributeListWidget::Upd
 
 void SMGAGameplayAttributeListWidget::OnFilterTextChanged(const FText& InFilterText)
 {
-	AttributeTextFilter->SetRawFilterText(InFilterText);
-	SearchBoxPtr->SetError(AttributeTextFilter->GetFilterErrorText());
+	SearchText = InFilterText.ToString();
 
 	UpdatePropertyOptions();
+
+	if (AttributeList.IsValid())
+	{
+		AttributeList->RequestListRefresh();
+	}
 }
 
 // ReSharper disable once CppParameterNeverUsed
 void SMGAGameplayAttributeListWidget::OnAttributeSelectionChanged(const TSharedPtr<FMGAGameplayAttributeViewerNode> Item, ESelectInfo::Type SelectInfo) const
 {
-	OnAttributePicked.ExecuteIfBound(Item->Attribute.Get());
+	// Loads the owning Attribute Set Blueprint if needed, only now that it's been picked
+	FProperty* Property = Item.IsValid() && Item->Entry.IsValid() ? Item->Entry->LoadProperty() : nullptr;
+	OnAttributePicked.ExecuteIfBound(Property);
 }
 
 void SMGAGameplayAttributeWidget::Construct(const FArguments& InArgs)
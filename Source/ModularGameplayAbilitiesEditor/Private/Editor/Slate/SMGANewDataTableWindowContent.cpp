@@ -25,6 +25,7 @@
 #include "Misc/EngineVersionComparison.h"
 #include "Styling/MGAAppStyle.h"
 #include "Subsystems/MGAEditorSubsystem.h"
+#include "Utilities/MGADataTableUtils.h"
 #include "Utilities/MGAUtilities.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
@@ -53,7 +54,7 @@ void SMGANewDataTableWindowContent::Construct(const FArguments& InArgs, const TW
 	// Init view model
 	ViewModel = MakeShared<FNewDataTableWindowViewModel>();
 	ViewModel->SetSelectedPath(VirtualPath.ToString());
-	ViewModel->SetAssetName(FString::Printf(TEXT("DT_%s"), *FMGAUtilities::GetAttributeClassName(InBlueprint->GeneratedClass)));
+	ViewModel->SetAssetName(UE::MGA::DataTableUtils::GetDefaultDataTableName(InBlueprint.Get()));
 	ViewModel->OnModelPropertyChanged().AddThreadSafeSP(this, &SMGANewDataTableWindowContent::HandleModelPropertyChanged);
 
 	FPathPickerConfig PathPickerConfig;
@@ -84,12 +85,9 @@ void SMGANewDataTableWindowContent::Construct(const FArguments& InArgs, const TW
 		.SelectionMode(ESelectionMode::Single)
 		.AllowOverscroll(EAllowOverscroll::No);
 
-	const FString CSV = GenerateCSVFromMGAAttributes(Blueprint);
-	MGA_EDITOR_LOG(Verbose, TEXT("CSV Result:\n\n%s"), *CSV)
-
+	// Rows are filled in directly from the reflected attribute properties, no CSV round trip
 	UDataTable* DataTable = NewObject<UDataTable>(GetTransientPackage(), UDataTable::StaticClass());
-	DataTable->RowStruct = FAttributeMetaData::StaticStruct();
-	DataTable->CreateTableFromCSVString(CSV);
+	UE::MGA::DataTableUtils::PopulateDataTable(Blueprint.Get(), DataTable);
 	BuildDataColumnsAndRows(DataTable);
 
 	ChildSlot
@@ -291,84 +289,33 @@ FString SMGANewDataTableWindowContent::GenerateCSVFromMGAAttributes(const TWeakO
 	check(InBlueprint.IsValid());
 	check(InBlueprint->SkeletonGeneratedClass);
 
-	FString CSV;
-
-	const UClass* OwnerClass = InBlueprint->GeneratedClass;
-
-	TArray<FProperty*> Properties;
-	FMGAUtilities::GetAllAttributeFromClass(OwnerClass, Properties);
-
-	MGA_EDITOR_LOG(
-		Verbose,
-		TEXT("SMGANewDataTableWindowContent::GenerateCSVFromMGAAttributes Blueprint: %s, Properties: %d"),
-		*GetNameSafe(InBlueprint.Get()),
-		Properties.Num()
-	)
-
-	UAttributeSet* CDO = Cast<UAttributeSet>(OwnerClass->GetDefaultObject());
-	if (!ensureMsgf(CDO, TEXT("Invalid CDO couldn't cast to UAttributeSet from %s"), *GetNameSafe(OwnerClass)))
-	{
-		return CSV;
-	}
-
-	CSV.Append(TEXT("---,BaseValue,MinValue,MaxValue,DerivedAttributeInfo,bCanStack"));
-	const FString AttributeClassName = FMGAUtilities::GetAttributeClassName(OwnerClass);
+	TArray<TPair<FName, FAttributeMetaData>> Rows;
+	UE::MGA::DataTableUtils::GetAttributeMetaDataRows(InBlueprint.Get(), Rows);
 
-	for (const FProperty* Property : Properties)
+	TStringBuilder<4096> CSV;
+	CSV << TEXT("---,BaseValue,MinValue,MaxValue,DerivedAttributeInfo,bCanStack");
+	for (const TPair<FName, FAttributeMetaData>& Row : Rows)
 	{
-		MGA_EDITOR_LOG(Verbose, TEXT("\tProperty: %s (OwnerClass: %s, CDO: %s)"), *GetNameSafe(Property), *GetNameSafe(OwnerClass), *GetNameSafe(CDO))
-		if (!FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
-		{
-			continue;
-		}
-
-		FGameplayAttribute Attribute = FindFProperty<FProperty>(OwnerClass, Property->GetFName());
-		if (UModularAttributeSetBase::IsGameplayAttributeDataClampedProperty(Property))
-		{
-			if (const FMGAClampedAttributeData* Clamped = static_cast<FMGAClampedAttributeData*>(Attribute.GetGameplayAttributeData(CDO)))
-			{
-				const float MinValue = Clamped->MinValue.GetValueForClamping(CDO);
-				const float MaxValue = Clamped->MaxValue.GetValueForClamping(CDO);
-				
-				CSV.Append(FString::Printf(
-					TEXT("\r\n%s.%s,\"%f\",\"%f\",\"%f\",\"\",\"False\""),
-					*AttributeClassName,
-					*GetNameSafe(Property),
-					Clamped->GetBaseValue(),
-					MinValue,
-					MaxValue
-				));
-			}
-		}
-		else
-		{
-			const FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeDataChecked(CDO);
-			check(AttributeData);
-
-			CSV.Append(FString::Printf(
-				TEXT("\r\n%s.%s,\"%f\",\"%f\",\"%f\",\"\",\"False\""),
-				*AttributeClassName,
-				*GetNameSafe(Property),
-				AttributeData->GetBaseValue(),
-				0.f,
-				0.f
-			));
-		}
+		CSV.Appendf(
+			TEXT("\r\n%s,\"%f\",\"%f\",\"%f\",\"%s\",\"%s\""),
+			*Row.Key.ToString(),
+			Row.Value.BaseValue,
+			Row.Value.MinValue,
+			Row.Value.MaxValue,
+			*Row.Value.DerivedAttributeInfo,
+			Row.Value.bCanStack ? TEXT("True") : TEXT("False")
+		);
 	}
 
-	return CSV;
+	return CSV.ToString();
 }
 
 void SMGANewDataTableWindowContent::HandleBlueprintChanged(UBlueprint* InBlueprint)
 {
 	MGA_EDITOR_LOG(Verbose, TEXT("SMGANewDataTableWindowContent::HandleBlueprintChanged %s"), *GetNameSafe(InBlueprint))
 
-	const FString CSV = GenerateCSVFromMGAAttributes(InBlueprint);
-	MGA_EDITOR_LOG(Verbose, TEXT("CSV Result:\n\n%s"), *CSV)
-
 	UDataTable* DataTable = NewObject<UDataTable>(GetTransientPackage(), UDataTable::StaticClass());
-	DataTable->RowStruct = FAttributeMetaData::StaticStruct();
-	DataTable->CreateTableFromCSVString(CSV);
+	UE::MGA::DataTableUtils::PopulateDataTable(InBlueprint, DataTable);
 
 	AvailableColumns.Reset();
 	AvailableRows.Reset();
@@ -659,23 +606,15 @@ FReply SMGANewDataTableWindowContent::OnConfirmClicked()
 {
 	check(Blueprint.IsValid());
 
-	const FString PackageName = UPackageTools::SanitizePackageName(GetObjectPathForSave(false));
-	UPackage* Pkg = CreatePackage(*PackageName);
-	if (!ensure(Pkg))
+	const FString PackagePath = FPackageName::GetLongPackagePath(GetObjectPathForSave(false));
+	UDataTable* NewDataTable = UE::MGA::DataTableUtils::CreateOrUpdateDataTable(Blueprint.Get(), PackagePath, ViewModel->GetAssetName());
+	if (!ensure(NewDataTable))
 	{
 		CloseDialog();
 		// Failed to create the package to hold this asset for some reason
 		return FReply::Handled();
 	}
 
-	// Make sure the destination package is loaded
-	Pkg->FullyLoad();
-
-	constexpr EObjectFlags Flags = RF_Public | RF_Standalone | RF_Transactional;
-	UDataTable* NewDataTable = NewObject<UDataTable>(Pkg, UDataTable::StaticClass(), FName(*ViewModel->GetAssetName()), Flags);
-	NewDataTable->RowStruct = FAttributeMetaData::StaticStruct();
-	NewDataTable->CreateTableFromCSVString(GenerateCSVFromMGAAttributes(Blueprint));
-
 	// Close editor if existing asset already and is currently opened
 	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 #if UE_VERSION_NEWER_THAN(5, 1, -1)
@@ -58,6 +58,7 @@ public:
 	void Construct(const FArguments& InArgs, const TWeakObjectPtr<UBlueprint>& InBlueprint);
 	virtual ~SMGANewDataTableWindowContent() override;
 
+	/** Returns the FAttributeMetaData rows of InBlueprint as CSV text (the window itself fills DataTables directly, see UE::MGA::DataTableUtils) */
 	static FString GenerateCSVFromMGAAttributes(const TWeakObjectPtr<UBlueprint>& InBlueprint);
 
 private:
@@ -6,7 +6,12 @@
 #include "GameplayEffect.h"
 #include "Engine/Blueprint.h"
 #include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "Misc/UObjectToken.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Subsystems/MGAAttributeReferenceIndexSubsystem.h"
 #include "Subsystems/MGAEditorSubsystem.h"
 
 #if UE_VERSION_NEWER_THAN(5, 3, -1)
@@ -16,19 +21,37 @@
 
 #define LOCTEXT_NAMESPACE "MGAGameplayEffectReferencerHandler"
 
+namespace MGA::GameplayEffectReferencerHandler
+{
+	/** Bump whenever the cache layout or what gets cached changes, older cache files are discarded */
+	static constexpr int32 CacheVersion = 1;
+}
+
 TSharedPtr<IMGAAttributeReferencerHandler> FMGAGameplayEffectReferencerHandler::Create()
 {
 	return MakeShared<FMGAGameplayEffectReferencerHandler>();
 }
 
+FMGAGameplayEffectReferencerHandler::FMGAGameplayEffectReferencerHandler()
+{
+	LoadCache();
+
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMGAGameplayEffectReferencerHandler::HandleObjectModified);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FMGAGameplayEffectReferencerHandler::HandleObjectPropertyChanged);
+}
+
 FMGAGameplayEffectReferencerHandler::~FMGAGameplayEffectReferencerHandler()
 {
+	FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+
+	SaveCache();
 	AttributesCacheMap.Reset();
 }
 
 void FMGAGameplayEffectReferencerHandler::OnPreCompile(const FString& InPackageName)
 {
-	AttributesCacheMap.Reset();
+	// Cache entries are kept across compiles, HandlePreCompile() only rebuilds the ones of Gameplay Effects that changed
 }
 
 void FMGAGameplayEffectReferencerHandler::OnPostCompile(const FString& InPackageName)
@@ -44,6 +67,14 @@ bool FMGAGameplayEffectReferencerHandler::HandlePreCompile(const FAssetIdentifie
 	{
 		return false;
 	}
+
+	if (const FAttributesCacheEntry* CacheEntry = AttributesCacheMap.Find(InAssetIdentifier))
+	{
+		if (IsCacheEntryValid(InAssetIdentifier, *CacheEntry, EffectCDO))
+		{
+			return true;
+		}
+	}
 	
 	TArray<FAttributeReference> AttributesCache;
 	AttributesCache.Reserve(EffectCDO->Modifiers.Num());
@@ -170,10 +201,20 @@ bool FMGAGameplayEffectReferencerHandler::HandlePreCompile(const FAssetIdentifie
 #endif
 	}
 
-	AttributesCacheMap.Add(InAssetIdentifier, AttributesCache);
+	FAttributesCacheEntry& CacheEntry = AttributesCacheMap.Add(InAssetIdentifier);
+	CacheEntry.References = MoveTemp(AttributesCache);
+	CacheEntry.FileTimeStamp = UMGAAttributeReferenceIndexSubsystem::GetPackageFileTimeStamp(InAssetIdentifier.PackageName);
+	CacheEntry.DefaultObject = EffectCDO;
+	CacheEntry.bFromDirtyPackage = EffectCDO->GetPackage()->IsDirty();
 	return true;
 }
 
+bool FMGAGameplayEffectReferencerHandler::HasValidCache(const FAssetIdentifier& InAssetIdentifier) const
+{
+	const FAttributesCacheEntry* CacheEntry = AttributesCacheMap.Find(InAssetIdentifier);
+	return CacheEntry && IsCacheEntryValid(InAssetIdentifier, *CacheEntry);
+}
+
 bool FMGAGameplayEffectReferencerHandler::HandleAttributeRename(const FAssetIdentifier& InAssetIdentifier, const FMGAAttributeReferencerPayload& InPayload, TArray<TSharedRef<FTokenizedMessage>>& OutMessages)
 {
 	MGA_EDITOR_NS_LOG(Verbose, TEXT("InAssetIdentifier: %s, InPayload: %s"), *InAssetIdentifier.ToString(), *InPayload.ToString())
@@ -820,6 +861,137 @@ FAttributeBasedFloat* FMGAGameplayEffectReferencerHandler::GetAttributeBasedFloa
 	return nullptr;
 }
 
+bool FMGAGameplayEffectReferencerHandler::IsCacheEntryValid(const FAssetIdentifier& InAssetIdentifier, const FAttributesCacheEntry& InEntry, const UObject* InDefaultObject)
+{
+	if (InEntry.bStale)
+	{
+		return false;
+	}
+
+	// Built from a default object that got replaced since (eg. Gameplay Effect Blueprint recompiled or reloaded)
+	if (!InEntry.DefaultObject.IsExplicitlyNull())
+	{
+		if (!InEntry.DefaultObject.IsValid() || (InDefaultObject && InEntry.DefaultObject.Get() != InDefaultObject))
+		{
+			return false;
+		}
+
+		// Unsaved changes are tracked by modification events, the file on disk doesn't tell anything about them
+		if (InEntry.bFromDirtyPackage)
+		{
+			return true;
+		}
+	}
+
+	return InEntry.FileTimeStamp == UMGAAttributeReferenceIndexSubsystem::GetPackageFileTimeStamp(InAssetIdentifier.PackageName);
+}
+
+void FMGAGameplayEffectReferencerHandler::HandleObjectModified(UObject* InObject)
+{
+	if (!InObject)
+	{
+		return;
+	}
+
+	// Either the CDO itself or one of its subobjects (eg. Gameplay Effect Components)
+	const UGameplayEffect* EffectCDO = Cast<UGameplayEffect>(InObject);
+	if (!EffectCDO)
+	{
+		EffectCDO = InObject->GetTypedOuter<UGameplayEffect>();
+	}
+
+	if (!EffectCDO || !EffectCDO->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	if (FAttributesCacheEntry* CacheEntry = AttributesCacheMap.Find(FAssetIdentifier(EffectCDO->GetPackage()->GetFName())))
+	{
+		CacheEntry->bStale = true;
+	}
+}
+
+void FMGAGameplayEffectReferencerHandler::HandleObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent)
+{
+	HandleObjectModified(InObject);
+}
+
+FString FMGAGameplayEffectReferencerHandler::GetCacheFilePath()
+{
+	return FPaths::ProjectIntermediateDir() / TEXT("ModularGameplayAbilities") / TEXT("GameplayEffectAttributesCache.bin");
+}
+
+void FMGAGameplayEffectReferencerHandler::LoadCache()
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetCacheFilePath(), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	int32 Version = 0;
+	Reader << Version;
+	if (Version != MGA::GameplayEffectReferencerHandler::CacheVersion)
+	{
+		return;
+	}
+
+	int32 NumEntries = 0;
+	Reader << NumEntries;
+	for (int32 Index = 0; Index < NumEntries && !Reader.IsError(); ++Index)
+	{
+		FName PackageName;
+		FAttributesCacheEntry CacheEntry;
+		Reader << PackageName;
+		Reader << CacheEntry.FileTimeStamp;
+		Reader << CacheEntry.References;
+
+		if (!Reader.IsError())
+		{
+			AttributesCacheMap.Add(FAssetIdentifier(PackageName), MoveTemp(CacheEntry));
+		}
+	}
+
+	MGA_EDITOR_NS_LOG(Verbose, TEXT("Loaded %d cached Gameplay Effects"), AttributesCacheMap.Num())
+}
+
+void FMGAGameplayEffectReferencerHandler::SaveCache() const
+{
+	TArray<TPair<FName, const FAttributesCacheEntry*>> EntriesToSave;
+	for (const TPair<FAssetIdentifier, FAttributesCacheEntry>& Pair : AttributesCacheMap)
+	{
+		if (Pair.Key.IsPackage() && !Pair.Value.bStale && !Pair.Value.bFromDirtyPackage && Pair.Value.FileTimeStamp != FDateTime::MinValue())
+		{
+			EntriesToSave.Emplace(Pair.Key.PackageName, &Pair.Value);
+		}
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	int32 Version = MGA::GameplayEffectReferencerHandler::CacheVersion;
+	Writer << Version;
+
+	int32 NumEntries = EntriesToSave.Num();
+	Writer << NumEntries;
+	for (const TPair<FName, const FAttributesCacheEntry*>& Entry : EntriesToSave)
+	{
+		FName PackageName = Entry.Key;
+		FDateTime FileTimeStamp = Entry.Value->FileTimeStamp;
+		TArray<FAttributeReference> References = Entry.Value->References;
+		Writer << PackageName;
+		Writer << FileTimeStamp;
+		Writer << References;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *GetCacheFilePath()))
+	{
+		MGA_EDITOR_NS_LOG(Warning, TEXT("Failed to write %s"), *GetCacheFilePath())
+	}
+}
+
 FString FMGAGameplayEffectReferencerHandler::GetClassDefaultName(const FString& InName)
 {
 	FString Name = InName;
@@ -79,20 +79,65 @@ public:
 		EAttributeReferenceType Type = EAttributeReferenceType::Unknown;
 
 		FAttributeReference() = default;
+
+		friend FArchive& operator<<(FArchive& Ar, FAttributeReference& InReference)
+		{
+			Ar << InReference.PackageNameOwner;
+			Ar << InReference.AttributeName;
+			Ar << InReference.Index;
+
+			uint8 Type = static_cast<uint8>(InReference.Type);
+			Ar << Type;
+			InReference.Type = static_cast<EAttributeReferenceType>(Type);
+			return Ar;
+		}
+	};
+
+	/** Cached attribute references of a Gameplay Effect, kept across compiles (and editor sessions) until that Gameplay Effect changes */
+	struct FAttributesCacheEntry
+	{
+		TArray<FAttributeReference> References;
+
+		/** Timestamp of the package file when the entry was built */
+		FDateTime FileTimeStamp;
+
+		/** Default object the entry was built from, unset for entries read from disk */
+		TWeakObjectPtr<UObject> DefaultObject;
+
+		/** Set when the Gameplay Effect was modified after the entry was built */
+		bool bStale = false;
+
+		/** Whether the entry was built from unsaved changes, such entries aren't written to disk */
+		bool bFromDirtyPackage = false;
 	};
 
 	static TSharedPtr<IMGAAttributeReferencerHandler> Create();
+
+	FMGAGameplayEffectReferencerHandler();
 	virtual ~FMGAGameplayEffectReferencerHandler() override;
 
 	//~ Begin IMGAAttributeReferencerHandler
 	virtual void OnPreCompile(const FString& InPackageName) override;
 	virtual void OnPostCompile(const FString& InPackageName) override;
 	virtual bool HandlePreCompile(const FAssetIdentifier& InAssetIdentifier, const FMGAAttributeReferencerPayload& InPayload) override;
+	virtual bool HasValidCache(const FAssetIdentifier& InAssetIdentifier) const override;
 	virtual bool HandleAttributeRename(const FAssetIdentifier& InAssetIdentifier, const FMGAAttributeReferencerPayload& InPayload, TArray<TSharedRef<FTokenizedMessage>>& OutMessages) override;
 	//~ End IMGAAttributeReferencerHandler
 
 protected:
-	TMap<FAssetIdentifier, TArray<FAttributeReference>> AttributesCacheMap;
+	/** Attributes referenced by each Gameplay Effect, built on pre-compile and only rebuilt once that Gameplay Effect changed */
+	TMap<FAssetIdentifier, FAttributesCacheEntry> AttributesCacheMap;
+
+	/** Returns whether InEntry still describes the Gameplay Effect, optionally built from InDefaultObject */
+	static bool IsCacheEntryValid(const FAssetIdentifier& InAssetIdentifier, const FAttributesCacheEntry& InEntry, const UObject* InDefaultObject = nullptr);
+
+	/** Marks the cache entry of the Gameplay Effect owning InObject (its CDO or one of its subobjects) as stale */
+	void HandleObjectModified(UObject* InObject);
+	void HandleObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent);
+
+	static FString GetCacheFilePath();
+	void LoadCache();
+	void SaveCache() const;
 
 	/**
 	 * Parses and returns an "Attribute Reference" for the given struct found in a Gameplay Effect CDO.
@@ -149,7 +194,7 @@ protected:
 			return false;
 		}
 
-		TArray<FAttributeReference> Modifiers = AttributesCacheMap.FindChecked(InAssetIdentifier);
+		TArray<FAttributeReference> Modifiers = AttributesCacheMap.FindChecked(InAssetIdentifier).References;
 		FAttributeReference* FoundElement = Modifiers.FindByPredicate(InPred);
 
 		if (!FoundElement)
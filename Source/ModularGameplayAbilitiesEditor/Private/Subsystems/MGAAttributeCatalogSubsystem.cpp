@@ -0,0 +1,548 @@
+// Copyright Halcyonyx Studios.
+
+#include "Subsystems/MGAAttributeCatalogSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "Editor.h"
+#include "MGADelegates.h"
+#include "MGAEditorLog.h"
+#include "MGAEditorSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Attributes/MGAAttributeSetBlueprint.h"
+#include "Attributes/ModularAttributeSetBase.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "Utilities/MGAUtilities.h"
+
+FProperty* FMGAAttributeCatalogEntry::FindProperty() const
+{
+	const UClass* OwnerClass = FindObject<UClass>(OwnerClassPath);
+	return OwnerClass ? FindFProperty<FProperty>(OwnerClass, PropertyName) : nullptr;
+}
+
+FProperty* FMGAAttributeCatalogEntry::LoadProperty() const
+{
+	if (FProperty* Property = FindProperty())
+	{
+		return Property;
+	}
+
+	MGA_EDITOR_LOG(Verbose, TEXT("FMGAAttributeCatalogEntry::LoadProperty - Loading %s for %s"), *OwnerClassPath.ToString(), *AttributeName)
+
+	const UClass* OwnerClass = LoadObject<UClass>(nullptr, *OwnerClassPath.ToString());
+	return OwnerClass ? FindFProperty<FProperty>(OwnerClass, PropertyName) : nullptr;
+}
+
+bool FMGAAttributeCatalogEntry::HasMetaData(const FString& InKey) const
+{
+	if (const FProperty* Property = FindProperty())
+	{
+		return Property->HasMetaData(*InKey);
+	}
+
+	return MetaDataKeys.Contains(FName(*InKey));
+}
+
+void UMGAAttributeCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.OnAssetAdded().AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleAssetRenamed);
+	AssetRegistry.OnAssetUpdated().AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleAssetUpdated);
+
+	FMGADelegates::OnPostCompile.AddUObject(this, &UMGAAttributeCatalogSubsystem::HandlePostCompile);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleReloadComplete);
+	FCoreUObjectDelegates::OnAssetLoaded.AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleAssetLoaded);
+	FModuleManager::Get().OnModulesChanged().AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleModulesChanged);
+	GEditor->OnBlueprintPreCompile().AddUObject(this, &UMGAAttributeCatalogSubsystem::HandleBlueprintPreCompile);
+
+	// Assets discovered later on (initial scan still running) come in through OnAssetAdded
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(UMGAAttributeSetBlueprint::StaticClass()->GetClassPathName(), Assets, true);
+	for (const FAssetData& Asset : Assets)
+	{
+		AddBlueprintAsset(Asset);
+	}
+
+	MGA_EDITOR_LOG(Verbose, TEXT("UMGAAttributeCatalogSubsystem::Initialize - Indexed %d Attribute Set Blueprints"), BlueprintAssets.Num())
+}
+
+void UMGAAttributeCatalogSubsystem::Deinitialize()
+{
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+	}
+
+	FMGADelegates::OnPostCompile.RemoveAll(this);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.RemoveAll(this);
+	FCoreUObjectDelegates::OnAssetLoaded.RemoveAll(this);
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().RemoveAll(this);
+	}
+
+	NativeEntries.Reset();
+	BlueprintAssets.Reset();
+	BlueprintParentClasses.Reset();
+	UntaggedBlueprintPackages.Reset();
+
+	Super::Deinitialize();
+}
+
+UMGAAttributeCatalogSubsystem& UMGAAttributeCatalogSubsystem::Get()
+{
+	check(GEditor);
+	return *GEditor->GetEditorSubsystem<UMGAAttributeCatalogSubsystem>();
+}
+
+void UMGAAttributeCatalogSubsystem::Query(const FMGAAttributeCatalogQuery& InQuery, TArray<TSharedPtr<const FMGAAttributeCatalogEntry>>& OutEntries)
+{
+	if (bNativeEntriesDirty)
+	{
+		BuildNativeEntries();
+	}
+
+	if (UntaggedBlueprintPackages.Num() > 0)
+	{
+		LoadUntaggedBlueprints();
+	}
+
+	const UMGAEditorSettings& Settings = UMGAEditorSettings::Get();
+
+	TArray<FString> SearchTerms;
+	InQuery.SearchText.ParseIntoArrayWS(SearchTerms);
+
+	struct FScoredEntry
+	{
+		TSharedPtr<const FMGAAttributeCatalogEntry> Entry;
+		int32 Score = 0;
+	};
+
+	TArray<FScoredEntry> ScoredEntries;
+
+	auto ConsiderEntry = [&](const TSharedPtr<const FMGAAttributeCatalogEntry>& InEntry)
+	{
+		if (InEntry->bSystemAttribute && !InQuery.bIncludeSystemAttributes)
+		{
+			return;
+		}
+
+		if (InQuery.FilterClass && !IsChildOf(InEntry->OwnerClassPath, InQuery.FilterClass))
+		{
+			// Attributes of super classes are loaded along with the filter class
+			const UClass* OwnerClass = FindObject<UClass>(InEntry->OwnerClassPath);
+			if (!InQuery.bIncludeSuperClasses || !OwnerClass || !InQuery.FilterClass->IsChildOf(OwnerClass))
+			{
+				return;
+			}
+		}
+
+		int32 Score = 0;
+		for (const FString& SearchTerm : SearchTerms)
+		{
+			const int32 TermScore = GetSearchScore(InEntry->AttributeName, SearchTerm);
+			if (TermScore == INDEX_NONE)
+			{
+				return;
+			}
+
+			Score = FMath::Max(Score, TermScore);
+		}
+
+		if (!InQuery.FilterMetaData.IsEmpty() && InEntry->HasMetaData(InQuery.FilterMetaData))
+		{
+			return;
+		}
+
+		// Allow properties to be filtered globally via Developer Settings (never show up)
+		if (UMGAEditorSettings::IsAttributeFiltered(Settings.FilterAttributesList, InEntry->AttributeName))
+		{
+			return;
+		}
+
+		ScoredEntries.Add({ InEntry, Score });
+	};
+
+	for (const TSharedPtr<const FMGAAttributeCatalogEntry>& Entry : NativeEntries)
+	{
+		ConsiderEntry(Entry);
+	}
+
+	for (const TPair<FName, FBlueprintAssetEntry>& Pair : BlueprintAssets)
+	{
+		for (const TSharedPtr<const FMGAAttributeCatalogEntry>& Entry : Pair.Value.Attributes)
+		{
+			ConsiderEntry(Entry);
+		}
+	}
+
+	ScoredEntries.Sort([](const FScoredEntry& A, const FScoredEntry& B)
+	{
+		if (A.Score != B.Score)
+		{
+			return A.Score < B.Score;
+		}
+
+		return A.Entry->AttributeName < B.Entry->AttributeName;
+	});
+
+	OutEntries.Reserve(OutEntries.Num() + ScoredEntries.Num());
+	for (const FScoredEntry& ScoredEntry : ScoredEntries)
+	{
+		OutEntries.Add(ScoredEntry.Entry);
+	}
+}
+
+int32 UMGAAttributeCatalogSubsystem::GetSearchScore(const FString& InCandidate, const FString& InSearchTerm)
+{
+	if (InSearchTerm.IsEmpty())
+	{
+		return 0;
+	}
+
+	int32 DotIndex = INDEX_NONE;
+	InCandidate.FindLastChar(TEXT('.'), DotIndex);
+
+	const int32 FoundIndex = InCandidate.Find(InSearchTerm, ESearchCase::IgnoreCase);
+	if (FoundIndex != INDEX_NONE)
+	{
+		if (FoundIndex == DotIndex + 1)
+		{
+			return 0;
+		}
+
+		return FoundIndex == 0 ? 1 : 2;
+	}
+
+	// Fuzzy, all characters of the term in order
+	int32 CandidateIndex = 0;
+	for (const TCHAR SearchChar : InSearchTerm)
+	{
+		const TCHAR LowerSearchChar = FChar::ToLower(SearchChar);
+		while (CandidateIndex < InCandidate.Len() && FChar::ToLower(InCandidate[CandidateIndex]) != LowerSearchChar)
+		{
+			CandidateIndex++;
+		}
+
+		if (CandidateIndex >= InCandidate.Len())
+		{
+			return INDEX_NONE;
+		}
+
+		CandidateIndex++;
+	}
+
+	return 3;
+}
+
+bool UMGAAttributeCatalogSubsystem::IsChildOf(const FTopLevelAssetPath& InClassPath, const UClass* InParentClass) const
+{
+	if (!InParentClass)
+	{
+		return false;
+	}
+
+	// Walk up unloaded Blueprint classes until a loaded one is found
+	FTopLevelAssetPath ClassPath = InClassPath;
+	for (int32 Depth = 0; Depth < 64 && ClassPath.IsValid(); ++Depth)
+	{
+		if (const UClass* Class = FindObject<UClass>(ClassPath))
+		{
+			return Class->IsChildOf(InParentClass);
+		}
+
+		const FTopLevelAssetPath* ParentClassPath = BlueprintParentClasses.Find(ClassPath);
+		if (!ParentClassPath)
+		{
+			return false;
+		}
+
+		ClassPath = *ParentClassPath;
+	}
+
+	return false;
+}
+
+void UMGAAttributeCatalogSubsystem::MarkNativeEntriesDirty()
+{
+	bNativeEntriesDirty = true;
+}
+
+void UMGAAttributeCatalogSubsystem::BuildNativeEntries()
+{
+	NativeEntries.Reset();
+	bNativeEntriesDirty = false;
+
+	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	{
+		const UClass* Class = *ClassIt;
+
+		// Attribute Set Blueprint classes are indexed from the asset registry. Other Blueprint classes deriving from an
+		// Attribute Set (eg. created from the regular Blueprint Class dialog) write no attribute tags, they are indexed here
+		// while loaded (IsValidAttributeClass() skips their skeleton and reinstancing classes).
+		if (Class->HasAnyClassFlags(CLASS_NewerVersionExists | CLASS_Deprecated) || (Class->ClassGeneratedBy && !IsUntaggedAttributeSetBlueprint(Cast<UBlueprint>(Class->ClassGeneratedBy))))
+		{
+			continue;
+		}
+
+		if (FMGAUtilities::IsValidAttributeClass(Class))
+		{
+			// Allow entire classes to be filtered globally
+			if (Class->HasMetaData(TEXT("HideInDetailsView")))
+			{
+				continue;
+			}
+
+			for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
+			{
+				const FProperty* Property = *PropertyIt;
+
+				// Allow properties to be filtered globally (never show up), and only allow field of expected types
+				if (Property->HasMetaData(TEXT("HideInDetailsView")) || !FMGAUtilities::IsValidCPPType(Property->GetCPPType()))
+				{
+					continue;
+				}
+
+				const TSharedRef<FMGAAttributeCatalogEntry> Entry = MakeShared<FMGAAttributeCatalogEntry>();
+				Entry->AttributeName = FString::Printf(TEXT("%s.%s"), *FMGAUtilities::GetAttributeClassName(Class), *Property->GetName());
+				Entry->PropertyName = Property->GetFName();
+				Entry->OwnerClassPath = Class->GetClassPathName();
+				Entry->Category = Property->GetMetaData(TEXT("Category"));
+				Entry->bReplicated = Property->HasAnyPropertyFlags(CPF_Net);
+				if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+				{
+					Entry->Type = StructProperty->Struct->GetFName();
+					Entry->bClamped = StructProperty->Struct->IsChildOf(FMGAClampedAttributeData::StaticStruct());
+				}
+
+				NativeEntries.Add(Entry);
+			}
+		}
+
+		// UAbilitySystemComponent can add 'system' attributes
+		if (Class->IsChildOf(UAbilitySystemComponent::StaticClass()) && !Class->ClassGeneratedBy)
+		{
+			for (TFieldIterator<FProperty> PropertyIt(Class, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
+			{
+				const FProperty* Property = *PropertyIt;
+
+				// SystemAttributes have to be explicitly tagged
+				if (!Property->HasMetaData(TEXT("SystemGameplayAttribute")))
+				{
+					continue;
+				}
+
+				const TSharedRef<FMGAAttributeCatalogEntry> Entry = MakeShared<FMGAAttributeCatalogEntry>();
+				Entry->AttributeName = FString::Printf(TEXT("%s.%s"), *Class->GetName(), *Property->GetName());
+				Entry->PropertyName = Property->GetFName();
+				Entry->OwnerClassPath = Class->GetClassPathName();
+				Entry->Category = Property->GetMetaData(TEXT("Category"));
+				Entry->Type = *Property->GetCPPType();
+				Entry->bReplicated = Property->HasAnyPropertyFlags(CPF_Net);
+				Entry->bSystemAttribute = true;
+				NativeEntries.Add(Entry);
+			}
+		}
+	}
+
+	MGA_EDITOR_LOG(Verbose, TEXT("UMGAAttributeCatalogSubsystem::BuildNativeEntries - Indexed %d native attributes"), NativeEntries.Num())
+}
+
+bool UMGAAttributeCatalogSubsystem::IsAttributeSetBlueprintAsset(const FAssetData& InAssetData)
+{
+	return InAssetData.AssetClassPath == UMGAAttributeSetBlueprint::StaticClass()->GetClassPathName();
+}
+
+bool UMGAAttributeCatalogSubsystem::IsUntaggedAttributeSetBlueprint(const UBlueprint* InBlueprint)
+{
+	return InBlueprint && !InBlueprint->IsA<UMGAAttributeSetBlueprint>() && InBlueprint->ParentClass && InBlueprint->ParentClass->IsChildOf(UModularAttributeSetBase::StaticClass());
+}
+
+void UMGAAttributeCatalogSubsystem::AddBlueprintAsset(const FAssetData& InAssetData)
+{
+	RemoveBlueprintAsset(InAssetData.PackageName);
+
+	const FString GeneratedClassPath = FPackageName::ExportTextPathToObjectPath(InAssetData.GetTagValueRef<FString>(FBlueprintTags::GeneratedClassPath));
+	const FString ParentClassPath = FPackageName::ExportTextPathToObjectPath(InAssetData.GetTagValueRef<FString>(FBlueprintTags::ParentClassPath));
+
+	FBlueprintAssetEntry& BlueprintEntry = BlueprintAssets.Add(InAssetData.PackageName);
+	BlueprintEntry.GeneratedClassPath = FTopLevelAssetPath(GeneratedClassPath);
+	BlueprintEntry.ParentClassPath = FTopLevelAssetPath(ParentClassPath);
+
+	if (!BlueprintEntry.GeneratedClassPath.IsValid())
+	{
+		MGA_EDITOR_LOG(Verbose, TEXT("UMGAAttributeCatalogSubsystem::AddBlueprintAsset - %s has no generated class yet"), *InAssetData.PackageName.ToString())
+		return;
+	}
+
+	BlueprintParentClasses.Add(BlueprintEntry.GeneratedClassPath, BlueprintEntry.ParentClassPath);
+
+	// Assets saved before attributes were written to tags are loaded once on next query, resaving them avoids it
+	FString AttributesTag;
+	if (!InAssetData.GetTagValue(UMGAAttributeSetBlueprint::AttributesTagName, AttributesTag))
+	{
+		if (!InAssetData.IsAssetLoaded())
+		{
+			MGA_EDITOR_LOG(Verbose, TEXT("UMGAAttributeCatalogSubsystem::AddBlueprintAsset - %s has no %s tag, resave it to index its attributes without loading it"), *InAssetData.PackageName.ToString(), *UMGAAttributeSetBlueprint::AttributesTagName.ToString())
+			UntaggedBlueprintPackages.Add(InAssetData.PackageName);
+		}
+
+		return;
+	}
+
+	TArray<FMGAAttributeSetBlueprintTagEntry> TagEntries;
+	UMGAAttributeSetBlueprint::ParseAttributesTag(AttributesTag, TagEntries);
+
+	const FString ClassName = InAssetData.AssetName.ToString();
+	for (const FMGAAttributeSetBlueprintTagEntry& TagEntry : TagEntries)
+	{
+		if (TagEntry.MetaDataKeys.Contains(TEXT("HideInDetailsView")))
+		{
+			continue;
+		}
+
+		const TSharedRef<FMGAAttributeCatalogEntry> Entry = MakeShared<FMGAAttributeCatalogEntry>();
+		Entry->AttributeName = FString::Printf(TEXT("%s.%s"), *ClassName, *TagEntry.Name.ToString());
+		Entry->PropertyName = TagEntry.Name;
+		Entry->OwnerClassPath = BlueprintEntry.GeneratedClassPath;
+		Entry->Category = TagEntry.Category;
+		Entry->MetaDataKeys = TagEntry.MetaDataKeys;
+		Entry->Type = TagEntry.Type;
+		Entry->bReplicated = TagEntry.bReplicated;
+		Entry->bClamped = TagEntry.bClamped;
+		Entry->bBlueprint = true;
+		BlueprintEntry.Attributes.Add(Entry);
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::RemoveBlueprintAsset(const FName InPackageName)
+{
+	UntaggedBlueprintPackages.Remove(InPackageName);
+
+	FBlueprintAssetEntry BlueprintEntry;
+	if (BlueprintAssets.RemoveAndCopyValue(InPackageName, BlueprintEntry))
+	{
+		BlueprintParentClasses.Remove(BlueprintEntry.GeneratedClassPath);
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::RefreshBlueprintPackage(const FName InPackageName)
+{
+	// Includes in memory assets, whose tags are gathered from the (possibly unsaved) Blueprint itself
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPackageName(InPackageName, Assets);
+
+	for (const FAssetData& Asset : Assets)
+	{
+		if (IsAttributeSetBlueprintAsset(Asset))
+		{
+			AddBlueprintAsset(Asset);
+		}
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::LoadUntaggedBlueprints()
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	const TSet<FName> PackageNames = MoveTemp(UntaggedBlueprintPackages);
+	UntaggedBlueprintPackages.Reset();
+
+	MGA_EDITOR_LOG(Display, TEXT("UMGAAttributeCatalogSubsystem::LoadUntaggedBlueprints - Loading %d Attribute Set Blueprints saved without attribute tags, resave them to avoid it"), PackageNames.Num())
+
+	for (const FName PackageName : PackageNames)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(PackageName, Assets, true);
+
+		for (const FAssetData& Asset : Assets)
+		{
+			if (IsAttributeSetBlueprintAsset(Asset))
+			{
+				Asset.GetAsset();
+			}
+		}
+
+		// Loaded assets report tags gathered from the Blueprint itself
+		RefreshBlueprintPackage(PackageName);
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::HandleAssetAdded(const FAssetData& InAssetData)
+{
+	if (IsAttributeSetBlueprintAsset(InAssetData))
+	{
+		AddBlueprintAsset(InAssetData);
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::HandleAssetRemoved(const FAssetData& InAssetData)
+{
+	if (IsAttributeSetBlueprintAsset(InAssetData))
+	{
+		RemoveBlueprintAsset(InAssetData.PackageName);
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::HandleAssetRenamed(const FAssetData& InAssetData, const FString& InOldObjectPath)
+{
+	if (IsAttributeSetBlueprintAsset(InAssetData))
+	{
+		RemoveBlueprintAsset(*FPackageName::ObjectPathToPackageName(InOldObjectPath));
+		AddBlueprintAsset(InAssetData);
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::HandleAssetUpdated(const FAssetData& InAssetData)
+{
+	if (IsAttributeSetBlueprintAsset(InAssetData))
+	{
+		AddBlueprintAsset(InAssetData);
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::HandlePostCompile(const FName& InPackageName)
+{
+	RefreshBlueprintPackage(InPackageName);
+}
+
+void UMGAAttributeCatalogSubsystem::HandleBlueprintPreCompile(UBlueprint* InBlueprint)
+{
+	if (IsUntaggedAttributeSetBlueprint(InBlueprint))
+	{
+		MarkNativeEntriesDirty();
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::HandleAssetLoaded(UObject* InObject)
+{
+	if (IsUntaggedAttributeSetBlueprint(Cast<UBlueprint>(InObject)))
+	{
+		MarkNativeEntriesDirty();
+	}
+}
+
+void UMGAAttributeCatalogSubsystem::HandleReloadComplete(EReloadCompleteReason InReason)
+{
+	MarkNativeEntriesDirty();
+}
+
+void UMGAAttributeCatalogSubsystem::HandleModulesChanged(FName InModuleName, const EModuleChangeReason InReason)
+{
+	if (InReason == EModuleChangeReason::ModuleLoaded || InReason == EModuleChangeReason::ModuleUnloaded)
+	{
+		MarkNativeEntriesDirty();
+	}
+}
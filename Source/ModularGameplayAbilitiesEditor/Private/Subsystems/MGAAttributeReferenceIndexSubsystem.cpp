@@ -0,0 +1,516 @@
+// Copyright Halcyonyx Studios.
+
+#include "Subsystems/MGAAttributeReferenceIndexSubsystem.h"
+
+#include "AttributeSet.h"
+#include "EdGraphSchema_K2.h"
+#include "Editor.h"
+#include "K2Node.h"
+#include "MGAEditorLog.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Subsystems/MGAEditorSubsystem.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+#define LOCTEXT_NAMESPACE "MGAAttributeReferenceIndexSubsystem"
+
+namespace MGA::AttributeReferenceIndex
+{
+	/** Bump whenever the serialized layout or what gets indexed changes, older index files are discarded */
+	static constexpr int32 Version = 1;
+
+	/** Struct nesting limit when looking for attributes in properties */
+	static constexpr int32 MaxDepth = 16;
+
+	static FAutoConsoleCommand RebuildCommand(
+		TEXT("MGA.AttributeReferenceIndex.Rebuild"),
+		TEXT("Loads all Blueprint assets and indexes their Gameplay Attribute references."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (GEditor)
+			{
+				UMGAAttributeReferenceIndexSubsystem::Get().RebuildIndex();
+			}
+		})
+	);
+
+	static bool ParseAttribute(const FGameplayAttribute& InAttribute, FName& OutOwnerPackageName, FName& OutAttributeName)
+	{
+		if (const FProperty* Property = InAttribute.GetUProperty())
+		{
+			const UStruct* OwnerStruct = Property->GetOwnerStruct();
+			if (!OwnerStruct)
+			{
+				return false;
+			}
+
+			OutOwnerPackageName = OwnerStruct->GetPackage()->GetFName();
+			OutAttributeName = Property->GetFName();
+			return true;
+		}
+
+		// Property may not resolve anymore (eg. renamed), go by its exported path
+		FString ExportedValue;
+		FGameplayAttribute::StaticStruct()->ExportText(ExportedValue, &InAttribute, &InAttribute, nullptr, PPF_SerializedAsImportText, nullptr);
+
+		FString PackageName;
+		FString AttributeName;
+		if (ExportedValue.IsEmpty() || !UMGAEditorSubsystem::ParseAttributeFromDefaultValue(ExportedValue, PackageName, AttributeName))
+		{
+			return false;
+		}
+
+		OutOwnerPackageName = *PackageName;
+		OutAttributeName = *AttributeName;
+		return true;
+	}
+
+	static void GatherValueReferences(const FProperty* InProperty, const void* InValue, const FString& InPath, const FString& InObjectPath, TArray<FMGAAttributeReference>& OutReferences, int32 InDepth);
+
+	static void GatherStructReferences(const UStruct* InStruct, const void* InContainer, const FString& InPathPrefix, const FString& InObjectPath, TArray<FMGAAttributeReference>& OutReferences, const int32 InDepth)
+	{
+		if (InDepth > MaxDepth)
+		{
+			return;
+		}
+
+		for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+		{
+			const FProperty* Property = *It;
+
+			// Not saved, can't hold a persistent reference
+			if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated))
+			{
+				continue;
+			}
+
+			for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+			{
+				FString Path = InPathPrefix + Property->GetName();
+				if (Property->ArrayDim > 1)
+				{
+					Path += FString::Printf(TEXT("[%d]"), Index);
+				}
+
+				GatherValueReferences(Property, Property->ContainerPtrToValuePtr<void>(InContainer, Index), Path, InObjectPath, OutReferences, InDepth);
+			}
+		}
+	}
+
+	static void GatherValueReferences(const FProperty* InProperty, const void* InValue, const FString& InPath, const FString& InObjectPath, TArray<FMGAAttributeReference>& OutReferences, const int32 InDepth)
+	{
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(InProperty))
+		{
+			if (StructProperty->Struct == FGameplayAttribute::StaticStruct())
+			{
+				FMGAAttributeReference Reference;
+				if (ParseAttribute(*static_cast<const FGameplayAttribute*>(InValue), Reference.OwnerPackageName, Reference.AttributeName))
+				{
+					Reference.ObjectPath = InObjectPath;
+					Reference.PropertyPath = InPath;
+					OutReferences.Add(MoveTemp(Reference));
+				}
+
+				return;
+			}
+
+			GatherStructReferences(StructProperty->Struct, InValue, InPath + TEXT("."), InObjectPath, OutReferences, InDepth + 1);
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(InProperty))
+		{
+			// Only structs can hold attributes, subobjects are gathered on their own
+			if (!ArrayProperty->Inner->IsA<FStructProperty>())
+			{
+				return;
+			}
+
+			FScriptArrayHelper ArrayHelper(ArrayProperty, InValue);
+			for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+			{
+				GatherValueReferences(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index), FString::Printf(TEXT("%s[%d]"), *InPath, Index), InObjectPath, OutReferences, InDepth + 1);
+			}
+		}
+	}
+
+	static void GatherPinReferences(const UK2Node* InNode, TArray<FMGAAttributeReference>& OutReferences)
+	{
+		for (const UEdGraphPin* Pin : InNode->Pins)
+		{
+			const bool bIsAttributePin = Pin && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct && Pin->PinType.PinSubCategoryObject == FGameplayAttribute::StaticStruct();
+			if (!bIsAttributePin || Pin->Direction != EGPD_Input || Pin->DefaultValue.IsEmpty())
+			{
+				continue;
+			}
+
+			FString PackageName;
+			FString AttributeName;
+			if (UMGAEditorSubsystem::ParseAttributeFromDefaultValue(Pin->DefaultValue, PackageName, AttributeName))
+			{
+				FMGAAttributeReference& Reference = OutReferences.AddDefaulted_GetRef();
+				Reference.OwnerPackageName = *PackageName;
+				Reference.AttributeName = *AttributeName;
+				Reference.ObjectPath = InNode->GetPathName();
+				Reference.PropertyPath = Pin->PinName.ToString();
+				Reference.bPin = true;
+			}
+		}
+	}
+
+	static bool MatchesAttribute(const FMGAAttributeReference& InReference, const FName InOwnerPackageName, const FName InAttributeName)
+	{
+		return InReference.OwnerPackageName == InOwnerPackageName && (InAttributeName.IsNone() || InReference.AttributeName == InAttributeName);
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FMGAAttributeReference& InReference)
+{
+	Ar << InReference.OwnerPackageName;
+	Ar << InReference.AttributeName;
+	Ar << InReference.ObjectPath;
+	Ar << InReference.PropertyPath;
+	Ar << InReference.bPin;
+	return Ar;
+}
+
+void UMGAAttributeReferenceIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LoadIndex();
+
+	UPackage::PackageSavedWithContextEvent.AddUObject(this, &UMGAAttributeReferenceIndexSubsystem::HandlePackageSaved);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.OnAssetRemoved().AddUObject(this, &UMGAAttributeReferenceIndexSubsystem::HandleAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddUObject(this, &UMGAAttributeReferenceIndexSubsystem::HandleAssetRenamed);
+}
+
+void UMGAAttributeReferenceIndexSubsystem::Deinitialize()
+{
+	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	}
+
+	SaveIndex();
+
+	Packages.Reset();
+	ReferencersByOwnerPackage.Reset();
+
+	Super::Deinitialize();
+}
+
+UMGAAttributeReferenceIndexSubsystem& UMGAAttributeReferenceIndexSubsystem::Get()
+{
+	check(GEditor);
+	return *GEditor->GetEditorSubsystem<UMGAAttributeReferenceIndexSubsystem>();
+}
+
+bool UMGAAttributeReferenceIndexSubsystem::IsPackageUpToDate(const FName InPackageName) const
+{
+	const FPackageEntry* Entry = Packages.Find(InPackageName);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	// Unsaved changes aren't indexed
+	if (const UPackage* Package = FindObjectFast<UPackage>(nullptr, InPackageName))
+	{
+		if (Package->IsDirty())
+		{
+			return false;
+		}
+	}
+
+	return Entry->FileTimeStamp == GetPackageFileTimeStamp(InPackageName);
+}
+
+bool UMGAAttributeReferenceIndexSubsystem::MayReferenceAttribute(const FName InReferencerPackageName, const FName InOwnerPackageName, const FName InAttributeName) const
+{
+	if (!IsPackageUpToDate(InReferencerPackageName))
+	{
+		return true;
+	}
+
+	return Packages.FindChecked(InReferencerPackageName).References.ContainsByPredicate([InOwnerPackageName, InAttributeName](const FMGAAttributeReference& Reference)
+	{
+		return MGA::AttributeReferenceIndex::MatchesAttribute(Reference, InOwnerPackageName, InAttributeName);
+	});
+}
+
+void UMGAAttributeReferenceIndexSubsystem::GetReferencingPackages(const FName InOwnerPackageName, const FName InAttributeName, TArray<FName>& OutPackageNames) const
+{
+	const TSet<FName>* Referencers = ReferencersByOwnerPackage.Find(InOwnerPackageName);
+	if (!Referencers)
+	{
+		return;
+	}
+
+	for (const FName ReferencerPackageName : *Referencers)
+	{
+		if (IsPackageUpToDate(ReferencerPackageName) && MayReferenceAttribute(ReferencerPackageName, InOwnerPackageName, InAttributeName))
+		{
+			OutPackageNames.AddUnique(ReferencerPackageName);
+		}
+	}
+}
+
+void UMGAAttributeReferenceIndexSubsystem::GetReferences(const FName InReferencerPackageName, const FName InOwnerPackageName, const FName InAttributeName, TArray<FMGAAttributeReference>& OutReferences) const
+{
+	const FPackageEntry* Entry = Packages.Find(InReferencerPackageName);
+	if (!Entry)
+	{
+		return;
+	}
+
+	for (const FMGAAttributeReference& Reference : Entry->References)
+	{
+		if (MGA::AttributeReferenceIndex::MatchesAttribute(Reference, InOwnerPackageName, InAttributeName))
+		{
+			OutReferences.Add(Reference);
+		}
+	}
+}
+
+void UMGAAttributeReferenceIndexSubsystem::IndexPackage(const UPackage* InPackage)
+{
+	if (!InPackage || InPackage == GetTransientPackage() || InPackage->HasAnyPackageFlags(PKG_CompiledIn))
+	{
+		return;
+	}
+
+	// Unsaved changes would be indexed against the timestamp of the previous save
+	if (InPackage->IsDirty())
+	{
+		return;
+	}
+
+	const FName PackageName = InPackage->GetFName();
+	const FDateTime FileTimeStamp = GetPackageFileTimeStamp(PackageName);
+
+	// Never saved, nothing to compare a later load against
+	if (FileTimeStamp == FDateTime::MinValue())
+	{
+		return;
+	}
+
+	FPackageEntry Entry;
+	Entry.FileTimeStamp = FileTimeStamp;
+	GatherPackageReferences(InPackage, Entry.References);
+
+	MGA_EDITOR_LOG(VeryVerbose, TEXT("UMGAAttributeReferenceIndexSubsystem::IndexPackage - %s: %d attribute references"), *PackageName.ToString(), Entry.References.Num())
+
+	AddPackageEntry(PackageName, MoveTemp(Entry));
+}
+
+void UMGAAttributeReferenceIndexSubsystem::RebuildIndex()
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), Assets, true);
+
+	FScopedSlowTask Progress(Assets.Num(), LOCTEXT("SlowTask_Rebuild", "Indexing Gameplay Attribute references"));
+	Progress.MakeDialog(true);
+
+	for (const FAssetData& Asset : Assets)
+	{
+		if (Progress.ShouldCancel())
+		{
+			break;
+		}
+
+		Progress.EnterProgressFrame(1.f);
+
+		if (IsPackageUpToDate(Asset.PackageName))
+		{
+			continue;
+		}
+
+		if (const UObject* Object = Asset.GetAsset())
+		{
+			IndexPackage(Object->GetPackage());
+		}
+	}
+
+	SaveIndex();
+
+	MGA_EDITOR_LOG(Display, TEXT("UMGAAttributeReferenceIndexSubsystem::RebuildIndex - Indexed %d packages"), Packages.Num())
+}
+
+void UMGAAttributeReferenceIndexSubsystem::GatherPackageReferences(const UPackage* InPackage, TArray<FMGAAttributeReference>& OutReferences)
+{
+	// Level actors don't define attribute references of their own
+	if (!InPackage || InPackage->ContainsMap())
+	{
+		return;
+	}
+
+	TArray<UObject*> Objects;
+	GetObjectsWithPackage(InPackage, Objects, true, RF_Transient, EInternalObjectFlags::Garbage);
+
+	for (const UObject* Object : Objects)
+	{
+		const UK2Node* Node = Cast<UK2Node>(Object);
+		if (Node)
+		{
+			MGA::AttributeReferenceIndex::GatherPinReferences(Node, OutReferences);
+		}
+
+		// Class default objects and their subobjects (eg. Gameplay Effect components), assets and nodes (eg. custom K2 nodes with attribute properties)
+		if (Node || Object->IsTemplate() || Object->IsAsset())
+		{
+			MGA::AttributeReferenceIndex::GatherStructReferences(Object->GetClass(), Object, FString(), Object->GetPathName(), OutReferences, 0);
+		}
+	}
+}
+
+FString UMGAAttributeReferenceIndexSubsystem::GetIndexFilePath()
+{
+	return FPaths::ProjectIntermediateDir() / TEXT("ModularGameplayAbilities") / TEXT("AttributeReferenceIndex.bin");
+}
+
+FDateTime UMGAAttributeReferenceIndexSubsystem::GetPackageFileTimeStamp(const FName InPackageName)
+{
+	FString Filename;
+	if (!FPackageName::TryConvertLongPackageNameToFilename(InPackageName.ToString(), Filename, FPackageName::GetAssetPackageExtension()))
+	{
+		return FDateTime::MinValue();
+	}
+
+	return IFileManager::Get().GetTimeStamp(*Filename);
+}
+
+void UMGAAttributeReferenceIndexSubsystem::AddPackageEntry(const FName InPackageName, FPackageEntry&& InEntry)
+{
+	RemovePackageEntry(InPackageName);
+
+	for (const FMGAAttributeReference& Reference : InEntry.References)
+	{
+		ReferencersByOwnerPackage.FindOrAdd(Reference.OwnerPackageName).Add(InPackageName);
+	}
+
+	Packages.Add(InPackageName, MoveTemp(InEntry));
+	bDirty = true;
+}
+
+void UMGAAttributeReferenceIndexSubsystem::RemovePackageEntry(const FName InPackageName)
+{
+	FPackageEntry Entry;
+	if (!Packages.RemoveAndCopyValue(InPackageName, Entry))
+	{
+		return;
+	}
+
+	for (const FMGAAttributeReference& Reference : Entry.References)
+	{
+		if (TSet<FName>* Referencers = ReferencersByOwnerPackage.Find(Reference.OwnerPackageName))
+		{
+			Referencers->Remove(InPackageName);
+			if (Referencers->IsEmpty())
+			{
+				ReferencersByOwnerPackage.Remove(Reference.OwnerPackageName);
+			}
+		}
+	}
+
+	bDirty = true;
+}
+
+void UMGAAttributeReferenceIndexSubsystem::LoadIndex()
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetIndexFilePath(), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	int32 Version = 0;
+	Reader << Version;
+	if (Version != MGA::AttributeReferenceIndex::Version)
+	{
+		MGA_EDITOR_LOG(Display, TEXT("UMGAAttributeReferenceIndexSubsystem::LoadIndex - Discarding index with version %d (expected %d)"), Version, MGA::AttributeReferenceIndex::Version)
+		return;
+	}
+
+	TMap<FName, FPackageEntry> LoadedPackages;
+	Reader << LoadedPackages;
+	if (Reader.IsError())
+	{
+		MGA_EDITOR_LOG(Warning, TEXT("UMGAAttributeReferenceIndexSubsystem::LoadIndex - Failed to read %s"), *GetIndexFilePath())
+		return;
+	}
+
+	for (TPair<FName, FPackageEntry>& Pair : LoadedPackages)
+	{
+		AddPackageEntry(Pair.Key, MoveTemp(Pair.Value));
+	}
+
+	bDirty = false;
+
+	MGA_EDITOR_LOG(Verbose, TEXT("UMGAAttributeReferenceIndexSubsystem::LoadIndex - Loaded %d packages"), Packages.Num())
+}
+
+void UMGAAttributeReferenceIndexSubsystem::SaveIndex()
+{
+	if (!bDirty)
+	{
+		return;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	int32 Version = MGA::AttributeReferenceIndex::Version;
+	Writer << Version;
+	Writer << Packages;
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *GetIndexFilePath()))
+	{
+		MGA_EDITOR_LOG(Warning, TEXT("UMGAAttributeReferenceIndexSubsystem::SaveIndex - Failed to write %s"), *GetIndexFilePath())
+		return;
+	}
+
+	bDirty = false;
+}
+
+void UMGAAttributeReferenceIndexSubsystem::HandlePackageSaved(const FString& InFilename, UPackage* InPackage, FObjectPostSaveContext InContext)
+{
+	// Cooking and autosaves don't write the package file the index is compared against
+	if (InContext.IsProceduralSave() || (InContext.GetSaveFlags() & SAVE_FromAutosave) != 0)
+	{
+		return;
+	}
+
+	IndexPackage(InPackage);
+}
+
+void UMGAAttributeReferenceIndexSubsystem::HandleAssetRemoved(const FAssetData& InAssetData)
+{
+	RemovePackageEntry(InAssetData.PackageName);
+}
+
+void UMGAAttributeReferenceIndexSubsystem::HandleAssetRenamed(const FAssetData& InAssetData, const FString& InOldObjectPath)
+{
+	// New package gets indexed when saved
+	RemovePackageEntry(*FPackageName::ObjectPathToPackageName(InOldObjectPath));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,418 @@
+// Copyright Halcyonyx Studios.
+
+#include "MGAAttributeRenameTask.h"
+
+#include "Editor.h"
+#include "MGAEditorLog.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/AsyncTaskNotification.h"
+#include "Misc/UObjectToken.h"
+#include "Subsystems/MGAAttributeReferenceIndexSubsystem.h"
+#include "UObject/Package.h"
+
+#define LOCTEXT_NAMESPACE "MGAAttributeRenameTask"
+
+namespace MGA::AttributeRename
+{
+	static int32 LoadBatchSize = 16;
+	static FAutoConsoleVariableRef CVarLoadBatchSize(
+		TEXT("MGA.AttributeRename.LoadBatchSize"),
+		LoadBatchSize,
+		TEXT("Maximum number of referencer packages loaded at once when a Gameplay Attribute is renamed."),
+		ECVF_Default
+	);
+
+	static float FrameBudgetMs = 10.f;
+	static FAutoConsoleVariableRef CVarFrameBudgetMs(
+		TEXT("MGA.AttributeRename.FrameBudgetMs"),
+		FrameBudgetMs,
+		TEXT("Time spent per frame updating referencers and K2 node pins when a Gameplay Attribute is renamed, in milliseconds."),
+		ECVF_Default
+	);
+
+	static FAutoConsoleCommand PreviewCommand(
+		TEXT("MGA.AttributeRename.Preview"),
+		TEXT("Reports the references that renaming a Gameplay Attribute would update, without modifying anything. Usage: MGA.AttributeRename.Preview <AttributeSetPackageName> <OldName> [NewName]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+		{
+			if (InArgs.Num() < 2)
+			{
+				MGA_EDITOR_LOG(Warning, TEXT("Usage: MGA.AttributeRename.Preview <AttributeSetPackageName> <OldName> [NewName]"))
+				return;
+			}
+
+			if (GEditor)
+			{
+				UMGAEditorSubsystem::Get().PreviewAttributeRename(*InArgs[0], *InArgs[1], InArgs.IsValidIndex(2) ? FName(*InArgs[2]) : FName(*InArgs[1]));
+			}
+		})
+	);
+}
+
+FMGAAttributeRenameTask::FMGAAttributeRenameTask(UMGAEditorSubsystem* InSubsystem, const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName, const bool bInDryRun)
+	: Subsystem(InSubsystem)
+	, PackageName(InPackageName)
+	, OldPropertyName(InOldPropertyName)
+	, NewPropertyName(InNewPropertyName)
+	, bDryRun(bInDryRun)
+{
+}
+
+FMGAAttributeRenameTask::~FMGAAttributeRenameTask()
+{
+	if (Notification.IsValid() && Phase != EPhase::Finished)
+	{
+		Notification->SetComplete(false);
+	}
+}
+
+void FMGAAttributeRenameTask::Start()
+{
+	UMGAEditorSubsystem* EditorSubsystem = Subsystem.Get();
+	if (!EditorSubsystem)
+	{
+		return;
+	}
+
+	EditorSubsystem->PendingMessages.Reset();
+
+	// Referencers were updated by a previous rename since they were cached (the renamed attribute name is the one that rename set)
+	if (!bDryRun && EditorSubsystem->PackagesPendingCacheRefresh.Contains(PackageName))
+	{
+		EditorSubsystem->HandlePreCompile(PackageName);
+	}
+
+	// First figure out the referencers for this package, skipping the ones known not to reference the attribute
+	TArray<FAssetData> ReferencerAssets;
+	TArray<FAssetDependency> Dependencies;
+	UMGAEditorSubsystem::GetReferencers(PackageName, Dependencies, ReferencerAssets);
+	UMGAEditorSubsystem::FilterReferencerAssets(PackageName, OldPropertyName, Dependencies, ReferencerAssets);
+
+	Referencers.Reserve(ReferencerAssets.Num());
+	for (FAssetData& ReferencerAsset : ReferencerAssets)
+	{
+		Referencers.AddDefaulted_GetRef().AssetData = MoveTemp(ReferencerAsset);
+	}
+
+	if (!bDryRun)
+	{
+		OwnerAttributeSetBP = LoadObject<UBlueprint>(nullptr, *PackageName.ToString());
+	}
+
+	MGA_EDITOR_LOG(Verbose, TEXT("FMGAAttributeRenameTask::Start - %s %s.%s to %s, %d referencers"), bDryRun ? TEXT("Previewing") : TEXT("Renaming"), *PackageName.ToString(), *OldPropertyName.ToString(), *NewPropertyName.ToString(), Referencers.Num())
+
+	TitleText = bDryRun
+		? FText::Format(LOCTEXT("PreviewTitle", "Preview rename of attribute {0} to {1}"), FText::FromName(OldPropertyName), FText::FromName(NewPropertyName))
+		: FText::Format(LOCTEXT("RenameTitle", "Rename attribute {0} to {1}"), FText::FromName(OldPropertyName), FText::FromName(NewPropertyName));
+
+	FAsyncTaskNotificationConfig Config;
+	Config.TitleText = TitleText;
+	Config.ProgressText = LOCTEXT("GatherReferencers", "Gathering referencers");
+	Config.bCanCancel = true;
+	Config.LogCategory = &LogModularGameplayAbilitiesEditor;
+	Notification = MakeUnique<FAsyncTaskNotification>(Config);
+}
+
+bool FMGAAttributeRenameTask::Tick()
+{
+	UMGAEditorSubsystem* EditorSubsystem = Subsystem.Get();
+	if (!EditorSubsystem || Phase == EPhase::Finished)
+	{
+		return true;
+	}
+
+	if (!bCancelled && Notification.IsValid() && Notification->GetPromptAction() == EAsyncTaskNotificationPromptAction::Cancel)
+	{
+		Cancel();
+	}
+
+	const double EndTime = FPlatformTime::Seconds() + MGA::AttributeRename::FrameBudgetMs / 1000.0;
+
+	if (Phase == EPhase::Referencers)
+	{
+		if (!bCancelled)
+		{
+			RequestLoads();
+		}
+
+		while (!bCancelled && !ReadyReferencers.IsEmpty() && FPlatformTime::Seconds() < EndTime)
+		{
+			ProcessReferencer(Referencers[ReadyReferencers.Pop(EAllowShrinking::No)]);
+		}
+
+		if (bCancelled || NumProcessed == Referencers.Num())
+		{
+			Phase = EPhase::Pins;
+
+			// Referencers are loaded by now, gathering pins won't need to load Blueprints. Nothing to modify in dry run,
+			// pins of referencers were already reported along with their other references.
+			if (!bCancelled && !bDryRun && OwnerAttributeSetBP.IsValid())
+			{
+				PinsToModify = EditorSubsystem->GetPinsToModify(PackageName.ToString(), OldPropertyName.ToString(), NewPropertyName.ToString());
+			}
+		}
+	}
+
+	if (Phase == EPhase::Pins)
+	{
+		while (!bCancelled && PinsToModify.IsValidIndex(NextPinIndex) && FPlatformTime::Seconds() < EndTime)
+		{
+			if (UBlueprint* Blueprint = EditorSubsystem->HandlePin(PinsToModify[NextPinIndex], OwnerAttributeSetBP.Get(), NewPropertyName))
+			{
+				BlueprintsModified.Add(Blueprint);
+			}
+
+			++NextPinIndex;
+		}
+
+		if (bCancelled || NextPinIndex >= PinsToModify.Num())
+		{
+			Finish();
+		}
+	}
+
+	UpdateProgress();
+	return Phase == EPhase::Finished;
+}
+
+void FMGAAttributeRenameTask::Cancel()
+{
+	MGA_EDITOR_LOG(Display, TEXT("FMGAAttributeRenameTask::Cancel - %s.%s to %s cancelled"), *PackageName.ToString(), *OldPropertyName.ToString(), *NewPropertyName.ToString())
+	bCancelled = true;
+}
+
+void FMGAAttributeRenameTask::RequestLoads()
+{
+	const UMGAAttributeReferenceIndexSubsystem& ReferenceIndex = UMGAAttributeReferenceIndexSubsystem::Get();
+
+	while (Referencers.IsValidIndex(NextLoadIndex) && NumLoadsInFlight < FMath::Max(1, MGA::AttributeRename::LoadBatchSize))
+	{
+		const int32 ReferencerIndex = NextLoadIndex++;
+		FReferencer& Referencer = Referencers[ReferencerIndex];
+
+		// Dry runs can report references of indexed packages without loading them
+		if (bDryRun && ReferenceIndex.IsPackageUpToDate(Referencer.AssetData.PackageName))
+		{
+			ReadyReferencers.Add(ReferencerIndex);
+			continue;
+		}
+
+		UPackage* Package = FindObjectFast<UPackage>(nullptr, Referencer.AssetData.PackageName);
+		if (Package && Package->IsFullyLoaded())
+		{
+			Referencer.Package.Reset(Package);
+			ReadyReferencers.Add(ReferencerIndex);
+			continue;
+		}
+
+		++NumLoadsInFlight;
+		LoadPackageAsync(
+			Referencer.AssetData.PackageName.ToString(),
+			FLoadPackageAsyncDelegate::CreateSP(this, &FMGAAttributeRenameTask::HandlePackageLoaded, ReferencerIndex)
+		);
+	}
+}
+
+void FMGAAttributeRenameTask::HandlePackageLoaded(const FName& InPackageName, UPackage* InPackage, const EAsyncLoadingResult::Type InResult, const int32 InReferencerIndex)
+{
+	--NumLoadsInFlight;
+
+	if (!Referencers.IsValidIndex(InReferencerIndex))
+	{
+		return;
+	}
+
+	FReferencer& Referencer = Referencers[InReferencerIndex];
+	if (InResult == EAsyncLoadingResult::Succeeded && InPackage)
+	{
+		Referencer.Package.Reset(InPackage);
+	}
+	else
+	{
+		MGA_EDITOR_LOG(Warning, TEXT("FMGAAttributeRenameTask::HandlePackageLoaded - Failed to load %s"), *InPackageName.ToString())
+	}
+
+	ReadyReferencers.Add(InReferencerIndex);
+}
+
+void FMGAAttributeRenameTask::ProcessReferencer(FReferencer& InReferencer)
+{
+	if (UMGAEditorSubsystem* EditorSubsystem = Subsystem.Get())
+	{
+		if (bDryRun)
+		{
+			ReportReferences(InReferencer.AssetData.PackageName, InReferencer.Package.Get());
+		}
+		else
+		{
+			EditorSubsystem->UpdateReferencer(InReferencer.AssetData, PackageName, OldPropertyName, NewPropertyName);
+		}
+	}
+
+	InReferencer.bProcessed = true;
+	InReferencer.Package.Reset();
+	++NumProcessed;
+}
+
+void FMGAAttributeRenameTask::ReportReferences(const FName& InPackageName, const UPackage* InPackage)
+{
+	UMGAEditorSubsystem* EditorSubsystem = Subsystem.Get();
+	if (!EditorSubsystem)
+	{
+		return;
+	}
+
+	TArray<FMGAAttributeReference> References;
+	const UMGAAttributeReferenceIndexSubsystem& ReferenceIndex = UMGAAttributeReferenceIndexSubsystem::Get();
+	if (ReferenceIndex.IsPackageUpToDate(InPackageName))
+	{
+		ReferenceIndex.GetReferences(InPackageName, PackageName, OldPropertyName, References);
+	}
+	else if (InPackage)
+	{
+		UMGAAttributeReferenceIndexSubsystem::GatherPackageReferences(InPackage, References);
+		References.RemoveAll([this](const FMGAAttributeReference& Reference)
+		{
+			return Reference.OwnerPackageName != PackageName || Reference.AttributeName != OldPropertyName;
+		});
+	}
+
+	for (const FMGAAttributeReference& Reference : References)
+	{
+		TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(EMessageSeverity::Info);
+		Message->AddToken(FTextToken::Create(Reference.bPin
+			? LOCTEXT("WouldChangePin", "K2 Node Pin: Would change property value of ")
+			: LOCTEXT("WouldChangeProperty", "Property: Would change value of ")
+		));
+
+		if (UObject* Object = FindObject<UObject>(nullptr, *Reference.ObjectPath))
+		{
+			Message->AddToken(
+				FUObjectToken::Create(Object, FText::FromString(Object->GetName()))
+				->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&UMGAEditorSubsystem::HandleMessageLogLinkActivated))
+			);
+		}
+		else
+		{
+			Message->AddToken(FTextToken::Create(FText::FromString(Reference.ObjectPath)));
+		}
+
+		Message->AddToken(FTextToken::Create(FText::Format(
+			LOCTEXT("WouldChangeFromTo", " > {0} from {1} to {2}"),
+			FText::FromString(Reference.PropertyPath),
+			FText::FromName(OldPropertyName),
+			FText::FromName(NewPropertyName)
+		)));
+
+		EditorSubsystem->PendingMessages.Add(Message);
+	}
+}
+
+void FMGAAttributeRenameTask::Finish()
+{
+	Phase = EPhase::Finished;
+
+	UMGAEditorSubsystem* EditorSubsystem = Subsystem.Get();
+	if (!EditorSubsystem)
+	{
+		return;
+	}
+
+	if (!bDryRun)
+	{
+		// Renames of this package queued meanwhile were cached before the referencers got updated
+		EditorSubsystem->PackagesPendingCacheRefresh.Add(PackageName);
+
+		TArray<UBlueprint*> Blueprints;
+		for (const TWeakObjectPtr<UBlueprint>& Blueprint : BlueprintsModified)
+		{
+			if (Blueprint.IsValid())
+			{
+				Blueprints.Add(Blueprint.Get());
+			}
+		}
+
+		EditorSubsystem->HandleModifiedBlueprints(Blueprints, OwnerAttributeSetBP.Get());
+	}
+
+	const int32 NumMessages = EditorSubsystem->PendingMessages.Num();
+
+	// List what was left behind, so that it can be fixed up manually
+	if (bCancelled)
+	{
+		for (const FReferencer& Referencer : Referencers)
+		{
+			if (!Referencer.bProcessed)
+			{
+				EditorSubsystem->PendingMessages.Add(FTokenizedMessage::Create(EMessageSeverity::Warning, FText::Format(
+					LOCTEXT("ReferencerNotProcessed", "Cancelled before processing {0}"),
+					FText::FromName(Referencer.AssetData.PackageName)
+				)));
+			}
+		}
+
+		for (int32 PinIndex = NextPinIndex; PinIndex < PinsToModify.Num(); ++PinIndex)
+		{
+			const UMGAEditorSubsystem::FPinToModify& PinToModify = PinsToModify[PinIndex];
+			if (PinToModify.BlueprintNode.IsValid())
+			{
+				EditorSubsystem->PendingMessages.Add(FTokenizedMessage::Create(EMessageSeverity::Warning, LOCTEXT("PinNotProcessed", "Cancelled before updating pin of "))
+					->AddToken(
+						FUObjectToken::Create(PinToModify.BlueprintNode.Get(), PinToModify.BlueprintNode->GetNodeTitle(ENodeTitleType::ListView))
+						->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&UMGAEditorSubsystem::HandleMessageLogLinkActivated))
+					)
+				);
+			}
+		}
+	}
+
+	const FText PageText = bDryRun
+		? FText::Format(LOCTEXT("PreviewPageInfo", "Preview of renaming attribute {0} to {1}"), FText::FromName(OldPropertyName), FText::FromName(NewPropertyName))
+		: FText::Format(LOCTEXT("PageInfo", "Renamed attribute from {0} to {1}"), FText::FromName(OldPropertyName), FText::FromName(NewPropertyName));
+	EditorSubsystem->FlushPendingMessages(PageText);
+
+	if (Notification.IsValid())
+	{
+		const FText ResultText = bCancelled
+			? FText::Format(LOCTEXT("Cancelled", "Cancelled after {0} of {1} referencers, see the message log"), FText::AsNumber(NumProcessed), FText::AsNumber(Referencers.Num()))
+			: bDryRun
+			? FText::Format(LOCTEXT("PreviewDone", "{0} references would be updated"), FText::AsNumber(NumMessages))
+			: FText::Format(LOCTEXT("RenameDone", "{0} references updated"), FText::AsNumber(NumMessages));
+		Notification->SetComplete(TitleText, ResultText, !bCancelled);
+	}
+
+	Referencers.Reset();
+	ReadyReferencers.Reset();
+	PinsToModify.Reset();
+	BlueprintsModified.Reset();
+}
+
+void FMGAAttributeRenameTask::UpdateProgress()
+{
+	if (!Notification.IsValid() || Phase == EPhase::Finished)
+	{
+		return;
+	}
+
+	if (Phase == EPhase::Referencers)
+	{
+		Notification->SetProgressText(FText::Format(
+			LOCTEXT("ReferencersProgress", "Referencers: {0} / {1} ({2} loading)"),
+			FText::AsNumber(NumProcessed),
+			FText::AsNumber(Referencers.Num()),
+			FText::AsNumber(NumLoadsInFlight)
+		));
+	}
+	else
+	{
+		Notification->SetProgressText(FText::Format(
+			LOCTEXT("PinsProgress", "K2 node pins: {0} / {1}"),
+			FText::AsNumber(NextPinIndex),
+			FText::AsNumber(PinsToModify.Num())
+		));
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,121 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Subsystems/MGAEditorSubsystem.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class FAsyncTaskNotification;
+class UPackage;
+
+/**
+ * Attribute rename run by UMGAEditorSubsystem over several frames, so that renaming an attribute referenced by many assets
+ * doesn't lock up the editor.
+ *
+ * Referencers are loaded asynchronously, a few packages at a time, and updated as they come in under a per frame time
+ * budget. K2 node pins are updated the same way once all referencers are loaded. Progress is shown by a cancellable
+ * notification: cancelling stops before the next referencer or pin, those already updated stay modified and the ones left
+ * are listed in the message log.
+ *
+ * Renames run one at a time. A rename compiled while a previous one of the same Attribute Set is pending was cached before
+ * the previous one updated the referencers, its caches are rebuilt on start (see PackagesPendingCacheRefresh).
+ *
+ * In dry run mode nothing gets loaded for referencers up to date in the attribute reference index and nothing is modified,
+ * the references that would be updated are reported to the message log instead.
+ */
+class FMGAAttributeRenameTask : public TSharedFromThis<FMGAAttributeRenameTask>
+{
+public:
+	FMGAAttributeRenameTask(UMGAEditorSubsystem* InSubsystem, const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName, bool bInDryRun);
+	~FMGAAttributeRenameTask();
+
+	/** Gathers referencers and shows the progress notification */
+	void Start();
+
+	/** Runs the task for up to MGA.AttributeRename.FrameBudgetMs, returns whether it is finished */
+	bool Tick();
+
+	/** Stops the task before the next referencer or pin */
+	void Cancel();
+
+	bool IsDryRun() const { return bDryRun; }
+	FName GetPackageName() const { return PackageName; }
+	FName GetOldPropertyName() const { return OldPropertyName; }
+	FName GetNewPropertyName() const { return NewPropertyName; }
+
+private:
+	enum class EPhase : uint8
+	{
+		/** Loading and updating referencer assets */
+		Referencers,
+
+		/** Updating K2 node pins */
+		Pins,
+
+		Finished
+	};
+
+	/** A referencer asset, possibly being loaded */
+	struct FReferencer
+	{
+		FAssetData AssetData;
+
+		/** Keeps the loaded package from being garbage collected until the referencer is processed */
+		TStrongObjectPtr<UPackage> Package;
+
+		bool bProcessed = false;
+	};
+
+	/** Requests loads of referencers until MGA.AttributeRename.LoadBatchSize packages are in flight */
+	void RequestLoads();
+
+	void HandlePackageLoaded(const FName& InPackageName, UPackage* InPackage, EAsyncLoadingResult::Type InResult, int32 InReferencerIndex);
+
+	/** Updates (or reports in dry run) a loaded referencer */
+	void ProcessReferencer(FReferencer& InReferencer);
+
+	/** Reports references of InPackageName to the renamed attribute, from the index or the loaded package */
+	void ReportReferences(const FName& InPackageName, const UPackage* InPackage);
+
+	void Finish();
+
+	void UpdateProgress();
+
+	TWeakObjectPtr<UMGAEditorSubsystem> Subsystem;
+
+	FName PackageName;
+	FName OldPropertyName;
+	FName NewPropertyName;
+	bool bDryRun = false;
+
+	/** Title of the progress notification */
+	FText TitleText;
+
+	EPhase Phase = EPhase::Referencers;
+	bool bCancelled = false;
+
+	TArray<FReferencer> Referencers;
+
+	/** Index of the next referencer to request a load for */
+	int32 NextLoadIndex = 0;
+
+	/** Indices of loaded referencers waiting to be processed */
+	TArray<int32> ReadyReferencers;
+
+	int32 NumProcessed = 0;
+
+	/** Number of package loads requested and not completed yet */
+	int32 NumLoadsInFlight = 0;
+
+	TArray<UMGAEditorSubsystem::FPinToModify> PinsToModify;
+	int32 NextPinIndex = 0;
+
+	/** Owner attribute set Blueprint, and Blueprints with a modified pin */
+	TWeakObjectPtr<UBlueprint> OwnerAttributeSetBP;
+	TSet<TWeakObjectPtr<UBlueprint>> BlueprintsModified;
+
+	TUniquePtr<FAsyncTaskNotification> Notification;
+};
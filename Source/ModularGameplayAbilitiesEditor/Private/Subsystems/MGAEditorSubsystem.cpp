@@ -4,6 +4,7 @@
 #include "Subsystems/MGAEditorSubsystem.h"
 
 #include "Editor.h"
+#include "Algo/AnyOf.h"
 #include "MGADelegates.h"
 #include "MGAEditorLog.h"
 #include "GameplayEffect.h"
@@ -12,12 +13,20 @@
 #include "TimerManager.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "HAL/FileManager.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Logging/MessageLog.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "Misc/ScopedSlowTask.h"
 #include "Misc/UObjectToken.h"
 #include "ReferencerHandlers/MGAGameplayEffectReferencerHandler.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Subsystems/AssetEditorSubsystem.h"
+#include "Subsystems/MGAAttributeReferenceIndexSubsystem.h"
+#include "Subsystems/MGAAttributeRenameTask.h"
+#include "Subsystems/MGAK2NodeRegistry.h"
 #include "Toolkits/AssetEditorToolkit.h"
 #include "Toolkits/IToolkit.h"
 #include "Toolkits/ToolkitManager.h"
@@ -25,6 +34,12 @@
 
 #define LOCTEXT_NAMESPACE "MGAEditorSubsystem"
 
+namespace MGA::EditorSubsystem
+{
+	/** Bump whenever the pending renames file layout changes, older files are discarded */
+	static constexpr int32 PendingRenamesVersion = 1;
+}
+
 void UMGAEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -42,15 +57,45 @@ void UMGAEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// but still getting occasional crash on Array export text
 	FMGADelegates::OnPostCompile.AddUObject(this, &UMGAEditorSubsystem::HandlePostCompile);
 
+	NodeRegistry = MakeShared<FMGAK2NodeRegistry>();
+
 	// Register handlers
 	RegisterReferencerHandler(TEXT("GameplayEffect"), FMGAGameplayEffectReferencerHandler::Create());
+
+	// Renames interrupted by the last editor exit, referencers need to be loaded and up to date in the asset registry
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.OnFilesLoaded().AddUObject(this, &UMGAEditorSubsystem::ResumePendingRenameTasks);
+	}
+	else
+	{
+		ResumePendingRenameTasks();
+	}
 }
 
 void UMGAEditorSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
 
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnFilesLoaded().RemoveAll(this);
+	}
+
+	// Cancelling would leave referencers half renamed, with messages nobody gets to see. Run them again on next start instead.
+	SavePendingRenameTasks();
+	RenameTasks.Reset();
+
+	if (RenameTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RenameTickerHandle);
+		RenameTickerHandle.Reset();
+	}
+
 	RegisteredHandlers.Reset();
+	NodeHandlerClassNames.Reset();
+	NodeRegistry.Reset();
 
 	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
 	MessageLogModule.UnregisterLogListing(LogName);
@@ -69,6 +114,13 @@ UMGAEditorSubsystem& UMGAEditorSubsystem::Get()
 void UMGAEditorSubsystem::RegisterReferencerHandler(const FName& InClassName, const TSharedPtr<IMGAAttributeReferencerHandler>& InHandler)
 {
 	RegisteredHandlers.Emplace(InClassName, InHandler);
+
+	// Nodes of K2 node classes are looked up from the node registry, other classes are asset referencers
+	const UClass* Class = FindFirstObject<UClass>(*InClassName.ToString(), EFindFirstObjectOptions::NativeFirst);
+	if (Class && Class->IsChildOf(UK2Node::StaticClass()))
+	{
+		NodeHandlerClassNames.Add(InClassName);
+	}
 }
 
 void UMGAEditorSubsystem::UnregisterReferencerHandler(const FName& InClassName)
@@ -77,6 +129,8 @@ void UMGAEditorSubsystem::UnregisterReferencerHandler(const FName& InClassName)
 	{
 		RegisteredHandlers.Remove(InClassName);
 	}
+
+	NodeHandlerClassNames.Remove(InClassName);
 }
 
 TSharedPtr<IMGAAttributeReferencerHandler> UMGAEditorSubsystem::FindAssetDependencyHandler(const FName& InPackageName, TWeakObjectPtr<UObject>& OutDefaultObject)
@@ -112,63 +166,220 @@ TSharedPtr<IMGAAttributeReferencerHandler> UMGAEditorSubsystem::FindAssetDepende
 
 void UMGAEditorSubsystem::HandleAttributeRename(const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName)
 {
-	if (bIsHandlingRename)
+	// Referencers are loaded and updated over the next frames, see FMGAAttributeRenameTask. Renames detected while a task runs
+	// (including by the compile of the owner Blueprint at the end of it) run once the previous ones are finished.
+	QueueRenameTask(InPackageName, InOldPropertyName, InNewPropertyName, false);
+}
+
+void UMGAEditorSubsystem::PreviewAttributeRename(const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName)
+{
+	QueueRenameTask(InPackageName, InOldPropertyName, InNewPropertyName, true);
+}
+
+void UMGAEditorSubsystem::QueueRenameTask(const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName, const bool bInDryRun)
+{
+	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::QueueRenameTask - PackageName: %s, OldName: %s, NewName: %s, DryRun: %s"), *InPackageName.ToString(), *InOldPropertyName.ToString(), *InNewPropertyName.ToString(), bInDryRun ? TEXT("true") : TEXT("false"))
+
+	const TSharedPtr<FMGAAttributeRenameTask> Task = MakeShared<FMGAAttributeRenameTask>(this, InPackageName, InOldPropertyName, InNewPropertyName, bInDryRun);
+	RenameTasks.Add(Task);
+
+	if (RenameTasks.Num() == 1)
+	{
+		Task->Start();
+	}
+
+	if (!RenameTickerHandle.IsValid())
+	{
+		RenameTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMGAEditorSubsystem::TickRenameTasks));
+	}
+}
+
+bool UMGAEditorSubsystem::TickRenameTasks(float InDeltaTime)
+{
+	if (!RenameTasks.IsEmpty() && RenameTasks[0]->Tick())
+	{
+		RenameTasks.RemoveAt(0);
+		if (!RenameTasks.IsEmpty())
+		{
+			RenameTasks[0]->Start();
+		}
+	}
+
+	if (RenameTasks.IsEmpty())
+	{
+		RenameTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void UMGAEditorSubsystem::CancelRenameTasks()
+{
+	if (!RenameTasks.IsEmpty())
+	{
+		// Finishes right away, updating what has been modified so far
+		RenameTasks[0]->Cancel();
+		RenameTasks[0]->Tick();
+		RenameTasks.Reset();
+	}
+
+	if (RenameTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(RenameTickerHandle);
+		RenameTickerHandle.Reset();
+	}
+}
+
+void UMGAEditorSubsystem::SavePendingRenameTasks() const
+{
+	TArray<TSharedPtr<FMGAAttributeRenameTask>> TasksToSave = RenameTasks.FilterByPredicate([](const TSharedPtr<FMGAAttributeRenameTask>& InTask)
+	{
+		return InTask.IsValid() && !InTask->IsDryRun();
+	});
+
+	IFileManager::Get().Delete(*GetPendingRenamesFilePath(), false, false, true);
+	if (TasksToSave.IsEmpty())
 	{
-		MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::HandleAttributeRename - Handling rename already. PackageName: %s, OldName: %s, NewName: %s"), *InPackageName.ToString(), *InOldPropertyName.ToString(), *InNewPropertyName.ToString())
 		return;
 	}
-	
-	PendingMessages.Reset();
 
-	// Keep a copy of old name to display with the notif and message log
-	const FName OldPropertyName = InOldPropertyName;
-	
-	FScopedSlowTask Progress(3.f, LOCTEXT("SlowTask_UpdateReferencers", "Rename attribute - Gather referencers"));
-	Progress.MakeDialog();
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
 
-	// First figure out the referencers for this package
-	TArray<FAssetData> ReferencerAssets;
-	TArray<FAssetDependency> Referencers;
-	GetReferencers(InPackageName, Referencers, ReferencerAssets);
+	int32 Version = MGA::EditorSubsystem::PendingRenamesVersion;
+	Writer << Version;
 
-	// Handle Gameplay Effect Referencers ...
-	Progress.EnterProgressFrame(1.f, FText::Format(LOCTEXT("SlowTask_UpdateReferencers", "Rename attribute - Update {0} referencers"), FText::AsNumber(Referencers.Num())));
-	
-	// Now, update any referencers with FGameplayAttribute properties to point to the new one, from the previously renamed prop
-	UpdateReferencers(ReferencerAssets, InPackageName, InOldPropertyName, InNewPropertyName);
+	int32 NumTasks = TasksToSave.Num();
+	Writer << NumTasks;
+	for (const TSharedPtr<FMGAAttributeRenameTask>& Task : TasksToSave)
+	{
+		FName PackageName = Task->GetPackageName();
+		FName OldPropertyName = Task->GetOldPropertyName();
+		FName NewPropertyName = Task->GetNewPropertyName();
+		Writer << PackageName;
+		Writer << OldPropertyName;
+		Writer << NewPropertyName;
+
+		MGA_EDITOR_LOG(Warning, TEXT("UMGAEditorSubsystem::SavePendingRenameTasks - Rename of %s.%s to %s not finished, it will run again on next editor start"), *PackageName.ToString(), *OldPropertyName.ToString(), *NewPropertyName.ToString())
+	}
 
-	Progress.EnterProgressFrame(1.f, LOCTEXT("SlowTask_UpdateK2Referencers", "Rename attribute - Update K2 Nodes referencers"));
-	
-	// Handle K2Node Referencers ...
-	UpdateK2NodeReferencers(InPackageName, InOldPropertyName, InNewPropertyName);
-	
-	Progress.EnterProgressFrame(1.f);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *GetPendingRenamesFilePath()))
+	{
+		MGA_EDITOR_LOG(Error, TEXT("UMGAEditorSubsystem::SavePendingRenameTasks - Failed to write %s, %d attribute renames are left unfinished"), *GetPendingRenamesFilePath(), NumTasks)
+	}
+}
+
+void UMGAEditorSubsystem::ResumePendingRenameTasks()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnFilesLoaded().RemoveAll(this);
+	}
 
-	if (!PendingMessages.IsEmpty())
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetPendingRenamesFilePath(), FILEREAD_Silent))
 	{
-		FMessageLog MessageLog(LogName);
-		const FText PageText = FText::Format(LOCTEXT("PageInfo", "Renamed attribute from {0} to {1}"), FText::FromName(OldPropertyName), FText::FromName(InNewPropertyName));
-		MessageLog.NewPage(FText::Format(LOCTEXT("NewPage", "{0} ({1})"), PageText, FText::AsDateTime(FDateTime::Now())));
+		return;
+	}
+
+	IFileManager::Get().Delete(*GetPendingRenamesFilePath(), false, false, true);
+
+	FMemoryReader Reader(Bytes);
+
+	int32 Version = 0;
+	Reader << Version;
+	if (Version != MGA::EditorSubsystem::PendingRenamesVersion)
+	{
+		return;
+	}
+
+	int32 NumTasks = 0;
+	Reader << NumTasks;
+	for (int32 Index = 0; Index < NumTasks && !Reader.IsError(); ++Index)
+	{
+		FName PackageName;
+		FName OldPropertyName;
+		FName NewPropertyName;
+		Reader << PackageName;
+		Reader << OldPropertyName;
+		Reader << NewPropertyName;
+
+		if (Reader.IsError())
+		{
+			break;
+		}
+
+		// The Attribute Set may not have been saved after the rename, referencers on disk are fine then
+		const UClass* OwnerClass = StaticLoadClass(UObject::StaticClass(), nullptr, *GetLoadClassPackagePath(PackageName.ToString()));
+		if (!OwnerClass || FindFProperty<FProperty>(OwnerClass, OldPropertyName))
+		{
+			MGA_EDITOR_LOG(Display, TEXT("UMGAEditorSubsystem::ResumePendingRenameTasks - Skipping rename of %s.%s to %s, the Attribute Set wasn't saved renamed"), *PackageName.ToString(), *OldPropertyName.ToString(), *NewPropertyName.ToString())
+			continue;
+		}
+
+		MGA_EDITOR_LOG(Display, TEXT("UMGAEditorSubsystem::ResumePendingRenameTasks - Resuming rename of %s.%s to %s interrupted by last editor exit"), *PackageName.ToString(), *OldPropertyName.ToString(), *NewPropertyName.ToString())
+
+		// Caches saved on exit predate the interrupted updates, rebuild the ones of referencers that changed since
+		PackagesPendingCacheRefresh.Add(PackageName);
+		QueueRenameTask(PackageName, OldPropertyName, NewPropertyName, false);
+	}
+}
 
-		const FText NotifyText = FText::Format(LOCTEXT("NotifyText", "Modular Attributes: {0} ({1} updates)"), PageText, FText::AsNumber(PendingMessages.Num()));
-		MessageLog.Info(NotifyText);
-		MessageLog.AddMessages(PendingMessages);
+FString UMGAEditorSubsystem::GetPendingRenamesFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ModularGameplayAbilities") / TEXT("PendingAttributeRenames.bin");
+}
 
-		MessageLog.Notify(NotifyText, EMessageSeverity::Info, true);
+void UMGAEditorSubsystem::FlushPendingMessages(const FText& InPageText)
+{
+	if (PendingMessages.IsEmpty())
+	{
+		return;
 	}
+
+	FMessageLog MessageLog(LogName);
+	MessageLog.NewPage(FText::Format(LOCTEXT("NewPage", "{0} ({1})"), InPageText, FText::AsDateTime(FDateTime::Now())));
+
+	const FText NotifyText = FText::Format(LOCTEXT("NotifyText", "Modular Attributes: {0} ({1} updates)"), InPageText, FText::AsNumber(PendingMessages.Num()));
+	MessageLog.Info(NotifyText);
+	MessageLog.AddMessages(PendingMessages);
+
+	MessageLog.Notify(NotifyText, EMessageSeverity::Info, true);
+	PendingMessages.Reset();
 }
 
 void UMGAEditorSubsystem::HandlePreCompile(const FName& InPackageName)
 {
 	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::HandlePreCompile InPackageName: %s"), *InPackageName.ToString())
+
+	// Referencers updated by a previous rename are cached again below
+	PackagesPendingCacheRefresh.Remove(InPackageName);
 	
 	// First figure out the referencers for this package
 	TArray<FAssetData> ReferencerAssets;
 	TArray<FAssetDependency> Referencers;
 	GetReferencers(InPackageName, Referencers, ReferencerAssets);
 
+	// The attribute about to be renamed isn't known yet, keep referencers of any attribute of this package
+	FilterReferencerAssets(InPackageName, NAME_None, Referencers, ReferencerAssets);
+
+	// Nodes of K2 node classes with a registered handler (for instance, custom K2 Node switch with array property of FGameplayAttribute)
+	TMap<FName, TArray<UK2Node*>> HandledNodes;
+	for (const FName& NodeClassName : NodeHandlerClassNames)
+	{
+		NodeRegistry->GetNodesOfClass(NodeClassName, HandledNodes.Add(NodeClassName));
+	}
+
 	for (const TPair<FName, TSharedPtr<IMGAAttributeReferencerHandler>>& RegisteredHandler : RegisteredHandlers)
 	{
+		// K2 node handlers have nothing to prepare without any node to handle
+		const TArray<UK2Node*>* Nodes = HandledNodes.Find(RegisteredHandler.Key);
+		if (Nodes && Nodes->IsEmpty())
+		{
+			continue;
+		}
+
 		TSharedPtr<IMGAAttributeReferencerHandler> Handler = RegisteredHandler.Value;
 		if (Handler.IsValid())
 		{
@@ -179,6 +390,17 @@ void UMGAEditorSubsystem::HandlePreCompile(const FName& InPackageName)
 	// Then check if we have a registered handler
 	for (const FAssetData& Referencer : ReferencerAssets)
 	{
+		// Attributes cached by a handler are still up to date, no need to load the referencer
+		const bool bHasValidCache = Algo::AnyOf(RegisteredHandlers, [&Referencer](const TPair<FName, TSharedPtr<IMGAAttributeReferencerHandler>>& RegisteredHandler)
+		{
+			return RegisteredHandler.Value.IsValid() && RegisteredHandler.Value->HasValidCache(Referencer.PackageName);
+		});
+
+		if (bHasValidCache)
+		{
+			continue;
+		}
+
 		FMGAAttributeReferencerPayload Payload;
 		Payload.PackageName = InPackageName.ToString();
 		TSharedPtr<IMGAAttributeReferencerHandler> ReferencerHandler = FindAssetDependencyHandler(Referencer.PackageName, Payload.DefaultObject);
@@ -188,35 +410,23 @@ void UMGAEditorSubsystem::HandlePreCompile(const FName& InPackageName)
 		}
 	}
 
-	for (TObjectIterator<UK2Node> NodeIt; NodeIt; ++NodeIt)
+	// If we have an handler for these K2 Nodes, delegate any custom handling of an attribute rename
+	for (const TPair<FName, TArray<UK2Node*>>& Pair : HandledNodes)
 	{
-		UK2Node* Node = *NodeIt;
-		if (!Node)
+		TSharedPtr<IMGAAttributeReferencerHandler> Handler = RegisteredHandlers.FindRef(Pair.Key);
+		if (!Handler.IsValid())
 		{
 			continue;
 		}
 
-		FString NodeName = Node->GetName();
-		const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
-		if (!Blueprint)
-		{
-			continue;
-		}
-
-		// If we have an handler for this K2 Node, delegate any custom handling of an attribute rename (for instance, custom K2 Node switch with array property of FGameplayAttribute)
-		const UClass* NodeClass = Node->GetClass();
-		if (NodeClass && RegisteredHandlers.Contains(NodeClass->GetFName()))
+		for (UK2Node* Node : Pair.Value)
 		{
-			TSharedPtr<IMGAAttributeReferencerHandler> Handler = RegisteredHandlers.FindChecked(NodeClass->GetFName());
-			if (Handler.IsValid() && Blueprint->GetPackage() != GetTransientPackage())
-			{
-				FMGAAttributeReferencerPayload Payload;
-				Payload.DefaultObject = Node;
-				Payload.PackageName = InPackageName.ToString();
-				
-				FAssetIdentifier AssetIdentifier(Node, NAME_None);
-				Handler->HandlePreCompile(AssetIdentifier, Payload);
-			}
+			FMGAAttributeReferencerPayload Payload;
+			Payload.DefaultObject = Node;
+			Payload.PackageName = InPackageName.ToString();
+			
+			FAssetIdentifier AssetIdentifier(Node, NAME_None);
+			Handler->HandlePreCompile(AssetIdentifier, Payload);
 		}
 	}
 }
@@ -291,6 +501,75 @@ void UMGAEditorSubsystem::GetGameplayEffectReferencers(const FName& InPackageNam
 	GetReferencers(InPackageName, OutReferencers, OutAssetsData, { UGameplayEffect::StaticClass() });
 }
 
+void UMGAEditorSubsystem::FilterReferencerAssets(const FName& InPackageName, const FName& InAttributeName, const TArray<FAssetDependency>& InReferencers, TArray<FAssetData>& InOutAssetsData)
+{
+	const UMGAAttributeReferenceIndexSubsystem& ReferenceIndex = UMGAAttributeReferenceIndexSubsystem::Get();
+
+	const int32 NumAssets = InOutAssetsData.Num();
+	InOutAssetsData.RemoveAll([&ReferenceIndex, &InReferencers, &InPackageName, &InAttributeName](const FAssetData& AssetData)
+	{
+		if (!ReferenceIndex.MayReferenceAttribute(AssetData.PackageName, InPackageName, InAttributeName))
+		{
+			return true;
+		}
+
+		const FAssetDependency* Referencer = InReferencers.FindByPredicate([&AssetData](const FAssetDependency& Dependency)
+		{
+			return Dependency.AssetId.PackageName == AssetData.PackageName;
+		});
+
+		return Referencer && !EnumHasAnyFlags(Referencer->Properties, UE::AssetRegistry::EDependencyProperty::Hard);
+	});
+
+	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::FilterReferencerAssets - Kept %d referencers out of %d"), InOutAssetsData.Num(), NumAssets)
+}
+
+TArray<UBlueprint*> UMGAEditorSubsystem::GetBlueprintsToScan(const FName& InPackageName, const FName& InAttributeName)
+{
+	if (!ensureMsgf(!InAttributeName.IsNone(), TEXT("GetBlueprintsToScan would load every indexed referencer of %s"), *InPackageName.ToString()))
+	{
+		return {};
+	}
+
+	UMGAAttributeReferenceIndexSubsystem& ReferenceIndex = UMGAAttributeReferenceIndexSubsystem::Get();
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<UBlueprint*> Blueprints;
+
+	// Indexed Blueprints referencing the attribute, possibly not loaded
+	TArray<FName> ReferencingPackages;
+	ReferenceIndex.GetReferencingPackages(InPackageName, InAttributeName, ReferencingPackages);
+	for (const FName ReferencingPackage : ReferencingPackages)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(ReferencingPackage, Assets);
+		for (const FAssetData& Asset : Assets)
+		{
+			if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset()))
+			{
+				Blueprints.AddUnique(Blueprint);
+			}
+		}
+	}
+
+	// Loaded Blueprints the index can't tell about (never indexed, changed on disk or with unsaved changes)
+	for (TObjectIterator<UBlueprint> BlueprintIt; BlueprintIt; ++BlueprintIt)
+	{
+		UBlueprint* Blueprint = *BlueprintIt;
+		const UPackage* Package = Blueprint ? Blueprint->GetPackage() : nullptr;
+		if (!Package || Package == GetTransientPackage() || ReferenceIndex.IsPackageUpToDate(Package->GetFName()))
+		{
+			continue;
+		}
+
+		ReferenceIndex.IndexPackage(Package);
+		Blueprints.AddUnique(Blueprint);
+	}
+
+	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::GetBlueprintsToScan - %d Blueprints to scan (%d from the attribute reference index)"), Blueprints.Num(), ReferencingPackages.Num())
+	return Blueprints;
+}
+
 UGameplayEffect* UMGAEditorSubsystem::GetGameplayEffectCDO(const FString& InPackageName)
 {
 	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::GetGameplayEffectCDO - Try load with %s"), *InPackageName)
@@ -374,45 +653,46 @@ TArray<UMGAEditorSubsystem::FPinToModify> UMGAEditorSubsystem::GetPinsToModify(c
 {
 	TArray<FPinToModify> PinsToModify;
 
-	for (TObjectIterator<UK2Node> NodeIt; NodeIt; ++NodeIt)
+	// If we have an handler for a K2 Node class, delegate any custom handling of an attribute rename (for instance, custom K2 Node switch with array property of FGameplayAttribute)
+	for (const FName& NodeClassName : NodeHandlerClassNames)
 	{
-		UK2Node* Node = *NodeIt;
-		if (!Node)
+		TSharedPtr<IMGAAttributeReferencerHandler> Handler = RegisteredHandlers.FindRef(NodeClassName);
+		if (!Handler.IsValid())
 		{
 			continue;
 		}
 
-		UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
-		if (!Blueprint)
+		TArray<UK2Node*> HandledNodes;
+		NodeRegistry->GetNodesOfClass(NodeClassName, HandledNodes);
+		for (UK2Node* Node : HandledNodes)
 		{
-			continue;
+			FMGAAttributeReferencerPayload Payload;
+			Payload.DefaultObject = Node;
+			Payload.PackageName = InPackageName;
+			Payload.OldPropertyName = InOldPropertyName;
+			Payload.NewPropertyName = InNewPropertyName;
+			
+			TArray<TSharedRef<FTokenizedMessage>> Messages;
+			FAssetIdentifier AssetIdentifier(Node, NAME_None);
+			Handler->HandleAttributeRename(AssetIdentifier, Payload, Messages);
+			PendingMessages.Append(Messages);
 		}
+	}
+
+	// Nodes with an attribute pin, of the Blueprints which may reference the renamed attribute
+	TArray<UK2Node*> Nodes;
+	for (UBlueprint* Blueprint : GetBlueprintsToScan(*InPackageName, *InOldPropertyName))
+	{
+		NodeRegistry->GetAttributeNodes(Blueprint, Nodes);
+	}
 
-		if (Blueprint->GetPackage() == GetTransientPackage())
+	for (UK2Node* Node : Nodes)
+	{
+		if (!Node)
 		{
 			continue;
 		}
 
-		// If we have an handler for this K2 Node, delegate any custom handling of an attribute rename (for instance, custom K2 Node switch with array property of FGameplayAttribute)
-		UClass* NodeClass = Node->GetClass();
-		if (NodeClass && RegisteredHandlers.Contains(NodeClass->GetFName()))
-		{
-			TSharedPtr<IMGAAttributeReferencerHandler> Handler = RegisteredHandlers.FindChecked(NodeClass->GetFName());
-			if (Handler.IsValid())
-			{
-				FMGAAttributeReferencerPayload Payload;
-				Payload.DefaultObject = Node;
-				Payload.PackageName = InPackageName;
-				Payload.OldPropertyName = InOldPropertyName;
-				Payload.NewPropertyName = InNewPropertyName;
-				
-				TArray<TSharedRef<FTokenizedMessage>> Messages;
-				FAssetIdentifier AssetIdentifier(Node, NAME_None);
-				Handler->HandleAttributeRename(AssetIdentifier, Payload, Messages);
-				PendingMessages.Append(Messages);
-			}
-		}
-		
 		for (UEdGraphPin* Pin : Node->Pins)
 		{
 			FEdGraphPinType PinType = Pin->PinType;
@@ -459,87 +739,106 @@ TArray<UMGAEditorSubsystem::FPinToModify> UMGAEditorSubsystem::GetPinsToModify(c
 void UMGAEditorSubsystem::HandlePins(const TArray<FPinToModify>& InPinsToModify, const UBlueprint* InOwnerAttributeSetBP, const FName& InNewPropertyName)
 {
 	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::UpdateK2NodeReferencers - Test InPinsToModify: %d"), InPinsToModify.Num())
-	TSet<UBlueprint*> BlueprintsModified;
+	TArray<UBlueprint*> BlueprintsModified;
 	for (const FPinToModify& PinToModify : InPinsToModify)
 	{
-		if (!PinToModify.Pin || !PinToModify.BlueprintNode.IsValid())
+		if (UBlueprint* Blueprint = HandlePin(PinToModify, InOwnerAttributeSetBP, InNewPropertyName))
 		{
-			continue;
+			BlueprintsModified.AddUnique(Blueprint);
 		}
+	}
 
-		if (!InOwnerAttributeSetBP->GeneratedClass)
-		{
-			MGA_EDITOR_LOG(Warning, TEXT("UMGAEditorSubsystem::UpdateK2NodeReferencers - NO GENERATED CLASS (InOwnerAttributeSetBP: %s"), *GetNameSafe(InOwnerAttributeSetBP))
-			continue;
-		}
+	HandleModifiedBlueprints(BlueprintsModified, InOwnerAttributeSetBP);
+}
 
-		UEdGraphPin* Pin = PinToModify.Pin;
-		TWeakObjectPtr<UK2Node> BlueprintNode = PinToModify.BlueprintNode;
-		UBlueprint* Blueprint = BlueprintNode->GetBlueprint();
-		const UEdGraph* OwningGraph = BlueprintNode->GetGraph();
-		FString DefaultValue = Pin->GetDefaultAsString();
+UBlueprint* UMGAEditorSubsystem::HandlePin(const FPinToModify& InPinToModify, const UBlueprint* InOwnerAttributeSetBP, const FName& InNewPropertyName)
+{
+	// Pins may have been gathered a few frames ago, make sure the node wasn't reconstructed since
+	if (!InPinToModify.Pin || !InPinToModify.BlueprintNode.IsValid() || !InPinToModify.BlueprintNode->Pins.Contains(InPinToModify.Pin))
+	{
+		return nullptr;
+	}
 
-		MGA_EDITOR_LOG(Verbose, TEXT("\t UMGAEditorSubsystem::UpdateK2NodeReferencers - PinToModify Blueprint: %s"), *GetNameSafe(Blueprint))
-		MGA_EDITOR_LOG(Verbose, TEXT("\t UMGAEditorSubsystem::UpdateK2NodeReferencers - PinToModify Pin: %s"), *Pin->GetName())
+	if (!InOwnerAttributeSetBP || !InOwnerAttributeSetBP->GeneratedClass)
+	{
+		MGA_EDITOR_LOG(Warning, TEXT("UMGAEditorSubsystem::UpdateK2NodeReferencers - NO GENERATED CLASS (InOwnerAttributeSetBP: %s"), *GetNameSafe(InOwnerAttributeSetBP))
+		return nullptr;
+	}
 
-		if (FProperty* Prop = FindFProperty<FProperty>(InOwnerAttributeSetBP->GeneratedClass, InNewPropertyName))
-		{
-			MGA_EDITOR_LOG(Verbose, TEXT("\t Prop: %s (Owner: %s)"), *GetNameSafe(Prop), *InOwnerAttributeSetBP->GeneratedClass->GetName())
+	UEdGraphPin* Pin = InPinToModify.Pin;
+	TWeakObjectPtr<UK2Node> BlueprintNode = InPinToModify.BlueprintNode;
+	UBlueprint* Blueprint = BlueprintNode->GetBlueprint();
+	const UEdGraph* OwningGraph = BlueprintNode->GetGraph();
+	FString DefaultValue = Pin->GetDefaultAsString();
 
-			FString FinalValue;
-			FGameplayAttribute NewAttributeStruct;
-			NewAttributeStruct.SetUProperty(Prop);
+	MGA_EDITOR_LOG(Verbose, TEXT("\t UMGAEditorSubsystem::UpdateK2NodeReferencers - PinToModify Blueprint: %s"), *GetNameSafe(Blueprint))
+	MGA_EDITOR_LOG(Verbose, TEXT("\t UMGAEditorSubsystem::UpdateK2NodeReferencers - PinToModify Pin: %s"), *Pin->GetName())
 
-			FGameplayAttribute::StaticStruct()->ExportText(FinalValue, &NewAttributeStruct, &NewAttributeStruct, nullptr, PPF_SerializedAsImportText, nullptr);
+	FProperty* Prop = FindFProperty<FProperty>(InOwnerAttributeSetBP->GeneratedClass, InNewPropertyName);
+	if (!Prop)
+	{
+		return nullptr;
+	}
 
-			if (FinalValue != DefaultValue && Pin->GetSchema())
-			{
-				// const FScopedTransaction Transaction(LOCTEXT("ChangePinValueTransaction", "Change Pin Value"));
-				Pin->Modify();
-				Pin->GetSchema()->TrySetDefaultValue(*Pin, FinalValue);
+	MGA_EDITOR_LOG(Verbose, TEXT("\t Prop: %s (Owner: %s)"), *GetNameSafe(Prop), *InOwnerAttributeSetBP->GeneratedClass->GetName())
 
-				TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(EMessageSeverity::Info);
-				Message->AddToken(FTextToken::Create(LOCTEXT("ChangedPinProperty", "K2 Node Pin: Changed property value of ")));
-				if (Blueprint)
-				{
-					Message->AddToken(
-						FUObjectToken::Create(Blueprint, FText::FromString(Blueprint->GetName()))
-						->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&HandleMessageLogLinkActivated))
-					);
-				}
+	FString FinalValue;
+	FGameplayAttribute NewAttributeStruct;
+	NewAttributeStruct.SetUProperty(Prop);
 
-				if (OwningGraph)
-				{
-					Message->AddToken(FTextToken::Create(LOCTEXT("Separator", " > ")));
-					Message->AddToken(
-						FUObjectToken::Create(OwningGraph, FText::FromString(OwningGraph->GetName()))
-						->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&HandleMessageLogLinkActivated))
-					);
-				}
-					
-				Message->AddToken(FTextToken::Create(LOCTEXT("Separator", " > ")));
-				Message->AddToken(
-					FUObjectToken::Create(BlueprintNode.Get(), BlueprintNode->GetNodeTitle(ENodeTitleType::ListView))
-					->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&HandleMessageLogLinkActivated))
-				);
-
-				FText MessageText = FText::Format(
-					LOCTEXT("ChangedPinFromTo", "from {0} to {1}"),
-					FText::FromString(PinToModify.OldPropertyName),
-					FText::FromString(Prop->GetName())
-				);
-				Message->AddToken(FTextToken::Create(MessageText));
-
-				PendingMessages.Add(Message);
-				MGA_EDITOR_LOG(Verbose, TEXT("\t %s"), *Message->ToText().ToString())
-
-				BlueprintsModified.Emplace(Blueprint);
-			}
-		}
+	FGameplayAttribute::StaticStruct()->ExportText(FinalValue, &NewAttributeStruct, &NewAttributeStruct, nullptr, PPF_SerializedAsImportText, nullptr);
+
+	if (FinalValue == DefaultValue || !Pin->GetSchema())
+	{
+		return nullptr;
+	}
+
+	// const FScopedTransaction Transaction(LOCTEXT("ChangePinValueTransaction", "Change Pin Value"));
+	Pin->Modify();
+	Pin->GetSchema()->TrySetDefaultValue(*Pin, FinalValue);
+
+	TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(EMessageSeverity::Info);
+	Message->AddToken(FTextToken::Create(LOCTEXT("ChangedPinProperty", "K2 Node Pin: Changed property value of ")));
+	if (Blueprint)
+	{
+		Message->AddToken(
+			FUObjectToken::Create(Blueprint, FText::FromString(Blueprint->GetName()))
+			->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&HandleMessageLogLinkActivated))
+		);
 	}
 
-	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::UpdateK2NodeReferencers - BlueprintsModified: %d"), BlueprintsModified.Num())
-	for (UBlueprint* Blueprint : BlueprintsModified)
+	if (OwningGraph)
+	{
+		Message->AddToken(FTextToken::Create(LOCTEXT("Separator", " > ")));
+		Message->AddToken(
+			FUObjectToken::Create(OwningGraph, FText::FromString(OwningGraph->GetName()))
+			->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&HandleMessageLogLinkActivated))
+		);
+	}
+		
+	Message->AddToken(FTextToken::Create(LOCTEXT("Separator", " > ")));
+	Message->AddToken(
+		FUObjectToken::Create(BlueprintNode.Get(), BlueprintNode->GetNodeTitle(ENodeTitleType::ListView))
+		->OnMessageTokenActivated(FOnMessageTokenActivated::CreateStatic(&HandleMessageLogLinkActivated))
+	);
+
+	FText MessageText = FText::Format(
+		LOCTEXT("ChangedPinFromTo", "from {0} to {1}"),
+		FText::FromString(InPinToModify.OldPropertyName),
+		FText::FromString(Prop->GetName())
+	);
+	Message->AddToken(FTextToken::Create(MessageText));
+
+	PendingMessages.Add(Message);
+	MGA_EDITOR_LOG(Verbose, TEXT("\t %s"), *Message->ToText().ToString())
+
+	return Blueprint;
+}
+
+void UMGAEditorSubsystem::HandleModifiedBlueprints(const TArray<UBlueprint*>& InBlueprintsModified, const UBlueprint* InOwnerAttributeSetBP)
+{
+	MGA_EDITOR_LOG(Verbose, TEXT("UMGAEditorSubsystem::UpdateK2NodeReferencers - BlueprintsModified: %d"), InBlueprintsModified.Num())
+	for (UBlueprint* Blueprint : InBlueprintsModified)
 	{
 		if (!Blueprint)
 		{
@@ -561,9 +860,7 @@ void UMGAEditorSubsystem::HandlePins(const TArray<FPinToModify>& InPinsToModify,
 		if (Blueprint == InOwnerAttributeSetBP)
 		{
 			MGA_EDITOR_LOG(Verbose, TEXT("\t Blueprint: %s is the same. Needs compile again."), *Blueprint->GetName())
-			bIsHandlingRename = true;
 			FKismetEditorUtilities::CompileBlueprint(Blueprint);
-			bIsHandlingRename = false;
 
 			if (Blueprint->Status == BS_UpToDate)
 			{
@@ -655,30 +952,44 @@ void UMGAEditorSubsystem::UpdateReferencers(TArray<FAssetData> InReferencers, co
 	for (const FAssetData& Referencer : InReferencers)
 	{
 		Progress.EnterProgressFrame(1.f);
+		UpdateReferencer(Referencer, InPackageName, InOldPropertyName, InNewPropertyName);
+	}
+}
 
-		FMGAAttributeReferencerPayload Payload;
-		Payload.PackageName = InPackageName.ToString();
-		Payload.OldPropertyName = InOldPropertyName.ToString();
-		Payload.NewPropertyName = InNewPropertyName.ToString();
-		Payload.ReferencerBlueprint = Cast<UBlueprint>(Referencer.GetAsset());
-		TSharedPtr<IMGAAttributeReferencerHandler> Handler = FindAssetDependencyHandler(Referencer.PackageName, Payload.DefaultObject);
+bool UMGAEditorSubsystem::UpdateReferencer(const FAssetData& InReferencer, const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName)
+{
+	FMGAAttributeReferencerPayload Payload;
+	Payload.PackageName = InPackageName.ToString();
+	Payload.OldPropertyName = InOldPropertyName.ToString();
+	Payload.NewPropertyName = InNewPropertyName.ToString();
+	Payload.ReferencerBlueprint = Cast<UBlueprint>(InReferencer.GetAsset());
+
+	// Had to be loaded anyway, index it before it gets modified so that next renames can skip it
+	if (Payload.ReferencerBlueprint.IsValid() && !UMGAAttributeReferenceIndexSubsystem::Get().IsPackageUpToDate(InReferencer.PackageName))
+	{
+		UMGAAttributeReferenceIndexSubsystem::Get().IndexPackage(Payload.ReferencerBlueprint->GetPackage());
+	}
 
-		if (Handler.IsValid() && Payload.DefaultObject.IsValid())
-		{
-			TArray<TSharedRef<FTokenizedMessage>> Messages;
-			const bool bHandledRename = Handler->HandleAttributeRename(Referencer.PackageName, Payload, Messages);
-			PendingMessages.Append(Messages);
-			
-			if (bHandledRename)
-			{
-				Payload.DefaultObject->Modify();
-				Payload.DefaultObject->PostEditChange();
-				Payload.DefaultObject->MarkPackageDirty();
+	TSharedPtr<IMGAAttributeReferencerHandler> Handler = FindAssetDependencyHandler(InReferencer.PackageName, Payload.DefaultObject);
+	if (!Handler.IsValid() || !Payload.DefaultObject.IsValid())
+	{
+		return false;
+	}
 
-				FMGADelegates::OnRequestDetailsRefresh.Broadcast();
-			}
-		}
+	TArray<TSharedRef<FTokenizedMessage>> Messages;
+	const bool bHandledRename = Handler->HandleAttributeRename(InReferencer.PackageName, Payload, Messages);
+	PendingMessages.Append(Messages);
+	
+	if (bHandledRename)
+	{
+		Payload.DefaultObject->Modify();
+		Payload.DefaultObject->PostEditChange();
+		Payload.DefaultObject->MarkPackageDirty();
+
+		FMGADelegates::OnRequestDetailsRefresh.Broadcast();
 	}
+
+	return bHandledRename;
 }
 
 // ReSharper disable once CppMemberFunctionMayBeStatic
@@ -695,10 +1006,15 @@ void UMGAEditorSubsystem::HandlePostCompile(const FName& InPackageName)
 		}
 	}
 
-	// First figure out the referencers for this package
+	// First figure out the referencers for this package. Only loaded ones can be opened in an editor, don't load the others to check their class.
 	TArray<FAssetData> ReferencerAssets;
 	TArray<FAssetDependency> Referencers;
-	GetGameplayEffectReferencers(InPackageName, Referencers, ReferencerAssets);
+	GetReferencers(InPackageName, Referencers, ReferencerAssets);
+	ReferencerAssets.RemoveAll([](const FAssetData& AssetData)
+	{
+		const UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset());
+		return !Blueprint || !Blueprint->GeneratedClass || !Blueprint->GeneratedClass->IsChildOf(UGameplayEffect::StaticClass());
+	});
 
 	// Second, close the editors. It fixes a crash when the Slate details customizations for Gameplay Effects and Attributes tries
 	// to access a now invalid property
@@ -0,0 +1,221 @@
+// Copyright Halcyonyx Studios.
+
+#include "MGAK2NodeRegistry.h"
+
+#include "AttributeSet.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node.h"
+#include "MGAEditorLog.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+FMGAK2NodeRegistry::FMGAK2NodeRegistry()
+{
+	// The UObject array is preallocated, its capacity doesn't change once the engine is running
+	NumTrackedIndexWords = FMath::DivideAndRoundUp(GUObjectArray.GetObjectArrayCapacity(), 64);
+	TrackedIndices = MakeUnique<std::atomic<uint64>[]>(NumTrackedIndexWords);
+
+	// Nodes loaded before the editor module started
+	for (TObjectIterator<UK2Node> NodeIt(RF_ClassDefaultObject | RF_ArchetypeObject); NodeIt; ++NodeIt)
+	{
+		PendingNodes.Add(*NodeIt);
+		MarkTracked(GUObjectArray.ObjectToIndex(*NodeIt));
+	}
+
+	GUObjectArray.AddUObjectCreateListener(this);
+	GUObjectArray.AddUObjectDeleteListener(this);
+	bListening = true;
+
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMGAK2NodeRegistry::HandleObjectModified);
+}
+
+FMGAK2NodeRegistry::~FMGAK2NodeRegistry()
+{
+	FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+	OnUObjectArrayShutdown();
+}
+
+void FMGAK2NodeRegistry::GetNodesOfClass(const FName InClassName, TArray<UK2Node*>& OutNodes)
+{
+	FScopeLock Lock(&CriticalSection);
+	FlushPendingNodes();
+
+	if (const TSet<const UK2Node*>* Nodes = NodesByClass.Find(InClassName))
+	{
+		OutNodes.Reserve(OutNodes.Num() + Nodes->Num());
+		for (const UK2Node* Node : *Nodes)
+		{
+			OutNodes.Add(const_cast<UK2Node*>(Node));
+		}
+	}
+}
+
+void FMGAK2NodeRegistry::GetAttributeNodes(const UBlueprint* InBlueprint, TArray<UK2Node*>& OutNodes)
+{
+	FScopeLock Lock(&CriticalSection);
+	FlushPendingNodes();
+
+	if (const TSet<const UK2Node*>* Nodes = AttributeNodesByBlueprint.Find(InBlueprint))
+	{
+		OutNodes.Reserve(OutNodes.Num() + Nodes->Num());
+		for (const UK2Node* Node : *Nodes)
+		{
+			OutNodes.Add(const_cast<UK2Node*>(Node));
+		}
+	}
+}
+
+bool FMGAK2NodeRegistry::HasAttributePin(const UK2Node* InNode)
+{
+	return InNode->Pins.ContainsByPredicate([](const UEdGraphPin* Pin)
+	{
+		return Pin
+			&& Pin->Direction == EGPD_Input
+			&& Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct
+			&& Pin->PinType.PinSubCategoryObject == FGameplayAttribute::StaticStruct();
+	});
+}
+
+void FMGAK2NodeRegistry::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// Not constructed yet, only its class and flags can be used
+	if ((Object->GetFlags() & (RF_ClassDefaultObject | RF_ArchetypeObject)) != 0 || !Object->GetClass()->IsChildOf(UK2Node::StaticClass()))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	PendingNodes.Add(static_cast<const UK2Node*>(Object));
+	MarkTracked(Index);
+}
+
+void FMGAK2NodeRegistry::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	// Called for every destroyed UObject. Being destroyed, only its address and index can be used (its class may already
+	// be gone), skip objects that aren't tracked nodes before taking the lock.
+	if (!ClearTracked(Index))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	RemoveNode(static_cast<const UK2Node*>(Object));
+}
+
+void FMGAK2NodeRegistry::OnUObjectArrayShutdown()
+{
+	if (bListening)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+		bListening = false;
+	}
+}
+
+void FMGAK2NodeRegistry::FlushPendingNodes()
+{
+	if (PendingNodes.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 NumPendingNodes = PendingNodes.Num();
+	const TSet<const UK2Node*> Nodes = MoveTemp(PendingNodes);
+	PendingNodes.Reset();
+
+	for (const UK2Node* Node : Nodes)
+	{
+		RemoveNode(Node);
+
+		if (!IsValid(Node) || Node->GetPackage() == GetTransientPackage())
+		{
+			continue;
+		}
+
+		const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(const_cast<UK2Node*>(Node));
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		FNodeInfo& Info = NodeInfos.Add(Node);
+		Info.ClassName = Node->GetClass()->GetFName();
+		Info.Blueprint = Blueprint;
+		Info.bHasAttributePin = HasAttributePin(Node);
+
+		NodesByClass.FindOrAdd(Info.ClassName).Add(Node);
+		if (Info.bHasAttributePin)
+		{
+			AttributeNodesByBlueprint.FindOrAdd(Info.Blueprint).Add(Node);
+		}
+	}
+
+	MGA_EDITOR_LOG(VeryVerbose, TEXT("FMGAK2NodeRegistry::FlushPendingNodes - Classified %d nodes, %d tracked"), NumPendingNodes, NodeInfos.Num())
+}
+
+void FMGAK2NodeRegistry::RemoveNode(const UK2Node* InNode)
+{
+	PendingNodes.Remove(InNode);
+
+	FNodeInfo Info;
+	if (!NodeInfos.RemoveAndCopyValue(InNode, Info))
+	{
+		return;
+	}
+
+	if (TSet<const UK2Node*>* Nodes = NodesByClass.Find(Info.ClassName))
+	{
+		Nodes->Remove(InNode);
+	}
+
+	if (Info.bHasAttributePin)
+	{
+		if (TSet<const UK2Node*>* Nodes = AttributeNodesByBlueprint.Find(Info.Blueprint))
+		{
+			Nodes->Remove(InNode);
+			if (Nodes->IsEmpty())
+			{
+				AttributeNodesByBlueprint.Remove(Info.Blueprint);
+			}
+		}
+	}
+}
+
+void FMGAK2NodeRegistry::MarkTracked(const int32 InObjectIndex)
+{
+	if (InObjectIndex >= 0 && InObjectIndex / 64 < NumTrackedIndexWords)
+	{
+		TrackedIndices[InObjectIndex / 64].fetch_or(uint64(1) << (InObjectIndex % 64), std::memory_order_release);
+	}
+}
+
+bool FMGAK2NodeRegistry::ClearTracked(const int32 InObjectIndex)
+{
+	if (InObjectIndex < 0 || InObjectIndex / 64 >= NumTrackedIndexWords)
+	{
+		return false;
+	}
+
+	const uint64 Bit = uint64(1) << (InObjectIndex % 64);
+	std::atomic<uint64>& Word = TrackedIndices[InObjectIndex / 64];
+
+	// Plain load first, most destroyed objects aren't nodes and shouldn't write to the shared word
+	if ((Word.load(std::memory_order_acquire) & Bit) == 0)
+	{
+		return false;
+	}
+
+	return (Word.fetch_and(~Bit, std::memory_order_acq_rel) & Bit) != 0;
+}
+
+void FMGAK2NodeRegistry::HandleObjectModified(UObject* InObject)
+{
+	// Pins may have changed (eg. node reconstructed, pin type changed), classify it again on next query
+	if (const UK2Node* Node = Cast<UK2Node>(InObject))
+	{
+		FScopeLock Lock(&CriticalSection);
+		PendingNodes.Add(Node);
+		MarkTracked(GUObjectArray.ObjectToIndex(Node));
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectArray.h"
+#include <atomic>
+
+class UBlueprint;
+class UK2Node;
+
+/**
+ * Registry of loaded K2 nodes used by UMGAEditorSubsystem, so that compiling or renaming attributes doesn't iterate every
+ * K2 node in memory.
+ *
+ * Keeps nodes by node class (for referencer handlers registered for a K2 node class) and, per Blueprint, the nodes with a
+ * Gameplay Attribute input pin. Nodes are tracked as they are created and destroyed; created and modified nodes are only
+ * (re)classified on next query, since their pins and outer Blueprint aren't known yet when they are constructed.
+ *
+ * Nodes of the transient package (eg. Blueprint action menu templates) are ignored.
+ *
+ * The UObject array index of every tracked node is flagged in a bit array read without the lock, so that the delete
+ * listener (called for every destroyed UObject) only locks for nodes.
+ */
+class FMGAK2NodeRegistry : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+{
+public:
+	FMGAK2NodeRegistry();
+	virtual ~FMGAK2NodeRegistry() override;
+
+	/** Returns nodes of the class named InClassName (without the class prefix, exact class only) */
+	void GetNodesOfClass(FName InClassName, TArray<UK2Node*>& OutNodes);
+
+	/** Returns nodes of InBlueprint with a Gameplay Attribute input pin */
+	void GetAttributeNodes(const UBlueprint* InBlueprint, TArray<UK2Node*>& OutNodes);
+
+	/** Returns whether InNode has a Gameplay Attribute input pin */
+	static bool HasAttributePin(const UK2Node* InNode);
+
+	//~ Begin FUObjectCreateListener / FUObjectDeleteListener
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+	//~ End FUObjectCreateListener / FUObjectDeleteListener
+
+private:
+	/** Classifies nodes created or modified since last call */
+	void FlushPendingNodes();
+
+	void RemoveNode(const UK2Node* InNode);
+
+	/** Flags the UObject array index of a node about to be tracked */
+	void MarkTracked(int32 InObjectIndex);
+
+	/** Clears the flag of a UObject array index, returns whether it was set */
+	bool ClearTracked(int32 InObjectIndex);
+
+	void HandleObjectModified(UObject* InObject);
+
+	/** Whether the listeners are registered to GUObjectArray */
+	bool bListening = false;
+
+	/** Guards all members, nodes can be created from async loading threads */
+	FCriticalSection CriticalSection;
+
+	/**
+	 * One bit per UObject array index, set for nodes that may be pending or classified. Readable without CriticalSection,
+	 * lets NotifyUObjectDeleted() skip the lock and map lookups for every destroyed UObject that isn't a tracked node.
+	 */
+	TUniquePtr<std::atomic<uint64>[]> TrackedIndices;
+
+	/** Number of words in TrackedIndices, enough for the UObject array capacity */
+	int32 NumTrackedIndexWords = 0;
+
+	/** Nodes created or modified since last flush */
+	TSet<const UK2Node*> PendingNodes;
+
+	/** Classified nodes, per node class name */
+	TMap<FName, TSet<const UK2Node*>> NodesByClass;
+
+	/** Classified nodes with a Gameplay Attribute input pin, per Blueprint */
+	TMap<TObjectKey<UBlueprint>, TSet<const UK2Node*>> AttributeNodesByBlueprint;
+
+	/** Class name and Blueprint each classified node was registered with, to unregister it */
+	struct FNodeInfo
+	{
+		FName ClassName;
+		TObjectKey<UBlueprint> Blueprint;
+		bool bHasAttributePin = false;
+	};
+
+	TMap<const UK2Node*, FNodeInfo> NodeInfos;
+};
@@ -0,0 +1,30 @@
+// Copyright Halcyonyx Studios.
+
+#include "Tests/MGAPredictionLoopbackTestAbility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MGAPredictionLoopbackTestAbility)
+
+bool UMGAPredictionLoopbackTestAbility::bRejectOnServer = false;
+
+UMGAPredictionLoopbackTestAbility::UMGAPredictionLoopbackTestAbility()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
+}
+
+bool UMGAPredictionLoopbackTestAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (bRejectOnServer && ActorInfo && ActorInfo->IsNetAuthority())
+	{
+		return false;
+	}
+
+	return Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags);
+}
+
+void UMGAPredictionLoopbackTestAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+
+	EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+}
@@ -0,0 +1,30 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbility.h"
+#include "MGAPredictionLoopbackTestAbility.generated.h"
+
+/**
+ * Locally predicted ability activated by the ModularGameplayAbilities.PredictionProfiler.Loopback automation test.
+ *
+ * Ends right after activating. The server refuses to activate it while bRejectOnServer is set, so that the predicting
+ * client gets its prediction key rejected.
+ */
+UCLASS(NotBlueprintable, Transient)
+class UMGAPredictionLoopbackTestAbility : public UGameplayAbility
+{
+	GENERATED_BODY()
+
+public:
+	UMGAPredictionLoopbackTestAbility();
+
+	/** Whether the server refuses activations, set by the test between cases */
+	static bool bRejectOnServer;
+
+	//~ Begin UGameplayAbility interface
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	//~ End UGameplayAbility interface
+};
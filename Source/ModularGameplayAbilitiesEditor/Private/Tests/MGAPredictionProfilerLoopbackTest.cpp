@@ -0,0 +1,201 @@
+// Copyright Halcyonyx Studios.
+
+#include "ActorComponent/ModularAbilitySystemComponent.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Tests/MGAPredictionLoopbackTestAbility.h"
+#include "Utilities/MGAPredictionProfiler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && MGA_WITH_PREDICTION_PROFILER
+
+namespace MGA::PredictionProfilerLoopbackTest
+{
+	/** Seconds each step may take before the test fails, PIE startup included */
+	static constexpr double StepTimeout = 30.0;
+
+	struct FState
+	{
+		TWeakObjectPtr<UModularAbilitySystemComponent> ClientAbilitySystemComponent;
+		FGameplayAbilitySpecHandle AbilityHandle;
+		double StepStartTime = 0.0;
+		bool bFailed = false;
+	};
+
+	static UWorld* FindPlayWorld(const ENetMode InNetMode)
+	{
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			UWorld* World = WorldContext.World();
+			if (WorldContext.WorldType == EWorldType::PIE && World && World->GetNetMode() == InNetMode)
+			{
+				return World;
+			}
+		}
+
+		return nullptr;
+	}
+
+	static const FMGAPredictionProfiler::FAbilityStats* FindAbilityStats()
+	{
+		return FMGAPredictionProfiler::Get().GetStats().Find(UMGAPredictionLoopbackTestAbility::StaticClass()->GetFName());
+	}
+
+	/** Fails the test once the current step took longer than StepTimeout, returns whether it did */
+	static bool HasTimedOut(FAutomationTestBase& InTest, FState& InState, const TCHAR* InStep)
+	{
+		if (FPlatformTime::Seconds() - InState.StepStartTime < StepTimeout)
+		{
+			return false;
+		}
+
+		InTest.AddError(FString::Printf(TEXT("Timed out: %s"), InStep));
+		InState.bFailed = true;
+		return true;
+	}
+
+	/**
+	 * Activates the test ability from the client, then waits for the profiler to resolve it. The activation has to be
+	 * counted as confirmed or rejected exactly once, never both, whichever order the rejection and the catch up came in.
+	 */
+	static void AddActivationCase(FAutomationTestBase& InTest, const TSharedRef<FState>& InState, const bool bInRejectOnServer)
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&InTest, InState, bInRejectOnServer]()
+		{
+			UModularAbilitySystemComponent* ASC = InState->ClientAbilitySystemComponent.Get();
+			if (InState->bFailed || !ASC)
+			{
+				return true;
+			}
+
+			UMGAPredictionLoopbackTestAbility::bRejectOnServer = bInRejectOnServer;
+			InState->StepStartTime = FPlatformTime::Seconds();
+			InTest.TestTrue(TEXT("Client activates the predicted ability"), ASC->TryActivateAbility(InState->AbilityHandle));
+			return true;
+		}));
+
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&InTest, InState, bInRejectOnServer]()
+		{
+			if (InState->bFailed)
+			{
+				return true;
+			}
+
+			const int32 ExpectedConfirmed = 1;
+			const int32 ExpectedRejected = bInRejectOnServer ? 1 : 0;
+
+			const FMGAPredictionProfiler::FAbilityStats* Stats = FindAbilityStats();
+			const int32 NumResolved = Stats ? Stats->NumConfirmed + Stats->NumRejected : 0;
+			if (NumResolved < ExpectedConfirmed + ExpectedRejected)
+			{
+				return HasTimedOut(InTest, *InState, TEXT("waiting for the activation to be resolved"));
+			}
+
+			// Rejected keys catch up as well, give a late rejection or a wrong confirmation the time to show up
+			if (FPlatformTime::Seconds() - InState->StepStartTime < 2.0 * IConsoleManager::Get().FindConsoleVariable(TEXT("MGA.PredictionProfiler.RejectGraceSeconds"))->GetFloat())
+			{
+				return false;
+			}
+
+			InTest.TestEqual(TEXT("Confirmed activations"), Stats->NumConfirmed, ExpectedConfirmed);
+			InTest.TestEqual(TEXT("Rejected activations"), Stats->NumRejected, ExpectedRejected);
+			return true;
+		}));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMGAPredictionProfilerLoopbackTest,
+	"ModularGameplayAbilities.PredictionProfiler.Loopback",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/**
+ * Plays in editor with a dedicated server and a client in the same process, connected through the regular net driver
+ * over loopback. The client activates a locally predicted ability twice, accepted then rejected by the server, and the
+ * prediction profiler must count one confirmation and one rejection.
+ */
+bool FMGAPredictionProfilerLoopbackTest::RunTest(const FString& Parameters)
+{
+	using namespace MGA::PredictionProfilerLoopbackTest;
+
+	FAutomationEditorCommonUtils::CreateNewMap();
+
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_Client);
+	PlaySettings->SetPlayNumberOfClients(1);
+	PlaySettings->SetRunUnderOneProcess(true);
+	PlaySettings->bLaunchSeparateServer = true;
+
+	FRequestPlaySessionParams PlaySessionParams;
+	PlaySessionParams.EditorPlaySettings = PlaySettings;
+	GEditor->RequestPlaySession(PlaySessionParams);
+
+	IConsoleManager::Get().FindConsoleVariable(TEXT("MGA.PredictionProfiler.Enabled"))->Set(true);
+	FMGAPredictionProfiler::Get().Reset();
+
+	const TSharedRef<FState> State = MakeShared<FState>();
+	State->StepStartTime = FPlatformTime::Seconds();
+
+	// Server side: a replicated Ability System Component on the player controller, granted the test ability
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		UWorld* ServerWorld = FindPlayWorld(NM_DedicatedServer);
+		APlayerController* PlayerController = ServerWorld ? ServerWorld->GetFirstPlayerController() : nullptr;
+		if (!PlayerController)
+		{
+			return HasTimedOut(*this, *State, TEXT("waiting for the client to join the server"));
+		}
+
+		UModularAbilitySystemComponent* ASC = NewObject<UModularAbilitySystemComponent>(PlayerController, TEXT("PredictionLoopbackAbilitySystem"));
+		ASC->SetIsReplicated(true);
+		ASC->RegisterComponent();
+		ASC->InitAbilityActorInfo(PlayerController, PlayerController);
+		State->AbilityHandle = ASC->GiveAbility(FGameplayAbilitySpec(UMGAPredictionLoopbackTestAbility::StaticClass()));
+
+		State->StepStartTime = FPlatformTime::Seconds();
+		return true;
+	}));
+
+	// Client side: wait for the component and the granted ability to replicate
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		if (State->bFailed)
+		{
+			return true;
+		}
+
+		UWorld* ClientWorld = FindPlayWorld(NM_Client);
+		APlayerController* PlayerController = ClientWorld ? ClientWorld->GetFirstPlayerController() : nullptr;
+		UModularAbilitySystemComponent* ASC = PlayerController ? PlayerController->FindComponentByClass<UModularAbilitySystemComponent>() : nullptr;
+		if (!ASC || !ASC->FindAbilitySpecFromHandle(State->AbilityHandle))
+		{
+			return HasTimedOut(*this, *State, TEXT("waiting for the granted ability to replicate"));
+		}
+
+		ASC->InitAbilityActorInfo(PlayerController, PlayerController);
+		State->ClientAbilitySystemComponent = ASC;
+		return true;
+	}));
+
+	AddActivationCase(*this, State, false);
+	AddActivationCase(*this, State, true);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([]()
+	{
+		UMGAPredictionLoopbackTestAbility::bRejectOnServer = false;
+		IConsoleManager::Get().FindConsoleVariable(TEXT("MGA.PredictionProfiler.Enabled"))->Set(false);
+		FMGAPredictionProfiler::Get().Reset();
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif
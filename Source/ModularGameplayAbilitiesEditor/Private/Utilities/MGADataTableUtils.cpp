@@ -0,0 +1,165 @@
+// Copyright Halcyonyx Studios.
+
+#include "Utilities/MGADataTableUtils.h"
+
+#include "FileHelpers.h"
+#include "MGAEditorLog.h"
+#include "PackageTools.h"
+#include "Attributes/ModularAttributeSetBase.h"
+#include "Engine/Blueprint.h"
+#include "Engine/DataTable.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/Package.h"
+#include "Utilities/MGAUtilities.h"
+
+#define LOCTEXT_NAMESPACE "MGADataTableUtils"
+
+void UE::MGA::DataTableUtils::GetAttributeMetaDataRows(const UBlueprint* InBlueprint, TArray<TPair<FName, FAttributeMetaData>>& OutRows)
+{
+	const UClass* OwnerClass = InBlueprint ? InBlueprint->GeneratedClass.Get() : nullptr;
+	if (!OwnerClass)
+	{
+		return;
+	}
+
+	UAttributeSet* CDO = Cast<UAttributeSet>(OwnerClass->GetDefaultObject());
+	if (!ensureMsgf(CDO, TEXT("Invalid CDO couldn't cast to UAttributeSet from %s"), *GetNameSafe(OwnerClass)))
+	{
+		return;
+	}
+
+	TArray<FProperty*> Properties;
+	FMGAUtilities::GetAllAttributeFromClass(OwnerClass, Properties);
+
+	const FString AttributeClassName = FMGAUtilities::GetAttributeClassName(OwnerClass);
+	OutRows.Reserve(OutRows.Num() + Properties.Num());
+
+	TStringBuilder<256> RowName;
+	for (FProperty* Property : Properties)
+	{
+		if (!FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+		{
+			continue;
+		}
+
+		const FGameplayAttribute Attribute(Property);
+		const FGameplayAttributeData* AttributeData = Attribute.GetGameplayAttributeDataChecked(CDO);
+
+		FAttributeMetaData MetaData;
+		MetaData.BaseValue = AttributeData->GetBaseValue();
+		MetaData.MinValue = 0.f;
+		MetaData.MaxValue = 0.f;
+		MetaData.bCanStack = false;
+
+		if (UModularAttributeSetBase::IsGameplayAttributeDataClampedProperty(Property))
+		{
+			const FMGAClampedAttributeData* Clamped = static_cast<const FMGAClampedAttributeData*>(AttributeData);
+			MetaData.MinValue = Clamped->MinValue.GetValueForClamping(CDO);
+			MetaData.MaxValue = Clamped->MaxValue.GetValueForClamping(CDO);
+		}
+
+		RowName.Reset();
+		RowName << AttributeClassName << TEXT('.') << Property->GetName();
+		OutRows.Emplace(FName(RowName.ToView()), MoveTemp(MetaData));
+	}
+
+	MGA_EDITOR_LOG(Verbose, TEXT("UE::MGA::DataTableUtils::GetAttributeMetaDataRows Blueprint: %s, Rows: %d"), *GetNameSafe(InBlueprint), OutRows.Num())
+}
+
+void UE::MGA::DataTableUtils::PopulateDataTable(const UBlueprint* InBlueprint, UDataTable* InDataTable)
+{
+	check(InDataTable);
+
+	TArray<TPair<FName, FAttributeMetaData>> Rows;
+	GetAttributeMetaDataRows(InBlueprint, Rows);
+
+	InDataTable->EmptyTable();
+	InDataTable->RowStruct = FAttributeMetaData::StaticStruct();
+
+	for (const TPair<FName, FAttributeMetaData>& Row : Rows)
+	{
+		InDataTable->AddRow(Row.Key, Row.Value);
+	}
+}
+
+FString UE::MGA::DataTableUtils::GetDefaultDataTableName(const UBlueprint* InBlueprint)
+{
+	return FString::Printf(TEXT("DT_%s"), *FMGAUtilities::GetAttributeClassName(InBlueprint ? InBlueprint->GeneratedClass.Get() : nullptr));
+}
+
+UDataTable* UE::MGA::DataTableUtils::CreateOrUpdateDataTable(const UBlueprint* InBlueprint, const FString& InPackagePath, const FString& InAssetName)
+{
+	const FString PackageName = UPackageTools::SanitizePackageName(InPackagePath / InAssetName);
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!Package)
+	{
+		MGA_EDITOR_LOG(Warning, TEXT("UE::MGA::DataTableUtils::CreateOrUpdateDataTable - Failed to create package %s"), *PackageName)
+		return nullptr;
+	}
+
+	// Make sure the destination package is loaded
+	Package->FullyLoad();
+
+	UDataTable* DataTable = nullptr;
+	if (UObject* ExistingObject = StaticFindObjectFast(UObject::StaticClass(), Package, FName(*InAssetName)))
+	{
+		DataTable = Cast<UDataTable>(ExistingObject);
+		if (!DataTable)
+		{
+			MGA_EDITOR_LOG(Warning, TEXT("UE::MGA::DataTableUtils::CreateOrUpdateDataTable - An asset of type %s already exists at %s"), *GetNameSafe(ExistingObject->GetClass()), *PackageName)
+			return nullptr;
+		}
+
+		DataTable->Modify();
+	}
+	else
+	{
+		constexpr EObjectFlags Flags = RF_Public | RF_Standalone | RF_Transactional;
+		DataTable = NewObject<UDataTable>(Package, UDataTable::StaticClass(), FName(*InAssetName), Flags);
+	}
+
+	PopulateDataTable(InBlueprint, DataTable);
+	DataTable->MarkPackageDirty();
+	return DataTable;
+}
+
+void UE::MGA::DataTableUtils::GenerateDataTables(const TArray<UBlueprint*>& InBlueprints, const FString& InPackagePath, const bool bInSave, TArray<UDataTable*>& OutDataTables)
+{
+	FScopedSlowTask Progress(InBlueprints.Num(), LOCTEXT("SlowTask_GenerateDataTables", "Generating Attribute DataTables"));
+	Progress.MakeDialog(true);
+
+	TArray<UPackage*> PackagesToSave;
+	PackagesToSave.Reserve(InBlueprints.Num());
+
+	for (const UBlueprint* Blueprint : InBlueprints)
+	{
+		if (Progress.ShouldCancel())
+		{
+			break;
+		}
+
+		Progress.EnterProgressFrame(1.f, FText::FromString(GetNameSafe(Blueprint)));
+
+		if (!Blueprint || !Blueprint->GeneratedClass)
+		{
+			continue;
+		}
+
+		const FString PackagePath = InPackagePath.IsEmpty() ? FPackageName::GetLongPackagePath(Blueprint->GetPathName()) : InPackagePath;
+		if (UDataTable* DataTable = CreateOrUpdateDataTable(Blueprint, PackagePath, GetDefaultDataTableName(Blueprint)))
+		{
+			OutDataTables.Add(DataTable);
+			PackagesToSave.Add(DataTable->GetPackage());
+		}
+	}
+
+	if (bInSave && !PackagesToSave.IsEmpty())
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	MGA_EDITOR_LOG(Display, TEXT("UE::MGA::DataTableUtils::GenerateDataTables - Generated %d DataTables out of %d Blueprints"), OutDataTables.Num(), InBlueprints.Num())
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,39 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+
+class UBlueprint;
+class UDataTable;
+class UPackage;
+
+namespace UE::MGA::DataTableUtils
+{
+	/** Builds a FAttributeMetaData row (named ClassName.AttributeName) for each Gameplay Attribute of InBlueprint, from its class default object */
+	void GetAttributeMetaDataRows(const UBlueprint* InBlueprint, TArray<TPair<FName, FAttributeMetaData>>& OutRows);
+
+	/** Replaces the rows of InDataTable with the FAttributeMetaData rows of InBlueprint, without going through CSV text */
+	void PopulateDataTable(const UBlueprint* InBlueprint, UDataTable* InDataTable);
+
+	/** Returns the default DataTable asset name for InBlueprint (eg. DT_HealthSet) */
+	FString GetDefaultDataTableName(const UBlueprint* InBlueprint);
+
+	/**
+	 * Creates (or updates if it already exists) the DataTable InPackagePath/InAssetName with the FAttributeMetaData rows of InBlueprint.
+	 *
+	 * The package is marked dirty, not saved. Returns nullptr if the package couldn't be created or an asset of another type exists there.
+	 */
+	UDataTable* CreateOrUpdateDataTable(const UBlueprint* InBlueprint, const FString& InPackagePath, const FString& InAssetName);
+
+	/**
+	 * Creates or updates the DataTables of many Attribute Set Blueprints in one pass, named after GetDefaultDataTableName().
+	 *
+	 * @param InBlueprints Attribute Set Blueprints to generate DataTables for
+	 * @param InPackagePath Content folder of the generated DataTables, next to each Blueprint if empty
+	 * @param bInSave Whether the packages of the generated DataTables are saved (all at once, at the end)
+	 * @param OutDataTables Generated DataTables
+	 */
+	void GenerateDataTables(const TArray<UBlueprint*>& InBlueprints, const FString& InPackagePath, bool bInSave, TArray<UDataTable*>& OutDataTables);
+}
@@ -34,6 +34,13 @@ public:
 	}
 
 	virtual const TArray<FText>& GetSubMenus() const override;
+
+	virtual bool HasActions(const TArray<UObject*>& InObjects) const override
+	{
+		return true;
+	}
+
+	virtual void GetActions(const TArray<UObject*>& InObjects, FToolMenuSection& Section) override;
 	
 	// virtual uint32 GetCategories() override { return EAssetTypeCategories::Gameplay; }
 	// virtual TSharedPtr<SWidget> GetThumbnailOverlay(const FAssetData& AssetData) const override;
@@ -44,4 +51,7 @@ public:
 
 private:
 	EAssetTypeCategories::Type AssetCategory;
+
+	/** Creates or updates the FAttributeMetaData DataTable of each of the selected Blueprints, next to them */
+	static void ExecuteGenerateDataTables(TArray<TWeakObjectPtr<UBlueprint>> InBlueprints);
 };
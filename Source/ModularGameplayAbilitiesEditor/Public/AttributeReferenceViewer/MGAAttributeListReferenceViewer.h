@@ -3,26 +3,26 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Misc/TextFilter.h"
-#include "UObject/WeakFieldPtr.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/SListView.h"
 
 class SBorder;
 class SSearchBox;
+struct FMGAAttributeCatalogEntry;
 
 struct FMGAAttributeListReferenceViewerNode
 {
-	FMGAAttributeListReferenceViewerNode(FProperty* InAttribute, const FString& InAttributeName)
+	FMGAAttributeListReferenceViewerNode(const TSharedPtr<const FMGAAttributeCatalogEntry>& InEntry, const FString& InAttributeName)
 	{
-		Attribute = InAttribute;
+		Entry = InEntry;
 		AttributeName = MakeShareable(new FString(InAttributeName));
 	}
 
 	/** The displayed name for this node. */
 	TSharedPtr<FString> AttributeName;
 
-	TWeakFieldPtr<FProperty> Attribute;
+	/** Catalog entry of the attribute, see UMGAAttributeCatalogSubsystem */
+	TSharedPtr<const FMGAAttributeCatalogEntry> Entry;
 };
 
 /** Widget allowing user to list Gameplay Attributes and open up the reference viewer for them */
@@ -48,13 +48,11 @@ public:
 	TSharedPtr<SWidget> GetWidgetToFocusOnOpen();
 	
 private:
-	typedef TTextFilter<const FProperty&> FAttributeTextFilter;
-	
 	/** Allows for the user to find a specific gameplay attribute in the list */
 	TSharedPtr<SSearchBox> SearchAttributeBox;
 
-	/** Filters needed for filtering the attributes */
-	TSharedPtr<FAttributeTextFilter> AttributeTextFilter;
+	/** Current search text, see UMGAAttributeCatalogSubsystem::Query() */
+	FString SearchText;
 	
 	/** Container widget holding the attribute list */
 	TSharedPtr<SBorder> AttributesContainerWidget;
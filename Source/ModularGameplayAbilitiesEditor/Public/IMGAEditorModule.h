@@ -51,8 +51,9 @@ public:
 	/**
 	 *	Preloads any AttributeSets Blueprint assets to ensure Effect and GameplayAttribute details customization can list all of them.
 	 *
-	 *	Without this, only BP Attributes that were previously opened (and loaded into memory) or right-clicked in content browser would show up.
+	 *	Attribute pickers no longer need this, they list BP Attributes from asset registry tags (see UMGAAttributeCatalogSubsystem).
 	 */
+	UE_DEPRECATED(5.5, "Attribute pickers list Blueprint attributes from asset registry tags, use UMGAAttributeCatalogSubsystem instead of loading Attribute Set Blueprints.")
 	virtual void PreloadAssetsByClass(UClass* InClass) const = 0;
 
 	/** Creates and returns a new window widget to create a FAttributeMetaData DataTable asset from a given ModularAttributeSet. */
@@ -37,7 +37,9 @@ private:
     static void SetupGameplayAttributesPropertyFlags();
 
     //~ Begin IMGAEditorModule
+    PRAGMA_DISABLE_DEPRECATION_WARNINGS
     virtual void PreloadAssetsByClass(UClass* InClass) const override;
+    PRAGMA_ENABLE_DEPRECATION_WARNINGS
     virtual TSharedRef<SWindow> CreateDataTableWindow(const TWeakObjectPtr<UBlueprint>& InBlueprint, const FMGADataTableWindowArgs& InArgs) const override;
     //~ End IMGAEditorModule
 };
@@ -54,5 +54,12 @@ public:
 	virtual void OnPostCompile(const FString& InPackageName) = 0;
 	
 	virtual bool HandlePreCompile(const FAssetIdentifier& InAssetIdentifier, const FMGAAttributeReferencerPayload& InPayload) = 0;
+
+	/** Returns whether attributes cached for InAssetIdentifier are still valid, in which case HandlePreCompile() is skipped (and the asset not loaded) */
+	virtual bool HasValidCache(const FAssetIdentifier& InAssetIdentifier) const
+	{
+		return false;
+	}
+
 	virtual bool HandleAttributeRename(const FAssetIdentifier& InAssetIdentifier, const FMGAAttributeReferencerPayload& InPayload, TArray<TSharedRef<FTokenizedMessage>>& OutMessages) = 0;
 };
@@ -0,0 +1,160 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "UObject/TopLevelAssetPath.h"
+#include "MGAAttributeCatalogSubsystem.generated.h"
+
+class UBlueprint;
+enum class EModuleChangeReason;
+enum class EReloadCompleteReason;
+struct FAssetData;
+
+/** A Gameplay Attribute listed by UMGAAttributeCatalogSubsystem */
+struct MODULARGAMEPLAYABILITIESEDITOR_API FMGAAttributeCatalogEntry
+{
+	/** Displayed name, "OwnerClass.Attribute" (without the _C suffix for Blueprint classes) */
+	FString AttributeName;
+
+	/** Name of the attribute property */
+	FName PropertyName;
+
+	/** Class declaring the attribute, the generated class for Blueprints */
+	FTopLevelAssetPath OwnerClassPath;
+
+	/** Category of the attribute property */
+	FString Category;
+
+	/** Metadata keys of Blueprint declared attributes, native ones read metadata from their property */
+	TArray<FName> MetaDataKeys;
+
+	/** Name of the attribute data struct (eg. GameplayAttributeData, MGAClampedAttributeData) */
+	FName Type;
+
+	/** Whether the attribute property is replicated */
+	bool bReplicated = false;
+
+	/** Whether the attribute is a FMGAClampedAttributeData (with a min or max clamp definition for Blueprint attributes) */
+	bool bClamped = false;
+
+	/** Whether this is a 'system' attribute of an Ability System Component class */
+	bool bSystemAttribute = false;
+
+	/** Whether the attribute is declared by an Attribute Set Blueprint */
+	bool bBlueprint = false;
+
+	/** Returns the attribute property if its owner class is loaded, nullptr otherwise */
+	FProperty* FindProperty() const;
+
+	/** Returns the attribute property, loading its owner class if needed */
+	FProperty* LoadProperty() const;
+
+	/** Returns whether the attribute property has the given metadata, without loading its owner class */
+	bool HasMetaData(const FString& InKey) const;
+};
+
+/** Filters for UMGAAttributeCatalogSubsystem::Query() */
+struct FMGAAttributeCatalogQuery
+{
+	/** Whitespace separated terms, each of them must match (prefix, substring or fuzzy) */
+	FString SearchText;
+
+	/** If set, only lists attributes of this class and its child classes */
+	const UClass* FilterClass = nullptr;
+
+	/** With FilterClass, also lists attributes of its super classes */
+	bool bIncludeSuperClasses = false;
+
+	/** Attributes with this metadata are not listed */
+	FString FilterMetaData;
+
+	/** Whether to list 'system' attributes of Ability System Component classes */
+	bool bIncludeSystemAttributes = true;
+};
+
+/**
+ * Editor subsystem indexing all Gameplay Attributes for the attribute pickers, without loading Attribute Set Blueprints.
+ *
+ * Native attributes are gathered from loaded classes (rebuilt on module load and hot reload / live coding). Blueprint
+ * attributes are read from the asset registry tags written by UMGAAttributeSetBlueprint, and updated incrementally when
+ * an Attribute Set Blueprint is added, removed, renamed, saved or compiled. Regular Blueprints deriving from an Attribute
+ * Set write no such tags, they are gathered with native classes while loaded.
+ *
+ * Blueprints are only loaded when one of their attributes is actually picked (see FMGAAttributeCatalogEntry::LoadProperty()),
+ * or once on first query for Blueprints saved before attributes were written to their tags.
+ */
+UCLASS()
+class MODULARGAMEPLAYABILITIESEDITOR_API UMGAAttributeCatalogSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UEditorSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End UEditorSubsystem interface
+
+	static UMGAAttributeCatalogSubsystem& Get();
+
+	/** Returns attributes matching InQuery, best search matches first then sorted by name */
+	void Query(const FMGAAttributeCatalogQuery& InQuery, TArray<TSharedPtr<const FMGAAttributeCatalogEntry>>& OutEntries);
+
+	/**
+	 * Returns how well InCandidate matches InSearchTerm, lower is better, INDEX_NONE if it doesn't.
+	 *
+	 * Prefix of the attribute (part after the dot) first, then prefix of the whole name, substring and finally
+	 * characters of the term found in order (fuzzy). Case insensitive.
+	 */
+	static int32 GetSearchScore(const FString& InCandidate, const FString& InSearchTerm);
+
+	/** Returns whether the class at InClassPath is InParentClass or one of its child classes, without loading it */
+	bool IsChildOf(const FTopLevelAssetPath& InClassPath, const UClass* InParentClass) const;
+
+	/** Flags native attributes for a rebuild on next query */
+	void MarkNativeEntriesDirty();
+
+private:
+	/** Attribute Set Blueprint asset, indexed by package name */
+	struct FBlueprintAssetEntry
+	{
+		FTopLevelAssetPath GeneratedClassPath;
+		FTopLevelAssetPath ParentClassPath;
+		TArray<TSharedPtr<const FMGAAttributeCatalogEntry>> Attributes;
+	};
+
+	void BuildNativeEntries();
+	void AddBlueprintAsset(const FAssetData& InAssetData);
+	void RemoveBlueprintAsset(FName InPackageName);
+	void RefreshBlueprintPackage(FName InPackageName);
+
+	/** Loads Attribute Set Blueprints without an attributes tag so that their in memory tags can be indexed */
+	void LoadUntaggedBlueprints();
+
+	static bool IsAttributeSetBlueprintAsset(const FAssetData& InAssetData);
+
+	/** Whether InBlueprint derives from an Attribute Set without being a UMGAAttributeSetBlueprint, with no attributes tag */
+	static bool IsUntaggedAttributeSetBlueprint(const UBlueprint* InBlueprint);
+
+	void HandleAssetAdded(const FAssetData& InAssetData);
+	void HandleAssetRemoved(const FAssetData& InAssetData);
+	void HandleAssetRenamed(const FAssetData& InAssetData, const FString& InOldObjectPath);
+	void HandleAssetUpdated(const FAssetData& InAssetData);
+	void HandlePostCompile(const FName& InPackageName);
+	void HandleBlueprintPreCompile(UBlueprint* InBlueprint);
+	void HandleAssetLoaded(UObject* InObject);
+	void HandleReloadComplete(EReloadCompleteReason InReason);
+	void HandleModulesChanged(FName InModuleName, EModuleChangeReason InReason);
+
+	TArray<TSharedPtr<const FMGAAttributeCatalogEntry>> NativeEntries;
+	bool bNativeEntriesDirty = true;
+
+	TMap<FName, FBlueprintAssetEntry> BlueprintAssets;
+
+	/** Packages of Attribute Set Blueprints saved without an attributes tag, loaded on next query */
+	TSet<FName> UntaggedBlueprintPackages;
+
+	/** Parent class of each indexed Blueprint generated class, to resolve class hierarchies without loading */
+	TMap<FTopLevelAssetPath, FTopLevelAssetPath> BlueprintParentClasses;
+};
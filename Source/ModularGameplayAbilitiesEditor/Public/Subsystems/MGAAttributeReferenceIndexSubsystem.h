@@ -0,0 +1,124 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "MGAAttributeReferenceIndexSubsystem.generated.h"
+
+class FObjectPostSaveContext;
+class UPackage;
+struct FAssetData;
+
+/** A reference to a Gameplay Attribute, held by an object of a referencer package */
+struct MODULARGAMEPLAYABILITIESEDITOR_API FMGAAttributeReference
+{
+	/** Package of the class declaring the attribute (eg. /Game/Foo/BP_AttributeSet or /Script/MyModule) */
+	FName OwnerPackageName;
+
+	/** Name of the attribute property */
+	FName AttributeName;
+
+	/** Path name of the object holding the reference (eg. a class default object, one of its subobjects or a K2 node) */
+	FString ObjectPath;
+
+	/** Property path to the reference within the object (eg. Modifiers[2].Attribute), or pin name for K2 node pins */
+	FString PropertyPath;
+
+	/** Whether the reference is the default value of a K2 node pin */
+	bool bPin = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FMGAAttributeReference& InReference);
+};
+
+/**
+ * Editor subsystem maintaining a persistent index of Gameplay Attribute references, from each attribute to the packages,
+ * objects, properties and K2 node pins referencing it.
+ *
+ * A package is indexed when it is saved (and when the rename pipeline had to load it anyway). An index entry is only
+ * trusted while it matches the package file timestamp and the package isn't dirty in memory, so that packages changed
+ * outside of this editor session (eg. source control sync) or with unsaved changes are still loaded and scanned.
+ *
+ * Used by UMGAEditorSubsystem so that attribute renames only load packages that actually reference the renamed attribute.
+ * The index is written to the project Intermediate directory on shutdown, MGA.AttributeReferenceIndex.Rebuild indexes
+ * all Blueprint assets at once.
+ */
+UCLASS()
+class MODULARGAMEPLAYABILITIESEDITOR_API UMGAAttributeReferenceIndexSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UEditorSubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End UEditorSubsystem interface
+
+	static UMGAAttributeReferenceIndexSubsystem& Get();
+
+	/** Returns whether the index entry of InPackageName can be trusted (indexed, unchanged on disk and not dirty in memory) */
+	bool IsPackageUpToDate(FName InPackageName) const;
+
+	/**
+	 * Returns whether InReferencerPackageName may reference InAttributeName of InOwnerPackageName (any attribute of it if None).
+	 *
+	 * Always true for packages not up to date in the index, as only loading them can tell.
+	 */
+	bool MayReferenceAttribute(FName InReferencerPackageName, FName InOwnerPackageName, FName InAttributeName = NAME_None) const;
+
+	/** Returns up to date packages referencing InAttributeName of InOwnerPackageName (any attribute of it if None) */
+	void GetReferencingPackages(FName InOwnerPackageName, FName InAttributeName, TArray<FName>& OutPackageNames) const;
+
+	/** Returns indexed references of InReferencerPackageName to InAttributeName of InOwnerPackageName (any attribute of it if None) */
+	void GetReferences(FName InReferencerPackageName, FName InOwnerPackageName, FName InAttributeName, TArray<FMGAAttributeReference>& OutReferences) const;
+
+	/** Scans the objects of a loaded package for attribute references and updates its index entry (skipped for dirty packages) */
+	void IndexPackage(const UPackage* InPackage);
+
+	/** Loads and indexes all Blueprint assets */
+	void RebuildIndex();
+
+	/** Gathers attribute references held by objects of InPackage */
+	static void GatherPackageReferences(const UPackage* InPackage, TArray<FMGAAttributeReference>& OutReferences);
+
+	/** Returns the timestamp of the file of InPackageName, FDateTime::MinValue() if it was never saved */
+	static FDateTime GetPackageFileTimeStamp(FName InPackageName);
+
+private:
+	/** Indexed package */
+	struct FPackageEntry
+	{
+		/** Timestamp of the package file when it was indexed */
+		FDateTime FileTimeStamp;
+
+		TArray<FMGAAttributeReference> References;
+
+		friend FArchive& operator<<(FArchive& Ar, FPackageEntry& InEntry)
+		{
+			Ar << InEntry.FileTimeStamp;
+			Ar << InEntry.References;
+			return Ar;
+		}
+	};
+
+	static FString GetIndexFilePath();
+
+	void AddPackageEntry(FName InPackageName, FPackageEntry&& InEntry);
+	void RemovePackageEntry(FName InPackageName);
+
+	void LoadIndex();
+	void SaveIndex();
+
+	void HandlePackageSaved(const FString& InFilename, UPackage* InPackage, FObjectPostSaveContext InContext);
+	void HandleAssetRemoved(const FAssetData& InAssetData);
+	void HandleAssetRenamed(const FAssetData& InAssetData, const FString& InOldObjectPath);
+
+	/** Index entries, per referencer package */
+	TMap<FName, FPackageEntry> Packages;
+
+	/** Referencer packages of each attribute owner package */
+	TMap<FName, TSet<FName>> ReferencersByOwnerPackage;
+
+	/** Whether the index changed since it was loaded or saved */
+	bool bDirty = false;
+};
@@ -4,12 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "EditorSubsystem.h"
+#include "Containers/Ticker.h"
 #include "MGAEditorSubsystem.generated.h"
 
+class FMGAAttributeRenameTask;
+class FMGAK2NodeRegistry;
 class FTokenizedMessage;
 class IMGAAttributeReferencerHandler;
 class IMessageToken;
 class IToolkit;
+class UBlueprint;
 class UEdGraphPin;
 class UGameplayEffect;
 class UK2Node;
@@ -33,12 +37,18 @@ struct FAssetDependency;
  *
  * When a rename happens, this event fires off and triggers the following logic in this subsystem:
  *
- * 1. Get all referencers to the original Attribute Set Blueprints (its package name)
+ * 1. Get all referencers to the original Attribute Set Blueprints (its package name), skipping the ones that the attribute
+ * reference index (UMGAAttributeReferenceIndexSubsystem) knows don't reference the renamed attribute
  * 2. Check if any referencers is currently opened in Editor, store them
  * (TODO: Check if renamed attribute is actually used, a referencer can be referencing other attributes from same BP, in which case closing asset editor is not required)
  * 3. Close any opened referencers in Editor
  * 4. Update CDO for any referencers to update property from Old Attribute property to the new one
  * 5. Reopen any closed editor previously, if any
+ *
+ * Steps 1 to 4 run as a FMGAAttributeRenameTask over several frames: referencers are loaded asynchronously in batches and
+ * updated under a per frame time budget (MGA.AttributeRename.LoadBatchSize, MGA.AttributeRename.FrameBudgetMs), with a
+ * cancellable progress notification. PreviewAttributeRename() (or MGA.AttributeRename.Preview) runs the same task as a
+ * dry run, only reporting the references that a rename would update.
  */
 UCLASS()
 class MODULARGAMEPLAYABILITIESEDITOR_API UMGAEditorSubsystem : public UEditorSubsystem
@@ -52,8 +62,25 @@ public:
 	/** List of referencer handler registered via RegisterReferencerHandler() */
 	TMap<FName, TSharedPtr<IMGAAttributeReferencerHandler>> RegisteredHandlers;
 
-	/** Keeps track of whether we are currently handling a rename (and prevent rename code path to run again when we manually compile the BP at the end of this run) */
-	bool bIsHandlingRename = false;
+	/** Names of the registered handler classes that are K2 node classes */
+	TSet<FName> NodeHandlerClassNames;
+
+	/** Loaded K2 nodes by class and attribute nodes by Blueprint, so that compiles and renames don't iterate all loaded nodes */
+	TSharedPtr<FMGAK2NodeRegistry> NodeRegistry;
+
+	/** Pending attribute renames, the first one is running */
+	TArray<TSharedPtr<FMGAAttributeRenameTask>> RenameTasks;
+
+	/** Ticks the running rename task while there is one */
+	FTSTicker::FDelegateHandle RenameTickerHandle;
+
+	/**
+	 * Attribute Set packages renamed since their referencers were last cached by HandlePreCompile().
+	 *
+	 * A rename queued behind another one of the same package (eg. B to C compiled while A to B is still running) was cached
+	 * before the referencers got updated to B, its task rebuilds the caches when it starts so that B is found.
+	 */
+	TSet<FName> PackagesPendingCacheRefresh;
 	
 	/** List of pending tokenized messages representing an attribute ref updated */
 	TArray<TSharedRef<FTokenizedMessage>> PendingMessages;
@@ -106,6 +133,31 @@ public:
 	 */
 	void HandleAttributeRename(const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName);
 
+	/** Reports to the message log the references that renaming InOldPropertyName of InPackageName would update, without modifying anything */
+	void PreviewAttributeRename(const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName);
+
+	/** Queues a rename task (a dry run if bInDryRun), started once the previous ones are finished */
+	void QueueRenameTask(const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName, bool bInDryRun);
+
+	/** Ticks the running rename task, starting the next one when finished. Returns false once there is none left. */
+	bool TickRenameTasks(float InDeltaTime);
+
+	/** Cancels the running rename task and drops the pending ones. Referencers already updated stay modified, there is no rollback. */
+	void CancelRenameTasks();
+
+	/**
+	 * Saves the renames not finished yet (including the running one) to GetPendingRenamesFilePath(), so that they are run
+	 * again on next editor start instead of leaving referencers half renamed. Updates not saved yet are lost on exit anyway,
+	 * running the whole rename again is safe as referencers already updated don't reference the old name anymore.
+	 */
+	void SavePendingRenameTasks() const;
+
+	/** Queues the renames saved by SavePendingRenameTasks() once the asset registry is done loading, skipping the ones whose Attribute Set wasn't saved renamed */
+	void ResumePendingRenameTasks();
+
+	/** Returns the file pending renames are saved to on editor exit */
+	static FString GetPendingRenamesFilePath();
+
 	/**
 	 * Triggered by FMGABlueprintEditor just before FBlueprintEditor::Compile()
 	 *
@@ -145,9 +197,32 @@ public:
 	/** Gather the list of Blueprints with K2Node using a Pin Attribute parameter */
 	TArray<FPinToModify> GetPinsToModify(const FString& InPackageName, const FString& InOldPropertyName, const FString& InNewPropertyName);
 
+	/**
+	 * Removes referencers that can't reference InAttributeName of InPackageName (any of its attributes if None), so that they don't get loaded.
+	 *
+	 * Those are the ones indexed by UMGAAttributeReferenceIndexSubsystem without such a reference, and the ones only holding soft references
+	 * to the package (a FGameplayAttribute hard references its owner class).
+	 */
+	static void FilterReferencerAssets(const FName& InPackageName, const FName& InAttributeName, const TArray<FAssetDependency>& InReferencers, TArray<FAssetData>& InOutAssetsData);
+
+	/**
+	 * Returns the Blueprints whose K2 nodes may reference InAttributeName of InPackageName.
+	 *
+	 * Blueprints indexed with such a reference are loaded if needed, loaded Blueprints not up to date in the index are scanned as well.
+	 * Only called once the renamed attribute is known: with None, every indexed referencer of the package would be loaded
+	 * (pre-compile only goes through already loaded nodes, see HandlePreCompile()).
+	 */
+	static TArray<UBlueprint*> GetBlueprintsToScan(const FName& InPackageName, const FName& InAttributeName);
+
 	/** Goes through the list of pins to modify, actually update the pin to point to the new attribute property name */
 	void HandlePins(const TArray<FPinToModify>& InPinsToModify, const UBlueprint* InOwnerAttributeSetBP, const FName& InNewPropertyName);
 
+	/** Updates a single pin to point to the new attribute property name, returns the Blueprint of the pin if it was modified */
+	UBlueprint* HandlePin(const FPinToModify& InPinToModify, const UBlueprint* InOwnerAttributeSetBP, const FName& InNewPropertyName);
+
+	/** Marks Blueprints with modified pins as structurally modified, compiling InOwnerAttributeSetBP again if it is one of them */
+	void HandleModifiedBlueprints(const TArray<UBlueprint*>& InBlueprintsModified, const UBlueprint* InOwnerAttributeSetBP);
+
 	/** Bring focus and navigate to the token object */
 	static void HandleMessageLogLinkActivated(const TSharedRef<IMessageToken>& InToken);
 
@@ -157,6 +232,12 @@ public:
 	/** Handles update of FGameplayAttribute properties in the referencers asset to point to the new FGameplayAttribute that was renamed */
 	void UpdateReferencers(TArray<FAssetData> InReferencers, const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName);
 
+	/** Handles update of FGameplayAttribute properties of a single referencer asset (loading it if needed), returns whether it was modified */
+	bool UpdateReferencer(const FAssetData& InReferencer, const FName& InPackageName, const FName& InOldPropertyName, const FName& InNewPropertyName);
+
+	/** Adds PendingMessages to a new message log page titled InPageText and notifies about it */
+	void FlushPendingMessages(const FText& InPageText);
+
 	/**
 	 * TODO: Probably not needed anymore since refactoring of Slate widget to use TWeakFieldPtr (that method was used to close any active / opened GE Blueprint to avoid a crash)
 	 * Addendum: Still needed, if we have a ref to one of the attributes of a BP that is compiled, may crash (seen it consistently with Gameplay Cues Magnitude Attribute)
@@ -17,6 +17,7 @@ public class ModularGameplayAbilitiesEditorCommon : ModuleRules
         PrivateDependencyModuleNames.AddRange(
             new string[]
             {
+                "AssetRegistry",
                 "CoreUObject",
                 "EditorStyle",
                 "Engine",
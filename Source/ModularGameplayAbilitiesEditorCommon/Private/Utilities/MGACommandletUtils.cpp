@@ -0,0 +1,79 @@
+// Copyright Halcyonyx Studios.
+
+#include "Utilities/MGACommandletUtils.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/Parse.h"
+#include "Modules/ModuleManager.h"
+
+void UE::MGA::CommandletUtils::GetAssetsFromParams(const FString& InParams, const UClass* InAssetClass, TArray<FAssetData>& OutAssets)
+{
+	check(InAssetClass);
+
+	FString BlueprintsParam;
+	FString PathsParam;
+	FParse::Value(*InParams, TEXT("Blueprints="), BlueprintsParam, false);
+	FParse::Value(*InParams, TEXT("Paths="), PathsParam, false);
+
+	TArray<FString> PackageNames;
+	BlueprintsParam.ParseIntoArray(PackageNames, TEXT("+"));
+
+	TArray<FString> Paths;
+	PathsParam.ParseIntoArray(Paths, TEXT("+"));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter ClassFilter;
+	ClassFilter.ClassPaths.Add(InAssetClass->GetClassPathName());
+	ClassFilter.bRecursiveClasses = true;
+	ClassFilter.bRecursivePaths = true;
+
+	if (PackageNames.IsEmpty() && Paths.IsEmpty())
+	{
+		AssetRegistry.GetAssets(ClassFilter, OutAssets);
+		return;
+	}
+
+	// Package names and paths in a single filter would only return assets matching both, query them separately
+	TSet<FName> AddedPackageNames;
+	const auto AddAssets = [&AssetRegistry, &AddedPackageNames, &OutAssets](const FARFilter& InFilter)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssets(InFilter, Assets);
+
+		for (FAssetData& Asset : Assets)
+		{
+			bool bAlreadyAdded = false;
+			AddedPackageNames.Add(Asset.PackageName, &bAlreadyAdded);
+			if (!bAlreadyAdded)
+			{
+				OutAssets.Add(MoveTemp(Asset));
+			}
+		}
+	};
+
+	if (!PackageNames.IsEmpty())
+	{
+		FARFilter Filter = ClassFilter;
+		for (const FString& PackageName : PackageNames)
+		{
+			Filter.PackageNames.Add(*PackageName);
+		}
+
+		AddAssets(Filter);
+	}
+
+	if (!Paths.IsEmpty())
+	{
+		FARFilter Filter = ClassFilter;
+		for (const FString& Path : Paths)
+		{
+			Filter.PackagePaths.Add(*Path);
+		}
+
+		AddAssets(Filter);
+	}
+}
@@ -0,0 +1,22 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+namespace UE::MGA::CommandletUtils
+{
+	/**
+	 * Returns the assets of InAssetClass (or one of its child classes) selected by the -Blueprints= and -Paths= parameters
+	 * shared by the Attribute Set commandlets, once the asset registry finished searching all assets.
+	 *
+	 * - Blueprints: package names of assets to return, separated by "+" (eg. /Game/A+/Game/B)
+	 * - Paths: content folders (recursive) to return assets from, separated by "+"
+	 *
+	 * Both parameters add up: assets listed in Blueprints and assets under Paths are returned, each asset once. All assets
+	 * of the class are returned when neither parameter is given.
+	 */
+	MODULARGAMEPLAYABILITIESEDITORCOMMON_API void GetAssetsFromParams(const FString& InParams, const UClass* InAssetClass, TArray<FAssetData>& OutAssets);
+}
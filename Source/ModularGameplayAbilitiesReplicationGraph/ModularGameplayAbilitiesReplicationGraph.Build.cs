@@ -0,0 +1,31 @@
+// Copyright Halcyonyx Studios.
+
+using UnrealBuildTool;
+
+public class ModularGameplayAbilitiesReplicationGraph : ModuleRules
+{
+    public ModularGameplayAbilitiesReplicationGraph(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+        ShortName = "MGAReplicationGraph";
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "ReplicationGraph",
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "Engine",
+                "GameplayAbilities",
+                "ModularGameplayAbilities",
+                "NetCore",
+            }
+        );
+    }
+}
@@ -0,0 +1,203 @@
+// Copyright Halcyonyx Studios.
+
+#include "Commandlets/MGAReplicationGraphBenchmarkCommandlet.h"
+
+#include "Commandlets/MGAReplicationGraphBenchmarkTypes.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "Replication/ModularAbilityReplicationGraphNode.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MGAReplicationGraphBenchmarkCommandlet)
+
+namespace MGA::ReplicationGraphBenchmark
+{
+	/** Simulated time between two replication frames */
+	static constexpr float FrameDeltaSeconds = 1.f / 30.f;
+
+	/** Sum of the bytes sent on every client connection of InNetDriver since it started listening */
+	static int64 GetTotalBytesSent(const UNetDriver& InNetDriver)
+	{
+		int64 TotalBytes = 0;
+		for (const UNetConnection* Connection : InNetDriver.ClientConnections)
+		{
+			TotalBytes += Connection ? static_cast<int64>(Connection->OutTotalBytes) : 0;
+		}
+
+		return TotalBytes;
+	}
+}
+
+UMGAReplicationGraphBenchmarkCommandlet::UMGAReplicationGraphBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UMGAReplicationGraphBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace MGA::ReplicationGraphBenchmark;
+
+	int32 NumConnections = 32;
+	int32 NumActors = 1000;
+	int32 NumFrames = 300;
+	float ActiveRatio = 0.1f;
+	float WorldSize = 100000.f;
+	int32 Seed = 0;
+	int32 Port = 17777;
+	FParse::Value(*Params, TEXT("Connections="), NumConnections);
+	FParse::Value(*Params, TEXT("Actors="), NumActors);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("ActiveRatio="), ActiveRatio);
+	FParse::Value(*Params, TEXT("WorldSize="), WorldSize);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Port="), Port);
+	const bool bBaseline = FParse::Param(*Params, TEXT("Baseline"));
+
+	NumConnections = FMath::Max(NumConnections, 1);
+	NumActors = FMath::Max(NumActors, 0);
+	NumFrames = FMath::Max(NumFrames, 1);
+	ActiveRatio = FMath::Clamp(ActiveRatio, 0.f, 1.f);
+
+	FRandomStream RandomStream(Seed);
+	auto GetRandomLocation = [&RandomStream, WorldSize]()
+	{
+		return FVector(RandomStream.FRandRange(0.f, WorldSize), RandomStream.FRandRange(0.f, WorldSize), 0.f);
+	};
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("MGAReplicationGraphBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->SetBegunPlay(true);
+
+	// Every net driver created while listening gets the benchmark graph
+	UReplicationDriver::CreateReplicationDriverDelegate().BindLambda([bBaseline](UNetDriver*, const FURL&, UWorld*) -> UReplicationDriver*
+	{
+		UMGAReplicationGraphBenchmarkGraph* Graph = NewObject<UMGAReplicationGraphBenchmarkGraph>(GetTransientPackage());
+		Graph->bBaseline = bBaseline;
+		return Graph;
+	});
+
+	FURL ListenURL;
+	ListenURL.Port = Port;
+	const bool bListening = World->Listen(ListenURL);
+	UReplicationDriver::CreateReplicationDriverDelegate().Unbind();
+
+	UNetDriver* NetDriver = World->GetNetDriver();
+	UMGAReplicationGraphBenchmarkGraph* Graph = NetDriver ? Cast<UMGAReplicationGraphBenchmarkGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+	if (!bListening || !Graph)
+	{
+		MGA_LOG(Error, TEXT("UMGAReplicationGraphBenchmarkCommandlet - Failed to listen on port %d with the benchmark replication graph"), Port)
+
+		if (NetDriver)
+		{
+			GEngine->DestroyNamedNetDriver(World, NetDriver->NetDriverName);
+			World->SetNetDriver(nullptr);
+		}
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return 1;
+	}
+
+	// Simulated connections never send anything back, don't let them time out
+	NetDriver->bNoTimeouts = true;
+
+	for (int32 Index = 0; Index < NumConnections; ++Index)
+	{
+		// Viewers only need a location, the connection has no player controller
+		AActor* Viewer = World->SpawnActor<AActor>(AActor::StaticClass());
+		USceneComponent* ViewerRoot = NewObject<USceneComponent>(Viewer);
+		Viewer->SetRootComponent(ViewerRoot);
+		ViewerRoot->RegisterComponent();
+		Viewer->SetActorLocation(GetRandomLocation());
+
+		UNetConnection* Connection = NewObject<USimulatedClientNetConnection>();
+		Connection->InitConnection(NetDriver, USOCK_Open, ListenURL, 1000000);
+		Connection->InitSendBuffer();
+		NetDriver->AddClientConnection(Connection);
+
+		Connection->SetClientLoginState(EClientLoginState::Welcomed);
+		Connection->SetClientWorldPackageName(World->GetOutermost()->GetFName());
+		Connection->OwningActor = Viewer;
+		Connection->ViewTarget = Viewer;
+	}
+
+	TArray<AMGAReplicationGraphBenchmarkActor*> Actors;
+	Actors.Reserve(NumActors);
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Actors.Add(World->SpawnActor<AMGAReplicationGraphBenchmarkActor>(GetRandomLocation(), FRotator::ZeroRotator, SpawnParameters));
+	}
+
+	MGA_LOG(Display, TEXT("UMGAReplicationGraphBenchmarkCommandlet - %s, %d connections, %d actors, %d frames, %.0f%% active per frame"), bBaseline ? TEXT("Baseline actor list") : TEXT("Modular Ability node"), NumConnections, NumActors, NumFrames, ActiveRatio * 100.f)
+
+	const int32 NumActivePerFrame = FMath::RoundToInt(NumActors * ActiveRatio);
+
+	double TotalFrameSeconds = 0.0;
+	double MaxFrameSeconds = 0.0;
+	double TotalGatherSeconds = 0.0;
+	int64 TotalBytes = 0;
+	int64 MaxFrameBytes = 0;
+	int64 TotalMovedActors = 0;
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		World->TimeSeconds += FrameDeltaSeconds;
+		World->RealTimeSeconds += FrameDeltaSeconds;
+
+		for (int32 Index = 0; Index < NumActivePerFrame && Actors.Num() > 0; ++Index)
+		{
+			if (AMGAReplicationGraphBenchmarkActor* Actor = Actors[RandomStream.RandHelper(Actors.Num())])
+			{
+				Actor->BumpCounter();
+			}
+		}
+
+		const int64 BytesBefore = GetTotalBytesSent(*NetDriver);
+		const double GatherSecondsBefore = Graph->AbilitySystemNode ? Graph->AbilitySystemNode->GetGatherSeconds() : 0.0;
+
+		NetDriver->TickDispatch(FrameDeltaSeconds);
+
+		const double StartTime = FPlatformTime::Seconds();
+		NetDriver->TickFlush(FrameDeltaSeconds);
+		const double FrameSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const int64 FrameBytes = GetTotalBytesSent(*NetDriver) - BytesBefore;
+
+		TotalFrameSeconds += FrameSeconds;
+		MaxFrameSeconds = FMath::Max(MaxFrameSeconds, FrameSeconds);
+		TotalBytes += FrameBytes;
+		MaxFrameBytes = FMath::Max(MaxFrameBytes, FrameBytes);
+
+		if (Graph->AbilitySystemNode)
+		{
+			TotalGatherSeconds += Graph->AbilitySystemNode->GetGatherSeconds() - GatherSecondsBefore;
+			TotalMovedActors += Graph->AbilitySystemNode->GetNumMovedActors();
+		}
+	}
+
+	MGA_LOG(Display, TEXT("UMGAReplicationGraphBenchmarkCommandlet - Replication frame: %.3f ms avg, %.3f ms max"), TotalFrameSeconds * 1000.0 / NumFrames, MaxFrameSeconds * 1000.0)
+	MGA_LOG(Display, TEXT("UMGAReplicationGraphBenchmarkCommandlet - Bytes sent per frame: %.0f avg, %lld max, %.0f avg per connection"), static_cast<double>(TotalBytes) / NumFrames, MaxFrameBytes, static_cast<double>(TotalBytes) / NumFrames / NumConnections)
+
+	if (Graph->AbilitySystemNode)
+	{
+		MGA_LOG(Display, TEXT("UMGAReplicationGraphBenchmarkCommandlet - Node gather: %.3f ms avg per frame, %.1f actors moved between cell lists per frame"), TotalGatherSeconds * 1000.0 / NumFrames, static_cast<double>(TotalMovedActors) / NumFrames)
+		Graph->AbilitySystemNode->DumpStats(*GLog);
+	}
+
+	GEngine->DestroyNamedNetDriver(World, NetDriver->NetDriverName);
+	World->SetNetDriver(nullptr);
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return 0;
+}
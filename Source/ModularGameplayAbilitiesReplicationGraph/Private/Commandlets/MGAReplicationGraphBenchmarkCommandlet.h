@@ -0,0 +1,42 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MGAReplicationGraphBenchmarkCommandlet.generated.h"
+
+/**
+ * Benchmarks UModularAbilityReplicationGraphNode: listens on a game world with a replication graph routing Ability System
+ * actors to the node, adds simulated client connections (which absorb and auto ack traffic), then runs replication frames
+ * while a share of the actors report activity every frame.
+ *
+ * Logs average / max CPU time of the replication frame (NetDriver TickFlush) and of the node gather, and bytes sent per frame
+ * in total and per connection. Run once with -Baseline to compare against a plain actor list replicating every actor to
+ * every connection each frame.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=MGAReplicationGraphBenchmark [-Connections=32] [-Actors=1000] [-Frames=300] [-ActiveRatio=0.1] [-WorldSize=100000] [-Seed=0] [-Port=17777] [-Baseline]
+ *
+ * - Connections: number of simulated client connections, each viewing from a random location
+ * - Actors: number of replicated actors owning a Modular Ability System Component, at random locations
+ * - Frames: number of replication frames, at 30 frames per second of simulated time
+ * - ActiveRatio: share of actors changing replicated state and reporting activity each frame
+ * - WorldSize: side of the square actors and viewers are spread over, in world units
+ * - Seed: random seed of locations and activity
+ * - Port: port the benchmark world listens on
+ * - Baseline: route actors to a UReplicationGraphNode_ActorList instead of the Modular Ability node
+ *
+ * Returns non zero if the benchmark world failed to listen.
+ */
+UCLASS()
+class UMGAReplicationGraphBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMGAReplicationGraphBenchmarkCommandlet();
+
+	//~ Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet interface
+};
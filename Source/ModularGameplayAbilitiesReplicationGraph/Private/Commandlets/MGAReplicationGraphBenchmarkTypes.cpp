@@ -0,0 +1,105 @@
+// Copyright Halcyonyx Studios.
+
+#include "Commandlets/MGAReplicationGraphBenchmarkTypes.h"
+
+#include "ActorComponent/ModularAbilitySystemComponent.h"
+#include "Components/SceneComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Replication/ModularAbilityReplicationGraphNode.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MGAReplicationGraphBenchmarkTypes)
+
+AMGAReplicationGraphBenchmarkActor::AMGAReplicationGraphBenchmarkActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bReplicates = true;
+	SetRootComponent(CreateDefaultSubobject<USceneComponent>(TEXT("Root")));
+
+	AbilitySystemComponent = CreateDefaultSubobject<UModularAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	AbilitySystemComponent->SetIsReplicated(true);
+}
+
+void AMGAReplicationGraphBenchmarkActor::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	AbilitySystemComponent->InitAbilityActorInfo(this, this);
+}
+
+void AMGAReplicationGraphBenchmarkActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ThisClass, Counter);
+}
+
+UAbilitySystemComponent* AMGAReplicationGraphBenchmarkActor::GetAbilitySystemComponent() const
+{
+	return AbilitySystemComponent;
+}
+
+void AMGAReplicationGraphBenchmarkActor::BumpCounter()
+{
+	Counter++;
+	AbilitySystemComponent->NotifyAbilitySystemActivity(EModularAbilitySystemActivity::AttributeChange);
+}
+
+void UMGAReplicationGraphBenchmarkGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Culling is left to the Modular Ability node, the baseline replicates everything every frame
+	FClassReplicationInfo ClassInfo;
+	ClassInfo.SetCullDistanceSquared(0.f);
+	ClassInfo.ReplicationPeriodFrame = 1;
+	GlobalActorReplicationInfoMap.SetClassInfo(AActor::StaticClass(), ClassInfo);
+}
+
+void UMGAReplicationGraphBenchmarkGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	if (bBaseline)
+	{
+		BaselineNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+		AddGlobalGraphNode(BaselineNode);
+		return;
+	}
+
+	AbilitySystemNode = CreateNewNode<UModularAbilityReplicationGraphNode>();
+	AddGlobalGraphNode(AbilitySystemNode);
+}
+
+void UMGAReplicationGraphBenchmarkGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	if (!ActorInfo.Actor || !ActorInfo.Actor->IsA<AMGAReplicationGraphBenchmarkActor>())
+	{
+		return;
+	}
+
+	if (AbilitySystemNode)
+	{
+		AbilitySystemNode->NotifyAddNetworkActor(ActorInfo);
+	}
+	else if (BaselineNode)
+	{
+		BaselineNode->NotifyAddNetworkActor(ActorInfo);
+	}
+}
+
+void UMGAReplicationGraphBenchmarkGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (!ActorInfo.Actor || !ActorInfo.Actor->IsA<AMGAReplicationGraphBenchmarkActor>())
+	{
+		return;
+	}
+
+	if (AbilitySystemNode)
+	{
+		AbilitySystemNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+	else if (BaselineNode)
+	{
+		BaselineNode->NotifyRemoveNetworkActor(ActorInfo);
+	}
+}
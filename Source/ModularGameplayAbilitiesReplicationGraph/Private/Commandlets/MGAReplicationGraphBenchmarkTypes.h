@@ -0,0 +1,74 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemInterface.h"
+#include "GameFramework/Actor.h"
+#include "ReplicationGraph.h"
+#include "MGAReplicationGraphBenchmarkTypes.generated.h"
+
+class UModularAbilityReplicationGraphNode;
+class UModularAbilitySystemComponent;
+
+/**
+ * Replicated actor owning a UModularAbilitySystemComponent, spawned by UMGAReplicationGraphBenchmarkCommandlet.
+ *
+ * BumpCounter() changes replicated state and reports Ability System activity, like an attribute change would.
+ */
+UCLASS(NotBlueprintable, Transient)
+class AMGAReplicationGraphBenchmarkActor : public AActor, public IAbilitySystemInterface
+{
+	GENERATED_BODY()
+
+public:
+	AMGAReplicationGraphBenchmarkActor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	//~ Begin AActor interface
+	virtual void PostInitializeComponents() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	//~ End AActor interface
+
+	//~ Begin IAbilitySystemInterface interface
+	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
+	//~ End IAbilitySystemInterface interface
+
+	void BumpCounter();
+
+private:
+	UPROPERTY()
+	TObjectPtr<UModularAbilitySystemComponent> AbilitySystemComponent;
+
+	UPROPERTY(Replicated)
+	int32 Counter = 0;
+};
+
+/**
+ * Replication graph used by UMGAReplicationGraphBenchmarkCommandlet.
+ *
+ * Benchmark actors are routed to a UModularAbilityReplicationGraphNode, or to a plain actor list gathered every frame for
+ * every connection when bBaseline is set. Other replicated actors are not replicated.
+ */
+UCLASS(Transient)
+class UMGAReplicationGraphBenchmarkGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	/** Routes benchmark actors to a plain actor list instead of the Modular Ability node, set before the graph is initialized */
+	bool bBaseline = false;
+
+	/** Node benchmark actors are routed to, null when bBaseline is set */
+	UPROPERTY()
+	TObjectPtr<UModularAbilityReplicationGraphNode> AbilitySystemNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> BaselineNode;
+
+	//~ Begin UReplicationGraph interface
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	//~ End UReplicationGraph interface
+};
@@ -0,0 +1,5 @@
+// Copyright Halcyonyx Studios.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, ModularGameplayAbilitiesReplicationGraph)
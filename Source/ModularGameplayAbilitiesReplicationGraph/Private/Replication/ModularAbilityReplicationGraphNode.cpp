@@ -0,0 +1,297 @@
+// Copyright Halcyonyx Studios.
+
+#include "Replication/ModularAbilityReplicationGraphNode.h"
+
+#include "AbilitySystemGlobals.h"
+#include "ActorComponent/ModularAbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "ModularGameplayAbilitiesLogChannels.h"
+#include "UObject/UObjectIterator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModularAbilityReplicationGraphNode)
+
+namespace MGA::ReplicationGraph
+{
+	static FAutoConsoleCommandWithOutputDevice StatsCommand(
+		TEXT("MGA.ReplicationGraph.Stats"),
+		TEXT("Logs active / idle actor counts and gather cost of Modular Ability replication graph nodes."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			for (TObjectIterator<UModularAbilityReplicationGraphNode> It; It; ++It)
+			{
+				if (!It->HasAnyFlags(RF_ClassDefaultObject))
+				{
+					It->DumpStats(Ar);
+				}
+			}
+		})
+	);
+}
+
+UModularAbilityReplicationGraphNode::UModularAbilityReplicationGraphNode()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UModularAbilityReplicationGraphNode::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+	if (!Actor)
+	{
+		return;
+	}
+
+	FTrackedActor& TrackedActor = TrackedActors.FindOrAdd(Actor);
+	TrackedActor.Actor = Actor;
+
+	ExtendActorChannelFrameTimeout(Actor);
+
+	// New actors start active so that their initial state goes out right away
+	const UWorld* World = Actor->GetWorld();
+	TrackedActor.LastActivityTime = World ? World->GetTimeSeconds() : 0.0;
+
+	UModularAbilitySystemComponent* ASC = Cast<UModularAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Actor));
+	if (!ASC)
+	{
+		MGA_LOG(Verbose, TEXT("UModularAbilityReplicationGraphNode - %s has no Modular Ability System Component, replicated as always active"), *GetNameSafe(Actor))
+		return;
+	}
+
+	TrackedActor.AbilitySystemComponent = ASC;
+	TrackedActor.ActivityHandle = ASC->OnAbilitySystemActivity.AddWeakLambda(this, [this, ActorKey = FObjectKey(Actor)](EModularAbilitySystemActivity)
+	{
+		if (FTrackedActor* Tracked = TrackedActors.Find(ActorKey))
+		{
+			NotifyActorActivity(Tracked->Actor);
+		}
+	});
+}
+
+bool UModularAbilityReplicationGraphNode::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	FTrackedActor TrackedActor;
+	if (!TrackedActors.RemoveAndCopyValue(ActorInfo.Actor, TrackedActor))
+	{
+		if (bWarnIfNotFound)
+		{
+			MGA_LOG(Warning, TEXT("UModularAbilityReplicationGraphNode::NotifyRemoveNetworkActor - %s was not tracked"), *GetNameSafe(ActorInfo.Actor))
+		}
+
+		return false;
+	}
+
+	if (UModularAbilitySystemComponent* ASC = TrackedActor.AbilitySystemComponent.Get())
+	{
+		ASC->OnAbilitySystemActivity.Remove(TrackedActor.ActivityHandle);
+	}
+
+	RemoveFromCell(TrackedActor);
+	return true;
+}
+
+void UModularAbilityReplicationGraphNode::NotifyResetAllNetworkActors()
+{
+	for (const TPair<FObjectKey, FTrackedActor>& Pair : TrackedActors)
+	{
+		if (UModularAbilitySystemComponent* ASC = Pair.Value.AbilitySystemComponent.Get())
+		{
+			ASC->OnAbilitySystemActivity.Remove(Pair.Value.ActivityHandle);
+		}
+	}
+
+	TrackedActors.Reset();
+	Cells.Reset();
+	NumActiveActors = 0;
+	NumIdleActors = 0;
+
+	Super::NotifyResetAllNetworkActors();
+}
+
+void UModularAbilityReplicationGraphNode::NotifyActorActivity(AActor* InActor)
+{
+	FTrackedActor* TrackedActor = TrackedActors.Find(InActor);
+	if (!TrackedActor || !InActor)
+	{
+		return;
+	}
+
+	const UWorld* World = InActor->GetWorld();
+	TrackedActor->LastActivityTime = World ? World->GetTimeSeconds() : 0.0;
+}
+
+FIntPoint UModularAbilityReplicationGraphNode::GetCellCoordinates(const FVector& InLocation) const
+{
+	const double SafeCellSize = FMath::Max(CellSize, 1.f);
+	return FIntPoint(FMath::FloorToInt(InLocation.X / SafeCellSize), FMath::FloorToInt(InLocation.Y / SafeCellSize));
+}
+
+int32 UModularAbilityReplicationGraphNode::GetIdleReplicationPeriod() const
+{
+	// Leaves room for a timeout above the period, which is stored on a uint8
+	return FMath::Clamp(IdleReplicationPeriod, 1, MAX_uint8 - 1);
+}
+
+uint8 UModularAbilityReplicationGraphNode::GetRequiredActorChannelFrameTimeout() const
+{
+	// A frame of slack, staggered idle gathers land exactly IdleReplicationPeriod frames apart
+	return static_cast<uint8>(GetIdleReplicationPeriod() + 1);
+}
+
+void UModularAbilityReplicationGraphNode::ExtendActorChannelFrameTimeout(AActor* InActor) const
+{
+	if (!GraphGlobals.IsValid() || !GraphGlobals->GlobalActorReplicationInfoMap)
+	{
+		return;
+	}
+
+	const uint8 RequiredTimeout = GetRequiredActorChannelFrameTimeout();
+
+	// Class settings for actors spawned later, actor settings because they were copied from the class when first registered
+	FClassReplicationInfo& ClassInfo = GraphGlobals->GlobalActorReplicationInfoMap->GetClassInfo(InActor->GetClass());
+	if (ClassInfo.ActorChannelFrameTimeout < RequiredTimeout)
+	{
+		MGA_LOG(Verbose, TEXT("UModularAbilityReplicationGraphNode - Raising ActorChannelFrameTimeout of %s from %d to %d"), *GetNameSafe(InActor->GetClass()), ClassInfo.ActorChannelFrameTimeout, RequiredTimeout)
+		ClassInfo.ActorChannelFrameTimeout = RequiredTimeout;
+	}
+
+	FGlobalActorReplicationInfo& ActorInfo = GraphGlobals->GlobalActorReplicationInfoMap->Get(InActor);
+	ActorInfo.Settings.ActorChannelFrameTimeout = FMath::Max(ActorInfo.Settings.ActorChannelFrameTimeout, RequiredTimeout);
+}
+
+void UModularAbilityReplicationGraphNode::RemoveFromCell(FTrackedActor& InTrackedActor)
+{
+	if (!InTrackedActor.bPlaced)
+	{
+		return;
+	}
+
+	InTrackedActor.bPlaced = false;
+	(InTrackedActor.bActive ? NumActiveActors : NumIdleActors)--;
+
+	FCell* Cell = Cells.Find(InTrackedActor.Cell);
+	if (!Cell)
+	{
+		return;
+	}
+
+	(InTrackedActor.bActive ? Cell->ActiveActors : Cell->IdleActors).RemoveFast(InTrackedActor.Actor);
+	if (Cell->ActiveActors.Num() == 0 && Cell->IdleActors.Num() == 0)
+	{
+		Cells.Remove(InTrackedActor.Cell);
+	}
+}
+
+void UModularAbilityReplicationGraphNode::PrepareForReplication()
+{
+	NumMovedActors = 0;
+
+	const UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+	// Lists are kept across frames, only actors that changed cell or activity are moved
+	for (TPair<FObjectKey, FTrackedActor>& Pair : TrackedActors)
+	{
+		FTrackedActor& TrackedActor = Pair.Value;
+		AActor* Actor = TrackedActor.Actor;
+		if (!IsValid(Actor))
+		{
+			RemoveFromCell(TrackedActor);
+			continue;
+		}
+
+		const FIntPoint CellCoordinates = GetCellCoordinates(Actor->GetActorLocation());
+
+		// Actors without a Modular ASC have no activity to go by
+		const bool bIsActive = !TrackedActor.AbilitySystemComponent.IsValid() || Now - TrackedActor.LastActivityTime <= ActivityWindow;
+		if (TrackedActor.bPlaced && TrackedActor.Cell == CellCoordinates && TrackedActor.bActive == bIsActive)
+		{
+			continue;
+		}
+
+		RemoveFromCell(TrackedActor);
+
+		FCell& Cell = Cells.FindOrAdd(CellCoordinates);
+		(bIsActive ? Cell.ActiveActors : Cell.IdleActors).Add(Actor);
+		(bIsActive ? NumActiveActors : NumIdleActors)++;
+
+		TrackedActor.Cell = CellCoordinates;
+		TrackedActor.bActive = bIsActive;
+		TrackedActor.bPlaced = true;
+		NumMovedActors++;
+	}
+}
+
+void UModularAbilityReplicationGraphNode::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const int32 CellRadius = FMath::CeilToInt(CullDistance / FMath::Max(CellSize, 1.f));
+	const int32 IdlePeriod = GetIdleReplicationPeriod();
+
+	TSet<FIntPoint, DefaultKeyFuncs<FIntPoint>, TInlineSetAllocator<16>> GatheredCells;
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const FIntPoint ViewerCell = GetCellCoordinates(Viewer.ViewLocation);
+		for (int32 X = ViewerCell.X - CellRadius; X <= ViewerCell.X + CellRadius; ++X)
+		{
+			for (int32 Y = ViewerCell.Y - CellRadius; Y <= ViewerCell.Y + CellRadius; ++Y)
+			{
+				const FIntPoint CellCoordinates(X, Y);
+				bool bAlreadyGathered = false;
+				GatheredCells.Add(CellCoordinates, &bAlreadyGathered);
+				if (bAlreadyGathered)
+				{
+					continue;
+				}
+
+				FCell* Cell = Cells.Find(CellCoordinates);
+				if (!Cell)
+				{
+					continue;
+				}
+
+				if (Cell->ActiveActors.Num() > 0)
+				{
+					Params.OutGatheredReplicationLists.AddReplicationActorList(Cell->ActiveActors);
+					NumGatheredLists++;
+				}
+
+				// Stagger idle cells across frames so that they don't all replicate on the same one
+				const uint32 CellOffset = GetTypeHash(CellCoordinates);
+				if (Cell->IdleActors.Num() > 0 && (Params.ReplicationFrameNum + CellOffset) % IdlePeriod == 0)
+				{
+					Params.OutGatheredReplicationLists.AddReplicationActorList(Cell->IdleActors);
+					NumGatheredLists++;
+				}
+			}
+		}
+	}
+
+	GatherSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UModularAbilityReplicationGraphNode::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+	DebugInfo.Log(FString::Printf(TEXT("Tracked: %d, Active: %d, Idle: %d, Cells: %d"), TrackedActors.Num(), NumActiveActors, NumIdleActors, Cells.Num()));
+	DebugInfo.PopIndent();
+}
+
+void UModularAbilityReplicationGraphNode::DumpStats(FOutputDevice& Ar)
+{
+	Ar.Logf(
+		TEXT("%s - Tracked: %d, Active: %d, Idle: %d, Cells: %d, Gathered lists: %d, Gather time: %.3f ms (total since last stats)"),
+		*GetPathName(),
+		TrackedActors.Num(),
+		NumActiveActors,
+		NumIdleActors,
+		Cells.Num(),
+		NumGatheredLists,
+		GatherSeconds * 1000.0
+	);
+
+	NumGatheredLists = 0;
+	GatherSeconds = 0.0;
+}
@@ -0,0 +1,140 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "ModularAbilityReplicationGraphNode.generated.h"
+
+class UModularAbilitySystemComponent;
+enum class EModularAbilitySystemActivity : uint8;
+
+/**
+ * Replication graph node for actors owning a UModularAbilitySystemComponent (pawns, player states).
+ *
+ * Actors are bucketed by spatial grid cell and by recent activity of their Ability System Component (attribute changes,
+ * tag changes, ability activations, see UModularAbilitySystemComponent::OnAbilitySystemActivity):
+ *
+ * - Active actors (activity within ActivityWindow seconds) are gathered every frame for connections within CullDistance
+ * - Idle actors are only gathered every IdleReplicationPeriod frames, staggered per cell to spread the cost
+ *
+ * Cell lists are kept across frames, PrepareForReplication() only moves actors whose cell or activity changed.
+ *
+ * Actor channels are closed once an actor wasn't gathered for ActorChannelFrameTimeout frames (4 by default), so the node
+ * raises the ActorChannelFrameTimeout of tracked actors and their class above IdleReplicationPeriod, see
+ * GetRequiredActorChannelFrameTimeout(). Otherwise idle actors would have their channel closed and reopened every period.
+ *
+ * Lives in the optional ModularGameplayAbilitiesReplicationGraph module, add it to your module dependencies along with
+ * ReplicationGraph. Usage, from a UReplicationGraph subclass:
+ *
+ * ```cpp
+ * void UMyReplicationGraph::InitGlobalGraphNodes()
+ * {
+ * 	Super::InitGlobalGraphNodes();
+ *
+ * 	AbilitySystemNode = CreateNewNode<UModularAbilityReplicationGraphNode>();
+ * 	AddGlobalGraphNode(AbilitySystemNode);
+ * }
+ *
+ * // Then route ASC owning actors to it from RouteAddNetworkActorToNodes() / RouteRemoveNetworkActorToNodes()
+ * ```
+ *
+ * Node stats can be logged with MGA.ReplicationGraph.Stats, and the node benchmarked with N simulated connections by the
+ * MGAReplicationGraphBenchmark commandlet (see UMGAReplicationGraphBenchmarkCommandlet).
+ */
+UCLASS(Config = Game)
+class MODULARGAMEPLAYABILITIESREPLICATIONGRAPH_API UModularAbilityReplicationGraphNode : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UModularAbilityReplicationGraphNode();
+
+	/** Size of a spatial grid cell, in world units */
+	UPROPERTY(Config)
+	float CellSize = 10000.f;
+
+	/** Actors further than this from every viewer of a connection are not gathered for it */
+	UPROPERTY(Config)
+	float CullDistance = 15000.f;
+
+	/** Seconds an actor is considered active after the last activity of its Ability System Component */
+	UPROPERTY(Config)
+	float ActivityWindow = 2.f;
+
+	/** Idle actors are gathered every this many replication frames, clamped to [1, 254] */
+	UPROPERTY(Config)
+	int32 IdleReplicationPeriod = 8;
+
+	//~ Begin UReplicationGraphNode interface
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+	//~ End UReplicationGraphNode interface
+
+	/** Marks the actor active, called on activity of its Ability System Component */
+	void NotifyActorActivity(AActor* InActor);
+
+	/** Logs actor counts and gather cost to the given output device, then resets the cumulative gather stats */
+	void DumpStats(FOutputDevice& Ar);
+
+	/** Returns seconds spent in GatherActorListsForConnection() since the last DumpStats() */
+	double GetGatherSeconds() const
+	{
+		return GatherSeconds;
+	}
+
+	/** Returns the number of actors moved between cell lists by the last PrepareForReplication() */
+	int32 GetNumMovedActors() const
+	{
+		return NumMovedActors;
+	}
+
+	/** Returns the ActorChannelFrameTimeout tracked actors need so that their channel stays open between idle gathers */
+	uint8 GetRequiredActorChannelFrameTimeout() const;
+
+private:
+	struct FTrackedActor
+	{
+		AActor* Actor = nullptr;
+		TWeakObjectPtr<UModularAbilitySystemComponent> AbilitySystemComponent;
+		FDelegateHandle ActivityHandle;
+		double LastActivityTime = -UE_BIG_NUMBER;
+
+		/** Cell and list the actor is currently in, valid once bPlaced */
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		bool bActive = false;
+		bool bPlaced = false;
+	};
+
+	struct FCell
+	{
+		FActorRepListRefView ActiveActors;
+		FActorRepListRefView IdleActors;
+	};
+
+	FIntPoint GetCellCoordinates(const FVector& InLocation) const;
+
+	/** Removes InTrackedActor from its current cell list, dropping the cell once empty */
+	void RemoveFromCell(FTrackedActor& InTrackedActor);
+
+	int32 GetIdleReplicationPeriod() const;
+
+	/** Raises the ActorChannelFrameTimeout of InActor and its class to GetRequiredActorChannelFrameTimeout() if lower */
+	void ExtendActorChannelFrameTimeout(AActor* InActor) const;
+
+	TMap<FObjectKey, FTrackedActor> TrackedActors;
+	TMap<FIntPoint, FCell> Cells;
+
+	/** Actor counts of the last replication frame */
+	int32 NumActiveActors = 0;
+	int32 NumIdleActors = 0;
+	int32 NumMovedActors = 0;
+
+	/** Gather stats, cumulative since the last DumpStats() */
+	int32 NumGatheredLists = 0;
+	double GatherSeconds = 0.0;
+};
@@ -0,0 +1,220 @@
+// Copyright Halcyonyx Studios.
+
+#include "Commandlets/MGAGenerateAttributeSetsCommandlet.h"
+
+#include "GameProjectUtils.h"
+#include "MGAAttributeSetCodeGenerator.h"
+#include "MGAScaffoldLog.h"
+#include "MGAScaffoldUtils.h"
+#include "AssetRegistry/AssetData.h"
+#include "Attributes/MGAAttributeSetBlueprint.h"
+#include "Attributes/ModularAttributeSetBase.h"
+#include "Engine/Blueprint.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Models/MGAAttributeSetWizardViewModel.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utilities/MGACommandletUtils.h"
+
+UMGAGenerateAttributeSetsCommandlet::UMGAGenerateAttributeSetsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMGAGenerateAttributeSetsCommandlet::Main(const FString& Params)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FString ModuleName;
+	FString ClassPath;
+	FParse::Value(*Params, TEXT("Module="), ModuleName);
+	FParse::Value(*Params, TEXT("ClassPath="), ClassPath);
+	const bool bPrivate = FParse::Param(*Params, TEXT("Private"));
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	const TSharedPtr<FModuleContextInfo> ModuleInfo = FindModuleInfo(ModuleName);
+	if (!ModuleInfo.IsValid())
+	{
+		MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - Failed to find module \"%s\" in project"), ModuleName.IsEmpty() ? FApp::GetProjectName() : *ModuleName)
+		return 1;
+	}
+
+	TArray<FAssetData> Assets;
+	UE::MGA::CommandletUtils::GetAssetsFromParams(Params, UMGAAttributeSetBlueprint::StaticClass(), Assets);
+
+	MGA_SCAFFOLD_LOG(Display, TEXT("UMGAGenerateAttributeSetsCommandlet - Generating %d Attribute Set classes in %s module"), Assets.Num(), *ModuleInfo->ModuleName)
+
+	// Request all loads first so that packages load concurrently
+	for (const FAssetData& Asset : Assets)
+	{
+		LoadPackageAsync(Asset.PackageName.ToString());
+	}
+
+	FlushAsyncLoading();
+
+	// Generate all contents before writing anything, so that a single invalid Blueprint doesn't leave the batch half written
+	int32 NumErrors = 0;
+	TArray<FMGAScaffoldClassFiles> ClassesFiles;
+	ClassesFiles.Reserve(Assets.Num());
+	TArray<FString> RequiredModuleDependencies;
+
+	for (const FAssetData& Asset : Assets)
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset());
+		if (!Blueprint || !Blueprint->GeneratedClass)
+		{
+			MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - Failed to load %s"), *Asset.PackageName.ToString())
+			++NumErrors;
+			continue;
+		}
+
+		const TSharedPtr<FMGAAttributeSetWizardViewModel> ViewModel = MakeViewModel(Blueprint, ModuleInfo, ClassPath, bPrivate);
+		if (!ViewModel->IsLastInputValidityCheckSuccessful())
+		{
+			MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - Cannot generate class for %s: %s"), *Asset.PackageName.ToString(), *ViewModel->GetLastInputValidityErrorText().ToString())
+			++NumErrors;
+			continue;
+		}
+
+		FMGAScaffoldClassFiles& ClassFiles = ClassesFiles.AddDefaulted_GetRef();
+		ClassFiles.ClassName = ViewModel->GetNewClassName();
+		ClassFiles.ClassPath = ViewModel->GetNewClassPath();
+		ClassFiles.HeaderDestination = ViewModel->GetCalculatedClassHeaderName();
+		ClassFiles.HeaderContent = FMGAAttributeSetCodeGenerator::GenerateHeaderContent(ViewModel);
+		ClassFiles.SourceDestination = ViewModel->GetCalculatedClassSourceName();
+		ClassFiles.SourceContent = FMGAAttributeSetCodeGenerator::GenerateSourceContent(ViewModel);
+		ClassFiles.ModuleInfo = *ModuleInfo;
+
+		for (const FMGARequiredModuleDependency& Dependency : ViewModel->GetRequiredModuleDependencies())
+		{
+			RequiredModuleDependencies.AddUnique(Dependency.ModuleName);
+		}
+	}
+
+	if (NumErrors > 0)
+	{
+		MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - %d / %d Attribute Set classes cannot be generated, no file written"), NumErrors, Assets.Num())
+		return 1;
+	}
+
+	// Build.cs is read once for the dependencies of all classes
+	FText ErrorText;
+	TArray<FString> MissingModuleDependencies;
+	FMGAScaffoldUtils::DoesBuildCSSatisfiesDependencies(*ModuleInfo, RequiredModuleDependencies, MissingModuleDependencies, ErrorText);
+	if (!ErrorText.IsEmpty())
+	{
+		MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - %s"), *ErrorText.ToString())
+		return 1;
+	}
+
+	if (bDryRun)
+	{
+		for (const FMGAScaffoldClassFiles& ClassFiles : ClassesFiles)
+		{
+			MGA_SCAFFOLD_LOG(Display, TEXT("\t Would write %s"), *ClassFiles.HeaderDestination)
+			MGA_SCAFFOLD_LOG(Display, TEXT("\t Would write %s"), *ClassFiles.SourceDestination)
+		}
+
+		for (const FString& MissingModuleDependency : MissingModuleDependencies)
+		{
+			MGA_SCAFFOLD_LOG(Display, TEXT("\t Would add %s to %s"), *MissingModuleDependency, *FMGAScaffoldUtils::GetModuleBuildCSFilename(*ModuleInfo))
+		}
+
+		return 0;
+	}
+
+	// Build.cs goes first: it is a single file that can be restored byte for byte, whereas classes being added regenerate
+	// project files. Nothing is left behind if the module dependencies can't be added.
+	const FString BuildCSFilePath = FMGAScaffoldUtils::GetModuleBuildCSFilePath(*ModuleInfo);
+	TArray<uint8> BuildCSFileContents;
+	if (!MissingModuleDependencies.IsEmpty())
+	{
+		if (!FFileHelper::LoadFileToArray(BuildCSFileContents, *BuildCSFilePath)
+			|| !FMGAScaffoldUtils::AddBuildCSDependencies(*ModuleInfo, MissingModuleDependencies, ErrorText))
+		{
+			MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - Failed to add module dependencies %s to %s: %s"), *FString::Join(MissingModuleDependencies, TEXT(", ")), *FMGAScaffoldUtils::GetModuleBuildCSFilename(*ModuleInfo), *ErrorText.ToString())
+			return 1;
+		}
+
+		MGA_SCAFFOLD_LOG(Display, TEXT("\t Added %s to %s"), *FString::Join(MissingModuleDependencies, TEXT(", ")), *FMGAScaffoldUtils::GetModuleBuildCSFilename(*ModuleInfo))
+	}
+
+	TArray<FString> CreatedFiles;
+	const GameProjectUtils::EAddCodeToProjectResult Result = FMGAScaffoldUtils::AddClassesToProject(ClassesFiles, CreatedFiles, ErrorText);
+	for (const FString& CreatedFile : CreatedFiles)
+	{
+		MGA_SCAFFOLD_LOG(Display, TEXT("\t Wrote %s"), *CreatedFile)
+	}
+
+	if (Result != GameProjectUtils::EAddCodeToProjectResult::Succeeded)
+	{
+		MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - Failed to generate classes: %s"), *ErrorText.ToString())
+
+		// The classes needing the dependencies weren't added (or only partially, if project files failed to update)
+		if (CreatedFiles.IsEmpty() && !BuildCSFileContents.IsEmpty())
+		{
+			if (FFileHelper::SaveArrayToFile(BuildCSFileContents, *BuildCSFilePath))
+			{
+				MGA_SCAFFOLD_LOG(Display, TEXT("\t Restored %s"), *FMGAScaffoldUtils::GetModuleBuildCSFilename(*ModuleInfo))
+			}
+			else
+			{
+				MGA_SCAFFOLD_LOG(Error, TEXT("UMGAGenerateAttributeSetsCommandlet - Failed to restore %s, remove %s from its dependencies"), *BuildCSFilePath, *FString::Join(MissingModuleDependencies, TEXT(", ")))
+			}
+		}
+
+		return 1;
+	}
+
+	MGA_SCAFFOLD_LOG(Display, TEXT("UMGAGenerateAttributeSetsCommandlet - Generated %d Attribute Set classes, took %.2f seconds. Build the project from your IDE to compile them."), ClassesFiles.Num(), FPlatformTime::Seconds() - StartTime)
+	return 0;
+}
+
+TSharedPtr<FModuleContextInfo> UMGAGenerateAttributeSetsCommandlet::FindModuleInfo(const FString& InModuleName)
+{
+	const FString ModuleName = InModuleName.IsEmpty() ? FString(FApp::GetProjectName()) : InModuleName;
+
+	TArray<FModuleContextInfo> Modules = GameProjectUtils::GetCurrentProjectModules();
+	Modules.Append(GameProjectUtils::GetCurrentProjectPluginModules());
+
+	const FModuleContextInfo* ModuleInfo = Modules.FindByPredicate([&ModuleName](const FModuleContextInfo& InModuleInfo)
+	{
+		return InModuleInfo.ModuleName == ModuleName;
+	});
+
+	return ModuleInfo ? MakeShared<FModuleContextInfo>(*ModuleInfo) : nullptr;
+}
+
+TSharedPtr<FMGAAttributeSetWizardViewModel> UMGAGenerateAttributeSetsCommandlet::MakeViewModel(UBlueprint* InBlueprint, const TSharedPtr<FModuleContextInfo>& InModuleInfo, const FString& InClassPath, const bool bInPrivate)
+{
+	check(InBlueprint);
+	check(InModuleInfo.IsValid());
+
+	// Derive from the nearest native parent, the Blueprint may have another Attribute Set Blueprint as parent. Attributes
+	// inherited from it are declared in the generated class, see FMGAHeaderViewListItem::GetAllProperties().
+	const UClass* ParentClass = InBlueprint->ParentClass;
+	while (ParentClass && !ParentClass->HasAnyClassFlags(CLASS_Native))
+	{
+		ParentClass = ParentClass->GetSuperClass();
+	}
+
+	const TSharedPtr<FMGAAttributeSetWizardViewModel> ViewModel = MakeShared<FMGAAttributeSetWizardViewModel>(ParentClass ? ParentClass : UModularAttributeSetBase::StaticClass());
+	ViewModel->Initialize();
+
+	// No widget is listening, skip change notifications
+	const FString ClassLocationFolder = bInPrivate ? TEXT("Private") : TEXT("Public");
+	ViewModel->SetSelectedModuleInfo(InModuleInfo, false);
+	ViewModel->SetNewClassName(InBlueprint->GetName(), false);
+	ViewModel->SetNewClassPath(InModuleInfo->ModuleSourcePath / ClassLocationFolder / InClassPath / TEXT(""), false);
+	ViewModel->SetSelectedClassPath(InClassPath, false);
+	ViewModel->SetSelectedBlueprint(InBlueprint, false);
+
+	ViewModel->UpdateRequiredModuleDependencies();
+
+	// Missing module dependencies are added to Build.cs once for all classes
+	ViewModel->UpdateInputValidity(false);
+	return ViewModel;
+}
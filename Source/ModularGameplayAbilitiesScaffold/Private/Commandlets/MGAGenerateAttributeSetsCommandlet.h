@@ -0,0 +1,57 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MGAGenerateAttributeSetsCommandlet.generated.h"
+
+class FMGAAttributeSetWizardViewModel;
+class UBlueprint;
+struct FModuleContextInfo;
+
+/**
+ * Generates the C++ classes of many Attribute Set Blueprints at once, the same way the Attribute Set Wizard does for a
+ * single one.
+ *
+ * Header and source contents are all generated before any file is written. Files are then written in one pass, the IDE
+ * project is updated (or project files regenerated) once, and missing module dependencies of all generated classes are
+ * added to the target module Build.cs file in a single edit.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=MGAGenerateAttributeSets [-Blueprints=/Game/A+/Game/B] [-Paths=/Game/Attributes+/Game/Other] [-Module=MyGame] [-ClassPath=Attributes] [-Private] [-DryRun]
+ *
+ * - Blueprints: package names of the Attribute Set Blueprints to generate classes for
+ * - Paths: content folders (recursive) to look for Attribute Set Blueprints in
+ * - Module: name of the project or plugin module to add the classes to, the primary game module if omitted
+ * - ClassPath: sub folder of the module Public (or Private) folder to put the files in
+ * - Private: put headers in the module Private folder instead of the Public one
+ * - DryRun: log the files that would be written and the module dependencies that would be added, without writing anything
+ *
+ * Blueprints and Paths add up (Blueprints listed or under one of the paths are used), all Attribute Set Blueprints of the
+ * project are used when neither is given. Classes are named after
+ * their Blueprint, and derive from the nearest native parent class of the Blueprint. Attributes inherited from parent
+ * Attribute Set Blueprints are declared in the generated class as well, so a Blueprint and its parent Blueprint generated
+ * in the same batch both declare the parent attributes. Returns non zero if any class could not be generated.
+ *
+ * Nothing is written if a file to generate already exists. Build.cs is edited first, and restored if the classes then fail
+ * to be written (files written before a write failure are deleted).
+ */
+UCLASS()
+class UMGAGenerateAttributeSetsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMGAGenerateAttributeSetsCommandlet();
+
+	//~ Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet interface
+
+private:
+	/** Returns the project or plugin module named InModuleName, the primary game module if empty */
+	static TSharedPtr<FModuleContextInfo> FindModuleInfo(const FString& InModuleName);
+
+	/** Returns a view model set up like the wizard would be for InBlueprint, with input validity already checked */
+	static TSharedPtr<FMGAAttributeSetWizardViewModel> MakeViewModel(UBlueprint* InBlueprint, const TSharedPtr<FModuleContextInfo>& InModuleInfo, const FString& InClassPath, bool bInPrivate);
+};
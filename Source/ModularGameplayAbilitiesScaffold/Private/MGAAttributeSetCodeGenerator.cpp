@@ -0,0 +1,272 @@
+// Copyright Halcyonyx Studios.
+
+#include "MGAAttributeSetCodeGenerator.h"
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "HeaderView/MGAHeaderViewClassListItem.h"
+#include "HeaderView/MGAHeaderViewVariableListItem.h"
+#include "HeaderView/Attributes/MGAHeaderViewAttributeAccessorsListItem.h"
+#include "HeaderView/Attributes/MGAHeaderViewAttributeVariableListItem.h"
+#include "HeaderView/Attributes/MGAHeaderViewConstructorListItem.h"
+#include "HeaderView/Attributes/MGAHeaderViewCopyrightListItem.h"
+#include "HeaderView/Attributes/MGAHeaderViewGetLifetimeListItem.h"
+#include "HeaderView/Attributes/MGAHeaderViewIncludesListItem.h"
+#include "HeaderView/Attributes/MGAHeaderViewOnRepListItem.h"
+#include "LineEndings/MGALineEndings.h"
+#include "Models/MGAAttributeSetWizardViewModel.h"
+#include "SourceView/MGASourceViewConstructorListItem.h"
+#include "SourceView/MGASourceViewGetLifetimeListItem.h"
+#include "SourceView/MGASourceViewIncludesListItem.h"
+#include "SourceView/MGASourceViewOnRepListItem.h"
+#include "UObject/FieldPath.h"
+#include "Utilities/MGAUtilities.h"
+
+namespace MGA::CodeGenerator
+{
+	/**
+	 * Returns a list item factory for InProperty, calling InCreate with the property.
+	 *
+	 * The property is resolved when the item is built, as it may be gone by then (eg. Blueprint recompiled before the list
+	 * is repopulated), in which case the item is left empty.
+	 */
+	template <typename TCreate>
+	static TFunction<FMGAHeaderViewListItemPtr()> MakePropertyItemFactory(const FProperty* InProperty, TCreate&& InCreate)
+	{
+		return [PropertyPath = TFieldPath<FProperty>(const_cast<FProperty*>(InProperty)), Create = Forward<TCreate>(InCreate)]() -> FMGAHeaderViewListItemPtr
+		{
+			const FProperty* Property = PropertyPath.Get();
+			return Property ? Create(*Property) : nullptr;
+		};
+	}
+
+	/** Returns a factory for a line that never needs rebuilding (eg. an access specifier) */
+	static TFunction<FMGAHeaderViewListItemPtr()> MakeTextItemFactory(const FString& InRawString, const FString& InRichText)
+	{
+		return [InRawString, InRichText]
+		{
+			return FMGAHeaderViewListItem::Create(InRawString, InRichText);
+		};
+	}
+
+	/** Returns a factory for an access specifier line, eg. "public:" */
+	static TFunction<FMGAHeaderViewListItemPtr()> MakeAccessSpecifierItemFactory(const TCHAR* InAccessSpecifier)
+	{
+		return MakeTextItemFactory(
+			FString::Printf(TEXT("%s:"), InAccessSpecifier),
+			FString::Printf(TEXT("<%s>%s</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator, InAccessSpecifier)
+		);
+	}
+}
+
+void FMGAAttributeSetCodeGenerator::BuildHeaderItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const FAddItem InAddItem)
+{
+	check(InViewModel.IsValid());
+
+	const UBlueprint* Blueprint = InViewModel->GetSelectedBlueprint().Get();
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	using EDependency = EMGAHeaderViewItemDependency;
+
+	// Add the copyright notice
+	InAddItem(EDependency::None, [] { return FMGAHeaderViewCopyrightListItem::Create(); });
+
+	// Add the include directives
+	InAddItem(EDependency::ClassName | EDependency::ParentClass, [InViewModel] { return FMGAHeaderViewIncludesListItem::Create(InViewModel); });
+
+	// Add the attribute accessors macro
+	InAddItem(EDependency::None, [] { return FMGAHeaderViewAttributesAccessorsListItem::Create(); });
+
+	// Add the class declaration
+	InAddItem(EDependency::ClassName | EDependency::ParentClass | EDependency::ClassLocation | EDependency::Module, [InViewModel]
+	{
+		return FMGAHeaderViewClassListItem::Create(InViewModel);
+	});
+
+	AddHeaderVariableItems(InViewModel, FMGAHeaderViewListItem::GetAllProperties(Blueprint->GeneratedClass), InAddItem);
+
+	// Add the constructor declaration
+	InAddItem(EDependency::ClassName, [InViewModel] { return FMGAHeaderViewConstructorListItem::Create(InViewModel); });
+
+	// Add the GetLifetimeReplicatedProp
+	const TArray<const FProperty*> ReplicatedProps = FMGAHeaderViewListItem::GetAllProperties(Blueprint->GeneratedClass, true);
+	if (!ReplicatedProps.IsEmpty())
+	{
+		InAddItem(EDependency::ClassName, [InViewModel] { return FMGAHeaderViewGetLifetimeListItem::Create(InViewModel); });
+		AddHeaderOnRepFunctionItems(InViewModel, ReplicatedProps, InAddItem);
+	}
+
+	// Add the closing brace of the class
+	InAddItem(EDependency::None, MGA::CodeGenerator::MakeTextItemFactory(TEXT("};"), TEXT("};")));
+}
+
+void FMGAAttributeSetCodeGenerator::BuildSourceItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const FAddItem InAddItem)
+{
+	check(InViewModel.IsValid());
+
+	const UBlueprint* Blueprint = InViewModel->GetSelectedBlueprint().Get();
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	using EDependency = EMGAHeaderViewItemDependency;
+
+	// Add the copyright notice
+	InAddItem(EDependency::None, [] { return FMGAHeaderViewCopyrightListItem::Create(); });
+
+	// Add the include directives
+	InAddItem(EDependency::ClassName | EDependency::ClassLocation | EDependency::ClassPath, [InViewModel]
+	{
+		return FMGASourceViewIncludesListItem::Create(InViewModel);
+	});
+
+	// Add the constructor implementation
+	InAddItem(EDependency::ClassName | EDependency::ParentClass, [InViewModel] { return FMGASourceViewConstructorListItem::Create(InViewModel); });
+
+	// Add the GetLifetimeReplicatedProp implementation
+	const TArray<const FProperty*> ReplicatedProps = FMGAHeaderViewListItem::GetAllProperties(Blueprint->GeneratedClass, true);
+	if (!ReplicatedProps.IsEmpty())
+	{
+		InAddItem(EDependency::ClassName | EDependency::ParentClass, [InViewModel] { return FMGASourceViewGetLifetimeListItem::Create(InViewModel); });
+	}
+	AddSourceOnRepFunctionItems(InViewModel, ReplicatedProps, InAddItem);
+}
+
+FString FMGAAttributeSetCodeGenerator::GenerateHeaderContent(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel)
+{
+	return JoinItems(BuildItems([&InViewModel](const FAddItem InAddItem)
+	{
+		BuildHeaderItems(InViewModel, InAddItem);
+	}));
+}
+
+FString FMGAAttributeSetCodeGenerator::GenerateSourceContent(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel)
+{
+	return JoinItems(BuildItems([&InViewModel](const FAddItem InAddItem)
+	{
+		BuildSourceItems(InViewModel, InAddItem);
+	}));
+}
+
+FString FMGAAttributeSetCodeGenerator::JoinItems(const TArray<FMGAHeaderViewListItemPtr>& InItems, const bool bInRichText)
+{
+	TArray<FString> LineItemsContent;
+	Algo::Transform(InItems, LineItemsContent, [bInRichText](const FMGAHeaderViewListItemPtr& Item)
+	{
+		return bInRichText ? Item->GetRichItemString() : Item->GetRawItemString();
+	});
+
+	FString Content = FString::Join(LineItemsContent, TEXT("\n"));
+	MGA::String::ToHostLineEndingsInline(Content);
+	return Content;
+}
+
+TArray<FMGAHeaderViewListItemPtr> FMGAAttributeSetCodeGenerator::BuildItems(const TFunctionRef<void(FAddItem)> InBuild)
+{
+	TArray<FMGAHeaderViewListItemPtr> Items;
+	InBuild([&Items](EMGAHeaderViewItemDependency, TFunction<FMGAHeaderViewListItemPtr()>&& InFactory)
+	{
+		if (FMGAHeaderViewListItemPtr Item = InFactory())
+		{
+			Items.Add(MoveTemp(Item));
+		}
+	});
+
+	return Items;
+}
+
+void FMGAAttributeSetCodeGenerator::AddHeaderVariableItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const TArray<const FProperty*>& InVarProperties, const FAddItem InAddItem)
+{
+	// We should only add an access specifier line if the previous variable was a different one
+	int32 PrevAccessSpecifier = 0;
+	for (const FProperty* VarProperty : InVarProperties)
+	{
+		constexpr int32 Private = 2;
+		constexpr int32 Public = 1;
+		const int32 AccessSpecifier = VarProperty->GetBoolMetaData(FBlueprintMetadata::MD_Private) ? Private : Public;
+		if (AccessSpecifier != PrevAccessSpecifier)
+		{
+			switch (AccessSpecifier)
+			{
+			case Public:
+				InAddItem(EMGAHeaderViewItemDependency::None, MGA::CodeGenerator::MakeAccessSpecifierItemFactory(TEXT("public")));
+				break;
+			case Private:
+				InAddItem(EMGAHeaderViewItemDependency::None, MGA::CodeGenerator::MakeAccessSpecifierItemFactory(TEXT("private")));
+				break;
+			default:
+				break;
+			}
+
+			PrevAccessSpecifier = AccessSpecifier;
+		}
+		else
+		{
+			// add an empty line to space variables out
+			InAddItem(EMGAHeaderViewItemDependency::None, MGA::CodeGenerator::MakeTextItemFactory(TEXT(""), TEXT("")));
+		}
+
+		if (FMGAUtilities::IsValidCPPType(VarProperty->GetCPPType()))
+		{
+			InAddItem(EMGAHeaderViewItemDependency::ClassName | EMGAHeaderViewItemDependency::ParentClass, MGA::CodeGenerator::MakePropertyItemFactory(VarProperty, [InViewModel](const FProperty& InProperty)
+			{
+				return FMGAHeaderViewAttributeVariableListItem::Create(InProperty, InViewModel);
+			}));
+		}
+		else
+		{
+			InAddItem(EMGAHeaderViewItemDependency::ClassName, MGA::CodeGenerator::MakePropertyItemFactory(VarProperty, [InViewModel](const FProperty& InProperty)
+			{
+				return FMGAHeaderViewVariableListItem::Create(InProperty, InViewModel);
+			}));
+		}
+	}
+}
+
+void FMGAAttributeSetCodeGenerator::AddHeaderOnRepFunctionItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const TArray<const FProperty*>& InReplicatedProps, const FAddItem InAddItem)
+{
+	// Check if we have at least one item with repnotify to add a definition for, and prevent adding a protected access with no items
+	if (InReplicatedProps.ContainsByPredicate(&NeedsOnRepFunction))
+	{
+		InAddItem(EMGAHeaderViewItemDependency::None, MGA::CodeGenerator::MakeAccessSpecifierItemFactory(TEXT("protected")));
+	}
+
+	for (const FProperty* VarProperty : InReplicatedProps)
+	{
+		if (NeedsOnRepFunction(VarProperty))
+		{
+			InAddItem(EMGAHeaderViewItemDependency::ParentClass, MGA::CodeGenerator::MakePropertyItemFactory(VarProperty, [InViewModel](const FProperty& InProperty)
+			{
+				return FMGAHeaderViewOnRepListItem::Create(InViewModel, InProperty);
+			}));
+		}
+	}
+}
+
+void FMGAAttributeSetCodeGenerator::AddSourceOnRepFunctionItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const TArray<const FProperty*>& InReplicatedProps, const FAddItem InAddItem)
+{
+	for (const FProperty* VarProperty : InReplicatedProps)
+	{
+		if (NeedsOnRepFunction(VarProperty))
+		{
+			InAddItem(EMGAHeaderViewItemDependency::ClassName | EMGAHeaderViewItemDependency::ParentClass, MGA::CodeGenerator::MakePropertyItemFactory(VarProperty, [InViewModel](const FProperty& InProperty)
+			{
+				return FMGASourceViewOnRepListItem::Create(InViewModel, InProperty);
+			}));
+		}
+	}
+}
+
+bool FMGAAttributeSetCodeGenerator::NeedsOnRepFunction(const FProperty* InProperty)
+{
+	if (!InProperty)
+	{
+		return false;
+	}
+
+	return FMGAUtilities::IsValidCPPType(InProperty->GetCPPType()) || (InProperty->HasAnyPropertyFlags(CPF_Net) && InProperty->HasAnyPropertyFlags(CPF_RepNotify));
+}
@@ -82,6 +82,67 @@ namespace
 	};
 }
 
+// FMGAHeaderViewDeferredListItem ///////////////////////////////////////////////
+
+namespace
+{
+	/** List item forwarding to the item built by its factory, built on first access */
+	struct FMGAHeaderViewDeferredListItem : public FMGAHeaderViewListItem
+	{
+		explicit FMGAHeaderViewDeferredListItem(TFunction<TSharedPtr<FMGAHeaderViewListItem>()>&& InFactory)
+			: Factory(MoveTemp(InFactory))
+		{
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForItem() const override
+		{
+			return GetItem().GenerateWidgetForItem();
+		}
+
+		virtual const FString& GetRawItemString() const override
+		{
+			return GetItem().GetRawItemString();
+		}
+
+		virtual const FString& GetRichItemString() const override
+		{
+			return GetItem().GetRichItemString();
+		}
+
+		virtual void ExtendContextMenu(FMenuBuilder& InMenuBuilder, const TWeakObjectPtr<UObject> InAsset) override
+		{
+			GetItem().ExtendContextMenu(InMenuBuilder, InAsset);
+		}
+
+		virtual void OnMouseButtonDoubleClick(const TWeakObjectPtr<UObject> InAsset) override
+		{
+			GetItem().OnMouseButtonDoubleClick(InAsset);
+		}
+
+	private:
+		FMGAHeaderViewListItem& GetItem() const
+		{
+			if (!Item.IsValid())
+			{
+				Item = Factory ? Factory() : nullptr;
+				Factory.Reset();
+
+				if (!Item.IsValid())
+				{
+					Item = Create(FString(), FString());
+				}
+			}
+
+			return *Item;
+		}
+
+		mutable TFunction<TSharedPtr<FMGAHeaderViewListItem>()> Factory;
+
+		/** Item built by Factory, once accessed */
+		mutable TSharedPtr<FMGAHeaderViewListItem> Item;
+	};
+}
+
 // FMGAHeaderViewListItem ///////////////////////////////////////////////////////
 
 const FText FMGAHeaderViewListItem::InvalidCPPIdentifierErrorText = LOCTEXT("CPPIdentifierError", "Name is not a valid C++ Identifier");
@@ -114,6 +175,11 @@ TSharedPtr<FMGAHeaderViewListItem> FMGAHeaderViewListItem::Create(FString InRawS
 	return MakeShareable(new FMGAHeaderViewListItem(MoveTemp(InRawString), MoveTemp(InRichText)));
 }
 
+TSharedPtr<FMGAHeaderViewListItem> FMGAHeaderViewListItem::CreateDeferred(TFunction<TSharedPtr<FMGAHeaderViewListItem>()>&& InFactory)
+{
+	return MakeShareable(new FMGAHeaderViewDeferredListItem(MoveTemp(InFactory)));
+}
+
 FMGAHeaderViewListItem::FMGAHeaderViewListItem(FString&& InRawString, FString&& InRichText)
 	: RichTextString(MoveTemp(InRichText))
 	, RawItemString(MoveTemp(InRawString))
@@ -122,27 +188,43 @@ FMGAHeaderViewListItem::FMGAHeaderViewListItem(FString&& InRawString, FString&&
 
 TArray<const FProperty*> FMGAHeaderViewListItem::GetAllProperties(const UStruct* InStruct, const bool bInFilterReplicated)
 {
+	// Parent Blueprint classes first, so that inherited attributes come before the ones they are a parent of
+	TArray<const UStruct*> Structs;
+	for (const UStruct* Struct = InStruct; Struct; Struct = Struct->GetSuperStruct())
+	{
+		const UClass* Class = Cast<UClass>(Struct);
+		if (Class && Class->HasAnyClassFlags(CLASS_Native))
+		{
+			break;
+		}
+
+		Structs.Insert(Struct, 0);
+	}
+
 	TArray<const FProperty*> VarProperties;
-	for (TFieldIterator<FProperty> PropertyIt(InStruct, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
+	for (const UStruct* Struct : Structs)
 	{
-		if (FProperty* VarProperty = *PropertyIt)
+		for (TFieldIterator<FProperty> PropertyIt(Struct, EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
 		{
-			if (!VarProperty || !VarProperty->HasAnyPropertyFlags(CPF_BlueprintVisible))
+			if (FProperty* VarProperty = *PropertyIt)
 			{
-				continue;
-			}
+				if (!VarProperty || !VarProperty->HasAnyPropertyFlags(CPF_BlueprintVisible))
+				{
+					continue;
+				}
 
-			if (bInFilterReplicated)
-			{
-				if (VarProperty->HasAnyPropertyFlags(CPF_Net))
+				if (bInFilterReplicated)
+				{
+					if (VarProperty->HasAnyPropertyFlags(CPF_Net))
+					{
+						VarProperties.Add(VarProperty);
+					}
+				}
+				else
 				{
 					VarProperties.Add(VarProperty);
 				}
 			}
-			else
-			{
-				VarProperties.Add(VarProperty);
-			}
 		}
 	}
 
@@ -9,6 +9,7 @@
 #include "ISourceControlProvider.h"
 #include "SourceCodeNavigation.h"
 #include "SourceControlOperations.h"
+#include "HAL/FileManager.h"
 #include "Misc/App.h"
 #include "Misc/FileHelper.h"
 #include "Misc/MessageDialog.h"
@@ -34,45 +35,17 @@ GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::AddClassToProject(
 	FText& OutErrorText
 )
 {
-	const TSet<FString> DisallowedHeaderNames;
-	if (!GameProjectUtils::IsValidClassNameForCreation(InNewClassName, InModuleInfo, DisallowedHeaderNames, OutErrorText))
-	{
-		return GameProjectUtils::EAddCodeToProjectResult::InvalidInput;
-	}
-
-	if (!FApp::HasProjectName())
-	{
-		OutErrorText = LOCTEXT("AddCodeToProject_NoGameName", "You can not add code because you have not loaded a project.");
-		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
-	}
-
-	FString NewCppPath;
-	FString NewHeaderPath;
-	if (!GameProjectUtils::CalculateSourcePaths(InNewClassPath, InModuleInfo, NewHeaderPath, NewCppPath, &OutErrorText))
+	FMGAScaffoldClassFiles ClassFiles;
+	ClassFiles.ClassName = InNewClassName;
+	ClassFiles.ClassPath = InNewClassPath;
+	ClassFiles.HeaderDestination = InHeaderDestination;
+	ClassFiles.SourceDestination = InSourceDestination;
+	ClassFiles.ModuleInfo = InModuleInfo;
+
+	const GameProjectUtils::EAddCodeToProjectResult ValidationResult = ValidateClassFiles(ClassFiles, OutErrorText);
+	if (ValidationResult != GameProjectUtils::EAddCodeToProjectResult::Succeeded)
 	{
-		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
-	}
-
-	if (!InHeaderDestination.StartsWith(NewHeaderPath))
-	{
-		OutErrorText = FText::Format(
-			LOCTEXT("HeaderPathMismatched", "NewHeaderPath returned by GameProjectUtils::CalculateSourcePaths is different than provided destination\n\t HeaderPath: {0}\n\t Destination: {1}"),
-			FText::FromString(NewHeaderPath),
-			FText::FromString(InHeaderDestination)
-		);
-
-		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
-	}
-
-	if (!InSourceDestination.StartsWith(NewCppPath))
-	{
-		OutErrorText = FText::Format(
-			LOCTEXT("HeaderPathMismatched", "NewCppPath returned by GameProjectUtils::CalculateSourcePaths is different than provided destination\n\t CppPath: {0}\n\t Destination: {1}"),
-			FText::FromString(NewCppPath),
-			FText::FromString(InSourceDestination)
-		);
-
-		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
+		return ValidationResult;
 	}
 
 	FScopedSlowTask SlowTask(5.f, LOCTEXT("AddingCodeToProject", "Adding code to project..."));
@@ -114,39 +87,10 @@ GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::AddClassToProject(
 
 
 	const bool bProjectHadCodeFiles = GameProjectUtils::ProjectHasCodeFiles();
-	bool bGenerateProjectFiles = true;
-
-	TArray<FString> CreatedFilesForExternalAppRead;
-	CreatedFilesForExternalAppRead.Reserve(CreatedFiles.Num());
-	for (const FString& CreatedFile : CreatedFiles)
-	{
-		CreatedFilesForExternalAppRead.Add(IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*CreatedFile));
-	}
-
-	// First see if we can avoid a full generation by adding the new files to an already open project
-	if (bProjectHadCodeFiles && FSourceCodeNavigation::AddSourceFiles(CreatedFilesForExternalAppRead))
+	const GameProjectUtils::EAddCodeToProjectResult AddFilesResult = AddCreatedFilesToProject(CreatedFiles, bProjectHadCodeFiles, OutErrorText);
+	if (AddFilesResult != GameProjectUtils::EAddCodeToProjectResult::Succeeded)
 	{
-		// We managed the gather, so we can skip running the full generate
-		bGenerateProjectFiles = false;
-	}
-
-	if (bGenerateProjectFiles)
-	{
-		// Generate project files if we happen to be using a project file.
-		if (!FDesktopPlatformModule::Get()->GenerateProjectFiles(FPaths::RootDir(), FPaths::GetProjectFilePath(), GWarn))
-		{
-			OutErrorText = LOCTEXT("FailedToGenerateProjectFiles", "Failed to generate project files.");
-			return GameProjectUtils::EAddCodeToProjectResult::FailedToHotReload;
-		}
-	}
-
-	SlowTask.EnterProgressFrame(1.0f, LOCTEXT("CompilingCPlusPlusCode", "Compiling new C++ code. Please wait..."));
-
-	// Mark the files for add in SCC
-	ISourceControlProvider& SourceControlProvider = ISourceControlModule::Get().GetProvider();
-	if (ISourceControlModule::Get().IsEnabled() && SourceControlProvider.IsAvailable())
-	{
-		SourceControlProvider.Execute(ISourceControlOperation::Create<FMarkForAdd>(), CreatedFilesForExternalAppRead);
+		return AddFilesResult;
 	}
 
 	SlowTask.EnterProgressFrame(1.0f, LOCTEXT("CompilingCPlusPlusCode", "Compiling new C++ code. Please wait..."));
@@ -183,6 +127,138 @@ GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::AddClassToProject(
 	return GameProjectUtils::EAddCodeToProjectResult::Succeeded;
 }
 
+GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::AddClassesToProject(const TArray<FMGAScaffoldClassFiles>& InClassesFiles, TArray<FString>& OutCreatedFiles, FText& OutErrorText)
+{
+	if (InClassesFiles.IsEmpty())
+	{
+		return GameProjectUtils::EAddCodeToProjectResult::Succeeded;
+	}
+
+	// Validate the whole batch before writing anything
+	TSet<FString> ClassNames;
+	for (const FMGAScaffoldClassFiles& ClassFiles : InClassesFiles)
+	{
+		bool bAlreadyInBatch = false;
+		ClassNames.Add(ClassFiles.ClassName, &bAlreadyInBatch);
+		if (bAlreadyInBatch)
+		{
+			OutErrorText = FText::Format(LOCTEXT("AddClassesToProject_DuplicateClassName", "Class {0} is generated more than once."), FText::FromString(ClassFiles.ClassName));
+			return GameProjectUtils::EAddCodeToProjectResult::InvalidInput;
+		}
+
+		const GameProjectUtils::EAddCodeToProjectResult Result = ValidateClassFiles(ClassFiles, OutErrorText);
+		if (Result != GameProjectUtils::EAddCodeToProjectResult::Succeeded)
+		{
+			return Result;
+		}
+
+		// Existing files couldn't be restored if the batch fails half way
+		for (const FString& Destination : { ClassFiles.HeaderDestination, ClassFiles.SourceDestination })
+		{
+			if (IFileManager::Get().FileExists(*Destination))
+			{
+				OutErrorText = FText::Format(LOCTEXT("AddClassesToProject_FileExists", "{0} already exists."), FText::FromString(Destination));
+				return GameProjectUtils::EAddCodeToProjectResult::InvalidInput;
+			}
+		}
+	}
+
+	FScopedSlowTask SlowTask(InClassesFiles.Num() + 1, LOCTEXT("AddingCodeToProject", "Adding code to project..."));
+
+	TArray<FString> CreatedFiles;
+	CreatedFiles.Reserve(InClassesFiles.Num() * 2);
+
+	const auto AddFile = [&CreatedFiles, &OutErrorText](const FString& InDestination, const FString& InContent)
+	{
+		const GameProjectUtils::EAddCodeToProjectResult Result = AddCodeFileToProject(InDestination, InContent, OutErrorText);
+		if (Result != GameProjectUtils::EAddCodeToProjectResult::Succeeded)
+		{
+			// Don't leave part of the batch behind, none of the files existed before
+			for (const FString& CreatedFile : CreatedFiles)
+			{
+				IFileManager::Get().Delete(*CreatedFile, false, false, true);
+			}
+
+			return Result;
+		}
+
+		CreatedFiles.Add(InDestination);
+		return Result;
+	};
+
+	for (const FMGAScaffoldClassFiles& ClassFiles : InClassesFiles)
+	{
+		SlowTask.EnterProgressFrame(1.f);
+
+		// Class Header File
+		GameProjectUtils::EAddCodeToProjectResult Result = AddFile(ClassFiles.HeaderDestination, ClassFiles.HeaderContent);
+		if (Result != GameProjectUtils::EAddCodeToProjectResult::Succeeded)
+		{
+			return Result;
+		}
+
+		// Class CPP file
+		Result = AddFile(ClassFiles.SourceDestination, ClassFiles.SourceContent);
+		if (Result != GameProjectUtils::EAddCodeToProjectResult::Succeeded)
+		{
+			return Result;
+		}
+	}
+
+	OutCreatedFiles.Append(CreatedFiles);
+
+	SlowTask.EnterProgressFrame(1.f);
+
+	// Project files are updated once for the whole batch, rather than once per class
+	return AddCreatedFilesToProject(OutCreatedFiles, GameProjectUtils::ProjectHasCodeFiles(), OutErrorText);
+}
+
+GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::ValidateClassFiles(const FMGAScaffoldClassFiles& InClassFiles, FText& OutErrorText)
+{
+	const TSet<FString> DisallowedHeaderNames;
+	if (!GameProjectUtils::IsValidClassNameForCreation(InClassFiles.ClassName, InClassFiles.ModuleInfo, DisallowedHeaderNames, OutErrorText))
+	{
+		return GameProjectUtils::EAddCodeToProjectResult::InvalidInput;
+	}
+
+	if (!FApp::HasProjectName())
+	{
+		OutErrorText = LOCTEXT("AddCodeToProject_NoGameName", "You can not add code because you have not loaded a project.");
+		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
+	}
+
+	FString NewCppPath;
+	FString NewHeaderPath;
+	if (!GameProjectUtils::CalculateSourcePaths(InClassFiles.ClassPath, InClassFiles.ModuleInfo, NewHeaderPath, NewCppPath, &OutErrorText))
+	{
+		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
+	}
+
+	if (!InClassFiles.HeaderDestination.StartsWith(NewHeaderPath))
+	{
+		OutErrorText = FText::Format(
+			LOCTEXT("HeaderPathMismatched", "NewHeaderPath returned by GameProjectUtils::CalculateSourcePaths is different than provided destination\n\t HeaderPath: {0}\n\t Destination: {1}"),
+			FText::FromString(NewHeaderPath),
+			FText::FromString(InClassFiles.HeaderDestination)
+		);
+
+		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
+	}
+
+	if (!InClassFiles.SourceDestination.StartsWith(NewCppPath))
+	{
+		OutErrorText = FText::Format(
+			LOCTEXT("HeaderPathMismatched", "NewCppPath returned by GameProjectUtils::CalculateSourcePaths is different than provided destination\n\t CppPath: {0}\n\t Destination: {1}"),
+			FText::FromString(NewCppPath),
+			FText::FromString(InClassFiles.SourceDestination)
+		);
+
+		return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
+	}
+
+	return GameProjectUtils::EAddCodeToProjectResult::Succeeded;
+}
+
 GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::AddCodeFileToProject(const FString& InDestination, const FString& InContent, FText& OutErrorText)
 {
 	// Generate
@@ -194,6 +270,44 @@ GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::AddCodeFileToProjec
 	return GameProjectUtils::EAddCodeToProjectResult::FailedToAddCode;
 }
 
+GameProjectUtils::EAddCodeToProjectResult FMGAScaffoldUtils::AddCreatedFilesToProject(const TArray<FString>& InCreatedFiles, const bool bInProjectHadCodeFiles, FText& OutErrorText)
+{
+	bool bGenerateProjectFiles = true;
+
+	TArray<FString> CreatedFilesForExternalAppRead;
+	CreatedFilesForExternalAppRead.Reserve(InCreatedFiles.Num());
+	for (const FString& CreatedFile : InCreatedFiles)
+	{
+		CreatedFilesForExternalAppRead.Add(IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*CreatedFile));
+	}
+
+	// First see if we can avoid a full generation by adding the new files to an already open project
+	if (bInProjectHadCodeFiles && FSourceCodeNavigation::AddSourceFiles(CreatedFilesForExternalAppRead))
+	{
+		// We managed the gather, so we can skip running the full generate
+		bGenerateProjectFiles = false;
+	}
+
+	if (bGenerateProjectFiles)
+	{
+		// Generate project files if we happen to be using a project file.
+		if (!FDesktopPlatformModule::Get()->GenerateProjectFiles(FPaths::RootDir(), FPaths::GetProjectFilePath(), GWarn))
+		{
+			OutErrorText = LOCTEXT("FailedToGenerateProjectFiles", "Failed to generate project files.");
+			return GameProjectUtils::EAddCodeToProjectResult::FailedToHotReload;
+		}
+	}
+
+	// Mark the files for add in SCC
+	ISourceControlProvider& SourceControlProvider = ISourceControlModule::Get().GetProvider();
+	if (ISourceControlModule::Get().IsEnabled() && SourceControlProvider.IsAvailable())
+	{
+		SourceControlProvider.Execute(ISourceControlOperation::Create<FMarkForAdd>(), CreatedFilesForExternalAppRead);
+	}
+
+	return GameProjectUtils::EAddCodeToProjectResult::Succeeded;
+}
+
 bool FMGAScaffoldUtils::UpdateProjectFiles(FText& ErrorText)
 {
 	TArray<FString> CreatedFiles;
@@ -416,13 +530,9 @@ FString FMGAScaffoldUtils::GetModuleBuildCSFilePath(const FModuleContextInfo& In
 
 bool FMGAScaffoldUtils::DoesBuildCSFileContains(const FModuleContextInfo& InModuleContextInfo, const FString& InSearchPattern, FText& OutFailReason)
 {
-	const FString FileName = GetModuleBuildCSFilePath(InModuleContextInfo);
-
-	// Read the file to a string
 	FString FileContents;
-	if (!FFileHelper::LoadFileToString(FileContents, *FileName))
+	if (!LoadBuildCSFile(InModuleContextInfo, FileContents, OutFailReason))
 	{
-		OutFailReason = FText::FromString(FString::Printf(TEXT("Failed to open descriptor file %s"), *FileName));
 		return false;
 	}
 
@@ -431,20 +541,18 @@ bool FMGAScaffoldUtils::DoesBuildCSFileContains(const FModuleContextInfo& InModu
 
 bool FMGAScaffoldUtils::DoesBuildCSSatisfiesDependencies(const FModuleContextInfo& InModuleContextInfo, const TArray<FString>& InModuleDependencies, TArray<FString>& OutMissingModuleDependencies, FText& OutFailReason)
 {
+	// Read the file once for all dependencies
+	FString FileContents;
+	if (!LoadBuildCSFile(InModuleContextInfo, FileContents, OutFailReason))
+	{
+		return false;
+	}
+
 	TArray<FString> MissingModuleDependencies;
 	for (const FString& ModuleDependency : InModuleDependencies)
 	{
-		FText ErrorText;
 		const FString DependencySearchPattern = FString::Printf(TEXT("\"%s\""), *ModuleDependency);
-		const bool bHasDependency = DoesBuildCSFileContains(InModuleContextInfo, DependencySearchPattern, ErrorText);
-
-		if (!ErrorText.IsEmpty())
-		{
-			OutFailReason = ErrorText;
-			return false;
-		}
-		
-		if (!bHasDependency)
+		if (!FileContents.Contains(DependencySearchPattern))
 		{
 			MissingModuleDependencies.Add(ModuleDependency);
 		}
@@ -455,6 +563,84 @@ bool FMGAScaffoldUtils::DoesBuildCSSatisfiesDependencies(const FModuleContextInf
 	return bSatisfiesDependencies;
 }
 
+bool FMGAScaffoldUtils::AddBuildCSDependencies(const FModuleContextInfo& InModuleContextInfo, const TArray<FString>& InModuleDependencies, FText& OutFailReason)
+{
+	if (InModuleDependencies.IsEmpty())
+	{
+		return true;
+	}
+
+	FString FileContents;
+	if (!LoadBuildCSFile(InModuleContextInfo, FileContents, OutFailReason))
+	{
+		return false;
+	}
+
+	const FString FileName = GetModuleBuildCSFilePath(InModuleContextInfo);
+
+	// Dependencies are inserted right after the opening brace of "PublicDependencyModuleNames.AddRange(new string[] {"
+	const int32 AddRangeIndex = FileContents.Find(TEXT("PublicDependencyModuleNames.AddRange"), ESearchCase::CaseSensitive);
+	const int32 OpenBraceIndex = AddRangeIndex == INDEX_NONE ? INDEX_NONE : FileContents.Find(TEXT("{"), ESearchCase::CaseSensitive, ESearchDir::FromStart, AddRangeIndex);
+	if (OpenBraceIndex == INDEX_NONE)
+	{
+		OutFailReason = FText::Format(LOCTEXT("BuildCSNoPublicDependencies", "Failed to find PublicDependencyModuleNames.AddRange in {0}"), FText::FromString(FileName));
+		return false;
+	}
+
+	// Keep the list layout, either one dependency per line or all of them on the brace line (as in engine templates)
+	auto IsIndentation = [](const TCHAR Char) { return Char == TEXT(' ') || Char == TEXT('\t'); };
+	auto IsLineBreak = [](const TCHAR Char) { return Char == TEXT('\r') || Char == TEXT('\n'); };
+
+	int32 Index = OpenBraceIndex + 1;
+	while (Index < FileContents.Len() && IsIndentation(FileContents[Index]))
+	{
+		++Index;
+	}
+
+	const bool bMultiLine = Index < FileContents.Len() && IsLineBreak(FileContents[Index]);
+	const FString LineEnding = FileContents.Contains(TEXT("\r\n")) ? TEXT("\r\n") : TEXT("\n");
+
+	// Match the indentation of the line following the brace
+	FString Indentation;
+	if (bMultiLine)
+	{
+		while (Index < FileContents.Len() && IsLineBreak(FileContents[Index]))
+		{
+			++Index;
+		}
+
+		const int32 LineStartIndex = Index;
+		while (Index < FileContents.Len() && IsIndentation(FileContents[Index]))
+		{
+			++Index;
+		}
+
+		Indentation = FileContents.Mid(LineStartIndex, Index - LineStartIndex);
+		if (Index < FileContents.Len() && FileContents[Index] == TEXT('}'))
+		{
+			Indentation += TEXT("\t");
+		}
+	}
+
+	FString Insertion;
+	for (const FString& ModuleDependency : InModuleDependencies)
+	{
+		Insertion += bMultiLine
+			? FString::Printf(TEXT("%s%s\"%s\","), *LineEnding, *Indentation, *ModuleDependency)
+			: FString::Printf(TEXT(" \"%s\","), *ModuleDependency);
+	}
+
+	FileContents.InsertAt(OpenBraceIndex + 1, Insertion);
+
+	ISourceControlProvider& SourceControlProvider = ISourceControlModule::Get().GetProvider();
+	if (ISourceControlModule::Get().IsEnabled() && SourceControlProvider.IsAvailable())
+	{
+		SourceControlProvider.Execute(ISourceControlOperation::Create<FCheckOut>(), IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*FileName));
+	}
+
+	return GameProjectUtils::WriteOutputFile(FileName, FileContents, OutFailReason);
+}
+
 FString FMGAScaffoldUtils::GetContainingModuleName(const UStruct* InStruct)
 {
 	check(InStruct);
@@ -467,4 +653,18 @@ FString FMGAScaffoldUtils::GetContainingModuleName(const UStruct* InStruct)
 	return PackageName;
 }
 
+bool FMGAScaffoldUtils::LoadBuildCSFile(const FModuleContextInfo& InModuleContextInfo, FString& OutFileContents, FText& OutFailReason)
+{
+	const FString FileName = GetModuleBuildCSFilePath(InModuleContextInfo);
+
+	// Read the file to a string
+	if (!FFileHelper::LoadFileToString(OutFileContents, *FileName))
+	{
+		OutFailReason = FText::FromString(FString::Printf(TEXT("Failed to open descriptor file %s"), *FileName));
+		return false;
+	}
+
+	return true;
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -3,8 +3,10 @@
 #include "Models/MGAAttributeSetWizardViewModel.h"
 
 #include "AttributeSet.h"
+#include "MGAHeaderViewListItem.h"
 #include "MGAScaffoldUtils.h"
 #include "SourceCodeNavigation.h"
+#include "Engine/Blueprint.h"
 #include "Framework/Application/SlateApplication.h"
 
 TArray<FMGARequiredModuleDependency> FMGAAttributeSetWizardViewModel::ReservedModuleDependencies = {
@@ -46,7 +48,7 @@ void FMGAAttributeSetWizardViewModel::Initialize()
 {
 }
 
-void FMGAAttributeSetWizardViewModel::UpdateInputValidity()
+void FMGAAttributeSetWizardViewModel::UpdateInputValidity(const bool bInCheckModuleDependencies)
 {
 	bLastInputValidityCheckSuccessful = true;
 
@@ -145,7 +147,7 @@ void FMGAAttributeSetWizardViewModel::UpdateInputValidity()
 			}
 		}
 
-		if (bLastInputValidityCheckSuccessful && !MissingModuleDependencies.IsEmpty())
+		if (bInCheckModuleDependencies && bLastInputValidityCheckSuccessful && !MissingModuleDependencies.IsEmpty())
 		{
 			const FString Separator = TEXT("\n- ");
 			auto JoinByPredicate = [](const FMGARequiredModuleDependency& Item)
@@ -184,7 +186,8 @@ void FMGAAttributeSetWizardViewModel::UpdateInputValidity()
 		SetbSatisfiesModuleDependencies(MissingModuleDependencies.IsEmpty());
 	}
 
-	LastPeriodicValidityCheckTime = FSlateApplication::Get().GetCurrentTime();
+	// Slate isn't initialized when running from a commandlet
+	LastPeriodicValidityCheckTime = FSlateApplication::IsInitialized() ? FSlateApplication::Get().GetCurrentTime() : FPlatformTime::Seconds();
 
 	// Since this function was invoked, periodic validity checks should be re-enabled if they were disabled.
 	bPreventPeriodicValidityChecksUntilNextChange = false;
@@ -233,4 +236,21 @@ void FMGAAttributeSetWizardViewModel::ResetRequiredModuleDependencies()
 	RequiredModuleDependencies.Append(ReservedModuleDependencies);
 }
 
+void FMGAAttributeSetWizardViewModel::UpdateRequiredModuleDependencies()
+{
+	ResetRequiredModuleDependencies();
+
+	const FString ParentClassModuleName = FMGAScaffoldUtils::GetContainingModuleName(ParentClassInfo.BaseClass);
+	AddRequiredModuleDependency(ParentClassModuleName, LOCTEXT("RequiredParentClassModule", "Parent Class"));
+
+	if (SelectedBlueprint.IsValid())
+	{
+		const bool bHasClampedProperties = FMGAHeaderViewListItem::IsUsingClampedAttributeData(SelectedBlueprint->SkeletonGeneratedClass);
+		if (bHasClampedProperties)
+		{
+			AddRequiredModuleDependency(TEXT("ModularGameplayAbilities"), LOCTEXT("RequiredClampedStructModule", "Using FMGAClampedAttributeData struct"));
+		}
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
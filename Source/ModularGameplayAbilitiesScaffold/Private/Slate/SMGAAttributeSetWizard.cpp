@@ -213,12 +213,8 @@ void SMGAAttributeSetWizard::CloseContainingWindow()
 
 FString SMGAAttributeSetWizard::GetBlueprintName(const FAssetData& InAssetData)
 {
-	if (const UBlueprint* Blueprint = Cast<UBlueprint>(InAssetData.GetAsset()))
-	{
-		return Blueprint->GetName();
-	}
-
-	return TEXT("");
+	// Asset name is the Blueprint name, no need to load it
+	return InAssetData.IsValid() ? InAssetData.AssetName.ToString() : TEXT("");
 }
 
 EVisibility SMGAAttributeSetWizard::GetGlobalErrorLabelVisibility() const
@@ -268,24 +264,7 @@ void SMGAAttributeSetWizard::UpdateRequiredModuleDependenciesIfNeeded() const
 {
 	check(ViewModel.IsValid());
 
-	ViewModel->ResetRequiredModuleDependencies();
-
-	const FNewClassInfo ParentClassInfo = ViewModel->GetParentClassInfo();
-	TSharedPtr<FModuleContextInfo> ModuleContextInfo = ViewModel->GetSelectedModuleInfo();
-	const TWeakObjectPtr<UBlueprint> Blueprint = ViewModel->GetSelectedBlueprint();
-	const FString ParentClassModuleName = FMGAScaffoldUtils::GetContainingModuleName(ParentClassInfo.BaseClass);
-
-	ViewModel->AddRequiredModuleDependency(ParentClassModuleName, LOCTEXT("RequiredParentClassModule", "Parent Class"));
-
-	if (Blueprint.IsValid())
-	{
-		const bool bHasClampedProperties = FMGAHeaderViewListItem::IsUsingClampedAttributeData(Blueprint->SkeletonGeneratedClass);
-		if (bHasClampedProperties)
-		{
-			ViewModel->AddRequiredModuleDependency(TEXT("ModularGameplayAbilities"), LOCTEXT("RequiredClampedStructModule", "Using FMGAClampedAttributeData struct"));
-		}
-	}
-	
+	ViewModel->UpdateRequiredModuleDependencies();
 	ViewModel->UpdateInputValidity();	
 }
 
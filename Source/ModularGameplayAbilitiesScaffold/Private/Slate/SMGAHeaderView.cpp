@@ -17,26 +17,11 @@
 #include "Framework/Commands/GenericCommands.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "HAL/PlatformApplicationMisc.h"
-#include "HeaderView/MGAHeaderViewClassListItem.h"
 #include "HeaderView/MGAHeaderViewFunctionListItem.h"
-#include "HeaderView/MGAHeaderViewVariableListItem.h"
-#include "HeaderView/Attributes/MGAHeaderViewAttributeAccessorsListItem.h"
-#include "HeaderView/Attributes/MGAHeaderViewAttributeVariableListItem.h"
-#include "HeaderView/Attributes/MGAHeaderViewConstructorListItem.h"
-#include "HeaderView/Attributes/MGAHeaderViewCopyrightListItem.h"
-#include "HeaderView/Attributes/MGAHeaderViewGetLifetimeListItem.h"
-#include "HeaderView/Attributes/MGAHeaderViewIncludesListItem.h"
-#include "HeaderView/Attributes/MGAHeaderViewOnRepListItem.h"
-#include "LineEndings/MGALineEndings.h"
 #include "Misc/EngineVersionComparison.h"
 #include "Models/MGAAttributeSetWizardViewModel.h"
-#include "SourceView/MGASourceViewConstructorListItem.h"
-#include "SourceView/MGASourceViewGetLifetimeListItem.h"
-#include "SourceView/MGASourceViewIncludesListItem.h"
-#include "SourceView/MGASourceViewOnRepListItem.h"
 #include "Styling/StyleColors.h"
 #include "Subsystems/AssetEditorSubsystem.h"
-#include "Utilities/MGAUtilities.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SComboButton.h"
 #include "Widgets/Input/SSegmentedControl.h"
@@ -301,10 +286,114 @@ void SMGAHeaderView::NotifyPostChange(const FPropertyChangedEvent& PropertyChang
 	RepopulateListView();
 }
 
-// ReSharper disable once CppParameterNeverUsed
 void SMGAHeaderView::HandleModelPropertyChanged(const FString& InPropertyName)
 {
-	RepopulateListView();
+	EMGAHeaderViewItemDependency Dependency = EMGAHeaderViewItemDependency::None;
+	if (!GetItemDependencyForModelProperty(InPropertyName, Dependency))
+	{
+		RepopulateListView();
+		return;
+	}
+
+	MGA_SCAFFOLD_LOG(VeryVerbose, TEXT("SMGAHeaderView::HandleModelPropertyChanged - %s, Dependency: %d"), *InPropertyName, static_cast<int32>(Dependency))
+	if (Dependency == EMGAHeaderViewItemDependency::None)
+	{
+		return;
+	}
+
+	if (HeaderListView.IsValid())
+	{
+		RefreshListItems(*HeaderListView, HeaderListItems, HeaderListItemSlots, Dependency);
+	}
+
+	if (SourceListView.IsValid())
+	{
+		RefreshListItems(*SourceListView, SourceListItems, SourceListItemSlots, Dependency);
+	}
+}
+
+bool SMGAHeaderView::GetItemDependencyForModelProperty(const FString& InPropertyName, EMGAHeaderViewItemDependency& OutDependency)
+{
+	static const TMap<FString, EMGAHeaderViewItemDependency> Dependencies = {
+		{ TEXT("NewClassName"), EMGAHeaderViewItemDependency::ClassName },
+		{ TEXT("ParentClassInfo"), EMGAHeaderViewItemDependency::ParentClass },
+		{ TEXT("ClassLocation"), EMGAHeaderViewItemDependency::ClassLocation },
+		{ TEXT("SelectedModuleInfo"), EMGAHeaderViewItemDependency::Module },
+		{ TEXT("SelectedClassPath"), EMGAHeaderViewItemDependency::ClassPath },
+
+		// Not part of the previewed content
+		{ TEXT("CurrentPreviewValue"), EMGAHeaderViewItemDependency::None },
+		{ TEXT("NewClassPath"), EMGAHeaderViewItemDependency::None },
+		{ TEXT("CalculatedClassHeaderName"), EMGAHeaderViewItemDependency::None },
+		{ TEXT("CalculatedClassSourceName"), EMGAHeaderViewItemDependency::None },
+		{ TEXT("RequiredModuleDependencies"), EMGAHeaderViewItemDependency::None },
+		{ TEXT("MissingModuleDependencies"), EMGAHeaderViewItemDependency::None },
+		{ TEXT("bSatisfiesModuleDependencies"), EMGAHeaderViewItemDependency::None }
+	};
+
+	// Anything else (eg. SelectedBlueprint) changes which items are listed
+	if (const EMGAHeaderViewItemDependency* Dependency = Dependencies.Find(InPropertyName))
+	{
+		OutDependency = *Dependency;
+		return true;
+	}
+
+	return false;
+}
+
+void SMGAHeaderView::AddHeaderItem(const EMGAHeaderViewItemDependency InDependencies, TFunction<FMGAHeaderViewListItemPtr()>&& InFactory)
+{
+	HeaderListItems.Add(FMGAHeaderViewListItem::CreateDeferred(CopyTemp(InFactory)));
+
+	FListItemSlot& Slot = HeaderListItemSlots.AddDefaulted_GetRef();
+	Slot.Dependencies = InDependencies;
+	Slot.Factory = MoveTemp(InFactory);
+}
+
+void SMGAHeaderView::AddSourceItem(const EMGAHeaderViewItemDependency InDependencies, TFunction<FMGAHeaderViewListItemPtr()>&& InFactory)
+{
+	SourceListItems.Add(FMGAHeaderViewListItem::CreateDeferred(CopyTemp(InFactory)));
+
+	FListItemSlot& Slot = SourceListItemSlots.AddDefaulted_GetRef();
+	Slot.Dependencies = InDependencies;
+	Slot.Factory = MoveTemp(InFactory);
+}
+
+void SMGAHeaderView::AddHeaderItem(const FMGAHeaderViewListItemPtr& InItem)
+{
+	HeaderListItems.Add(InItem);
+	HeaderListItemSlots.AddDefaulted();
+}
+
+void SMGAHeaderView::RefreshListItems(SListView<FMGAHeaderViewListItemPtr>& InListView, TArray<FMGAHeaderViewListItemPtr>& InListItems, const TArray<FListItemSlot>& InSlots, const EMGAHeaderViewItemDependency InDependency)
+{
+	check(InListItems.Num() == InSlots.Num());
+
+	int32 NumRefreshed = 0;
+	for (int32 Index = 0; Index < InListItems.Num(); ++Index)
+	{
+		const FListItemSlot& Slot = InSlots[Index];
+		if (!Slot.Factory || !EnumHasAnyFlags(Slot.Dependencies, InDependency))
+		{
+			continue;
+		}
+
+		// A new item makes the list view generate a new row for it, rows of other items are kept as is
+		const bool bWasSelected = InListView.IsItemSelected(InListItems[Index]);
+		InListItems[Index] = FMGAHeaderViewListItem::CreateDeferred(CopyTemp(Slot.Factory));
+		if (bWasSelected)
+		{
+			InListView.SetItemSelection(InListItems[Index], true);
+		}
+
+		++NumRefreshed;
+	}
+
+	MGA_SCAFFOLD_LOG(VeryVerbose, TEXT("SMGAHeaderView::RefreshListItems - Refreshed %d / %d items"), NumRefreshed, InListItems.Num())
+	if (NumRefreshed > 0)
+	{
+		InListView.RequestListRefresh();
+	}
 }
 
 void SMGAHeaderView::HandlePreviewValueChanged(const EMGAPreviewCppType InActiveTab) const
@@ -402,54 +491,22 @@ void SMGAHeaderView::OnAssetSelected(const FAssetData& SelectedAsset)
 
 FString SMGAHeaderView::GetHeaderContent() const
 {
-	TArray<FString> LineItemsContent;
-	Algo::Transform(HeaderListItems, LineItemsContent, [](const FMGAHeaderViewListItemPtr& Item)
-	{
-		return Item->GetRawItemString();
-	});
-
-	FString Content = FString::Join(LineItemsContent, TEXT("\n"));
-	MGA::String::ToHostLineEndingsInline(Content);
-	return Content;
+	return FMGAAttributeSetCodeGenerator::JoinItems(HeaderListItems);
 }
 
 FString SMGAHeaderView::GetHeaderRichContent() const
 {
-	TArray<FString> LineItemsContent;
-	Algo::Transform(HeaderListItems, LineItemsContent, [](const FMGAHeaderViewListItemPtr& Item)
-	{
-		return Item->GetRichItemString();
-	});
-
-	FString Content = FString::Join(LineItemsContent, TEXT("\n"));
-	MGA::String::ToHostLineEndingsInline(Content);
-	return Content;
+	return FMGAAttributeSetCodeGenerator::JoinItems(HeaderListItems, true);
 }
 
 FString SMGAHeaderView::GetSourceContent() const
 {
-	TArray<FString> LineItemsContent;
-	Algo::Transform(SourceListItems, LineItemsContent, [](const FMGAHeaderViewListItemPtr& Item)
-	{
-		return Item->GetRawItemString();
-	});
-
-	FString Content = FString::Join(LineItemsContent, TEXT("\n"));
-	MGA::String::ToHostLineEndingsInline(Content);
-	return Content;
+	return FMGAAttributeSetCodeGenerator::JoinItems(SourceListItems);
 }
 
 FString SMGAHeaderView::GetSourceRichContent() const
 {
-	TArray<FString> LineItemsContent;
-	Algo::Transform(SourceListItems, LineItemsContent, [](const FMGAHeaderViewListItemPtr& Item)
-	{
-		return Item->GetRichItemString();
-	});
-
-	FString Content = FString::Join(LineItemsContent, TEXT("\n"));
-	MGA::String::ToHostLineEndingsInline(Content);
-	return Content;
+	return FMGAAttributeSetCodeGenerator::JoinItems(SourceListItems, true);
 }
 
 TSharedRef<ITableRow> SMGAHeaderView::GenerateRowForItem(const FMGAHeaderViewListItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable) const
@@ -532,41 +589,15 @@ void SMGAHeaderView::RepopulateListView()
 void SMGAHeaderView::RepopulateHeaderListView()
 {
 	HeaderListItems.Empty();
+	HeaderListItemSlots.Empty();
 
 	check(ViewModel.IsValid());
-	const TWeakObjectPtr<UBlueprint> BlueprintWeakPtr = ViewModel->GetSelectedBlueprint();
-
-	if (const UBlueprint* Blueprint = BlueprintWeakPtr.Get())
+	FMGAAttributeSetCodeGenerator::BuildHeaderItems(ViewModel, [this](const EMGAHeaderViewItemDependency InDependencies, TFunction<FMGAHeaderViewListItemPtr()>&& InFactory)
 	{
-		// Add the copyright notice
-		HeaderListItems.Add(FMGAHeaderViewCopyrightListItem::Create());
-
-		// Add the include directives
-		HeaderListItems.Add(FMGAHeaderViewIncludesListItem::Create(ViewModel));
-
-		// Add the attribute accessors macro
-		HeaderListItems.Add(FMGAHeaderViewAttributesAccessorsListItem::Create());
-		
-		// Add the class declaration
-		HeaderListItems.Add(FMGAHeaderViewClassListItem::Create(ViewModel));
-
-		PopulateHeaderVariableItems(Blueprint->GeneratedClass);
-		// PopulateFunctionItems(Blueprint);
-
-		// Add the constructor declaration
-		HeaderListItems.Add(FMGAHeaderViewConstructorListItem::Create(ViewModel));
-
-		// Add the GetLifetimeReplicatedProp
-		const TArray<const FProperty*> ReplicatedProps = FMGAHeaderViewListItem::GetAllProperties(Blueprint->GeneratedClass, true);
-		if (!ReplicatedProps.IsEmpty())
-		{
-			HeaderListItems.Add(FMGAHeaderViewGetLifetimeListItem::Create(ViewModel));
-			PopulateHeaderOnRepFunctionItems(Blueprint, ReplicatedProps);
-		}
+		AddHeaderItem(InDependencies, MoveTemp(InFactory));
+	});
 
-		// Add the closing brace of the class
-		HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT("};"), TEXT("};")));
-	}
+	// PopulateFunctionItems(Blueprint);
 
 	HeaderListView->RequestListRefresh();
 }
@@ -574,28 +605,15 @@ void SMGAHeaderView::RepopulateHeaderListView()
 void SMGAHeaderView::RepopulateSourceListView()
 {
 	SourceListItems.Empty();
+	SourceListItemSlots.Empty();
 
 	check(ViewModel.IsValid());
-	
-	const TWeakObjectPtr<UBlueprint> SelectedBlueprint = ViewModel->GetSelectedBlueprint();
-	check(SelectedBlueprint.IsValid());
-
-	// Add the copyright notice
-	SourceListItems.Add(FMGAHeaderViewCopyrightListItem::Create());
+	check(ViewModel->GetSelectedBlueprint().IsValid());
 
-	// Add the include directives
-	SourceListItems.Add(FMGASourceViewIncludesListItem::Create(ViewModel));
-
-	// Add the constructor implementation
-	SourceListItems.Add(FMGASourceViewConstructorListItem::Create(ViewModel));
-	
-	// Add the GetLifetimeReplicatedProp implementation
-	const TArray<const FProperty*> ReplicatedProps = FMGAHeaderViewListItem::GetAllProperties(SelectedBlueprint->GeneratedClass, true);
-	if (!ReplicatedProps.IsEmpty())
+	FMGAAttributeSetCodeGenerator::BuildSourceItems(ViewModel, [this](const EMGAHeaderViewItemDependency InDependencies, TFunction<FMGAHeaderViewListItemPtr()>&& InFactory)
 	{
-		SourceListItems.Add(FMGASourceViewGetLifetimeListItem::Create(ViewModel));
-	}
-	AddSourceOnRepFunctionItems(ReplicatedProps);
+		AddSourceItem(InDependencies, MoveTemp(InFactory));
+	});
 
 	// PopulateSourceVariableItems(Blueprint->GeneratedClass);
 	// PopulateFunctionItems(Blueprint);
@@ -630,25 +648,25 @@ void SMGAHeaderView::PopulateFunctionItems(const UBlueprint* Blueprint)
 						{
 						default: 
 						case FUNC_Public:
-							HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT("public:"), FString::Printf(TEXT("<%s>public</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
+							AddHeaderItem(FMGAHeaderViewListItem::Create(TEXT("public:"), FString::Printf(TEXT("<%s>public</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
 							break;
 						case FUNC_Protected:
-							HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT("protected:"), FString::Printf(TEXT("<%s>protected</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
+							AddHeaderItem(FMGAHeaderViewListItem::Create(TEXT("protected:"), FString::Printf(TEXT("<%s>protected</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
 							break;
 						case FUNC_Private:
-							HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT("private:"), FString::Printf(TEXT("<%s>private</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
+							AddHeaderItem(FMGAHeaderViewListItem::Create(TEXT("private:"), FString::Printf(TEXT("<%s>private</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
 							break;
 						}
 					}
 					else
 					{
 						// add an empty line to space functions out
-						HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT(""), TEXT("")));
+						AddHeaderItem(FMGAHeaderViewListItem::Create(TEXT(""), TEXT("")));
 					}
 
 					PrevAccessSpecifier = AccessSpecifier;
 
-					HeaderListItems.Add(FMGAHeaderViewFunctionListItem::Create(EntryNodes[0]));
+					AddHeaderItem(FMGAHeaderViewFunctionListItem::Create(EntryNodes[0]));
 				}
 			}
 		}
@@ -684,120 +702,6 @@ void SMGAHeaderView::GatherFunctionGraphs(const UBlueprint* Blueprint, TArray<co
 	}
 }
 
-void SMGAHeaderView::PopulateHeaderOnRepFunctionItems(const UBlueprint* Blueprint, const TArray<const FProperty*> InReplicatedProps)
-{
-	check(Blueprint);
-
-	// Check if we have at least one item with repnotify to add a definition for, and prevent adding a protected access with no items
-	bool bHasRepNotifies = false;
-	for (const FProperty* VarProperty : InReplicatedProps)
-	{
-		if (VarProperty && VarProperty->HasAnyPropertyFlags(CPF_Net) && VarProperty->HasAnyPropertyFlags(CPF_RepNotify))
-		{
-			bHasRepNotifies = true;
-			break;
-		}
-
-		if (FMGAUtilities::IsValidCPPType(VarProperty->GetCPPType()))
-		{
-			bHasRepNotifies = true;
-			break;
-		}
-	}
-
-	if (bHasRepNotifies)
-	{
-		HeaderListItems.Add(FMGAHeaderViewListItem::Create(
-			TEXT("protected:"),
-			FString::Printf(TEXT("<%s>protected</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)
-		));
-	}
-
-	for (const FProperty* VarProperty : InReplicatedProps)
-	{
-		if (!VarProperty)
-		{
-			continue;
-		}
-
-		if (FMGAUtilities::IsValidCPPType(VarProperty->GetCPPType()))
-		{
-			HeaderListItems.Add(FMGAHeaderViewOnRepListItem::Create(ViewModel, *VarProperty));
-	
-		}
-		else if (VarProperty->HasAnyPropertyFlags(CPF_Net) && VarProperty->HasAnyPropertyFlags(CPF_RepNotify))
-		{
-			HeaderListItems.Add(FMGAHeaderViewOnRepListItem::Create(ViewModel, *VarProperty));
-		}
-	}
-}
-
-void SMGAHeaderView::AddHeaderVariableItems(TArray<const FProperty*> VarProperties)
-{
-	// We should only add an access specifier line if the previous variable was a different one
-	int32 PrevAccessSpecifier = 0;
-	for (const FProperty* VarProperty : VarProperties)
-	{
-		constexpr int32 Private = 2;
-		constexpr int32 Public = 1;
-		const int32 AccessSpecifier = VarProperty->GetBoolMetaData(FBlueprintMetadata::MD_Private) ? Private : Public;
-		if (AccessSpecifier != PrevAccessSpecifier)
-		{
-			switch (AccessSpecifier)
-			{
-			case Public:
-				HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT("public:"), FString::Printf(TEXT("<%s>public</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
-				break;
-			case Private:
-				HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT("private:"), FString::Printf(TEXT("<%s>private</>:"), *MGA::HeaderViewSyntaxDecorators::KeywordDecorator)));
-				break;
-			default:
-				break;
-			}
-
-			PrevAccessSpecifier = AccessSpecifier;
-		}
-		else
-		{
-			// add an empty line to space variables out
-			HeaderListItems.Add(FMGAHeaderViewListItem::Create(TEXT(""), TEXT("")));
-		}
-
-		FMGAHeaderViewListItemPtr VariableItem = FMGAUtilities::IsValidCPPType(VarProperty->GetCPPType()) ?
-			FMGAHeaderViewAttributeVariableListItem::Create(*VarProperty, ViewModel) :
-			FMGAHeaderViewVariableListItem::Create(*VarProperty, ViewModel);
-		
-		HeaderListItems.Add(VariableItem);
-	}
-}
-
-void SMGAHeaderView::AddSourceOnRepFunctionItems(const TArray<const FProperty*>& InReplicatedProps)
-{
-	// We should only add an access specifier line if the previous variable was a different one
-	for (const FProperty* VarProperty : InReplicatedProps)
-	{
-		if (!VarProperty)
-		{
-			continue;
-		}
-
-		if (FMGAUtilities::IsValidCPPType(VarProperty->GetCPPType()))
-		{
-			SourceListItems.Add(FMGASourceViewOnRepListItem::Create(ViewModel, *VarProperty));
-		}
-		else if (VarProperty->HasAnyPropertyFlags(CPF_Net) && VarProperty->HasAnyPropertyFlags(CPF_RepNotify))
-		{
-			SourceListItems.Add(FMGASourceViewOnRepListItem::Create(ViewModel, *VarProperty));
-		}
-	}
-}
-
-void SMGAHeaderView::PopulateHeaderVariableItems(const UStruct* Struct)
-{
-	const TArray<const FProperty*> VarProperties = FMGAHeaderViewListItem::GetAllProperties(Struct);
-	AddHeaderVariableItems(VarProperties);
-}
-
 TSharedPtr<SWidget> SMGAHeaderView::OnPreviewContextMenuOpening(const EMGAPreviewCppType InPreviewType) const
 {
 	check(ViewModel.IsValid());
@@ -2,6 +2,7 @@
 
 #include "SourceView/MGASourceViewGetLifetimeListItem.h"
 
+#include "Attributes/ModularAttributeSetBase.h"
 #include "Engine/Blueprint.h"
 #include "LineEndings/MGALineEndings.h"
 #include "Models/MGAAttributeSetWizardViewModel.h"
@@ -106,6 +107,19 @@ FMGASourceViewGetLifetimeListItem::FMGASourceViewGetLifetimeListItem(const TShar
 				);
 			}
 		}
+
+		// Replication rules of Modular Attribute Sets only apply to attributes registered when this runs
+		// i.e. ApplyAttributeReplicationRules(OutLifetimeProps);
+		const UClass* ParentClass = InViewModel->GetParentClassInfo().BaseClass;
+		if (ParentClass && ParentClass->IsChildOf<UModularAttributeSetBase>())
+		{
+			RawItemString += TEXT("\n\tApplyAttributeReplicationRules(OutLifetimeProps);\n");
+			RichTextString += FString::Printf(
+				TEXT("\n\t<%s>ApplyAttributeReplicationRules</>(<%s>OutLifetimeProps</>);\n"),
+				*MGA::HeaderViewSyntaxDecorators::IdentifierDecorator,
+				*MGA::HeaderViewSyntaxDecorators::IdentifierDecorator
+			);
+		}
 		
 		// Add closing brace line
 		RawItemString += TEXT("}\n");
@@ -0,0 +1,75 @@
+// Copyright Halcyonyx Studios.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MGAHeaderViewListItem.h"
+
+class FMGAAttributeSetWizardViewModel;
+class UBlueprint;
+
+/** Model properties the content of a list item depends on, so that only affected items are rebuilt on model changes */
+enum class EMGAHeaderViewItemDependency : uint8
+{
+	None = 0,
+
+	/** NewClassName */
+	ClassName = 1 << 0,
+
+	/** ParentClassInfo */
+	ParentClass = 1 << 1,
+
+	/** ClassLocation */
+	ClassLocation = 1 << 2,
+
+	/** SelectedModuleInfo */
+	Module = 1 << 3,
+
+	/** SelectedClassPath */
+	ClassPath = 1 << 4,
+};
+ENUM_CLASS_FLAGS(EMGAHeaderViewItemDependency)
+
+/**
+ * Builds the header and source lines of the C++ class generated from the Attribute Set Blueprint selected in a view model.
+ *
+ * Shared by the header view widget (which builds list items lazily, and rebuilds them on model changes) and the
+ * MGAGenerateAttributeSets commandlet (which only needs the file content, without any widget).
+ */
+class FMGAAttributeSetCodeGenerator
+{
+public:
+	/** Receives each line item factory in order, along with the model properties the item depends on */
+	using FAddItem = TFunctionRef<void(EMGAHeaderViewItemDependency, TFunction<FMGAHeaderViewListItemPtr()>&&)>;
+
+	/** Adds the header file line items of the selected Blueprint, nothing if there is none */
+	static void BuildHeaderItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, FAddItem InAddItem);
+
+	/** Adds the source file line items of the selected Blueprint, nothing if there is none */
+	static void BuildSourceItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, FAddItem InAddItem);
+
+	/** Returns the raw content of the header file, with host line endings */
+	static FString GenerateHeaderContent(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel);
+
+	/** Returns the raw content of the source file, with host line endings */
+	static FString GenerateSourceContent(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel);
+
+	/** Joins the raw (or rich) text of InItems into file content, with host line endings */
+	static FString JoinItems(const TArray<FMGAHeaderViewListItemPtr>& InItems, bool bInRichText = false);
+
+private:
+	/** Builds the items added by InBuild right away, skipping the ones whose property is gone */
+	static TArray<FMGAHeaderViewListItemPtr> BuildItems(TFunctionRef<void(FAddItem)> InBuild);
+
+	/** Adds items representing all variables present in the given asset */
+	static void AddHeaderVariableItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const TArray<const FProperty*>& InVarProperties, FAddItem InAddItem);
+
+	/** Adds items representing all on rep functions to add based on attribute variables present */
+	static void AddHeaderOnRepFunctionItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const TArray<const FProperty*>& InReplicatedProps, FAddItem InAddItem);
+
+	/** Adds line items for onrep notifier function implementations */
+	static void AddSourceOnRepFunctionItems(const TSharedPtr<FMGAAttributeSetWizardViewModel>& InViewModel, const TArray<const FProperty*>& InReplicatedProps, FAddItem InAddItem);
+
+	/** Returns whether an OnRep function is generated for InProperty */
+	static bool NeedsOnRepFunction(const FProperty* InProperty);
+};
@@ -31,16 +31,25 @@ struct FMGAHeaderViewListItem : public TSharedFromThis<FMGAHeaderViewListItem>
 	virtual ~FMGAHeaderViewListItem() {};
 
 	/** Creates the widget for this list item */
-	TSharedRef<SWidget> GenerateWidgetForItem() const;
+	virtual TSharedRef<SWidget> GenerateWidgetForItem() const;
 
 	/** Creates a basic list item containing some text */
 	static TSharedPtr<FMGAHeaderViewListItem> Create(FString InRawString, FString InRichText);
 
+	/**
+	 * Creates a list item that only builds its content with InFactory once first needed, ie. when the list view generates
+	 * a row for it or its text is read (copy, file generation).
+	 *
+	 * Formatting and syntax highlighting of items scrolled out of view is skipped that way, which matters for Attribute
+	 * Sets with hundreds of attributes. InFactory is called at most once, with the model state of that time.
+	 */
+	static TSharedPtr<FMGAHeaderViewListItem> CreateDeferred(TFunction<TSharedPtr<FMGAHeaderViewListItem>()>&& InFactory);
+
 	/** Returns the raw item text for copy actions */
-	const FString& GetRawItemString() const { return RawItemString; }
+	virtual const FString& GetRawItemString() const { return RawItemString; }
 	
 	/** Returns the rich item text */
-	const FString& GetRichItemString() const { return RichTextString; }
+	virtual const FString& GetRichItemString() const { return RichTextString; }
 
 	/** Allows the item to add items to the context menu if it is the only item selected */
 	virtual void ExtendContextMenu(FMenuBuilder& InMenuBuilder, TWeakObjectPtr<UObject> InAsset) {}
@@ -51,6 +60,9 @@ struct FMGAHeaderViewListItem : public TSharedFromThis<FMGAHeaderViewListItem>
 	/**
 	 * Returns all FProperties from the passed in object (generally a Blueprint skeleton class)
 	 *
+	 * Properties of parent Blueprint classes are included, parent first, up to the nearest native parent: the generated
+	 * class derives from that native parent, attributes inherited from an Attribute Set Blueprint have to be declared in it.
+	 *
 	 * @param InStruct Owning UStruct
 	 * @param bInFilterReplicated Whether to return only properties that are marked as replicated (Either Replicated or using RepNotify)
 	 */
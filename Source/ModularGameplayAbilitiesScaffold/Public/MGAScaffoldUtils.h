@@ -5,6 +5,18 @@
 #include "CoreMinimal.h"
 #include "GameProjectUtils.h"
 
+/** Header and source file of a class to add to the project */
+struct FMGAScaffoldClassFiles
+{
+	FString ClassName;
+	FString ClassPath;
+	FString HeaderDestination;
+	FString HeaderContent;
+	FString SourceDestination;
+	FString SourceContent;
+	FModuleContextInfo ModuleInfo;
+};
+
 /**
  * Scaffold generation utilities.
  */
@@ -24,8 +36,23 @@ public:
 		FText& OutErrorText
 	);
 
+	/**
+	 * Adds many classes at once: all of them are validated before writing any file, then project files are updated and
+	 * created files are marked for add in source control once for the whole batch.
+	 *
+	 * Fails without writing anything if any of the files already exists. If a file fails to be written, the files of the
+	 * batch written so far are deleted and OutCreatedFiles is left untouched. No hot reload or live coding compile is triggered.
+	 */
+	static GameProjectUtils::EAddCodeToProjectResult AddClassesToProject(const TArray<FMGAScaffoldClassFiles>& InClassesFiles, TArray<FString>& OutCreatedFiles, FText& OutErrorText);
+
+	/** Checks that the class name is available and that its files are going in the module source folder */
+	static GameProjectUtils::EAddCodeToProjectResult ValidateClassFiles(const FMGAScaffoldClassFiles& InClassFiles, FText& OutErrorText);
+
 	static GameProjectUtils::EAddCodeToProjectResult AddCodeFileToProject(const FString& InDestination, const FString& InContent, FText& OutErrorText);
 
+	/** Adds newly written files to the IDE project (or regenerates project files), and marks them for add in source control */
+	static GameProjectUtils::EAddCodeToProjectResult AddCreatedFilesToProject(const TArray<FString>& InCreatedFiles, bool bInProjectHadCodeFiles, FText& OutErrorText);
+
 	static bool UpdateProjectFiles(FText& ErrorText);
 
 	//~ Begin GameProjectUtils fallback - Those methods are private
@@ -70,6 +97,17 @@ public:
 	static bool DoesBuildCSFileContains(const FModuleContextInfo& InModuleContextInfo, const FString& InSearchPattern, FText& OutFailReason);
 	
 	static bool DoesBuildCSSatisfiesDependencies(const FModuleContextInfo& InModuleContextInfo, const TArray<FString>& InModuleDependencies, TArray<FString>& OutMissingModuleDependencies, FText& OutFailReason);
+
+	/**
+	 * Adds InModuleDependencies to the PublicDependencyModuleNames list of the module Build.cs file, in a single write
+	 * (checked out from source control first).
+	 *
+	 * Dependencies already listed are expected to be filtered out by the caller, see DoesBuildCSSatisfiesDependencies().
+	 */
+	static bool AddBuildCSDependencies(const FModuleContextInfo& InModuleContextInfo, const TArray<FString>& InModuleDependencies, FText& OutFailReason);
 	
 	static FString GetContainingModuleName(const UStruct* InStruct);
+
+private:
+	static bool LoadBuildCSFile(const FModuleContextInfo& InModuleContextInfo, FString& OutFileContents, FText& OutFailReason);
 };
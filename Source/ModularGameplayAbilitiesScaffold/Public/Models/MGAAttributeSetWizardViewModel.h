@@ -107,8 +107,13 @@ public:
 	/** Noop (for now) initialization sequence */
 	virtual void Initialize() override;
 
-	/** Checks the current class name/path for validity and updates cached values accordingly */
-	void UpdateInputValidity();
+	/**
+	 * Checks the current class name/path for validity and updates cached values accordingly
+	 *
+	 * @param bInCheckModuleDependencies Whether missing module dependencies in target module Build.cs file fail the check (the
+	 * MGAGenerateAttributeSets commandlet adds them all at once instead)
+	 */
+	void UpdateInputValidity(bool bInCheckModuleDependencies = true);
 
 	/** Returns whether last validity check was successful */
 	bool IsLastInputValidityCheckSuccessful() const;
@@ -131,6 +136,9 @@ public:
 	/** Reset required module dependencies to the reserved always included ones */
 	void ResetRequiredModuleDependencies();
 
+	/** Resets then adds the module dependencies required by the parent class and the selected Blueprint */
+	void UpdateRequiredModuleDependencies();
+
 private:
 	/** The list of "reserved" always required dependencies */
 	static TArray<FMGARequiredModuleDependency> ReservedModuleDependencies;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MGAAttributeSetCodeGenerator.h"
 #include "MGAHeaderViewListItem.h"
 #include "Misc/NotifyHook.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
@@ -78,11 +79,39 @@ private:
 	/** List Items source */
 	TArray<FMGAHeaderViewListItemPtr> SourceListItems;
 
+	/** How to rebuild a list item when model properties it depends on change */
+	struct FListItemSlot
+	{
+		EMGAHeaderViewItemDependency Dependencies = EMGAHeaderViewItemDependency::None;
+
+		/** Builds the item, unset for items that never need rebuilding */
+		TFunction<FMGAHeaderViewListItemPtr()> Factory;
+	};
+
+	/** Rebuild info of HeaderListItems, same indices */
+	TArray<FListItemSlot> HeaderListItemSlots;
+
+	/** Rebuild info of SourceListItems, same indices */
+	TArray<FListItemSlot> SourceListItemSlots;
+
 	/** Switcher for active tab view */
 	TSharedPtr<SWidgetSwitcher> TabContentSwitcher;
 
-	/** Handler for a model property change */
+	/** Handler for a model property change, rebuilds only the list items depending on it */
 	void HandleModelPropertyChanged(const FString& InPropertyName);
+
+	/** Returns which list items depend on the model property InPropertyName, false if the whole list needs to be repopulated */
+	static bool GetItemDependencyForModelProperty(const FString& InPropertyName, EMGAHeaderViewItemDependency& OutDependency);
+
+	/** Adds an item built (lazily) by InFactory, and rebuilt whenever one of InDependencies changes */
+	void AddHeaderItem(EMGAHeaderViewItemDependency InDependencies, TFunction<FMGAHeaderViewListItemPtr()>&& InFactory);
+	void AddSourceItem(EMGAHeaderViewItemDependency InDependencies, TFunction<FMGAHeaderViewListItemPtr()>&& InFactory);
+
+	/** Adds an item that never needs rebuilding (eg. an access specifier line) */
+	void AddHeaderItem(const FMGAHeaderViewListItemPtr& InItem);
+
+	/** Replaces the items of InListItems depending on InDependency with new (deferred) ones, keeping their selection */
+	static void RefreshListItems(SListView<FMGAHeaderViewListItemPtr>& InListView, TArray<FMGAHeaderViewListItemPtr>& InListItems, const TArray<FListItemSlot>& InSlots, EMGAHeaderViewItemDependency InDependency);
 	
 	/** Handler for segmented control tab view changed */
 	void HandlePreviewValueChanged(EMGAPreviewCppType InActiveTab) const;
@@ -110,16 +139,6 @@ private:
 	/** Gathers all function graphs from the blueprint and sorts them according to the selected method from config */
 	void GatherFunctionGraphs(const UBlueprint* Blueprint, TArray<const UEdGraph*>& OutFunctionGraphs) const;
 
-	/** Adds items to the list view representing all on rep functions to add based on attribute variables present */
-	void PopulateHeaderOnRepFunctionItems(const UBlueprint* Blueprint, const TArray<const FProperty*> InReplicatedProps);
-
-	/** Adds items to the list view representing all variables present in the given asset */
-	void PopulateHeaderVariableItems(const UStruct* Struct);
-	void AddHeaderVariableItems(TArray<const FProperty*> VarProperties);
-
-	/** Adds line items for onrep notifier function implementations */
-	void AddSourceOnRepFunctionItems(const TArray<const FProperty*>& InReplicatedProps);
-
 	/** Creates a context menu for the list view */
 	TSharedPtr<SWidget> OnPreviewContextMenuOpening(EMGAPreviewCppType InPreviewType) const;
 